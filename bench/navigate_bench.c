@@ -0,0 +1,566 @@
+/*
+ * navigate_bench.c - microbenchmarks of the parser and the generator
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Usage: navigate_bench [-t seconds] [-r repeats] [-f filter] [-c corpus] [tracksdir]
+//
+//	-t	the minimum time of one measurement, 0.2 s by default
+//	-r	the number of measurements, the best one is reported, 3 by default
+//	-f	runs only the benchmarks with the name containing the filter
+//	-c	also runs the tracks benchmarks on the file, e.g. made by
+//		navigate_corpus, as the group corpus
+//
+// The results are printed as CSV, one benchmark per line:
+//
+//	group,name,operations,bytes,ns_per_op,mb_per_s
+//
+// The groups are parse and generate (one sentence type repeated),
+// field (the field parsers), frame (checksum and framer) and tracks
+// (the stream of tests/tracks). The lines starting with '#' are comments.
+//
+
+#include <navigate.h>
+#include "../src/version.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif // _WIN32
+
+// The number of the sentences in the corpus of one type
+#define NM_CORPUS		256
+
+// The benchmarked function does n operations, returns the number of bytes
+// processed, or 0 on error
+typedef size_t (*bench_fn_t)(void *ctx, size_t n);
+
+static double g_mintime = 0.2;
+static int g_repeats = 3;
+static const char *g_filter = NULL;
+
+static volatile size_t g_sink;
+
+//
+// The sample sentences of the supported types, without the checksum.
+// BWC and BWR are left out, their parser does not accept the distance
+// units field of the standard.
+static const char *g_samples[] =
+{
+	"GPAAM,A,V,10.1,N,St. Petersburg^2C Russia",
+	"GPACK,846",
+	"GPALM,3,1,04,3400,44,0011,09,8a14,7f01,780012,00dd01,000000,920f15,115,023",
+	"GPALR,120813,846,A,V,",
+	"GPAPB,A,A,0.10,R,N,V,V,011,M,DEST,011,M,011,M,A",
+	"GPBEC,220516,5130.02,N,00046.34,W,213.8,T,218.0,M,0004.6,N,EGLM",
+	"GPBOD,099.3,T,105.6,M,POINTB,POINTA",
+	"GPBWW,099.3,T,105.6,M,POINTB,POINTA",
+	"SDDBT,17.5,f,5.33,M,2.92,F",
+	"SDDPT,5.33,-0.5,100",
+	"GPDTM,W84,,14.196,N,19.095,W,3.446,W84",
+	"GPGBS,015509.00,-0.031,-0.186,0.219,19,0.000,-0.354,6.972",
+	"GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,",
+	"GPGLL,4807.038,N,01131.000,E,123519,A,A",
+	"GNGNS,200701,6000,N,03000,E,AD,04,2.3,2.003,18.2,4,13",
+	"GPGRS,003416,0,1,0.2,0.34,1.01,0.98,,,0.1,-103,,,",
+	"GPGSA,A,3,01,12,03,02,18,,,24,14,,,,2.12003,2.12,0.012",
+	"GPGST,140816,1.4,0.56,3.2,18,0.2,0.1,1",
+	"GPGSV,3,1,09,04,12,000,,05,18,012,45,14,,,,18,12,300,70",
+	"HCHDG,98.3,0.5,E,12.6,W",
+	"HEHDT,274.07,T",
+	"GLMLA,3,1,04,3400,44,0011,09,8a14,7f01,780012,00dd01,000000,920f15,115,023",
+	"WIMWV,214.8,R,0.1,N,A",
+	"GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W,A",
+	"GPTXT,01,01,25,Pay big attention to the Metro stations",
+	"GPVTG,054.7,T,034.4,M,005.5,N,010.2,K,A",
+	"GPZDA,201530.00,04,07,2002,00,00"
+};
+
+#define NM_SAMPLES		(sizeof(g_samples) / sizeof(g_samples[0]))
+
+// The storage of a parsed sentence
+union parsed_t
+{
+	struct approved_field_t address;
+	double align;
+	char bytes[1024];
+};
+
+// The corpus of the sentences of one type, or of the tracks
+struct corpus_t
+{
+	char *data;
+	size_t size, nmsentences;
+};
+
+// The sentence parsed once, for the generator
+struct generate_t
+{
+	union parsed_t parsed;
+	char output[NAVI_SENTENCE_MAXSIZE + 1];
+};
+
+// The field parser and its input
+enum field_kind_t
+{
+	field_Number,
+	field_PositionFix,
+	field_Utc,
+	field_Offset,
+	field_Status,
+	field_ModeIndicator,
+	field_Date,
+	field_Datum,
+	field_HexField,
+	field_CharacterField
+};
+
+struct field_t
+{
+	const char *name;
+	enum field_kind_t kind;
+	const char *input;
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+};
+
+static struct field_t g_fields[] =
+{
+	{ "navi_parse_number", field_Number, "-12345.678," },
+	{ "navi_parse_position_fix", field_PositionFix, "4807.038,N,01131.000,E," },
+	{ "navi_parse_utc", field_Utc, "123519.25," },
+	{ "navi_parse_offset", field_Offset, "12.6,W," },
+	{ "navi_parse_status", field_Status, "A," },
+	{ "navi_parse_modeindicator", field_ModeIndicator, "D," },
+	{ "navi_parse_date", field_Date, "230394," },
+	{ "navi_parse_datum", field_Datum, "W84," },
+	{ "navi_parse_hexfield", field_HexField, "8a14," },
+	{ "navi_parse_character_field", field_CharacterField, "St. Petersburg^2C Russia," }
+};
+
+#define NM_FIELDS		(sizeof(g_fields) / sizeof(g_fields[0]))
+
+//
+// Returns the monotonic time in seconds
+static double bench_now(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter, frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif // _WIN32
+}
+
+//
+// Measures the function and prints the result. The operations are
+// counted in units of opsize, e.g. the sentences of a corpus.
+static int bench_run(const char *group, const char *name, bench_fn_t fn, void *ctx,
+	size_t opsize)
+{
+	size_t n = 1, bytes = 0;
+	double start, elapsed, best = 0.0;
+	int i;
+
+	if ((g_filter != NULL) && (strstr(name, g_filter) == NULL) && (strstr(group, g_filter) == NULL))
+		return 0;
+
+	// find the number of iterations taking the minimum time
+	for ( ; ; )
+	{
+		start = bench_now();
+		bytes = fn(ctx, n);
+		elapsed = bench_now() - start;
+
+		if (bytes == 0)
+		{
+			printf("# %s,%s failed (%d)\n", group, name, navierr_get_last()->errclass);
+			return 1;
+		}
+
+		if (elapsed >= g_mintime)
+			break;
+
+		n = elapsed > g_mintime / 100. ? (size_t)(n * 1.2 * g_mintime / elapsed) + 1 : n * 10;
+	}
+
+	best = elapsed;
+	for (i = 1; i < g_repeats; i++)
+	{
+		start = bench_now();
+		fn(ctx, n);
+		elapsed = bench_now() - start;
+
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	printf("%s,%s,%lu,%lu,%.2f,%.2f\n", group, name, (unsigned long)(n * opsize),
+		(unsigned long)bytes, best * 1e9 / ((double)n * opsize), (double)bytes / best / 1e6);
+	fflush(stdout);
+
+	return 0;
+}
+
+//
+// Parses all the sentences of the corpus n times
+static size_t bench_parse(void *ctx, size_t n)
+{
+	struct corpus_t *corpus = (struct corpus_t *)ctx;
+	union parsed_t parsed;
+	navi_addrfield_t type;
+	size_t i, offset, nmread;
+
+	for (i = 0; i < n; i++)
+	{
+		for (offset = 0; offset < corpus->size; offset += nmread)
+		{
+			if (navi_parse_msg(corpus->data + offset, corpus->size - offset, sizeof(parsed),
+					&type, &parsed, &nmread) != navi_Ok)
+			{
+				if (navierr_get_last()->errclass == navi_NoValidMessage)
+					break;
+				if ((corpus->nmsentences == NM_CORPUS) || (nmread == 0))
+					return 0;	// the synthetic corpus has no bad sentences
+			}
+		}
+	}
+
+	g_sink += (size_t)parsed.address.afmt;
+
+	return n * corpus->size;
+}
+
+//
+// Generates the sentence n times
+static size_t bench_generate(void *ctx, size_t n)
+{
+	struct generate_t *gen = (struct generate_t *)ctx;
+	size_t i, nmwritten = 0, bytes = 0;
+
+	for (i = 0; i < n; i++)
+	{
+		if (navi_create_msg(navi_af_Approved, &gen->parsed.address, &gen->parsed.address + 1,
+				gen->output, sizeof(gen->output), &nmwritten) != navi_Ok)
+		{
+			return 0;
+		}
+		bytes += nmwritten;
+	}
+
+	return bytes;
+}
+
+//
+// Parses the field n times
+static size_t bench_field(void *ctx, size_t n)
+{
+	struct field_t *field = (struct field_t *)ctx;
+	union
+	{
+		double number;
+		struct navi_position_t fix;
+		struct navi_utc_t utc;
+		struct navi_offset_t offset;
+		struct navi_date_t date;
+		navi_status_t status;
+		navi_modeindicator_t mi;
+		navi_datum_t datum;
+		char bytes[NAVI_SENTENCE_MAXSIZE + 1];
+	} value;
+	navierr_status_t status = navi_Ok;
+	size_t i, nmread = 0;
+
+	memset(&value, 0, sizeof(value));
+
+	for (i = 0; (i < n) && (status == navi_Ok); i++)
+	{
+		switch (field->kind)
+		{
+		case field_Number:
+			status = navi_parse_number(field->buffer, &value.number, &nmread);
+			break;
+		case field_PositionFix:
+			status = navi_parse_position_fix(field->buffer, &value.fix, &nmread);
+			break;
+		case field_Utc:
+			status = navi_parse_utc(field->buffer, &value.utc, &nmread);
+			break;
+		case field_Offset:
+			status = navi_parse_offset(field->buffer, &value.offset, &nmread);
+			break;
+		case field_Status:
+			status = navi_parse_status(field->buffer, &value.status, &nmread);
+			break;
+		case field_ModeIndicator:
+			status = navi_parse_modeindicator(field->buffer, &value.mi, &nmread);
+			break;
+		case field_Date:
+			status = navi_parse_date(field->buffer, &value.date, &nmread);
+			break;
+		case field_Datum:
+			status = navi_parse_datum(field->buffer, &value.datum, &nmread);
+			break;
+		case field_HexField:
+			status = navi_parse_hexfield(field->buffer, 4, value.bytes, &nmread);
+			break;
+		case field_CharacterField:
+			status = navi_parse_character_field(field->buffer, value.bytes,
+				sizeof(value.bytes), &nmread);
+			break;
+		}
+	}
+
+	if (status != navi_Ok)
+		return 0;
+
+	g_sink += value.bytes[0];
+
+	return n * nmread;
+}
+
+//
+// Calculates the checksums of the corpus sentences n times
+static size_t bench_checksum(void *ctx, size_t n)
+{
+	struct corpus_t *corpus = (struct corpus_t *)ctx;
+	unsigned int cs = 0;
+	size_t i, length;
+	char *sentence;
+
+	length = strchr(corpus->data, '\n') + 1 - corpus->data;
+
+	for (i = 0; i < n; i++)
+	{
+		sentence = corpus->data + (i % corpus->nmsentences) * length;
+		if (navi_checksum(sentence, length, NULL, &cs) != navi_Ok)
+			return 0;
+	}
+
+	g_sink += cs;
+
+	return n * length;
+}
+
+//
+// Frames the sentences of the corpus n times
+static size_t bench_framer(void *ctx, size_t n)
+{
+	struct corpus_t *corpus = (struct corpus_t *)ctx;
+	struct navi_framer_t framer;
+	size_t i, offset, nmread;
+
+	navi_framer_init(&framer);
+
+	for (i = 0; i < n; i++)
+	{
+		for (offset = 0; offset < corpus->size; offset += nmread)
+		{
+			if (navi_framer_push(&framer, corpus->data + offset, corpus->size - offset,
+					&nmread) != navi_Ok)
+			{
+				break;
+			}
+			g_sink += framer.length;
+		}
+	}
+
+	return n * corpus->size;
+}
+
+//
+// Builds the corpus of NM_CORPUS copies of the sample with the checksum
+static int make_corpus(const char *sample, struct corpus_t *corpus)
+{
+	char sentence[NAVI_SENTENCE_MAXSIZE + 8], csstr[3];
+	size_t length, i;
+
+	length = sprintf(sentence, "$%s*", sample);
+	if (navi_checksum(sentence, length, csstr, NULL) != navi_Ok)
+		return 1;
+	length += sprintf(sentence + length, "%s\r\n", csstr);
+
+	corpus->size = length * NM_CORPUS;
+	corpus->nmsentences = NM_CORPUS;
+	corpus->data = (char *)malloc(corpus->size + 1);
+	if (corpus->data == NULL)
+		return 1;
+
+	for (i = 0; i < NM_CORPUS; i++)
+		memcpy(corpus->data + i * length, sentence, length);
+	corpus->data[corpus->size] = '\0';
+
+	return 0;
+}
+
+//
+// Appends the file to the corpus
+static int read_file(const char *filename, struct corpus_t *corpus)
+{
+	char chunk[65536], *data;
+	size_t size, offset;
+	FILE *f;
+
+	if ((f = fopen(filename, "rb")) == NULL)
+		return 1;
+
+	while ((size = fread(chunk, 1, sizeof(chunk), f)) > 0)
+	{
+		data = (char *)realloc(corpus->data, corpus->size + size + 1);
+		if (data == NULL)
+		{
+			fclose(f);
+			return 1;
+		}
+
+		corpus->data = data;
+		memcpy(corpus->data + corpus->size, chunk, size);
+
+		for (offset = 0; offset < size; offset++)
+			corpus->nmsentences += chunk[offset] == '\n';
+		corpus->size += size;
+		corpus->data[corpus->size] = '\0';
+	}
+	fclose(f);
+
+	return 0;
+}
+
+//
+// Reads all the tracks into one corpus
+static int read_tracks(const char *tracksdir, struct corpus_t *corpus)
+{
+	char filename[1024];
+	int i;
+
+	corpus->data = NULL;
+	corpus->size = corpus->nmsentences = 0;
+
+	for (i = 0; ; i++)
+	{
+		sprintf(filename, "%s/iec.track.%d", tracksdir, i);
+		if (read_file(filename, corpus) != 0)
+			break;
+	}
+
+	return corpus->size == 0 ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *tracksdir = "tests/tracks", *corpusfile = NULL;
+	struct corpus_t corpus, tracks;
+	struct generate_t gen;
+	navi_addrfield_t type;
+	char name[32];
+	size_t i, nmread;
+	int result = 0;
+
+	for (i = 1; i < (size_t)argc; i++)
+	{
+		if ((strcmp(argv[i], "-t") == 0) && (i + 1 < (size_t)argc))
+			g_mintime = atof(argv[++i]);
+		else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < (size_t)argc))
+			g_repeats = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-f") == 0) && (i + 1 < (size_t)argc))
+			g_filter = argv[++i];
+		else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < (size_t)argc))
+			corpusfile = argv[++i];
+		else
+			tracksdir = argv[i];
+	}
+
+	printf("# libnavigate %s, minimum time %.3f s, best of %d\n",
+		LIBNAVIGATE_VERSION_STRING, g_mintime, g_repeats);
+	printf("group,name,operations,bytes,ns_per_op,mb_per_s\n");
+
+	// one sentence type, the parser and the generator
+	for (i = 0; i < NM_SAMPLES; i++)
+	{
+		if (make_corpus(g_samples[i], &corpus) != 0)
+			return 1;
+
+		memcpy(name, g_samples[i] + 2, 3);
+		name[3] = '\0';
+
+		result |= bench_run("parse", name, bench_parse, &corpus, NM_CORPUS);
+
+		if (navi_parse_msg(corpus.data, corpus.size, sizeof(gen.parsed), &type,
+				&gen.parsed, &nmread) == navi_Ok)
+		{
+			result |= bench_run("generate", name, bench_generate, &gen, 1);
+		}
+
+		if (i + 1 < NM_SAMPLES)
+			free(corpus.data);
+	}
+
+	// the field parsers
+	for (i = 0; i < NM_FIELDS; i++)
+	{
+		strcpy(g_fields[i].buffer, g_fields[i].input);
+		result |= bench_run("field", g_fields[i].name, bench_field, &g_fields[i], 1);
+	}
+
+	// the checksum and the framer, on the last corpus
+	result |= bench_run("frame", "navi_checksum", bench_checksum, &corpus, 1);
+	result |= bench_run("frame", "navi_framer_push", bench_framer, &corpus, corpus.nmsentences);
+	free(corpus.data);
+
+	// the real stream
+	if (read_tracks(tracksdir, &tracks) != 0)
+	{
+		printf("# cannot read the tracks in %s\n", tracksdir);
+		return 1;
+	}
+
+	result |= bench_run("tracks", "navi_parse_msg", bench_parse, &tracks, tracks.nmsentences);
+	result |= bench_run("tracks", "navi_framer_push", bench_framer, &tracks, tracks.nmsentences);
+	free(tracks.data);
+
+	// the synthetic stream
+	if (corpusfile != NULL)
+	{
+		corpus.data = NULL;
+		corpus.size = corpus.nmsentences = 0;
+
+		if ((read_file(corpusfile, &corpus) != 0) || (corpus.size == 0))
+		{
+			printf("# cannot read the corpus %s\n", corpusfile);
+			return 1;
+		}
+
+		result |= bench_run("corpus", "navi_parse_msg", bench_parse, &corpus, corpus.nmsentences);
+		result |= bench_run("corpus", "navi_framer_push", bench_framer, &corpus, corpus.nmsentences);
+		free(corpus.data);
+	}
+
+	return result;
+}
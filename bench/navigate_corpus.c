@@ -0,0 +1,1026 @@
+/*
+ * navigate_corpus.c - generator of synthetic IEC 61162-1 traffic
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Usage: navigate_corpus [-s seed] [-n size] [-v vessels] [-e noise]
+//	[-j jobs] [-R TYPE=rate]... [output]
+//
+//	-s	the seed, the same seed gives the same output, 1 by default
+//	-n	the size of the output, with the suffix k, M or G, 64M by default
+//	-v	the number of the vessels, 4 by default
+//	-e	the probability of the noise per sentence, 0.001 by default
+//	-j	the number of the threads, 4 by default
+//	-R	the rate of the sentence type in Hz, 0 disables the type,
+//		e.g. -R HDT=20 -R TXT=0
+//
+// Every vessel has a GNSS receiver, GPS only (GP), GLONASS only (GL)
+// or combined (GN) with GSV of every constellation, a gyro (HE),
+// a magnetic compass (HC), an echo sounder (SD) and an anemometer (WI).
+// The vessel sails with a random walk of the course and the speed, and
+// all its sensors report the same motion. The sentences of all the
+// vessels are interleaved in the order of the simulated time, as on
+// a shared bus.
+//
+// The noise is the bad checksums, the truncated sentences and the
+// garbage between the sentences, in equal shares. The output is written
+// to the file or to the standard output, and the statistics to the
+// standard error.
+//
+// The traffic is generated by segments of SEGMENT_TIME seconds. Every
+// segment depends on the seed and its number only, with its own vessels,
+// so the segments are generated in parallel and the output is the same
+// for any number of the threads. No segment is started once the size is
+// reached, and the statistics count the sentences written whole only.
+//
+
+#include <navigate.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif // _WIN32
+
+#ifndef M_PI
+#define M_PI	3.14159265358979323846
+#endif // M_PI
+
+// The step of the simulated time, s
+#define TICK				0.05
+
+// The start of the simulated time, 2013-01-01 00:00:00 UTC
+#define START_TIME			1356998400
+
+#define MAX_VESSELS			64
+#define MAX_SATELLITES		12
+#define MAX_CONSTELLATIONS	3
+
+// The simulated time of one segment, s
+#define SEGMENT_TIME		600
+
+#define MAX_JOBS			64
+
+// The room for one emission, e.g. a TXT sequence
+#define EMIT_SENTENCES		64
+#define EMIT_ROOM			(EMIT_SENTENCES * NAVI_SENTENCE_MAXSIZE)
+
+//
+// The sentence types and their default rates
+enum stype_t
+{
+	stype_RMC,
+	stype_GGA,
+	stype_GNS,
+	stype_GLL,
+	stype_VTG,
+	stype_ZDA,
+	stype_GSA,
+	stype_GSV,
+	stype_TXT,
+	stype_HDT,
+	stype_HDG,
+	stype_DBT,
+	stype_DPT,
+	stype_MWV,
+	stype_Count
+};
+
+static struct
+{
+	const char *name;
+	double rate;
+} g_rates[stype_Count] =
+{
+	{ "RMC", 1.0 },
+	{ "GGA", 1.0 },
+	{ "GNS", 1.0 },		// the combined receivers only
+	{ "GLL", 1.0 },
+	{ "VTG", 1.0 },
+	{ "ZDA", 1.0 },
+	{ "GSA", 1.0 },
+	{ "GSV", 0.2 },
+	{ "TXT", 1.0 / 60 },
+	{ "HDT", 10.0 },
+	{ "HDG", 1.0 },
+	{ "DBT", 1.0 },
+	{ "DPT", 1.0 },
+	{ "MWV", 2.0 }
+};
+
+// The deterministic random numbers, xorshift64*
+struct rnd_t
+{
+	unsigned long long state;
+};
+
+struct satellite_t
+{
+	int id, snr;
+	double elevation, azimuth;
+};
+
+struct constellation_t
+{
+	navi_talkerid_t tid;
+	int nmsatellites;
+	struct satellite_t satellites[MAX_SATELLITES];
+};
+
+struct vessel_t
+{
+	navi_talkerid_t gnss;
+	int nmconstellations;
+	struct constellation_t constellations[MAX_CONSTELLATIONS];
+
+	double latitude, longitude;	// degrees
+	double course, speed;		// degrees true, knots
+	double turn;				// degrees per second
+	double depth;				// meters
+	double windangle, windspeed;	// degrees relative, knots
+
+	double next[stype_Count];	// the time of the next sentence of the type
+};
+
+// The noise added to the sentence
+enum noise_t
+{
+	noise_None,
+	noise_BadCrc,
+	noise_Truncated,
+	noise_Garbage
+};
+
+// The sentence in the segment, with its noise
+struct mark_t
+{
+	size_t end;		// the offset behind the sentence and its noise
+	enum noise_t noise;
+};
+
+// The segment of the traffic, with its vessels and sentences
+struct segment_t
+{
+	unsigned long long index;
+	struct rnd_t rnd;
+	struct vessel_t vessels[MAX_VESSELS];
+
+	char *buffer;
+	size_t length, capacity;
+	int errclass;		// the error of the generator, 0 if none
+
+	struct mark_t *marks;
+	size_t nmmarks, markcapacity;
+};
+
+// The statistics of the output
+struct corpusstats_t
+{
+	unsigned long long sentences;
+	unsigned long long badcrc, truncated, garbage;
+};
+
+// The texts of the TXT sequences
+static const char *g_texts[] =
+{
+	"ANTENNA OK",
+	"ANTENNA OPEN",
+	"Pay big attention to the Metro stations",
+	"ROM CORE 1.00 (59842) Jun 27 2012 17:43:52 HW VER 00080000 EXT CORE 1.00 PROTVER 14.00 "
+		"GNSS GPS;GLO;GAL MOD LIST UBX NMEA",
+	"jamming detected, the position may be degraded"
+};
+
+static unsigned long long g_seed = 1;
+static int g_nmvessels = 4;
+static double g_noise = 0.001;
+
+//
+// Returns the next random number
+static unsigned long long rnd_next(struct rnd_t *rnd)
+{
+	rnd->state ^= rnd->state >> 12;
+	rnd->state ^= rnd->state << 25;
+	rnd->state ^= rnd->state >> 27;
+
+	return rnd->state * 2685821657736338717ULL;
+}
+
+//
+// Seeds the random numbers, any seed gives the non-zero state
+static void rnd_seed(struct rnd_t *rnd, unsigned long long seed)
+{
+	// splitmix64
+	seed += 0x9E3779B97F4A7C15ULL;
+	seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+
+	rnd->state = (seed ^ (seed >> 31)) | 1;
+}
+
+//
+// Returns the random number in [0, 1)
+static double rnd_uniform(struct rnd_t *rnd)
+{
+	return (double)(rnd_next(rnd) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//
+// Returns the random number in [a, b)
+static double rnd_range(struct rnd_t *rnd, double a, double b)
+{
+	return a + (b - a) * rnd_uniform(rnd);
+}
+
+//
+// Returns the monotonic time in seconds
+static double bench_now(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter, frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif // _WIN32
+}
+
+//
+// Makes the room for one emission
+static int segment_reserve(struct segment_t *seg)
+{
+	struct mark_t *marks;
+	char *buffer;
+
+	if (seg->length + EMIT_ROOM > seg->capacity)
+	{
+		buffer = (char *)realloc(seg->buffer, seg->capacity * 2 + EMIT_ROOM);
+		if (buffer == NULL)
+			return 1;
+
+		seg->buffer = buffer;
+		seg->capacity = seg->capacity * 2 + EMIT_ROOM;
+	}
+
+	if (seg->nmmarks + EMIT_SENTENCES > seg->markcapacity)
+	{
+		marks = (struct mark_t *)realloc(seg->marks,
+			(seg->markcapacity * 2 + EMIT_SENTENCES) * sizeof(struct mark_t));
+		if (marks == NULL)
+			return 1;
+
+		seg->marks = marks;
+		seg->markcapacity = seg->markcapacity * 2 + EMIT_SENTENCES;
+	}
+
+	return 0;
+}
+
+//
+// Adds up the sentences and the noise in the first length bytes of the
+// segment, the sentence cut by the end is not counted
+static void segment_count(const struct segment_t *seg, size_t length,
+	struct corpusstats_t *stats)
+{
+	size_t i;
+
+	for (i = 0; (i < seg->nmmarks) && (seg->marks[i].end <= length); i++)
+	{
+		stats->sentences++;
+
+		switch (seg->marks[i].noise)
+		{
+		case noise_BadCrc:
+			stats->badcrc++;
+			break;
+		case noise_Truncated:
+			stats->truncated++;
+			break;
+		case noise_Garbage:
+			stats->garbage++;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+//
+// Appends the sentence, with the noise
+static void segment_append(struct segment_t *seg, const char *sentence, size_t length)
+{
+	char *s = seg->buffer + seg->length;
+	struct mark_t *mark = &seg->marks[seg->nmmarks++];
+	size_t i, n;
+	int kind;
+
+	memcpy(s, sentence, length);
+	seg->length += length;
+
+	mark->end = seg->length;
+	mark->noise = noise_None;
+
+	if ((g_noise <= 0.0) || (rnd_uniform(&seg->rnd) >= g_noise))
+		return;
+
+	kind = (int)(rnd_next(&seg->rnd) % 3);
+	if (kind == 0)
+	{
+		// the first digit of the checksum, e.g. *5C -> *1C
+		static const char hex[] = "0123456789ABCDEF";
+
+		if ((length < 5) || (s[length - 5] != '*'))
+			return;
+
+		for (i = 0; hex[i] != s[length - 4]; i++)
+			;
+		s[length - 4] = hex[(i + 1 + rnd_next(&seg->rnd) % 15) % 16];
+		mark->noise = noise_BadCrc;
+	}
+	else if (kind == 1)
+	{
+		// the sentence cut at a random position, without the line end
+		seg->length -= length - 1 - (size_t)(rnd_next(&seg->rnd) % (length - 3));
+		mark->noise = noise_Truncated;
+	}
+	else
+	{
+		// the line noise, up to 32 random bytes
+		n = 1 + (size_t)(rnd_next(&seg->rnd) % 32);
+		for (i = 0; i < n; i++)
+			seg->buffer[seg->length++] = (char)(rnd_next(&seg->rnd) & 0xff);
+		mark->noise = noise_Garbage;
+	}
+
+	mark->end = seg->length;
+}
+
+//
+// Appends the sentences one by one
+static void segment_append_all(struct segment_t *seg, const char *sentences, size_t length)
+{
+	const char *end;
+	size_t n;
+
+	while (length > 0)
+	{
+		end = memchr(sentences, '\n', length);
+		n = end != NULL ? (size_t)(end - sentences) + 1 : length;
+
+		segment_append(seg, sentences, n);
+		sentences += n;
+		length -= n;
+	}
+}
+
+//
+// Generates the sentence and appends it
+static int emit(struct segment_t *seg, navi_approved_fmt_t afmt, navi_talkerid_t tid,
+	const void *msg)
+{
+	char sentence[NAVI_SENTENCE_MAXSIZE + 1];
+	struct approved_field_t address;
+	size_t nmwritten;
+
+	address.afmt = afmt;
+	address.tid = tid;
+
+	if (navi_create_msg(navi_af_Approved, &address, msg, sentence, sizeof(sentence),
+			&nmwritten) != navi_Ok)
+	{
+		return 1;
+	}
+
+	segment_append(seg, sentence, nmwritten);
+	return 0;
+}
+
+//
+// Initializes the satellites in view of the constellation
+static void init_constellation(struct constellation_t *c, navi_talkerid_t tid,
+	struct rnd_t *rnd)
+{
+	int first, count, i, j, id;
+
+	// the satellite IDs of the IEC 61162-1
+	first = tid == navi_GL ? 65 : 1;
+	count = tid == navi_GL ? 24 : (tid == navi_GA ? 30 : 32);
+
+	c->tid = tid;
+	c->nmsatellites = 6 + (int)(rnd_next(rnd) % 7);
+
+	for (i = 0; i < c->nmsatellites; i++)
+	{
+		do
+		{
+			id = first + (int)(rnd_next(rnd) % count);
+			for (j = 0; (j < i) && (c->satellites[j].id != id); j++)
+				;
+		} while (j < i);
+
+		c->satellites[i].id = id;
+		c->satellites[i].elevation = rnd_range(rnd, 5.0, 85.0);
+		c->satellites[i].azimuth = rnd_range(rnd, 0.0, 360.0);
+		c->satellites[i].snr = 0;
+	}
+}
+
+//
+// Initializes the vessel at a random place of the Baltic Sea
+static void init_vessel(struct vessel_t *v, int index, struct rnd_t *rnd)
+{
+	int i;
+
+	switch (index % 3)
+	{
+	case 0:
+		v->gnss = navi_GP;
+		v->nmconstellations = 1;
+		init_constellation(&v->constellations[0], navi_GP, rnd);
+		break;
+	case 1:
+		v->gnss = navi_GL;
+		v->nmconstellations = 1;
+		init_constellation(&v->constellations[0], navi_GL, rnd);
+		break;
+	default:
+		v->gnss = navi_GN;
+		v->nmconstellations = 3;
+		init_constellation(&v->constellations[0], navi_GP, rnd);
+		init_constellation(&v->constellations[1], navi_GL, rnd);
+		init_constellation(&v->constellations[2], navi_GA, rnd);
+		break;
+	}
+
+	v->latitude = rnd_range(rnd, 55.0, 60.0);
+	v->longitude = rnd_range(rnd, 15.0, 28.0);
+	v->course = rnd_range(rnd, 0.0, 360.0);
+	v->speed = rnd_range(rnd, 4.0, 18.0);
+	v->turn = 0.0;
+	v->depth = rnd_range(rnd, 20.0, 120.0);
+	v->windangle = rnd_range(rnd, 0.0, 360.0);
+	v->windspeed = rnd_range(rnd, 2.0, 25.0);
+
+	// the sensors are not synchronized
+	for (i = 0; i < stype_Count; i++)
+		v->next[i] = g_rates[i].rate > 0.0 ? rnd_range(rnd, 0.0, 1.0 / g_rates[i].rate) : -1.0;
+}
+
+//
+// Moves the vessel and the satellites by dt seconds
+static void move_vessel(struct vessel_t *v, double dt, struct rnd_t *rnd)
+{
+	struct satellite_t *s;
+	int i, j;
+
+	v->turn += rnd_range(rnd, -0.2, 0.2) * dt;
+	if (fabs(v->turn) > 3.0)
+		v->turn *= 0.5;
+	v->course = fmod(v->course + v->turn * dt + 360.0, 360.0);
+
+	v->speed += rnd_range(rnd, -0.1, 0.1) * dt;
+	v->speed = v->speed < 0.5 ? 0.5 : (v->speed > 30.0 ? 30.0 : v->speed);
+
+	// one nautical mile is one minute of the latitude
+	v->latitude += v->speed * cos(v->course * M_PI / 180.0) * dt / 3600.0 / 60.0;
+	v->longitude += v->speed * sin(v->course * M_PI / 180.0) * dt / 3600.0 / 60.0 /
+		cos(v->latitude * M_PI / 180.0);
+
+	v->depth += rnd_range(rnd, -0.5, 0.5) * dt;
+	v->depth = v->depth < 3.0 ? 3.0 : v->depth;
+	v->windangle = fmod(v->windangle + rnd_range(rnd, -2.0, 2.0) * dt + 360.0, 360.0);
+	v->windspeed = fabs(v->windspeed + rnd_range(rnd, -0.2, 0.2) * dt);
+
+	for (i = 0; i < v->nmconstellations; i++)
+	{
+		for (j = 0; j < v->constellations[i].nmsatellites; j++)
+		{
+			s = &v->constellations[i].satellites[j];
+			s->azimuth = fmod(s->azimuth + 0.008 * dt, 360.0);
+		}
+	}
+}
+
+//
+// Fills the UTC and the date of the fix, at the whole second of the
+// simulated time
+static void simulated_time(double t, struct navi_utc_t *utc, struct navi_date_t *date)
+{
+	time_t seconds = (time_t)START_TIME + (time_t)t;
+	struct tm tm;
+
+#ifdef _WIN32
+	gmtime_s(&tm, &seconds);
+#else
+	gmtime_r(&seconds, &tm);
+#endif // _WIN32
+
+	navi_init_utc_from_hhmmss(tm.tm_hour, tm.tm_min, tm.tm_sec, utc);
+	navi_init_date(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, date);
+}
+
+//
+// Generates the sentence of the type for the vessel
+static int emit_sentence(struct segment_t *seg, struct vessel_t *v, enum stype_t type, double t)
+{
+	char sequence[EMIT_ROOM];
+	struct navi_satinfo_t info[MAX_SATELLITES];
+	struct constellation_t *c;
+	struct navi_utc_t utc;
+	struct navi_date_t date;
+	size_t nmwritten;
+	int i, j, n;
+
+	union
+	{
+		struct rmc_t rmc;
+		struct gga_t gga;
+		struct gns_t gns;
+		struct gll_t gll;
+		struct vtg_t vtg;
+		struct zda_t zda;
+		struct gsa_t gsa;
+		struct hdt_t hdt;
+		struct hdg_t hdg;
+		struct dbt_t dbt;
+		struct dpt_t dpt;
+		struct mwv_t mwv;
+	} msg;
+
+	simulated_time(t, &utc, &date);
+
+	switch (type)
+	{
+	case stype_RMC:
+		navi_init_rmc(&msg.rmc);
+		msg.rmc.vfields = RMC_VALID_DATE;
+		msg.rmc.utc = utc;
+		msg.rmc.status = navi_status_A;
+		navi_init_position_from_degrees(v->latitude, v->longitude, &msg.rmc.fix);
+		msg.rmc.speedN = v->speed;
+		msg.rmc.courseT = v->course;
+		msg.rmc.date = date;
+		navi_init_offset_from_degrees(8.5, navi_East, &msg.rmc.magnVariation);
+		msg.rmc.mi = navi_Autonomous;
+		return emit(seg, navi_RMC, v->gnss, &msg);
+
+	case stype_GGA:
+		navi_init_gga(&msg.gga);
+		msg.gga.utc = utc;
+		navi_init_position_from_degrees(v->latitude, v->longitude, &msg.gga.fix);
+		msg.gga.gpsindicator = navi_gps_SpsMode;
+		msg.gga.nmsatellites = v->constellations[0].nmsatellites;
+		msg.gga.hdop = 0.9;
+		msg.gga.antaltitude = 12.3;
+		msg.gga.geoidalsep = 17.2;
+		return emit(seg, navi_GGA, v->gnss, &msg);
+
+	case stype_GNS:
+		if (v->gnss != navi_GN)
+			return 0;
+		navi_init_gns(&msg.gns);
+		msg.gns.utc = utc;
+		navi_init_position_from_degrees(v->latitude, v->longitude, &msg.gns.fix);
+		msg.gns.mi[0] = msg.gns.mi[1] = navi_Autonomous;
+		for (i = 0, n = 0; i < v->nmconstellations; i++)
+			n += v->constellations[i].nmsatellites;
+		msg.gns.nmsatellites = n;
+		msg.gns.hdop = 0.7;
+		msg.gns.antaltitude = 12.3;
+		msg.gns.geoidalsep = 17.2;
+		return emit(seg, navi_GNS, v->gnss, &msg);
+
+	case stype_GLL:
+		navi_init_gll(&msg.gll);
+		navi_init_position_from_degrees(v->latitude, v->longitude, &msg.gll.fix);
+		msg.gll.utc = utc;
+		msg.gll.status = navi_status_A;
+		msg.gll.mi = navi_Autonomous;
+		return emit(seg, navi_GLL, v->gnss, &msg);
+
+	case stype_VTG:
+		navi_init_vtg(&msg.vtg);
+		msg.vtg.courseT = v->course;
+		msg.vtg.courseM = fmod(v->course + 351.5, 360.0);
+		msg.vtg.speedN = v->speed;
+		msg.vtg.speedK = v->speed * 1.852;
+		msg.vtg.mi = navi_Autonomous;
+		return emit(seg, navi_VTG, v->gnss, &msg);
+
+	case stype_ZDA:
+		navi_init_zda(&msg.zda);
+		msg.zda.vfields = ZDA_VALID_DATE | ZDA_VALID_LOCALZONE;
+		msg.zda.utc = utc;
+		msg.zda.date = date;
+		msg.zda.lzoffset = 0;
+		return emit(seg, navi_ZDA, v->gnss, &msg);
+
+	case stype_GSA:
+		// one sentence per constellation of the combined receiver
+		for (i = 0; i < v->nmconstellations; i++)
+		{
+			c = &v->constellations[i];
+
+			navi_init_gsa(&msg.gsa);
+			msg.gsa.swmode = navi_gsa_Automatic;
+			msg.gsa.fixmode = 3;
+			for (j = 0; j < c->nmsatellites; j++)
+				msg.gsa.satellites[j] = c->satellites[j].id;
+			msg.gsa.pdop = 1.6;
+			msg.gsa.hdop = 0.9;
+			msg.gsa.vdop = 1.3;
+
+			if (emit(seg, navi_GSA, v->gnss, &msg) != 0)
+				return 1;
+		}
+		return 0;
+
+	case stype_GSV:
+		for (i = 0; i < v->nmconstellations; i++)
+		{
+			c = &v->constellations[i];
+
+			for (j = 0; j < c->nmsatellites; j++)
+			{
+				info[j].id = c->satellites[j].id;
+				info[j].elevation = (int)c->satellites[j].elevation;
+				info[j].azimuth = (int)c->satellites[j].azimuth;
+
+				// some of the satellites are not tracked
+				c->satellites[j].snr = rnd_uniform(&seg->rnd) < 0.15 ? -1 :
+					(int)(20 + c->satellites[j].elevation / 3 + rnd_range(&seg->rnd, 0.0, 8.0));
+				info[j].snr = c->satellites[j].snr;
+				info[j].vfields = SATINFO_VALID_ORIENTATION |
+					(info[j].snr >= 0 ? SATINFO_VALID_SNR : 0);
+			}
+
+			if (navi_create_gsv_sequence(c->tid, c->nmsatellites, info, sequence,
+					sizeof(sequence), &nmwritten) != navi_Ok)
+			{
+				return 1;
+			}
+			segment_append_all(seg, sequence, nmwritten);
+		}
+		return 0;
+
+	case stype_TXT:
+		if (navi_create_txt_sequence(v->gnss, 1 + (int)(rnd_next(&seg->rnd) % 3),
+				g_texts[rnd_next(&seg->rnd) % (sizeof(g_texts) / sizeof(g_texts[0]))],
+				sequence, sizeof(sequence), &nmwritten) != navi_Ok)
+		{
+			return 1;
+		}
+		segment_append_all(seg, sequence, nmwritten);
+		return 0;
+
+	case stype_HDT:
+		navi_init_hdt(&msg.hdt);
+		msg.hdt.heading = fmod(v->course + rnd_range(&seg->rnd, -1.0, 1.0) + 360.0, 360.0);
+		return emit(seg, navi_HDT, navi_HE, &msg);
+
+	case stype_HDG:
+		navi_init_hdg(&msg.hdg);
+		msg.hdg.heading = fmod(v->course + 351.5 - 1.2 + 360.0, 360.0);
+		navi_init_offset_from_degrees(1.2, navi_East, &msg.hdg.deviation);
+		navi_init_offset_from_degrees(8.5, navi_East, &msg.hdg.variation);
+		return emit(seg, navi_HDG, navi_HC, &msg);
+
+	case stype_DBT:
+		navi_init_dbt(&msg.dbt);
+		msg.dbt.depth_feet = v->depth * 3.28084;
+		msg.dbt.depth_meters = v->depth;
+		msg.dbt.depth_fathoms = v->depth * 0.546807;
+		return emit(seg, navi_DBT, navi_SD, &msg);
+
+	case stype_DPT:
+		navi_init_dpt(&msg.dpt);
+		msg.dpt.depth = v->depth;
+		msg.dpt.offset = -1.5;
+		msg.dpt.range = 200.0;
+		return emit(seg, navi_DPT, navi_SD, &msg);
+
+	case stype_MWV:
+		navi_init_mwv(&msg.mwv);
+		msg.mwv.angle = v->windangle;
+		msg.mwv.reference = 'R';
+		msg.mwv.speed = v->windspeed;
+		msg.mwv.units = 'N';
+		msg.mwv.status = navi_status_A;
+		return emit(seg, navi_MWV, navi_WI, &msg);
+
+	default:
+		return 0;
+	}
+}
+
+//
+// Parses the size with the suffix k, M or G
+static unsigned long long parse_size(const char *s)
+{
+	char *end;
+	double size = strtod(s, &end);
+
+	switch (*end)
+	{
+	case 'k': case 'K':
+		size *= 1024.0;
+		break;
+	case 'm': case 'M':
+		size *= 1024.0 * 1024.0;
+		break;
+	case 'g': case 'G':
+		size *= 1024.0 * 1024.0 * 1024.0;
+		break;
+	}
+
+	return (unsigned long long)size;
+}
+
+//
+// Sets the rate of the sentence type, TYPE=rate
+static int parse_rate(const char *s)
+{
+	int i;
+
+	for (i = 0; i < stype_Count; i++)
+	{
+		if ((strncmp(s, g_rates[i].name, 3) == 0) && (s[3] == '='))
+		{
+			g_rates[i].rate = atof(s + 4);
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+//
+// Generates the segment
+static void generate_segment(struct segment_t *seg)
+{
+	double t, end;
+	int i, j;
+
+	// the segment depends on the seed and its number only
+	rnd_seed(&seg->rnd, g_seed * 0x9E3779B97F4A7C15ULL + seg->index);
+
+	seg->length = 0;
+	seg->nmmarks = 0;
+	seg->errclass = 0;
+
+	t = (double)seg->index * SEGMENT_TIME;
+	end = t + SEGMENT_TIME;
+
+	for (i = 0; i < g_nmvessels; i++)
+	{
+		init_vessel(&seg->vessels[i], i, &seg->rnd);
+		for (j = 0; j < stype_Count; j++)
+			seg->vessels[i].next[j] += seg->vessels[i].next[j] >= 0.0 ? t : 0.0;
+	}
+
+	for ( ; t < end; t += TICK)
+	{
+		for (i = 0; i < g_nmvessels; i++)
+		{
+			move_vessel(&seg->vessels[i], TICK, &seg->rnd);
+
+			for (j = 0; j < stype_Count; j++)
+			{
+				// the rates may be higher than the ticks
+				while ((seg->vessels[i].next[j] >= 0.0) && (seg->vessels[i].next[j] <= t))
+				{
+					seg->vessels[i].next[j] += 1.0 / g_rates[j].rate;
+
+					if (segment_reserve(seg) != 0)
+					{
+						seg->errclass = navi_SystemError;
+						return;
+					}
+					if (emit_sentence(seg, &seg->vessels[i], (enum stype_t)j, t) != 0)
+					{
+						seg->errclass = navierr_get_last()->errclass;
+						return;
+					}
+				}
+			}
+		}
+	}
+}
+
+#ifdef _WIN32
+static DWORD WINAPI segment_thread(LPVOID arg)
+#else
+static void *segment_thread(void *arg)
+#endif // _WIN32
+{
+	generate_segment((struct segment_t *)arg);
+	return 0;
+}
+
+#ifdef _WIN32
+typedef HANDLE thread_t;
+#else
+typedef pthread_t thread_t;
+#endif // _WIN32
+
+//
+// Starts generating the segment in the thread
+static int start_segment(thread_t *thread, struct segment_t *seg, unsigned long long index)
+{
+	seg->index = index;
+
+#ifdef _WIN32
+	*thread = CreateThread(NULL, 0, segment_thread, seg, 0, NULL);
+	return *thread != NULL ? 0 : 1;
+#else
+	return pthread_create(thread, NULL, segment_thread, seg) == 0 ? 0 : 1;
+#endif // _WIN32
+}
+
+//
+// Waits for the segment generated in the thread
+static void join_segment(thread_t thread)
+{
+#ifdef _WIN32
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+#else
+	pthread_join(thread, NULL);
+#endif // _WIN32
+}
+
+int main(int argc, char *argv[])
+{
+	static struct segment_t segments[MAX_JOBS];
+	thread_t threads[MAX_JOBS];
+	int running[MAX_JOBS];
+	unsigned long long size = 64ULL << 20, written = 0, index, nmstarted;
+	struct corpusstats_t stats;
+	struct segment_t *seg;
+	const char *filename = NULL;
+	size_t length;
+	int nmjobs = 4, i, result = 0;
+	double start, elapsed;
+	FILE *file;
+
+	for (i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc))
+			g_seed = strtoull(argv[++i], NULL, 10);
+		else if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+			size = parse_size(argv[++i]);
+		else if ((strcmp(argv[i], "-v") == 0) && (i + 1 < argc))
+			g_nmvessels = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-e") == 0) && (i + 1 < argc))
+			g_noise = atof(argv[++i]);
+		else if ((strcmp(argv[i], "-j") == 0) && (i + 1 < argc))
+			nmjobs = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-R") == 0) && (i + 1 < argc))
+		{
+			if (parse_rate(argv[++i]) != 0)
+			{
+				fprintf(stderr, "Unknown sentence type: %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (argv[i][0] != '-')
+			filename = argv[i];
+		else
+		{
+			fprintf(stderr, "Usage: %s [-s seed] [-n size] [-v vessels] [-e noise] "
+				"[-j jobs] [-R TYPE=rate]... [output]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if ((g_nmvessels < 1) || (g_nmvessels > MAX_VESSELS) || (nmjobs < 1) || (nmjobs > MAX_JOBS))
+	{
+		fprintf(stderr, "The vessels must be 1 to %d, the jobs 1 to %d\n", MAX_VESSELS, MAX_JOBS);
+		return 1;
+	}
+
+	file = filename != NULL ? fopen(filename, "wb") : stdout;
+	if (file == NULL)
+	{
+		fprintf(stderr, "Cannot open %s\n", filename);
+		return 1;
+	}
+
+	// as the receivers print, e.g. 5930.1234 minutes, 12.3 knots
+	naviconf_set_presicion(4);
+
+	memset(&stats, 0, sizeof(stats));
+	memset(running, 0, sizeof(running));
+	start = bench_now();
+
+	// the segments are written in their order, every job starts the next
+	// segment after its one is written, until the size is reached
+	for (nmstarted = 0; nmstarted < (unsigned long long)nmjobs; nmstarted++)
+	{
+		i = (int)nmstarted;
+		if (start_segment(&threads[i], &segments[i], nmstarted) != 0)
+		{
+			fprintf(stderr, "Cannot start the thread\n");
+			result = 1;
+			break;
+		}
+		running[i] = 1;
+	}
+
+	for (index = 0; (written < size) && (result == 0); index++)
+	{
+		i = (int)(index % nmjobs);
+		seg = &segments[i];
+
+		join_segment(threads[i]);
+		running[i] = 0;
+
+		if (seg->errclass != 0)
+		{
+			fprintf(stderr, "Cannot generate the segment %llu: %d\n", seg->index, seg->errclass);
+			result = 1;
+			break;
+		}
+
+		// the last segment is cut to the size
+		length = seg->length;
+		if (written + length > size)
+			length = (size_t)(size - written);
+
+		if ((length > 0) && (fwrite(seg->buffer, 1, length, file) != length))
+		{
+			fprintf(stderr, "Cannot write the output\n");
+			result = 1;
+			break;
+		}
+
+		written += length;
+		segment_count(seg, length, &stats);
+
+		if (written < size)
+		{
+			if (start_segment(&threads[i], seg, nmstarted++) != 0)
+			{
+				fprintf(stderr, "Cannot start the thread\n");
+				result = 1;
+				break;
+			}
+			running[i] = 1;
+		}
+	}
+
+	// the segments started behind the size are not written
+	for (i = 0; i < nmjobs; i++)
+	{
+		if (running[i])
+			join_segment(threads[i]);
+	}
+
+	elapsed = bench_now() - start;
+
+	if (result == 0)
+	{
+		fprintf(stderr, "%llu bytes, %llu sentences, %llu s of traffic, "
+			"%llu bad checksums, %llu truncated, %llu garbage, %.1f MB/s\n",
+			written, stats.sentences, index * SEGMENT_TIME, stats.badcrc, stats.truncated,
+			stats.garbage, elapsed > 0.0 ? (double)written / elapsed / 1e6 : 0.0);
+	}
+
+	if (filename != NULL)
+		fclose(file);
+	for (i = 0; i < nmjobs; i++)
+	{
+		free(segments[i].buffer);
+		free(segments[i].marks);
+	}
+
+	return result;
+}
@@ -0,0 +1,450 @@
+/*
+ * navigate_regress.c - regression of the round trip and the throughput
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Usage: navigate_regress [-b baseline] [-T tolerance] [-u] [-t seconds]
+//	[-r repeats] file...
+//
+//	-b	the baseline file, navigate_regress.baseline by default
+//	-T	the allowed drop of the throughput, 0.2 (20%) by default
+//	-u	records the measured throughput into the baseline
+//	-t	the minimum time of one measurement, 0.5 s by default
+//	-r	the number of measurements, the best one is taken, 3 by default
+//
+// Every file, e.g. a track of tests/tracks or a corpus of navigate_corpus,
+// is replayed through parse -> generate -> parse -> generate. The sentences
+// generated from the original and from the generated ones must be
+// bit-identical. Then the throughput of the replay is measured, in MB/s of
+// the input, and compared with the baseline.
+//
+// The baseline is a text file of lines 'name mb_per_s', the name being
+// the base name of the file. The files missing from the baseline are
+// added to it. The baseline is kept per machine, so it is made in the build
+// directory on the first run.
+//
+// Returns 0 if all the files pass, 1 otherwise.
+//
+
+#include <navigate.h>
+#include "../src/version.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif // _WIN32
+
+// The maximum number of the files in the baseline
+#define NM_BASELINE		256
+
+// The storage of a parsed sentence
+union parsed_t
+{
+	struct approved_field_t address;
+	double align;
+	char bytes[1024];
+};
+
+// The file replayed
+struct replay_t
+{
+	char *data;
+	size_t size;
+
+	// counted by the round trip
+	size_t nmsentences, nmskipped;
+};
+
+// The baseline entry
+struct baseline_t
+{
+	char name[128];
+	double mbps;
+};
+
+static double g_mintime = 0.5;
+static int g_repeats = 3;
+
+static struct baseline_t g_baseline[NM_BASELINE];
+static int g_nmbaseline = 0;
+
+static volatile size_t g_sink;
+
+//
+// Returns the monotonic time in seconds
+static double regress_now(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter, frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif // _WIN32
+}
+
+//
+// Returns the body of the parsed sentence as navi_create_msg() takes it
+static const void *regress_body(navi_addrfield_t type, const union parsed_t *parsed)
+{
+	switch (type)
+	{
+	case navi_af_Approved:
+		return &parsed->address + 1;
+	case navi_af_Query:
+		return (const struct query_field_t *)parsed + 1;
+	default:
+		return parsed;
+	}
+}
+
+//
+// Parses the sentence and generates it back
+static navierr_status_t regress_cycle(char *buffer, size_t size, union parsed_t *parsed,
+	navi_addrfield_t *type, char *output, size_t *nmread, size_t *nmwritten)
+{
+	if (navi_parse_msg(buffer, size, sizeof(*parsed), type, parsed, nmread) != navi_Ok)
+		return navi_Error;
+
+	return navi_create_msg(*type, parsed, regress_body(*type, parsed), output,
+		NAVI_SENTENCE_MAXSIZE + 1, nmwritten);
+}
+
+//
+// Checks that the sentences generated twice are bit-identical
+static int regress_roundtrip(const char *name, struct replay_t *replay)
+{
+	char first[NAVI_SENTENCE_MAXSIZE + 1], second[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t offset, nmread, n, length, secondlength;
+	navi_addrfield_t type, secondtype;
+	union parsed_t parsed;
+	int result = 0;
+
+	replay->nmsentences = replay->nmskipped = 0;
+
+	for (offset = 0; offset < replay->size; offset += nmread)
+	{
+		nmread = 0;
+		if (regress_cycle(replay->data + offset, replay->size - offset, &parsed, &type,
+				first, &nmread, &length) != navi_Ok)
+		{
+			if ((navierr_get_last()->errclass == navi_NoValidMessage) || (nmread == 0))
+				break;
+
+			// unsupported or broken in the original
+			replay->nmskipped++;
+			continue;
+		}
+
+		replay->nmsentences++;
+
+		// the generated sentence must be parsed to the same one
+		if ((regress_cycle(first, length, &parsed, &secondtype, second, &n,
+				&secondlength) != navi_Ok) || (secondtype != type) ||
+			(secondlength != length) || (memcmp(first, second, length) != 0))
+		{
+			first[length] = '\0';
+			printf("# %s: the round trip of %.*s failed (%d)\n", name, (int)(length - 2),
+				first, navierr_get_last()->errclass);
+			result = 1;
+		}
+	}
+
+	return result;
+}
+
+//
+// Replays the file n times
+static size_t regress_replay(struct replay_t *replay, size_t n)
+{
+	char output[NAVI_SENTENCE_MAXSIZE + 1], again[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t i, offset, nmread, nmwritten, length;
+	navi_addrfield_t type;
+	union parsed_t parsed;
+
+	for (i = 0; i < n; i++)
+	{
+		for (offset = 0; offset < replay->size; offset += nmread)
+		{
+			nmread = 0;
+			if (regress_cycle(replay->data + offset, replay->size - offset, &parsed, &type,
+					output, &nmread, &nmwritten) != navi_Ok)
+			{
+				if ((navierr_get_last()->errclass == navi_NoValidMessage) || (nmread == 0))
+					break;
+				continue;
+			}
+
+			(void)regress_cycle(output, nmwritten, &parsed, &type, again, &length, &nmwritten);
+		}
+	}
+
+	g_sink += (size_t)type;
+
+	return n * replay->size;
+}
+
+//
+// Measures the throughput of the replay in MB/s, the best of g_repeats
+static double regress_measure(struct replay_t *replay)
+{
+	size_t n = 1, bytes = 0;
+	double start, elapsed, best;
+	int i;
+
+	// find the number of replays taking the minimum time
+	for ( ; ; )
+	{
+		start = regress_now();
+		bytes = regress_replay(replay, n);
+		elapsed = regress_now() - start;
+
+		if (elapsed >= g_mintime)
+			break;
+
+		n = elapsed > g_mintime / 100. ? (size_t)(n * 1.2 * g_mintime / elapsed) + 1 : n * 10;
+	}
+
+	best = elapsed;
+	for (i = 1; i < g_repeats; i++)
+	{
+		start = regress_now();
+		regress_replay(replay, n);
+		elapsed = regress_now() - start;
+
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	return (double)bytes / best / 1e6;
+}
+
+//
+// Reads the whole file
+static int read_file(const char *filename, struct replay_t *replay)
+{
+	char chunk[65536], *data;
+	size_t size;
+	FILE *f;
+
+	replay->data = NULL;
+	replay->size = 0;
+
+	if ((f = fopen(filename, "rb")) == NULL)
+		return 1;
+
+	while ((size = fread(chunk, 1, sizeof(chunk), f)) > 0)
+	{
+		data = (char *)realloc(replay->data, replay->size + size + 1);
+		if (data == NULL)
+		{
+			fclose(f);
+			return 1;
+		}
+
+		replay->data = data;
+		memcpy(replay->data + replay->size, chunk, size);
+		replay->size += size;
+		replay->data[replay->size] = '\0';
+	}
+	fclose(f);
+
+	return replay->size == 0 ? 1 : 0;
+}
+
+//
+// Reads the baseline, if there is one
+static void read_baseline(const char *filename)
+{
+	char line[256];
+	FILE *f;
+
+	if ((f = fopen(filename, "r")) == NULL)
+		return;
+
+	while ((g_nmbaseline < NM_BASELINE) && (fgets(line, sizeof(line), f) != NULL))
+	{
+		if ((line[0] == '#') ||
+			(sscanf(line, "%127s %lf", g_baseline[g_nmbaseline].name,
+				&g_baseline[g_nmbaseline].mbps) != 2))
+		{
+			continue;
+		}
+		g_nmbaseline++;
+	}
+	fclose(f);
+}
+
+//
+// Writes the baseline
+static int write_baseline(const char *filename)
+{
+	FILE *f;
+	int i;
+
+	if ((f = fopen(filename, "w")) == NULL)
+		return 1;
+
+	fprintf(f, "# libnavigate %s, the throughput of the replay in MB/s\n",
+		LIBNAVIGATE_VERSION_STRING);
+	for (i = 0; i < g_nmbaseline; i++)
+		fprintf(f, "%s %.2f\n", g_baseline[i].name, g_baseline[i].mbps);
+
+	return fclose(f) == 0 ? 0 : 1;
+}
+
+//
+// Returns the baseline entry of the file, a new one if there is none
+static struct baseline_t *find_baseline(const char *name)
+{
+	int i;
+
+	for (i = 0; i < g_nmbaseline; i++)
+	{
+		if (strcmp(g_baseline[i].name, name) == 0)
+			return &g_baseline[i];
+	}
+
+	if (g_nmbaseline >= NM_BASELINE)
+		return NULL;
+
+	strncpy(g_baseline[g_nmbaseline].name, name, sizeof(g_baseline[0].name) - 1);
+	g_baseline[g_nmbaseline].mbps = 0.0;
+
+	return &g_baseline[g_nmbaseline++];
+}
+
+//
+// Returns the base name of the path
+static const char *base_name(const char *path)
+{
+	const char *name = path, *p;
+
+	for (p = path; *p != '\0'; p++)
+	{
+		if ((*p == '/') || (*p == '\\'))
+			name = p + 1;
+	}
+
+	return name;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *baselinefile = "navigate_regress.baseline", *name;
+	double tolerance = 0.2, mbps;
+	struct baseline_t *baseline;
+	struct replay_t replay;
+	int i, update = 0, changed = 0, nmfiles = 0, result = 0;
+
+	for (i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc))
+			baselinefile = argv[++i];
+		else if ((strcmp(argv[i], "-T") == 0) && (i + 1 < argc))
+			tolerance = atof(argv[++i]);
+		else if (strcmp(argv[i], "-u") == 0)
+			update = 1;
+		else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+			g_mintime = atof(argv[++i]);
+		else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc))
+			g_repeats = atoi(argv[++i]);
+		else
+			argv[++nmfiles] = argv[i];
+	}
+
+	if (nmfiles == 0)
+	{
+		printf("Usage: %s [-b baseline] [-T tolerance] [-u] [-t seconds] [-r repeats] file...\n",
+			argv[0]);
+		return 1;
+	}
+
+	read_baseline(baselinefile);
+
+	printf("# libnavigate %s, baseline %s, tolerance %.0f%%\n",
+		LIBNAVIGATE_VERSION_STRING, baselinefile, tolerance * 100.);
+	printf("name,sentences,skipped,roundtrip,mb_per_s,baseline,status\n");
+
+	for (i = 1; i <= nmfiles; i++)
+	{
+		name = base_name(argv[i]);
+
+		if (read_file(argv[i], &replay) != 0)
+		{
+			printf("# cannot read %s\n", argv[i]);
+			result = 1;
+			continue;
+		}
+
+		if (regress_roundtrip(name, &replay) != 0)
+		{
+			printf("%s,%lu,%lu,FAILED,,,FAILED\n", name, (unsigned long)replay.nmsentences,
+				(unsigned long)replay.nmskipped);
+			free(replay.data);
+			result = 1;
+			continue;
+		}
+
+		mbps = regress_measure(&replay);
+		free(replay.data);
+
+		baseline = find_baseline(name);
+		if (baseline == NULL)
+		{
+			printf("# too many files in the baseline\n");
+			return 1;
+		}
+
+		printf("%s,%lu,%lu,ok,%.2f,%.2f,%s\n", name, (unsigned long)replay.nmsentences,
+			(unsigned long)replay.nmskipped, mbps, baseline->mbps,
+			update || (baseline->mbps == 0.0) ? "recorded" :
+			mbps < baseline->mbps * (1. - tolerance) ? "SLOWER" : "ok");
+		fflush(stdout);
+
+		if (update || (baseline->mbps == 0.0))
+		{
+			baseline->mbps = mbps;
+			changed = 1;
+		}
+		else if (mbps < baseline->mbps * (1. - tolerance))
+		{
+			result = 1;
+		}
+	}
+
+	if (changed && (write_baseline(baselinefile) != 0))
+	{
+		printf("# cannot write the baseline %s\n", baselinefile);
+		result = 1;
+	}
+
+	return result;
+}
@@ -0,0 +1,567 @@
+/*
+ * navigate_scenarios.cpp - throughput and latency of the parse modes on
+ * the sentence mixes of the typical deployments
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Usage: navigate_scenarios [-n size] [-t seconds] [-c chunk] [-j threads]
+//	[-s scenario] [-m mode]
+//
+//	-n	the size of the stream of every scenario, 1M by default
+//	-t	the minimum time of one measurement, 0.5 s by default
+//	-c	the size of the chunks read by the streaming modes, 64 by default,
+//		as from a serial port
+//	-j	the number of the threads of the mode parallel, 0 for the number
+//		of processors
+//	-s	runs only the scenario, e.g. survey
+//	-m	runs only the mode, e.g. lazy
+//
+// The scenarios are the streams of the epochs of one second:
+//
+//	rmc		RMC only, a plotter or a logger
+//	survey	GGA, GSA, three GSV and GST, a survey receiver
+//	ais		six AIVDM of the AIS transponder, which the parser skips,
+//			between RMC, GGA, VTG and ZDA of the own ship
+//	text	a sequence of TXT and RMC, a receiver reporting its state
+//
+// The modes are the ways the library offers to parse a stream:
+//
+//	loop		navi_parse_msg() on the buffer, sentence by sentence
+//	framer		navi_framer_push() on the chunks, then navi_parse_msg()
+//	batch		navi_parse_batch() on the buffer
+//	parallel	navi_parse_parallel() on the buffer
+//	arena		navi_arena_parse() on the buffer
+//	codec		DecodeAny() of the C++ bindings on the buffer
+//	lazy		Parser_t of the C++ bindings on the chunks, with the handlers
+//				of the types the application of the scenario uses, so that
+//				the other sentences are skipped unparsed: RMC for rmc and
+//				text, GGA and GST for survey, RMC and GGA for ais
+//
+// The throughput is measured in the bytes of the stream per second. Then
+// the stream is parsed again with time stamps: the data is stamped when it
+// is fed to the library, chunk by chunk by the streaming modes, and all at
+// once by the modes on the buffer. The latency of a sentence is from the
+// feed of the chunk holding its last byte to its delivery to the
+// application. So the modes on the buffer show how long a sentence waits
+// for the ones before it, and the streaming modes show the cost of the
+// sentence in its chunk. The results are printed as CSV, one scenario and
+// mode a line:
+//
+//	scenario,mode,sentences,delivered,mb_per_s,p50_ns,p99_ns
+//
+
+#include <navigate.h>
+#include <libnavigate/c++/parser.hpp>
+#include "../src/version.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif // _WIN32
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace libnavigate;
+
+// The storage of a parsed sentence
+union parsed_t
+{
+	struct approved_field_t address;
+	double align;
+	char bytes[1024];
+};
+
+struct scenario_t
+{
+	const char *name;
+	void (*epoch)(std::string &stream, int t);
+	void (*subscribe)(Parser_t &parser);
+
+	std::string stream;
+	size_t nmsentences;
+};
+
+struct parsemode_t
+{
+	const char *name;
+	void (*run)(scenario_t &scenario);
+};
+
+static size_t g_size = 1 << 20;
+static double g_mintime = 0.5;
+static size_t g_chunk = 64;
+static int g_threads = 0;
+
+// The sentences delivered in the pass, and their latencies if g_timed,
+// from the time stamp of the last data fed
+static size_t g_delivered;
+static bool g_timed;
+static double g_fed;
+static std::vector<float> g_latency;
+
+//
+// Returns the monotonic time in seconds
+static double bench_now(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter, frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif // _WIN32
+}
+
+//
+// Stamps the data fed to the library
+static inline void feed(void)
+{
+	if (g_timed)
+		g_fed = bench_now();
+}
+
+//
+// Counts the sentence delivered to the application. The sentences are
+// delivered before the next data is fed, so the last byte of the sentence
+// is in the data stamped last.
+static inline void deliver(void)
+{
+	g_delivered++;
+
+	if (g_timed)
+		g_latency.push_back((float)((bench_now() - g_fed) * 1e9));
+}
+
+//
+// Appends the sentence with the checksum and <cr><lf>, the format starts
+// with the address field
+static void append(std::string &stream, char start, const char *format, ...)
+{
+	char sentence[NAVI_SENTENCE_MAXSIZE + 8];
+	unsigned int cs = 0;
+	va_list args;
+	int length, i;
+
+	va_start(args, format);
+	length = vsnprintf(sentence, sizeof(sentence) - 6, format, args);
+	va_end(args);
+
+	for (i = 0; i < length; i++)
+		cs ^= (unsigned char)sentence[i];
+
+	stream += start;
+	stream.append(sentence, length);
+	snprintf(sentence, sizeof(sentence), "*%02X\r\n", cs);
+	stream += sentence;
+}
+
+//
+// Formats the time of the epoch as hhmmss
+static const char *utc(int t)
+{
+	static char buffer[16];
+
+	snprintf(buffer, sizeof(buffer), "%02d%02d%02d", t / 3600 % 24, t / 60 % 60, t % 60);
+	return buffer;
+}
+
+static void epoch_rmc(std::string &stream, int t)
+{
+	append(stream, '$', "GPRMC,%s,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W,A", utc(t));
+}
+
+static void epoch_survey(std::string &stream, int t)
+{
+	int i;
+
+	append(stream, '$', "GPGGA,%s,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,", utc(t));
+	append(stream, '$', "GPGSA,A,3,01,12,03,02,18,,,24,14,,,,2.12003,2.12,0.012");
+	for (i = 1; i <= 3; i++)
+		append(stream, '$', "GPGSV,3,%d,09,04,12,000,,05,18,012,45,14,,,,18,12,300,70", i);
+	append(stream, '$', "GPGST,%s,1.4,0.56,3.2,18,0.2,0.1,1", utc(t));
+}
+
+static void epoch_ais(std::string &stream, int t)
+{
+	static const char *payloads[] =
+	{
+		"13aEOK?P00PD2wVMdLDRhgvL289?", "15M67FC000G?ufbE`FepT@3n00Sa",
+		"33aDqfhP00PD1gHMd0vV0wvL2000", "14eG;o@034o8sd<L9i:a;WF>062D",
+		"B52K>;h00Fc>jpUlNV@ikwpUoP06", "13u?etPv2;0n:dDPwUM1U1Cb069D"
+	};
+	int i;
+
+	for (i = 0; i < 6; i++)
+		append(stream, '!', "AIVDM,1,1,,%c,%s,0", "AB"[i % 2], payloads[(t + i) % 6]);
+
+	append(stream, '$', "GPRMC,%s,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W,A", utc(t));
+	append(stream, '$', "GPGGA,%s,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,", utc(t));
+	append(stream, '$', "GPVTG,054.7,T,034.4,M,005.5,N,010.2,K,A");
+	append(stream, '$', "GPZDA,%s.00,04,07,2002,00,00", utc(t));
+}
+
+static void epoch_text(std::string &stream, int t)
+{
+	char buffer[4096], text[256];
+	size_t nmwritten;
+
+	snprintf(text, sizeof(text), "Epoch %d: antenna current normal, "
+		"almanac of 31 satellites is complete, RAIM is available, "
+		"the last position jump of 2.4 m was rejected, the oscillator is locked", t);
+
+	if (navi_create_txt_sequence(navi_GP, t % 100, text, buffer, sizeof(buffer),
+			&nmwritten) == navi_Ok)
+	{
+		stream.append(buffer, nmwritten);
+	}
+
+	epoch_rmc(stream, t);
+}
+
+static void subscribe_rmc(Parser_t &parser)
+{
+	parser.on<Rmc_v>([](const Rmc_v &) { deliver(); });
+}
+
+static void subscribe_survey(Parser_t &parser)
+{
+	parser.on<Gga_v>([](const Gga_v &) { deliver(); });
+	parser.on<Gst_v>([](const Gst_v &) { deliver(); });
+}
+
+static void subscribe_ais(Parser_t &parser)
+{
+	parser.on<Rmc_v>([](const Rmc_v &) { deliver(); });
+	parser.on<Gga_v>([](const Gga_v &) { deliver(); });
+}
+
+//
+// The modes
+//
+
+static void run_loop(scenario_t &scenario)
+{
+	char *data = &scenario.stream[0];
+	size_t size = scenario.stream.size(), offset, nmread;
+	navi_addrfield_t type;
+	union parsed_t parsed;
+
+	feed();
+
+	for (offset = 0; offset < size; offset += nmread)
+	{
+		nmread = 0;
+		if (navi_parse_msg(data + offset, size - offset, sizeof(parsed), &type,
+				&parsed, &nmread) == navi_Ok)
+		{
+			deliver();
+		}
+		else if ((navierr_get_last()->errclass == navi_NoValidMessage) || (nmread == 0))
+		{
+			break;
+		}
+	}
+}
+
+static void run_framer(scenario_t &scenario)
+{
+	const char *data = scenario.stream.data(), *chunk;
+	size_t size = scenario.stream.size(), offset, left, nmread, nmparsed;
+	struct navi_framer_t framer;
+	navi_addrfield_t type;
+	union parsed_t parsed;
+
+	navi_framer_init(&framer);
+
+	for (offset = 0; offset < size; offset += g_chunk)
+	{
+		chunk = data + offset;
+		left = std::min(g_chunk, size - offset);
+		feed();
+
+		while ((left > 0) && (navi_framer_push(&framer, chunk, left, &nmread) == navi_Ok))
+		{
+			chunk += nmread;
+			left -= nmread;
+
+			if (navi_parse_msg(framer.sentence, framer.length, sizeof(parsed), &type,
+					&parsed, &nmparsed) == navi_Ok)
+			{
+				deliver();
+			}
+		}
+	}
+}
+
+static int on_parsed(const struct navi_parsed_t *parsed, void *context)
+{
+	(void)context;
+
+	if (parsed->status == navi_Ok)
+		deliver();
+
+	return 0;
+}
+
+static void run_batch(scenario_t &scenario)
+{
+	feed();
+	(void)navi_parse_batch(&scenario.stream[0], scenario.stream.size(), on_parsed, NULL, NULL);
+}
+
+static void run_parallel(scenario_t &scenario)
+{
+	feed();
+	(void)navi_parse_parallel(&scenario.stream[0], scenario.stream.size(), g_threads,
+		on_parsed, NULL);
+}
+
+static void run_arena(scenario_t &scenario)
+{
+	static struct navi_arena_t *arena = navi_arena_create(0);
+
+	char *data = &scenario.stream[0];
+	size_t size = scenario.stream.size(), offset, nmread;
+	struct approved_field_t *msg;
+
+	// every pass starts over in the slabs of the first one
+	navi_arena_reset(arena);
+
+	feed();
+
+	for (offset = 0; offset < size; offset += nmread)
+	{
+		nmread = 0;
+		if ((msg = navi_arena_parse(arena, data + offset, size - offset, &nmread)) != NULL)
+		{
+			deliver();
+			navi_arena_free_msg(arena, msg);
+		}
+		else if ((navierr_get_last()->errclass == navi_NoValidMessage) || (nmread == 0))
+		{
+			break;
+		}
+	}
+}
+
+static void run_codec(scenario_t &scenario)
+{
+	char *data = &scenario.stream[0];
+	size_t size = scenario.stream.size(), offset, nmread;
+	NaviError_t error;
+
+	feed();
+
+	for (offset = 0; offset < size; offset += nmread)
+	{
+		nmread = 0;
+		if (!std::holds_alternative<std::monostate>(
+				DecodeAny(data + offset, size - offset, &nmread, error)))
+		{
+			deliver();
+		}
+		else if ((error == NaviError_t::NoValidMessage) || (nmread == 0))
+		{
+			break;
+		}
+	}
+}
+
+static void run_lazy(scenario_t &scenario)
+{
+	const char *data = scenario.stream.data();
+	size_t size = scenario.stream.size(), offset;
+	Parser_t parser;
+
+	scenario.subscribe(parser);
+
+	for (offset = 0; offset < size; offset += g_chunk)
+	{
+		feed();
+		parser.push(data + offset, std::min(g_chunk, size - offset));
+	}
+}
+
+static scenario_t g_scenarios[] =
+{
+	{ "rmc", epoch_rmc, subscribe_rmc, std::string(), 0 },
+	{ "survey", epoch_survey, subscribe_survey, std::string(), 0 },
+	{ "ais", epoch_ais, subscribe_ais, std::string(), 0 },
+	{ "text", epoch_text, subscribe_rmc, std::string(), 0 }
+};
+
+static const parsemode_t g_modes[] =
+{
+	{ "loop", run_loop },
+	{ "framer", run_framer },
+	{ "batch", run_batch },
+	{ "parallel", run_parallel },
+	{ "arena", run_arena },
+	{ "codec", run_codec },
+	{ "lazy", run_lazy }
+};
+
+//
+// Builds the stream of the scenario of g_size bytes at least
+static void make_stream(scenario_t &scenario)
+{
+	size_t i;
+	int t;
+
+	scenario.stream.clear();
+	for (t = 0; scenario.stream.size() < g_size; t++)
+		scenario.epoch(scenario.stream, t);
+
+	scenario.nmsentences = 0;
+	for (i = 0; i < scenario.stream.size(); i++)
+		scenario.nmsentences += scenario.stream[i] == '\n';
+}
+
+//
+// Returns the percentile of the latencies, reordering them
+static double percentile(std::vector<float> &latency, double p)
+{
+	size_t k;
+
+	if (latency.empty())
+		return 0.0;
+
+	k = std::min(latency.size() - 1, (size_t)(p * (double)latency.size()));
+	std::nth_element(latency.begin(), latency.begin() + k, latency.end());
+
+	return latency[k];
+}
+
+//
+// Measures the mode on the scenario and prints the result
+static void bench_run(scenario_t &scenario, const parsemode_t &mode)
+{
+	double start, elapsed, throughput;
+	size_t passes = 0, delivered;
+
+	// the throughput, without the time stamps
+	g_timed = false;
+	start = bench_now();
+	do
+	{
+		g_delivered = 0;
+		mode.run(scenario);
+		passes++;
+		elapsed = bench_now() - start;
+	} while (elapsed < g_mintime);
+
+	delivered = g_delivered;
+	throughput = (double)scenario.stream.size() * (double)passes / elapsed / 1e6;
+
+	// the latency, in the same number of the passes
+	g_timed = true;
+	g_latency.clear();
+	g_latency.reserve(passes * delivered);
+	while (passes-- > 0)
+		mode.run(scenario);
+
+	printf("%s,%s,%lu,%lu,%.2f,%.0f,%.0f\n", scenario.name, mode.name,
+		(unsigned long)scenario.nmsentences, (unsigned long)delivered, throughput,
+		percentile(g_latency, 0.5), percentile(g_latency, 0.99));
+	fflush(stdout);
+}
+
+//
+// Parses the size with the suffix k, M or G
+static size_t parse_size(const char *s)
+{
+	char *end;
+	double size = strtod(s, &end);
+
+	switch (*end)
+	{
+	case 'k': case 'K': size *= 1024.; break;
+	case 'm': case 'M': size *= 1024. * 1024.; break;
+	case 'g': case 'G': size *= 1024. * 1024. * 1024.; break;
+	}
+
+	return (size_t)size;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *scenario = NULL, *mode = NULL;
+	size_t i, j;
+
+	for (i = 1; i < (size_t)argc; i++)
+	{
+		if ((strcmp(argv[i], "-n") == 0) && (i + 1 < (size_t)argc))
+			g_size = parse_size(argv[++i]);
+		else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < (size_t)argc))
+			g_mintime = atof(argv[++i]);
+		else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < (size_t)argc))
+			g_chunk = parse_size(argv[++i]);
+		else if ((strcmp(argv[i], "-j") == 0) && (i + 1 < (size_t)argc))
+			g_threads = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < (size_t)argc))
+			scenario = argv[++i];
+		else if ((strcmp(argv[i], "-m") == 0) && (i + 1 < (size_t)argc))
+			mode = argv[++i];
+		else
+		{
+			printf("Usage: navigate_scenarios [-n size] [-t seconds] [-c chunk] [-j threads]\n"
+				"\t[-s scenario] [-m mode]\n");
+			return 1;
+		}
+	}
+
+	if (g_chunk == 0)
+		g_chunk = 1;
+
+	printf("# libnavigate %s, stream %lu bytes, chunk %lu bytes, minimum time %.3f s\n",
+		LIBNAVIGATE_VERSION_STRING, (unsigned long)g_size, (unsigned long)g_chunk, g_mintime);
+	printf("scenario,mode,sentences,delivered,mb_per_s,p50_ns,p99_ns\n");
+
+	for (i = 0; i < sizeof(g_scenarios) / sizeof(g_scenarios[0]); i++)
+	{
+		if ((scenario != NULL) && (strcmp(scenario, g_scenarios[i].name) != 0))
+			continue;
+
+		make_stream(g_scenarios[i]);
+
+		for (j = 0; j < sizeof(g_modes) / sizeof(g_modes[0]); j++)
+		{
+			if ((mode == NULL) || (strcmp(mode, g_modes[j].name) == 0))
+				bench_run(g_scenarios[i], g_modes[j]);
+		}
+
+		g_scenarios[i].stream.clear();
+	}
+
+	return 0;
+}
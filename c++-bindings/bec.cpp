@@ -18,106 +18,23 @@
 */
 
 #include "include/libnavigate/c++/bec.hpp"
-#include <string.h>
 
 namespace libnavigate
 {
 
-	Bec_t::Bec_t(const TalkerId_t &tid) : Message_t(MessageType_t::BEC)
+	Bec_t::Bec_t(const TalkerId_t &tid) : Message_t(MessageType_t::BEC, tid)
 	{
-		navi_init_bec((struct bec_t *)(*this), tid.toTalkerIdCode());
+		navi_init_bec((struct bec_t *)(*this));
 	}
 
 	Bec_t::Bec_t(const Message_t &msg) : Message_t(msg) { }
 
 	Bec_t::~Bec_t() { }
 
-	TalkerId_t Bec_t::talkerId() const
-	{
-		return TalkerId_t::fromTalkerIdCode(((const struct bec_t *)(*this))->tid);
-	}
-
-	void Bec_t::setTalkerId(const TalkerId_t &tid)
-	{
-		((struct bec_t *)(*this))->tid = tid.toTalkerIdCode();
-	}
-
 	void Bec_t::clearMessage()
 	{
-		navi_init_bec((struct bec_t *)(*this), TalkerId_t::Unknown);
-	}
-
-	Bec_t::operator const struct bec_t *() const
-	{
-		const void *p = (const void *)(*this);
-		return (const struct bec_t *)p;
-	}
-
-	Bec_t::operator struct bec_t *()
-	{
-		void *p = (void *)(*this);
-		return (struct bec_t *)p;
-	}
-
-	Utc_t Bec_t::utc() const
-	{
-		return Utc_t::fromUtcStruct(((const struct bec_t *)(*this))->utc);
-	}
-
-	PositionFix_t Bec_t::waypointFix() const
-	{
-		return PositionFix_t::fromPosition(&((const struct bec_t *)(*this))->waypointfix);
-	}
-
-	Offset_t Bec_t::bearingTrue() const
-	{
-		return Offset_t::fromOffset(&((const struct bec_t *)(*this))->bearingT);
-	}
-
-	Offset_t Bec_t::bearingMagnetic() const
-	{
-		return Offset_t::fromOffset(&((const struct bec_t *)(*this))->bearingM);
-	}
-
-	double Bec_t::distance() const
-	{
-		return ((const struct bec_t *)(*this))->distance;
-	}
-
-	std::string Bec_t::waypointId() const
-	{
-		return std::string(((const struct bec_t *)(*this))->waypoint_id);
-	}
-
-	void Bec_t::setUtc(const Utc_t &value)
-	{
-		((struct bec_t *)(*this))->utc = value.toUtcStruct();
-	}
-
-	void Bec_t::setWaypointFix(const PositionFix_t &value)
-	{
-		((struct bec_t *)(*this))->waypointfix = value.toPosition();
-	}
-
-	void Bec_t::setBearingTrue(const Offset_t &value)
-	{
-		((struct bec_t *)(*this))->bearingT = value.toOffset();
-	}
-
-	void Bec_t::setBearingMagnetic(const Offset_t &value)
-	{
-		((struct bec_t *)(*this))->bearingM = value.toOffset();
-	}
-
-	void Bec_t::setDistance(double value)
-	{
-		((struct bec_t *)(*this))->distance = value;
-	}
-
-	void Bec_t::setWaypointId(const std::string &value)
-	{
-		(void)strncpy(((struct bec_t *)(*this))->waypoint_id, value.c_str(),
-			sizeof(((struct bec_t *)(*this))->waypoint_id));
+		navi_init_bec((struct bec_t *)(*this));
+		Message_t::setTalkerId(TalkerId_t::Unknown);
 	}
 
 }
@@ -18,87 +18,23 @@
 */
 
 #include "include/libnavigate/c++/bod.hpp"
-#include <string.h>
 
 namespace libnavigate
 {
 
-	Bod_t::Bod_t(const TalkerId_t &tid) : Message_t(MessageType_t::BOD)
+	Bod_t::Bod_t(const TalkerId_t &tid) : Message_t(MessageType_t::BOD, tid)
 	{
-		navi_init_bod((struct bod_t *)(*this), tid.toTalkerIdCode());
+		navi_init_bod((struct bod_t *)(*this));
 	}
 
 	Bod_t::Bod_t(const Message_t &msg) : Message_t(msg) { }
 
 	Bod_t::~Bod_t() { }
 
-	TalkerId_t Bod_t::talkerId() const
-	{
-		return TalkerId_t::fromTalkerIdCode(((const struct bod_t *)(*this))->tid);
-	}
-
-	void Bod_t::setTalkerId(const TalkerId_t &tid)
-	{
-		((struct bod_t *)(*this))->tid = tid.toTalkerIdCode();
-	}
-
 	void Bod_t::clearMessage()
 	{
-		navi_init_bod((struct bod_t *)(*this), TalkerId_t::Unknown);
-	}
-
-	Bod_t::operator const struct bod_t *() const
-	{
-		const void *p = (const void *)(*this);
-		return (const struct bod_t *)p;
-	}
-
-	Bod_t::operator struct bod_t *()
-	{
-		void *p = (void *)(*this);
-		return (struct bod_t *)p;
-	}
-
-	Offset_t Bod_t::bearingTrue() const
-	{
-		return Offset_t::fromOffset(&((const struct bod_t *)(*this))->bearingT);
-	}
-
-	Offset_t Bod_t::bearingMagnetic() const
-	{
-		return Offset_t::fromOffset(&((const struct bod_t *)(*this))->bearingM);
-	}
-
-	std::string Bod_t::destWaypointId() const
-	{
-		return std::string(((const struct bod_t *)(*this))->dest_waypoint);
-	}
-
-	std::string Bod_t::origWaypointId() const
-	{
-		return std::string(((const struct bod_t *)(*this))->orig_waypoint);
-	}
-
-	void Bod_t::setBearingTrue(const Offset_t &value)
-	{
-		((struct bod_t *)(*this))->bearingT = value.toOffset();
-	}
-
-	void Bod_t::setBearingMagnetic(const Offset_t &value)
-	{
-		((struct bod_t *)(*this))->bearingM = value.toOffset();
-	}
-
-	void Bod_t::setDestWaypointId(const std::string &value)
-	{
-		(void)strncpy(((struct bod_t *)(*this))->dest_waypoint, value.c_str(),
-			sizeof(((struct bod_t *)(*this))->dest_waypoint));
-	}
-
-	void Bod_t::setOrigWaypointId(const std::string &value)
-	{
-		(void)strncpy(((struct bod_t *)(*this))->orig_waypoint, value.c_str(),
-			sizeof(((struct bod_t *)(*this))->orig_waypoint));
+		navi_init_bod((struct bod_t *)(*this));
+		Message_t::setTalkerId(TalkerId_t::Unknown);
 	}
 
 }
@@ -1,16 +1,38 @@
 #include "include/libnavigate/c++/errors.hpp"
 #include "include/libnavigate/c++/navigate.hpp"
+#include "instrument.hpp"
 
 namespace libnavigate
 {
 
 size_t Navigate_t::CreateMessage(const Message_t &msg, char *buffer, size_t maxsize)
 {
+	StatsScope_t scope(BindingsStats_t::CreateMessage);
 	size_t nmwritten;
+	NaviError_t error;
 
-	if (navi_create_msg(msg.type().toSentenceFormatter(), msg, buffer,
+	if ((nmwritten = CreateMessage(msg, buffer, maxsize, error)) == 0)
+	{
+		countStats(StatsExceptions);
+		throw error;
+	}
+
+	return nmwritten;
+}
+
+size_t Navigate_t::CreateMessage(const Message_t &msg, char *buffer, size_t maxsize,
+	NaviError_t &error)
+{
+	StatsScope_t scope(BindingsStats_t::CreateMessage);
+	size_t nmwritten;
+	struct approved_field_t address = msg.address();
+
+	if (navi_create_msg(navi_af_Approved, &address, msg, buffer,
 			maxsize, &nmwritten) != navi_Ok)
-		throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+	{
+		error = NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+		return 0;
+	}
 
 	return nmwritten;
 }
@@ -20,11 +42,19 @@ size_t Navigate_t::CreateMessage(const Message_t &msg, char *buffer, size_t maxs
 size_t Navigate_t::CreateTxtSequence(const TalkerId_t &tid, int textId,
 	const char *msg, char *buffer, size_t maxsize)
 {
+	StatsScope_t scope(BindingsStats_t::CreateTxtSequence);
 	size_t nmwritten;
 
+	// the only call site counted as virtual: toTalkerIdCode() of the
+	// reference is dispatched at run time
+	countStats(StatsVirtualCalls);
+
 	if (navi_create_txt_sequence(tid.toTalkerIdCode(), textId, msg, buffer,
 			maxsize, &nmwritten) != navi_Ok)
+	{
+		countStats(StatsExceptions);
 		throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+	}
 
 	return nmwritten;
 }
@@ -22,62 +22,17 @@
 namespace libnavigate
 {
 
-Gll_t::Gll_t(const TalkerId_t &tid) : Message_t(MessageType_t::GLL)
-	{ navi_init_gll((struct gll_t *)(*this), tid.toTalkerIdCode()); }
+Gll_t::Gll_t(const TalkerId_t &tid) : Message_t(MessageType_t::GLL, tid)
+	{ navi_init_gll((struct gll_t *)(*this)); }
 
 Gll_t::Gll_t(const Message_t &msg) : Message_t(msg) { }
 
 Gll_t::~Gll_t() { }
 
-TalkerId_t Gll_t::talkerId() const
-	{ return TalkerId_t::fromTalkerIdCode(((const struct gll_t *)(*this))->tid); }
-
-PositionFix_t Gll_t::positionFix() const
-	{ return PositionFix_t::fromPosition(&((const struct gll_t *)(*this))->fix); }
-
-Utc_t Gll_t::utc() const
-	{ return Utc_t::fromUtcStruct(((const struct gll_t *)(*this))->utc); }
-
-Status_t Gll_t::status() const
-	{ return Status_t::fromStatusCode(((const struct gll_t *)(*this))->status); }
-
-ModeIndicator_t Gll_t::modeIndicator() const
-	{ return ModeIndicator_t::fromModeIndCode(((const struct gll_t *)(*this))->mi); }
-
-void Gll_t::setTalkerId(const TalkerId_t &tid)
-	{ ((struct gll_t *)(*this))->tid = tid.toTalkerIdCode(); }
-
-void Gll_t::setPositionFix(const PositionFix_t &fix)
-	{ ((struct gll_t *)(*this))->fix = fix.toPosition(); }
-
-void Gll_t::setUtc(const Utc_t &utc)
-	{ ((struct gll_t *)(*this))->utc = utc.toUtcStruct(); }
-
-void Gll_t::setStatus(const Status_t &status)
-	{ ((struct gll_t *)(*this))->status = status.toStatusCode(); }
-
-void Gll_t::setModeIndicator(const ModeIndicator_t &mi)
-	{ ((struct gll_t *)(*this))->mi = mi.toModeIndCode(); }
-
-bool Gll_t::isPositionValid() const
-	{ return ((const struct gll_t *)(*this))->fix.latitude.sign != navi_offset_NULL; }
-
-bool Gll_t::isUtcValid() const
-	{ return navi_check_validity_utc(&((const struct gll_t *)(*this))->utc) == navi_Ok; }
-
 void Gll_t::clearMessage()
-	{ navi_init_gll((struct gll_t *)(*this), navi_talkerid_Unknown); }
-
-Gll_t::operator const struct gll_t *() const
-{
-	const void *p = (const void *)(*this);
-	return (const struct gll_t *)p;
-}
-
-Gll_t::operator struct gll_t *()
 {
-	void *p = (void *)(*this);
-	return (struct gll_t *)p;
+	navi_init_gll((struct gll_t *)(*this));
+	Message_t::setTalkerId(TalkerId_t::Unknown);
 }
 
 }
@@ -22,92 +22,17 @@
 namespace libnavigate
 {
 
-Gst_t::Gst_t(const TalkerId_t &tid) : Message_t(MessageType_t::GST)
-{ navi_init_gst((struct gst_t *)(*this), tid.toTalkerIdCode()); }
+Gst_t::Gst_t(const TalkerId_t &tid) : Message_t(MessageType_t::GST, tid)
+{ navi_init_gst((struct gst_t *)(*this)); }
 
 Gst_t::Gst_t(const Message_t &msg) : Message_t(msg) { }
 
 Gst_t::~Gst_t() { }
 
-TalkerId_t Gst_t::talkerId() const
-{ return TalkerId_t::fromTalkerIdCode(((const struct gst_t *)(*this))->tid); }
-
-Utc_t Gst_t::utc() const
-{ return Utc_t::fromUtcStruct(((const struct gst_t *)(*this))->utc); }
-
-double Gst_t::rmsOfStandardDeviation() const
-{ return ((const struct gst_t *)(*this))->rms; }
-
-double Gst_t::deviationOfSemiMajorAxis() const
-{ return ((const struct gst_t *)(*this))->devmajor; }
-
-double Gst_t::deviationOfSemiMinorAxis() const
-{ return ((const struct gst_t *)(*this))->devminor; }
-
-double Gst_t::orientationOfSemiMajorAxis() const
-{ return ((const struct gst_t *)(*this))->orientmajor; }
-
-double Gst_t::deviationOfLatitudeError() const
-{ return ((const struct gst_t *)(*this))->devlaterr; }
-
-double Gst_t::deviationOfLongitudeError() const
-{ return ((const struct gst_t *)(*this))->devlonerr; }
-
-double Gst_t::deviationOfAltitudeError() const
-{ return ((const struct gst_t *)(*this))->devalterr; }
-
-void Gst_t::setTalkerId(const TalkerId_t &tid)
-{ ((struct gst_t *)(*this))->tid = tid.toTalkerIdCode(); }
-
-void Gst_t::setUtc(const Utc_t &utc)
-{ ((struct gst_t *)(*this))->utc = utc.toUtcStruct(); }
-
-void Gst_t::setRmsOfStandardDeviation(double value)
-{ ((struct gst_t *)(*this))->rms = value; }
-
-void Gst_t::setDeviationOfSemiMajorAxis(double value)
-{ ((struct gst_t *)(*this))->devmajor = value; }
-
-void Gst_t::setDeviationOfSemiMinorAxis(double value)
-{ ((struct gst_t *)(*this))->devminor = value; }
-
-void Gst_t::setOrientationOfSemiMajorAxis(double value)
-{ ((struct gst_t *)(*this))->orientmajor = value; }
-
-void Gst_t::setDeviationOfLatitudeError(double value)
-{ ((struct gst_t *)(*this))->devlaterr = value; }
-
-void Gst_t::setDeviationOfLongitudeError(double value)
-{ ((struct gst_t *)(*this))->devlonerr = value; }
-
-void Gst_t::setDeviationOfAltitudeError(double value)
-{ ((struct gst_t *)(*this))->devalterr = value; }
-
-bool Gst_t::isRmsValid() const
-{ return navi_check_validity_number(((const struct gst_t *)(*this))->rms) == navi_Ok; }
-
-bool Gst_t::isStdDeviationOfEllipseValid() const
-{ return navi_check_validity_number(((const struct gst_t *)(*this))->devmajor) == navi_Ok; }
-
-bool Gst_t::isStdDeviationOfPositionValid() const
-{ return navi_check_validity_number(((const struct gst_t *)(*this))->devlaterr) == navi_Ok; }
-
-bool Gst_t::isStdDevofAltitudeValid() const
-{ return navi_check_validity_number(((const struct gst_t *)(*this))->devalterr) == navi_Ok; }
-
 void Gst_t::clearMessage()
-{ navi_init_gst((struct gst_t *)(*this), navi_talkerid_Unknown); }
-
-Gst_t::operator const struct gst_t *() const
-{
-	const void *p = (const void *)(*this);
-	return (const struct gst_t *)p;
-}
-
-Gst_t::operator struct gst_t *()
 {
-	void *p = (void *)(*this);
-	return (struct gst_t *)p;
+	navi_init_gst((struct gst_t *)(*this));
+	Message_t::setTalkerId(TalkerId_t::Unknown);
 }
 
 }
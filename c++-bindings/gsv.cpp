@@ -22,91 +22,17 @@
 namespace libnavigate
 {
 
-Gsv_t::Gsv_t(const TalkerId_t &tid) : Message_t(MessageType_t::GSV)
-	{ navi_init_gsv((struct gsv_t *)(*this), tid.toTalkerIdCode()); }
+Gsv_t::Gsv_t(const TalkerId_t &tid) : Message_t(MessageType_t::GSV, tid)
+	{ navi_init_gsv((struct gsv_t *)(*this)); }
 
 Gsv_t::Gsv_t(const Message_t &msg) : Message_t(msg) { }
 
 Gsv_t::~Gsv_t() { }
 
-TalkerId_t Gsv_t::talkerId() const
-	{ return TalkerId_t::fromTalkerIdCode(((const struct gsv_t *)(*this))->tid); }
-
-void Gsv_t::setTalkerId(const TalkerId_t &tid)
-	{ ((struct gsv_t *)(*this))->tid = tid.toTalkerIdCode(); }
-
-int Gsv_t::nmOfSatellites() const
-	{ return ((const struct gsv_t *)(*this))->nmsatellites; }
-
-int Gsv_t::totalNmOfMessages() const
-	{ return ((const struct gsv_t *)(*this))->totalnm; }
-
-int Gsv_t::messageNumber() const
-	{ return ((const struct gsv_t *)(*this))->msgnm; }
-
-void Gsv_t::setNmOfSatellites(int value)
-	{ ((struct gsv_t *)(*this))->nmsatellites = value; }
-
-void Gsv_t::setTotalNmOfMessages(int value)
-	{ ((struct gsv_t *)(*this))->totalnm = value; }
-
-void Gsv_t::setMessageNumber(int value)
-	{ ((struct gsv_t *)(*this))->msgnm = value; }
-
-unsigned int Gsv_t::satelliteId(int satIdx) const
-	{ return ((const struct gsv_t *)(*this))->info[satIdx].id; }
-
-unsigned int Gsv_t::elevation(int satIdx) const
-	{ return ((const struct gsv_t *)(*this))->info[satIdx].elevation; }
-
-unsigned int Gsv_t::azimuth(int satIdx) const
-	{ return ((const struct gsv_t *)(*this))->info[satIdx].azimuth; }
-
-unsigned int Gsv_t::snratio(int satIdx) const
-	{ return ((const struct gsv_t *)(*this))->info[satIdx].snr; }
-
-void Gsv_t::setSatelliteId(int satIdx, unsigned int value)
-{
-	((struct gsv_t *)(*this))->info[satIdx].id = value;
-}
-
-void Gsv_t::setOrientation(int satIdx, unsigned int elevation,
-	unsigned int azimuth)
-{
-	((struct gsv_t *)(*this))->info[satIdx].elevation = elevation;
-	((struct gsv_t *)(*this))->info[satIdx].azimuth = azimuth;
-	((struct gsv_t *)(*this))->info[satIdx].vfields |= SATINFO_VALID_ORIENTATION;
-}
-
-void Gsv_t::setSnratio(int satIdx, unsigned int value)
-{
-	((struct gsv_t *)(*this))->info[satIdx].snr = value;
-	((struct gsv_t *)(*this))->info[satIdx].vfields |= SATINFO_VALID_SNR;
-}
-
-bool Gsv_t::isOrientationValid(int satIdx) const
-{
-	return (((const struct gsv_t *)(*this))->info[satIdx].vfields & SATINFO_VALID_ORIENTATION) != 0 ? true : false;
-}
-
-bool Gsv_t::isSnrValid(int satIdx) const
-{
-	return (((const struct gsv_t *)(*this))->info[satIdx].vfields & SATINFO_VALID_SNR) != 0 ? true : false;
-}
-
 void Gsv_t::clearMessage()
-	{ navi_init_gsv((struct gsv_t *)(*this), navi_talkerid_Unknown); }
-
-Gsv_t::operator const struct gsv_t *() const
-{
-	const void *p = (const void *)(*this);
-	return (const struct gsv_t *)p;
-}
-
-Gsv_t::operator struct gsv_t *()
 {
-	void *p = (void *)(*this);
-	return (struct gsv_t *)p;
+	navi_init_gsv((struct gsv_t *)(*this));
+	Message_t::setTalkerId(TalkerId_t::Unknown);
 }
 
 }
@@ -22,12 +22,13 @@
 
 #include "sentence.hpp"
 #include <libnavigate/aam.h>
+#include <string.h>
 #include <string>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Aam_t) : public Message_t
+NAVI_EXTERN_CLASS(Aam_t) NAVI_FINAL : public Message_t
 {
 public:
 	static const int MaxWaypointIdSize = 60;
@@ -38,29 +39,65 @@ public:
 	virtual ~Aam_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-
-	virtual Status_t circleStatus() const;
-	virtual Status_t perpendicularStatus() const;
-	virtual double waypointRadius() const;
-	virtual std::string waypointId() const;
+	Status_t circleStatus() const;
+	Status_t perpendicularStatus() const;
+	double waypointRadius() const;
+	std::string waypointId() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setCircleStatus(const Status_t &value);
-	virtual void setPerpendicularStatus(const Status_t &value);
-	virtual void setWaypointRadius(double value);
-	virtual void setWaypointId(const std::string &value);
+	void setCircleStatus(const Status_t &value);
+	void setPerpendicularStatus(const Status_t &value);
+	void setWaypointRadius(double value);
+	void setWaypointId(const std::string &value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct aam_t *() const;
-	virtual operator struct aam_t *();
+	operator const struct aam_t *() const;
+	operator struct aam_t *();
 };
 
+inline Status_t Aam_t::circleStatus() const
+{
+	return Status_t::fromStatusCode(((const struct aam_t *)(*this))->circle);
+}
+
+inline Status_t Aam_t::perpendicularStatus() const
+{
+	return Status_t::fromStatusCode(((const struct aam_t *)(*this))->perp);
+}
+
+inline double Aam_t::waypointRadius() const
+	{ return ((const struct aam_t *)(*this))->radius; }
+
+inline std::string Aam_t::waypointId() const
+	{ return std::string(((const struct aam_t *)(*this))->wpid); }
+
+inline void Aam_t::setCircleStatus(const Status_t &value)
+	{ ((struct aam_t *)(*this))->circle = value.toStatusCode(); }
+
+inline void Aam_t::setPerpendicularStatus(const Status_t &value)
+	{ ((struct aam_t *)(*this))->perp = value.toStatusCode(); }
+
+inline void Aam_t::setWaypointRadius(double value)
+	{ ((struct aam_t *)(*this))->radius = value; }
+
+inline void Aam_t::setWaypointId(const std::string &value)
+	{ strncpy(((struct aam_t *)(*this))->wpid, value.c_str(), sizeof(((struct aam_t *)(*this))->wpid)); }
+
+inline Aam_t::operator const struct aam_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct aam_t *)p;
+}
+
+inline Aam_t::operator struct aam_t *()
+{
+	void *p = (void *)(*this);
+	return (struct aam_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_aamplusplus
@@ -27,7 +27,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Ack_t) : public Message_t
+NAVI_EXTERN_CLASS(Ack_t) NAVI_FINAL : public Message_t
 {
 public:
 	Ack_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -35,23 +35,41 @@ public:
 	virtual ~Ack_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-
-	virtual int alarmId() const;
+	int alarmId() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setAlarmId(int value);
+	void setAlarmId(int value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct ack_t *() const;
-	virtual operator struct ack_t *();
+	operator const struct ack_t *() const;
+	operator struct ack_t *();
 };
 
+inline Ack_t::operator const struct ack_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct ack_t *)p;
+}
+
+inline Ack_t::operator struct ack_t *()
+{
+	void *p = (void *)(*this);
+	return (struct ack_t *)p;
+}
+
+inline int Ack_t::alarmId() const
+{
+	return ((const struct ack_t *)(*this))->alarmid;
+}
+
+inline void Ack_t::setAlarmId(int value)
+{
+	((struct ack_t *)(*this))->alarmid = value;
+}
+
 }
 
 #endif // INCLUDE_navi_ackplusplus
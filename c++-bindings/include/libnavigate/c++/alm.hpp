@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Alm_t) : public Message_t
+NAVI_EXTERN_CLASS(Alm_t) NAVI_FINAL : public Message_t
 {
 public:
 	static const int MaxSatellites = ALM_MAX_SATELLITES;
@@ -37,65 +37,261 @@ public:
 	virtual ~Alm_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-	virtual int totalNmOfMessages() const;
-	virtual int messageNumber() const;
-
-	virtual unsigned int satellitePrn() const;
-	virtual unsigned int gpsWeek() const;
-	virtual unsigned int svHealth() const;
-	virtual unsigned int eccentricity() const;
-	virtual unsigned int almanacReferenceTime() const;
-	virtual unsigned int inclinationAngle() const;
-	virtual unsigned int rateOfRightAscension() const;
-	virtual unsigned int sqrtOfSemiMajorAxis() const;
-	virtual unsigned int argumentOfPerigee() const;
-	virtual unsigned int longitudeOfAscensionNode() const;
-	virtual unsigned int meanAnomaly() const;
-	virtual unsigned int clockParameter0() const;
-	virtual unsigned int clockParameter1() const;
+	int totalNmOfMessages() const;
+	int messageNumber() const;
+
+	unsigned int satellitePrn() const;
+	unsigned int gpsWeek() const;
+	unsigned int svHealth() const;
+	unsigned int eccentricity() const;
+	unsigned int almanacReferenceTime() const;
+	unsigned int inclinationAngle() const;
+	unsigned int rateOfRightAscension() const;
+	unsigned int sqrtOfSemiMajorAxis() const;
+	unsigned int argumentOfPerigee() const;
+	unsigned int longitudeOfAscensionNode() const;
+	unsigned int meanAnomaly() const;
+	unsigned int clockParameter0() const;
+	unsigned int clockParameter1() const;
 
 public:
-	virtual bool isGpsWeekValid() const;
-	virtual bool isSvHealthValid() const;
-	virtual bool isEccentricityValid() const;
-	virtual bool isAlmanacReferenceTimeValid() const;
-	virtual bool isInclinationAngleValid() const;
-	virtual bool isRateOfRightAscensionValid() const;
-	virtual bool isSqrtOfSemiMajorAxisValid() const;
-	virtual bool isArgumentOfPerigeeValid() const;
-	virtual bool isLongitudeOfAscensionNodeValid() const;
-	virtual bool isMeanAnomalyValid() const;
-	virtual bool isClockParameter0Valid() const;
-	virtual bool isClockParameter1Valid() const;
+	bool isGpsWeekValid() const;
+	bool isSvHealthValid() const;
+	bool isEccentricityValid() const;
+	bool isAlmanacReferenceTimeValid() const;
+	bool isInclinationAngleValid() const;
+	bool isRateOfRightAscensionValid() const;
+	bool isSqrtOfSemiMajorAxisValid() const;
+	bool isArgumentOfPerigeeValid() const;
+	bool isLongitudeOfAscensionNodeValid() const;
+	bool isMeanAnomalyValid() const;
+	bool isClockParameter0Valid() const;
+	bool isClockParameter1Valid() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-	virtual void setTotalNmOfMessages(int value);
-	virtual void setMessageNumber(int value);
-
-	virtual void setSatellitePrn(unsigned int value);
-	virtual void setGpsWeek(unsigned int value);
-	virtual void setSvHealth(unsigned int value);
-	virtual void setEccentricity(unsigned int value);
-	virtual void setAlmanacReferenceTime(unsigned int value);
-	virtual void setInclinationAngle(unsigned int value);
-	virtual void setRateOfRightAscension(unsigned int value);
-	virtual void setSqrtOfSemiMajorAxis(unsigned int value);
-	virtual void setArgumentOfPerigee(unsigned int value);
-	virtual void setLongitudeOfAscensionNode(unsigned int value);
-	virtual void setMeanAnomaly(unsigned int value);
-	virtual void setClockParameter0(unsigned int value);
-	virtual void setClockParameter1(unsigned int value);
+	void setTotalNmOfMessages(int value);
+	void setMessageNumber(int value);
+
+	void setSatellitePrn(unsigned int value);
+	void setGpsWeek(unsigned int value);
+	void setSvHealth(unsigned int value);
+	void setEccentricity(unsigned int value);
+	void setAlmanacReferenceTime(unsigned int value);
+	void setInclinationAngle(unsigned int value);
+	void setRateOfRightAscension(unsigned int value);
+	void setSqrtOfSemiMajorAxis(unsigned int value);
+	void setArgumentOfPerigee(unsigned int value);
+	void setLongitudeOfAscensionNode(unsigned int value);
+	void setMeanAnomaly(unsigned int value);
+	void setClockParameter0(unsigned int value);
+	void setClockParameter1(unsigned int value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct alm_t *() const;
-	virtual operator struct alm_t *();
+	operator const struct alm_t *() const;
+	operator struct alm_t *();
 };
 
+inline int Alm_t::totalNmOfMessages() const
+	{ return ((const struct alm_t *)(*this))->totalnm; }
+
+inline int Alm_t::messageNumber() const
+	{ return ((const struct alm_t *)(*this))->msgnm; }
+
+inline unsigned int Alm_t::satellitePrn() const
+	{ return ((const struct alm_t *)(*this))->alm.satelliteprn; }
+
+inline unsigned int Alm_t::gpsWeek() const
+	{ return ((const struct alm_t *)(*this))->alm.gpsweek; }
+
+inline unsigned int Alm_t::svHealth() const
+	{ return ((const struct alm_t *)(*this))->alm.svhealth; }
+
+inline unsigned int Alm_t::eccentricity() const
+	{ return ((const struct alm_t *)(*this))->alm.e; }
+
+inline unsigned int Alm_t::almanacReferenceTime() const
+	{ return ((const struct alm_t *)(*this))->alm.toa; }
+
+inline unsigned int Alm_t::inclinationAngle() const
+	{ return ((const struct alm_t *)(*this))->alm.sigmai; }
+
+inline unsigned int Alm_t::rateOfRightAscension() const
+	{ return ((const struct alm_t *)(*this))->alm.omegadot; }
+
+inline unsigned int Alm_t::sqrtOfSemiMajorAxis() const
+	{ return ((const struct alm_t *)(*this))->alm.sqrtsemiaxis; }
+
+inline unsigned int Alm_t::argumentOfPerigee() const
+	{ return ((const struct alm_t *)(*this))->alm.omega; }
+
+inline unsigned int Alm_t::longitudeOfAscensionNode() const
+	{ return ((const struct alm_t *)(*this))->alm.omega0; }
+
+inline unsigned int Alm_t::meanAnomaly() const
+	{ return ((const struct alm_t *)(*this))->alm.m0; }
+
+inline unsigned int Alm_t::clockParameter0() const
+	{ return ((const struct alm_t *)(*this))->alm.af0; }
+
+inline unsigned int Alm_t::clockParameter1() const
+	{ return ((const struct alm_t *)(*this))->alm.af1; }
+
+inline void Alm_t::setTotalNmOfMessages(int value)
+	{ ((struct alm_t *)(*this))->totalnm = value; }
+
+inline void Alm_t::setMessageNumber(int value)
+	{ ((struct alm_t *)(*this))->msgnm = value; }
+
+inline void Alm_t::setSatellitePrn(unsigned int value)
+	{ ((struct alm_t *)(*this))->alm.satelliteprn = value; }
+
+inline void Alm_t::setGpsWeek(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.gpsweek = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_GPSWEEK;
+}
+
+inline void Alm_t::setSvHealth(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.svhealth = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_SVHEALTH;
+}
+
+inline void Alm_t::setEccentricity(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.e = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_E;
+}
+
+inline void Alm_t::setAlmanacReferenceTime(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.toa = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_TOA;
+}
+
+inline void Alm_t::setInclinationAngle(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.sigmai = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_SIGMAI;
+}
+
+inline void Alm_t::setRateOfRightAscension(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.omegadot = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_OMEGADOT;
+}
+
+inline void Alm_t::setSqrtOfSemiMajorAxis(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.sqrtsemiaxis = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_SQRTSEMIAXIS;
+}
+
+inline void Alm_t::setArgumentOfPerigee(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.omega = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_OMEGA;
+}
+
+inline void Alm_t::setLongitudeOfAscensionNode(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.omega0 = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_OMEGA0;
+}
+
+inline void Alm_t::setMeanAnomaly(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.m0 = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_M0;
+}
+
+inline void Alm_t::setClockParameter0(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.af0 = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_AF0;
+}
+
+inline void Alm_t::setClockParameter1(unsigned int value)
+{
+	((struct alm_t *)(*this))->alm.af1 = value;
+	((struct alm_t *)(*this))->alm.vfields |= GPSALM_VALID_AF1;
+}
+
+inline bool Alm_t::isGpsWeekValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_GPSWEEK) != 0 ? true : false;
+}
+
+inline bool Alm_t::isSvHealthValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_SVHEALTH) != 0 ? true : false;
+}
+
+inline bool Alm_t::isEccentricityValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_E) != 0 ? true : false;
+}
+
+inline bool Alm_t::isAlmanacReferenceTimeValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_TOA) != 0 ? true : false;
+}
+
+inline bool Alm_t::isInclinationAngleValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_SIGMAI) != 0 ? true : false;
+}
+
+inline bool Alm_t::isRateOfRightAscensionValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_OMEGADOT) != 0 ? true : false;
+}
+
+inline bool Alm_t::isSqrtOfSemiMajorAxisValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_SQRTSEMIAXIS) != 0 ? true : false;
+}
+
+inline bool Alm_t::isArgumentOfPerigeeValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_OMEGA) != 0 ? true : false;
+}
+
+inline bool Alm_t::isLongitudeOfAscensionNodeValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_OMEGA0) != 0 ? true : false;
+}
+
+inline bool Alm_t::isMeanAnomalyValid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_M0) != 0 ? true : false;
+}
+
+inline bool Alm_t::isClockParameter0Valid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_AF0) != 0 ? true : false;
+}
+
+inline bool Alm_t::isClockParameter1Valid() const
+{
+	return (((const struct alm_t *)(*this))->alm.vfields & GPSALM_VALID_AF1) != 0 ? true : false;
+}
+
+inline Alm_t::operator const struct alm_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct alm_t *)p;
+}
+
+inline Alm_t::operator struct alm_t *()
+{
+	void *p = (void *)(*this);
+	return (struct alm_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_almplusplus
@@ -22,12 +22,13 @@
 
 #include "sentence.hpp"
 #include <libnavigate/alr.h>
+#include <string.h>
 #include <string>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Alr_t) : public Message_t
+NAVI_EXTERN_CLASS(Alr_t) NAVI_FINAL : public Message_t
 {
 public:
 	Alr_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -35,31 +36,74 @@ public:
 	virtual ~Alr_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-
-	virtual Utc_t utc() const;
-	virtual int alarmId() const;
-	virtual Status_t condition() const;
-	virtual Status_t acknowledgeState() const;
-	virtual std::string description() const;
+	Utc_t utc() const;
+	int alarmId() const;
+	Status_t condition() const;
+	Status_t acknowledgeState() const;
+	std::string description() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &value);
-	virtual void setAlarmId(int value);
-	virtual void setCondition(const Status_t &value);
-	virtual void setAcknowledgeState(const Status_t &value);
-	virtual void setDescription(const std::string &value);
+	void setUtc(const Utc_t &value);
+	void setAlarmId(int value);
+	void setCondition(const Status_t &value);
+	void setAcknowledgeState(const Status_t &value);
+	void setDescription(const std::string &value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct alr_t *() const;
-	virtual operator struct alr_t *();
+	operator const struct alr_t *() const;
+	operator struct alr_t *();
 };
 
+inline Alr_t::operator const struct alr_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct alr_t *)p;
+}
+
+inline Alr_t::operator struct alr_t *()
+{
+	void *p = (void *)(*this);
+	return (struct alr_t *)p;
+}
+
+inline Utc_t Alr_t::utc() const
+	{ return Utc_t::fromUtcStruct(((const struct alr_t *)(*this))->utc); }
+
+inline int Alr_t::alarmId() const
+	{ return ((const struct alr_t *)(*this))->alarmid; }
+
+inline Status_t Alr_t::condition() const
+	{ return Status_t::fromStatusCode(((const struct alr_t *)(*this))->condition); }
+
+inline Status_t Alr_t::acknowledgeState() const
+	{ return Status_t::fromStatusCode(((const struct alr_t *)(*this))->ackstate); }
+
+inline std::string Alr_t::description() const
+	{ return std::string(((const struct alr_t *)(*this))->description); }
+
+inline void Alr_t::setUtc(const Utc_t &value)
+{
+	((struct alr_t *)(*this))->utc = value.toUtcStruct();
+}
+
+inline void Alr_t::setAlarmId(int value)
+	{ ((struct alr_t *)(*this))->alarmid = value; }
+
+inline void Alr_t::setCondition(const Status_t &value)
+	{ ((struct alr_t *)(*this))->condition = value.toStatusCode(); }
+
+inline void Alr_t::setAcknowledgeState(const Status_t &value)
+	{ ((struct alr_t *)(*this))->ackstate = value.toStatusCode(); }
+
+inline void Alr_t::setDescription(const std::string &value)
+{
+	strncpy(((struct alr_t *)(*this))->description, value.c_str(),
+		sizeof(((const struct alr_t *)(*this))->description));
+}
+
 }
 
 #endif // INCLUDE_navi_alrplusplus
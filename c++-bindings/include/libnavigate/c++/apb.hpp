@@ -22,12 +22,13 @@
 
 #include "sentence.hpp"
 #include <libnavigate/apb.h>
+#include <string.h>
 #include <string>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Apb_t) : public Message_t
+NAVI_EXTERN_CLASS(Apb_t) NAVI_FINAL : public Message_t
 {
 public:
 	Apb_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -35,41 +36,150 @@ public:
 	virtual ~Apb_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-
-	virtual Status_t status0() const;
-	virtual Status_t status1() const;
-	virtual Offset_t xteMagnitude() const;
-	virtual Status_t arrivalCircle() const;
-	virtual Status_t perpendicular() const;
-	virtual Offset_t bearingOrigin() const;
-	virtual std::string waypointId() const;
-	virtual Offset_t bearingPresent() const;
-	virtual Offset_t heading() const;
-	virtual ModeIndicator_t modeIndicator() const;
+	Status_t status0() const;
+	Status_t status1() const;
+	Offset_t xteMagnitude() const;
+	Status_t arrivalCircle() const;
+	Status_t perpendicular() const;
+	Offset_t bearingOrigin() const;
+	std::string waypointId() const;
+	Offset_t bearingPresent() const;
+	Offset_t heading() const;
+	ModeIndicator_t modeIndicator() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setStatus0(const Status_t &value);
-	virtual void setStatus1(const Status_t &value);
-	virtual void setXteMagnitude(const Offset_t &value);
-	virtual void setArrivalCircle(const Status_t &value);
-	virtual void setPerpendicular(const Status_t &value);
-	virtual void setBearingOrigin(const Offset_t &value);
-	virtual void setWaypointId(const std::string &value);
-	virtual void setBearingPresent(const Offset_t &value);
-	virtual void setHeading(const Offset_t &value);
-	virtual void setModeIndicator(const ModeIndicator_t &value);
+	void setStatus0(const Status_t &value);
+	void setStatus1(const Status_t &value);
+	void setXteMagnitude(const Offset_t &value);
+	void setArrivalCircle(const Status_t &value);
+	void setPerpendicular(const Status_t &value);
+	void setBearingOrigin(const Offset_t &value);
+	void setWaypointId(const std::string &value);
+	void setBearingPresent(const Offset_t &value);
+	void setHeading(const Offset_t &value);
+	void setModeIndicator(const ModeIndicator_t &value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct apb_t *() const;
-	virtual operator struct apb_t *();
+	operator const struct apb_t *() const;
+	operator struct apb_t *();
 };
 
+inline Apb_t::operator const struct apb_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct apb_t *)p;
+}
+
+inline Apb_t::operator struct apb_t *()
+{
+	void *p = (void *)(*this);
+	return (struct apb_t *)p;
+}
+
+inline Status_t Apb_t::status0() const
+{
+	return Status_t::fromStatusCode(((const struct apb_t *)(*this))->status_0);
+}
+
+inline Status_t Apb_t::status1() const
+{
+	return Status_t::fromStatusCode(((const struct apb_t *)(*this))->status_1);
+}
+
+inline Offset_t Apb_t::xteMagnitude() const
+{
+	return Offset_t::fromOffset(&((const struct apb_t *)(*this))->xte_magnitude);
+}
+
+inline Status_t Apb_t::arrivalCircle() const
+{
+	return Status_t::fromStatusCode(((const struct apb_t *)(*this))->arrival_circle);
+}
+
+inline Status_t Apb_t::perpendicular() const
+{
+	return Status_t::fromStatusCode(((const struct apb_t *)(*this))->perpendicular);
+}
+
+inline Offset_t Apb_t::bearingOrigin() const
+{
+	return Offset_t::fromOffset(&((const struct apb_t *)(*this))->bearing_origin);
+}
+
+inline std::string Apb_t::waypointId() const
+{
+	return std::string(((const struct apb_t *)(*this))->waypoint_id);
+}
+
+inline Offset_t Apb_t::bearingPresent() const
+{
+	return Offset_t::fromOffset(&((const struct apb_t *)(*this))->bearing_present);
+}
+
+inline Offset_t Apb_t::heading() const
+{
+	return Offset_t::fromOffset(&((const struct apb_t *)(*this))->heading);
+}
+
+inline ModeIndicator_t Apb_t::modeIndicator() const
+{
+	return ModeIndicator_t::fromModeIndCode(((const struct apb_t *)(*this))->mode_indicator);
+}
+
+inline void Apb_t::setStatus0(const Status_t &value)
+{
+	((struct apb_t *)(*this))->status_0 = value.toStatusCode();
+}
+
+inline void Apb_t::setStatus1(const Status_t &value)
+{
+	((struct apb_t *)(*this))->status_1 = value.toStatusCode();
+}
+
+inline void Apb_t::setXteMagnitude(const Offset_t &value)
+{
+	((struct apb_t *)(*this))->xte_magnitude = value.toOffset();
+}
+
+inline void Apb_t::setArrivalCircle(const Status_t &value)
+{
+	((struct apb_t *)(*this))->arrival_circle = value.toStatusCode();
+}
+
+inline void Apb_t::setPerpendicular(const Status_t &value)
+{
+	((struct apb_t *)(*this))->perpendicular = value.toStatusCode();
+}
+
+inline void Apb_t::setBearingOrigin(const Offset_t &value)
+{
+	((struct apb_t *)(*this))->bearing_origin = value.toOffset();
+}
+
+inline void Apb_t::setWaypointId(const std::string &value)
+{
+	(void)strncpy(((struct apb_t *)(*this))->waypoint_id, value.c_str(),
+		sizeof(((struct apb_t *)(*this))->waypoint_id));
+}
+
+inline void Apb_t::setBearingPresent(const Offset_t &value)
+{
+	((struct apb_t *)(*this))->bearing_present = value.toOffset();
+}
+
+inline void Apb_t::setHeading(const Offset_t &value)
+{
+	((struct apb_t *)(*this))->heading = value.toOffset();
+}
+
+inline void Apb_t::setModeIndicator(const ModeIndicator_t &value)
+{
+	((struct apb_t *)(*this))->mode_indicator = value.toModeIndCode();
+}
+
 }
 
 #endif // INCLUDE_navi_apbplusplus
@@ -0,0 +1,195 @@
+/*
+ * arena.hpp - arena of parsed sentences and the allocator of it
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// The arena owns the slabs of the C library arena (see arena.h). The
+// containers keeping the history of the parsed sentences take their
+// memory from it by ArenaAllocator_t, and all of it is released at once
+// per epoch:
+//
+//	Arena_t arena;
+//	std::vector<Rmc_v, ArenaAllocator_t<Rmc_v> > history(arena.allocator<Rmc_v>());
+//
+//	history.reserve(nmepochs);
+//	...
+//	history.clear();
+//	arena.reset();
+//
+// The allocator never frees the single blocks, the memory is released by
+// reset() or by the destructor of the arena. The containers using the
+// arena must be cleared or destroyed before that.
+//
+
+#ifndef INCLUDE_navi_arenaplusplus
+#define INCLUDE_navi_arenaplusplus
+
+#if !(__cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L))
+#error "arena.hpp requires C++11"
+#endif // C++11
+
+#include "errors.hpp"
+#include <libnavigate/arena.h>
+#include <libnavigate/parser.h>
+
+#include <cstddef>
+#include <new>
+
+namespace libnavigate
+{
+
+template <typename T> class ArenaAllocator_t;
+
+class Arena_t
+{
+public:
+	// The slab size 0 means NAVI_ARENA_SLABSIZE. If there is no memory,
+	// throws std::bad_alloc.
+	explicit Arena_t(size_t slabsize = 0)
+		: m_arena(navi_arena_create(slabsize))
+	{
+		if (m_arena == nullptr)
+			throw std::bad_alloc();
+	}
+
+	Arena_t(Arena_t &&right) noexcept
+		: m_arena(right.m_arena) { right.m_arena = nullptr; }
+
+	Arena_t &operator=(Arena_t &&right) noexcept
+	{
+		if (this != &right)
+		{
+			navi_arena_destroy(m_arena);
+			m_arena = right.m_arena;
+			right.m_arena = nullptr;
+		}
+
+		return *this;
+	}
+
+	~Arena_t()
+		{ navi_arena_destroy(m_arena); }
+
+	// Allocates size bytes aligned for any type. If there is no memory,
+	// throws std::bad_alloc.
+	void *allocate(size_t size)
+	{
+		void *result = navi_arena_alloc(m_arena, size);
+
+		if (result == nullptr)
+			throw std::bad_alloc();
+
+		return result;
+	}
+
+	// Parses the approved sentence into the slot of its size, as
+	// navi_arena_parse() does. In case of error throws NaviError_t.
+	struct approved_field_t *parse(char *buffer, size_t maxsize, size_t *nmread)
+	{
+		struct approved_field_t *msg = navi_arena_parse(m_arena, buffer, maxsize, nmread);
+
+		if (msg == nullptr)
+			throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+
+		return msg;
+	}
+
+	// In case of error returns nullptr and sets error, never throws
+	struct approved_field_t *parse(char *buffer, size_t maxsize, size_t *nmread,
+		NaviError_t &error) noexcept
+	{
+		struct approved_field_t *msg = navi_arena_parse(m_arena, buffer, maxsize, nmread);
+
+		if (msg == nullptr)
+			error = NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+
+		return msg;
+	}
+
+	// Frees the slot returned by parse() for the next sentence of its type
+	void free(struct approved_field_t *msg) noexcept
+		{ navi_arena_free_msg(m_arena, msg); }
+
+	// Releases all the memory handed out, keeping the slabs for reuse
+	void reset() noexcept
+		{ navi_arena_reset(m_arena); }
+
+	// The number of bytes handed out since the last reset
+	size_t used() const noexcept
+		{ return navi_arena_used(m_arena); }
+
+	// The total size of the slabs
+	size_t reserved() const noexcept
+		{ return navi_arena_reserved(m_arena); }
+
+	template <typename T>
+	ArenaAllocator_t<T> allocator() noexcept
+		{ return ArenaAllocator_t<T>(*this); }
+
+private:
+	Arena_t(const Arena_t &) = delete;
+	Arena_t &operator=(const Arena_t &) = delete;
+
+	struct navi_arena_t *m_arena;
+};
+
+// The standard allocator taking the memory from the arena
+template <typename T>
+class ArenaAllocator_t
+{
+public:
+	typedef T value_type;
+
+	explicit ArenaAllocator_t(Arena_t &arena) noexcept
+		: m_arena(&arena) { }
+
+	template <typename U>
+	ArenaAllocator_t(const ArenaAllocator_t<U> &right) noexcept
+		: m_arena(right.m_arena) { }
+
+	T *allocate(size_t n)
+	{
+		if (n > size_t(-1) / sizeof(T))
+			throw std::bad_alloc();
+
+		return static_cast<T *>(m_arena->allocate(n * sizeof(T)));
+	}
+
+	// The memory is released by the reset of the arena
+	void deallocate(T *, size_t) noexcept { }
+
+	Arena_t &arena() const noexcept
+		{ return *m_arena; }
+
+	template <typename U>
+	bool operator==(const ArenaAllocator_t<U> &right) const noexcept
+		{ return m_arena == right.m_arena; }
+
+	template <typename U>
+	bool operator!=(const ArenaAllocator_t<U> &right) const noexcept
+		{ return m_arena != right.m_arena; }
+
+private:
+	template <typename U> friend class ArenaAllocator_t;
+
+	Arena_t *m_arena;
+};
+
+}
+
+#endif // INCLUDE_navi_arenaplusplus
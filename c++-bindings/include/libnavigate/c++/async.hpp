@@ -0,0 +1,394 @@
+/*
+ * async.hpp - C++20 coroutine reader of the multiplexed input sources
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// The event loop runs the epoll set of sources (see source.h) and the
+// coroutines reading them. Each source is an asynchronous stream of parsed
+// messages:
+//
+//	Task_t track(Source_t port)
+//	{
+//		while (std::optional<AnyMessage_t> msg = co_await port.next())
+//			std::visit(..., *msg);
+//		// the source is closed or has reached the end of file
+//	}
+//
+//	EventLoop_t loop(1024);
+//	loop.spawn(track(loop.openSerial("/dev/ttyS0", 4800)));
+//	loop.spawn(track(loop.openUdp(NULL, 10110)));
+//	loop.run();
+//
+// The loop and its coroutines live in one thread. To use several threads,
+// run one loop per thread and spread the sources among them.
+//
+
+#ifndef INCLUDE_navi_asyncplusplus
+#define INCLUDE_navi_asyncplusplus
+
+#if !defined(__cpp_impl_coroutine) || (__cpp_impl_coroutine < 201902L)
+#error "async.hpp requires C++20 coroutines"
+#endif // __cpp_impl_coroutine
+
+#include "codec.hpp"
+#include <libnavigate/source.h>
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace libnavigate
+{
+
+//
+// The coroutine started by EventLoop_t::spawn(). Its exception is
+// rethrown from EventLoop_t::run().
+class Task_t
+{
+public:
+	struct promise_type
+	{
+		std::exception_ptr exception;
+
+		Task_t get_return_object()
+			{ return Task_t(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend() noexcept
+			{ return { }; }
+		std::suspend_always final_suspend() noexcept
+			{ return { }; }
+		void return_void() { }
+		void unhandled_exception()
+			{ exception = std::current_exception(); }
+	};
+
+	Task_t(Task_t &&right) noexcept
+		: m_handle(right.m_handle) { right.m_handle = nullptr; }
+
+	~Task_t()
+	{
+		if (m_handle)
+			m_handle.destroy();
+	}
+
+private:
+	friend class EventLoop_t;
+
+	explicit Task_t(std::coroutine_handle<promise_type> handle)
+		: m_handle(handle) { }
+
+	Task_t(const Task_t &) = delete;
+	Task_t &operator=(const Task_t &) = delete;
+
+	std::coroutine_handle<promise_type> m_handle;
+};
+
+namespace detail
+{
+
+// Messages of the source waiting for its reader
+struct SourceState_t
+{
+	int id;
+	bool ended;
+	size_t nmfailed;
+	std::deque<AnyMessage_t> messages;
+	std::coroutine_handle<> waiter;
+};
+
+}
+
+class EventLoop_t;
+
+//
+// The input source as a stream of messages
+class Source_t
+{
+public:
+	class Next_t
+	{
+	public:
+		bool await_ready() const noexcept
+			{ return !m_state->messages.empty() || m_state->ended; }
+
+		void await_suspend(std::coroutine_handle<> handle) noexcept
+			{ m_state->waiter = handle; }
+
+		std::optional<AnyMessage_t> await_resume()
+		{
+			std::optional<AnyMessage_t> result;
+
+			if (!m_state->messages.empty())
+			{
+				result.emplace(std::move(m_state->messages.front()));
+				m_state->messages.pop_front();
+			}
+
+			return result;
+		}
+
+	private:
+		friend class Source_t;
+
+		explicit Next_t(detail::SourceState_t *state)
+			: m_state(state) { }
+
+		detail::SourceState_t *m_state;
+	};
+
+	Source_t() { }
+
+	// Waits for the next parsed message. Returns no message, when
+	// the source is closed or has reached the end of file.
+	Next_t next()
+		{ return Next_t(m_state.get()); }
+
+	// The identifier in the set of sources, or -1 if the source is closed
+	int id() const
+		{ return m_state && !m_state->ended ? m_state->id : -1; }
+
+	// The number of sentences failed to parse
+	size_t nmfailed() const
+		{ return m_state ? m_state->nmfailed : 0; }
+
+private:
+	friend class EventLoop_t;
+
+	explicit Source_t(std::shared_ptr<detail::SourceState_t> state)
+		: m_state(std::move(state)) { }
+
+	std::shared_ptr<detail::SourceState_t> m_state;
+};
+
+//
+// The set of sources with the coroutines reading them
+class EventLoop_t
+{
+public:
+	// Creates the loop for up to maxsources sources. In case of error
+	// throws NaviError_t.
+	explicit EventLoop_t(int maxsources)
+	{
+		m_sources = navi_sources_create(maxsources, &EventLoop_t::onSentence, this);
+		if (m_sources == NULL)
+			throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+	}
+
+	~EventLoop_t()
+	{
+		for (std::coroutine_handle<Task_t::promise_type> task : m_tasks)
+			task.destroy();
+		navi_sources_destroy(m_sources);
+	}
+
+	// Opens the serial port or pty
+	Source_t openSerial(const char *device, int baudrate)
+	{
+		int id;
+
+		if (navi_source_open_serial(m_sources, device, baudrate, &id) != navi_Ok)
+			throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+		return addSource(id);
+	}
+
+	// Opens the file
+	Source_t openFile(const char *filename)
+	{
+		int id;
+
+		if (navi_source_open_file(m_sources, filename, &id) != navi_Ok)
+			throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+		return addSource(id);
+	}
+
+	// Opens the UDP socket
+	Source_t openUdp(const char *address, unsigned short port)
+	{
+		int id;
+
+		if (navi_source_open_udp(m_sources, address, port, &id) != navi_Ok)
+			throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+		return addSource(id);
+	}
+
+	// Adds the descriptor opened by the user
+	Source_t addFd(int fd)
+	{
+		int id;
+
+		if (navi_source_add_fd(m_sources, fd, &id) != navi_Ok)
+			throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+		return addSource(id);
+	}
+
+	// Closes the source. Its reader receives the queued messages and
+	// then the end of the stream.
+	void close(Source_t &source)
+	{
+		detail::SourceState_t *state = source.m_state.get();
+
+		if ((state == nullptr) || state->ended)
+			return;
+
+		(void)navi_source_close(m_sources, state->id);
+		endSource(state->id);
+	}
+
+	// Starts the coroutine. It runs up to the first suspension
+	// at the next call of run() or runOnce().
+	void spawn(Task_t task)
+	{
+		m_tasks.push_back(task.m_handle);
+		m_ready.push_back(task.m_handle);
+		task.m_handle = nullptr;
+	}
+
+	// Resumes the ready coroutines, then waits up to timeout milliseconds
+	// for input and resumes the readers of it. Returns the number of
+	// the coroutines not yet finished.
+	size_t runOnce(int timeout)
+	{
+		resumeReady();
+
+		if (!m_tasks.empty())
+		{
+			if (navi_sources_poll(m_sources, timeout, NULL) != navi_Ok)
+				throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+			resumeReady();
+		}
+
+		return m_tasks.size();
+	}
+
+	// Runs until all the coroutines are finished
+	void run()
+	{
+		while (runOnce(-1) > 0) { }
+	}
+
+private:
+	EventLoop_t(const EventLoop_t &) = delete;
+	EventLoop_t &operator=(const EventLoop_t &) = delete;
+
+	Source_t addSource(int id)
+	{
+		std::shared_ptr<detail::SourceState_t> state = std::make_shared<detail::SourceState_t>();
+
+		state->id = id;
+		state->ended = false;
+		state->nmfailed = 0;
+		m_states[id] = state;
+
+		return Source_t(state);
+	}
+
+	void endSource(int id)
+	{
+		std::map<int, std::shared_ptr<detail::SourceState_t> >::iterator i = m_states.find(id);
+
+		if (i == m_states.end())
+			return;
+
+		i->second->ended = true;
+		wake(*i->second);
+		m_states.erase(i);
+	}
+
+	void wake(detail::SourceState_t &state)
+	{
+		if (state.waiter)
+		{
+			m_ready.push_back(state.waiter);
+			state.waiter = nullptr;
+		}
+	}
+
+	// Resumes the coroutines, deferred out of the callbacks of navi_sources_poll()
+	void resumeReady()
+	{
+		std::exception_ptr exception;
+
+		while (!m_ready.empty())
+		{
+			std::coroutine_handle<> handle = m_ready.front();
+			m_ready.pop_front();
+			handle.resume();
+		}
+
+		for (size_t i = 0; i < m_tasks.size(); )
+		{
+			if (m_tasks[i].done())
+			{
+				if (m_tasks[i].promise().exception && !exception)
+					exception = m_tasks[i].promise().exception;
+
+				m_tasks[i].destroy();
+				m_tasks[i] = m_tasks.back();
+				m_tasks.pop_back();
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+
+	static void onSentence(int source, char *sentence, size_t length, void *context)
+	{
+		EventLoop_t *loop = static_cast<EventLoop_t *>(context);
+		std::map<int, std::shared_ptr<detail::SourceState_t> >::iterator i;
+		AnyMessage_t msg;
+		NaviError_t error;
+		size_t nmread;
+
+		if (sentence == NULL)
+		{
+			loop->endSource(source);
+			return;
+		}
+
+		i = loop->m_states.find(source);
+		if (i == loop->m_states.end())
+			return;
+
+		msg = DecodeAny(sentence, length, &nmread, error);
+		if (std::holds_alternative<std::monostate>(msg))
+		{
+			i->second->nmfailed++;
+			return;
+		}
+
+		i->second->messages.push_back(std::move(msg));
+		loop->wake(*i->second);
+	}
+
+	struct navi_sources_t *m_sources;
+	std::map<int, std::shared_ptr<detail::SourceState_t> > m_states;
+	std::vector<std::coroutine_handle<Task_t::promise_type> > m_tasks;
+	std::deque<std::coroutine_handle<> > m_ready;
+};
+
+}
+
+#endif // INCLUDE_navi_asyncplusplus
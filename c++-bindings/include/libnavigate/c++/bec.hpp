@@ -22,12 +22,13 @@
 
 #include "sentence.hpp"
 #include <libnavigate/bec.h>
+#include <string.h>
 #include <string>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Bec_t) : public Message_t
+NAVI_EXTERN_CLASS(Bec_t) NAVI_FINAL : public Message_t
 {
 public:
 	Bec_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -35,33 +36,102 @@ public:
 	virtual ~Bec_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-
-	virtual Utc_t utc() const;
-	virtual PositionFix_t waypointFix() const;
-	virtual Offset_t bearingTrue() const;
-	virtual Offset_t bearingMagnetic() const;
-	virtual double distance() const;
-	virtual std::string waypointId() const;
+	Utc_t utc() const;
+	PositionFix_t waypointFix() const;
+	Offset_t bearingTrue() const;
+	Offset_t bearingMagnetic() const;
+	double distance() const;
+	std::string waypointId() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &value);
-	virtual void setWaypointFix(const PositionFix_t &value);
-	virtual void setBearingTrue(const Offset_t &value);
-	virtual void setBearingMagnetic(const Offset_t &value);
-	virtual void setDistance(double value);
-	virtual void setWaypointId(const std::string &value);
+	void setUtc(const Utc_t &value);
+	void setWaypointFix(const PositionFix_t &value);
+	void setBearingTrue(const Offset_t &value);
+	void setBearingMagnetic(const Offset_t &value);
+	void setDistance(double value);
+	void setWaypointId(const std::string &value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct bec_t *() const;
-	virtual operator struct bec_t *();
+	operator const struct bec_t *() const;
+	operator struct bec_t *();
 };
 
+inline Bec_t::operator const struct bec_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct bec_t *)p;
+}
+
+inline Bec_t::operator struct bec_t *()
+{
+	void *p = (void *)(*this);
+	return (struct bec_t *)p;
+}
+
+inline Utc_t Bec_t::utc() const
+{
+	return Utc_t::fromUtcStruct(((const struct bec_t *)(*this))->utc);
+}
+
+inline PositionFix_t Bec_t::waypointFix() const
+{
+	return PositionFix_t::fromPosition(&((const struct bec_t *)(*this))->waypointfix);
+}
+
+inline Offset_t Bec_t::bearingTrue() const
+{
+	return Offset_t::fromOffset(&((const struct bec_t *)(*this))->bearingT);
+}
+
+inline Offset_t Bec_t::bearingMagnetic() const
+{
+	return Offset_t::fromOffset(&((const struct bec_t *)(*this))->bearingM);
+}
+
+inline double Bec_t::distance() const
+{
+	return ((const struct bec_t *)(*this))->distance;
+}
+
+inline std::string Bec_t::waypointId() const
+{
+	return std::string(((const struct bec_t *)(*this))->waypoint_id);
+}
+
+inline void Bec_t::setUtc(const Utc_t &value)
+{
+	((struct bec_t *)(*this))->utc = value.toUtcStruct();
+}
+
+inline void Bec_t::setWaypointFix(const PositionFix_t &value)
+{
+	((struct bec_t *)(*this))->waypointfix = value.toPosition();
+}
+
+inline void Bec_t::setBearingTrue(const Offset_t &value)
+{
+	((struct bec_t *)(*this))->bearingT = value.toOffset();
+}
+
+inline void Bec_t::setBearingMagnetic(const Offset_t &value)
+{
+	((struct bec_t *)(*this))->bearingM = value.toOffset();
+}
+
+inline void Bec_t::setDistance(double value)
+{
+	((struct bec_t *)(*this))->distance = value;
+}
+
+inline void Bec_t::setWaypointId(const std::string &value)
+{
+	(void)strncpy(((struct bec_t *)(*this))->waypoint_id, value.c_str(),
+		sizeof(((struct bec_t *)(*this))->waypoint_id));
+}
+
 }
 
 #endif // INCLUDE_navi_becplusplus
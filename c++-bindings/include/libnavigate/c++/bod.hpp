@@ -22,12 +22,13 @@
 
 #include "sentence.hpp"
 #include <libnavigate/bod.h>
+#include <string.h>
 #include <string>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Bod_t) : public Message_t
+NAVI_EXTERN_CLASS(Bod_t) NAVI_FINAL : public Message_t
 {
 public:
 	Bod_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -35,29 +36,79 @@ public:
 	virtual ~Bod_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-
-	virtual Offset_t bearingTrue() const;
-	virtual Offset_t bearingMagnetic() const;
-	virtual std::string destWaypointId() const;
-	virtual std::string origWaypointId() const;
+	Offset_t bearingTrue() const;
+	Offset_t bearingMagnetic() const;
+	std::string destWaypointId() const;
+	std::string origWaypointId() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setBearingTrue(const Offset_t &value);
-	virtual void setBearingMagnetic(const Offset_t &value);
-	virtual void setDestWaypointId(const std::string &value);
-	virtual void setOrigWaypointId(const std::string &value);
+	void setBearingTrue(const Offset_t &value);
+	void setBearingMagnetic(const Offset_t &value);
+	void setDestWaypointId(const std::string &value);
+	void setOrigWaypointId(const std::string &value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct bod_t *() const;
-	virtual operator struct bod_t *();
+	operator const struct bod_t *() const;
+	operator struct bod_t *();
 };
 
+inline Bod_t::operator const struct bod_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct bod_t *)p;
+}
+
+inline Bod_t::operator struct bod_t *()
+{
+	void *p = (void *)(*this);
+	return (struct bod_t *)p;
+}
+
+inline Offset_t Bod_t::bearingTrue() const
+{
+	return Offset_t::fromOffset(&((const struct bod_t *)(*this))->bearingT);
+}
+
+inline Offset_t Bod_t::bearingMagnetic() const
+{
+	return Offset_t::fromOffset(&((const struct bod_t *)(*this))->bearingM);
+}
+
+inline std::string Bod_t::destWaypointId() const
+{
+	return std::string(((const struct bod_t *)(*this))->dest_waypoint);
+}
+
+inline std::string Bod_t::origWaypointId() const
+{
+	return std::string(((const struct bod_t *)(*this))->orig_waypoint);
+}
+
+inline void Bod_t::setBearingTrue(const Offset_t &value)
+{
+	((struct bod_t *)(*this))->bearingT = value.toOffset();
+}
+
+inline void Bod_t::setBearingMagnetic(const Offset_t &value)
+{
+	((struct bod_t *)(*this))->bearingM = value.toOffset();
+}
+
+inline void Bod_t::setDestWaypointId(const std::string &value)
+{
+	(void)strncpy(((struct bod_t *)(*this))->dest_waypoint, value.c_str(),
+		sizeof(((struct bod_t *)(*this))->dest_waypoint));
+}
+
+inline void Bod_t::setOrigWaypointId(const std::string &value)
+{
+	(void)strncpy(((struct bod_t *)(*this))->orig_waypoint, value.c_str(),
+		sizeof(((struct bod_t *)(*this))->orig_waypoint));
+}
+
 }
 
 #endif // INCLUDE_navi_bodplusplus
@@ -22,12 +22,13 @@
 
 #include "sentence.hpp"
 #include <libnavigate/bwc.h>
+#include <string.h>
 #include <string>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Bwc_t) : public Message_t
+NAVI_EXTERN_CLASS(Bwc_t) NAVI_FINAL : public Message_t
 {
 public:
 	Bwc_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -35,35 +36,114 @@ public:
 	virtual ~Bwc_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-
-	virtual Utc_t utc() const;
-	virtual PositionFix_t waypointFix() const;
-	virtual Offset_t bearingTrue() const;
-	virtual Offset_t bearingMagnetic() const;
-	virtual double distance() const;
-	virtual std::string waypointId() const;
-	virtual ModeIndicator_t modeIndicator() const;
+	Utc_t utc() const;
+	PositionFix_t waypointFix() const;
+	Offset_t bearingTrue() const;
+	Offset_t bearingMagnetic() const;
+	double distance() const;
+	std::string waypointId() const;
+	ModeIndicator_t modeIndicator() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &value);
-	virtual void setWaypointFix(const PositionFix_t &value);
-	virtual void setBearingTrue(const Offset_t &value);
-	virtual void setBearingMagnetic(const Offset_t &value);
-	virtual void setDistance(double value);
-	virtual void setWaypointId(const std::string &value);
-	virtual void setModeIndicator(const ModeIndicator_t &value);
+	void setUtc(const Utc_t &value);
+	void setWaypointFix(const PositionFix_t &value);
+	void setBearingTrue(const Offset_t &value);
+	void setBearingMagnetic(const Offset_t &value);
+	void setDistance(double value);
+	void setWaypointId(const std::string &value);
+	void setModeIndicator(const ModeIndicator_t &value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct bwc_t *() const;
-	virtual operator struct bwc_t *();
+	operator const struct bwc_t *() const;
+	operator struct bwc_t *();
 };
 
+inline Bwc_t::operator const struct bwc_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct bwc_t *)p;
+}
+
+inline Bwc_t::operator struct bwc_t *()
+{
+	void *p = (void *)(*this);
+	return (struct bwc_t *)p;
+}
+
+inline Utc_t Bwc_t::utc() const
+{
+	return Utc_t::fromUtcStruct(((const struct bwc_t *)(*this))->utc);
+}
+
+inline PositionFix_t Bwc_t::waypointFix() const
+{
+	return PositionFix_t::fromPosition(&((const struct bwc_t *)(*this))->waypointfix);
+}
+
+inline Offset_t Bwc_t::bearingTrue() const
+{
+	return Offset_t::fromOffset(&((const struct bwc_t *)(*this))->bearingT);
+}
+
+inline Offset_t Bwc_t::bearingMagnetic() const
+{
+	return Offset_t::fromOffset(&((const struct bwc_t *)(*this))->bearingM);
+}
+
+inline double Bwc_t::distance() const
+{
+	return ((const struct bwc_t *)(*this))->distance;
+}
+
+inline std::string Bwc_t::waypointId() const
+{
+	return std::string(((const struct bwc_t *)(*this))->waypoint_id);
+}
+
+inline ModeIndicator_t Bwc_t::modeIndicator() const
+{
+	return ModeIndicator_t::fromModeIndCode(((const struct bwc_t *)(*this))->mi);
+}
+
+inline void Bwc_t::setUtc(const Utc_t &value)
+{
+	((struct bwc_t *)(*this))->utc = value.toUtcStruct();
+}
+
+inline void Bwc_t::setWaypointFix(const PositionFix_t &value)
+{
+	((struct bwc_t *)(*this))->waypointfix = value.toPosition();
+}
+
+inline void Bwc_t::setBearingTrue(const Offset_t &value)
+{
+	((struct bwc_t *)(*this))->bearingT = value.toOffset();
+}
+
+inline void Bwc_t::setBearingMagnetic(const Offset_t &value)
+{
+	((struct bwc_t *)(*this))->bearingM = value.toOffset();
+}
+
+inline void Bwc_t::setDistance(double value)
+{
+	((struct bwc_t *)(*this))->distance = value;
+}
+
+inline void Bwc_t::setWaypointId(const std::string &value)
+{
+	(void)strncpy(((struct bwc_t *)(*this))->waypoint_id, value.c_str(),
+		sizeof(((struct bwc_t *)(*this))->waypoint_id));
+}
+
+inline void Bwc_t::setModeIndicator(const ModeIndicator_t &value)
+{
+	((struct bwc_t *)(*this))->mi = value.toModeIndCode();
+}
+
 }
 
 #endif // INCLUDE_navi_bwcplusplus
@@ -22,12 +22,13 @@
 
 #include "sentence.hpp"
 #include <libnavigate/bwr.h>
+#include <string.h>
 #include <string>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Bwr_t) : public Message_t
+NAVI_EXTERN_CLASS(Bwr_t) NAVI_FINAL : public Message_t
 {
 public:
 	Bwr_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -35,35 +36,114 @@ public:
 	virtual ~Bwr_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-
-	virtual Utc_t utc() const;
-	virtual PositionFix_t waypointFix() const;
-	virtual Offset_t bearingTrue() const;
-	virtual Offset_t bearingMagnetic() const;
-	virtual double distance() const;
-	virtual std::string waypointId() const;
-	virtual ModeIndicator_t modeIndicator() const;
+	Utc_t utc() const;
+	PositionFix_t waypointFix() const;
+	Offset_t bearingTrue() const;
+	Offset_t bearingMagnetic() const;
+	double distance() const;
+	std::string waypointId() const;
+	ModeIndicator_t modeIndicator() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &value);
-	virtual void setWaypointFix(const PositionFix_t &value);
-	virtual void setBearingTrue(const Offset_t &value);
-	virtual void setBearingMagnetic(const Offset_t &value);
-	virtual void setDistance(double value);
-	virtual void setWaypointId(const std::string &value);
-	virtual void setModeIndicator(const ModeIndicator_t &value);
+	void setUtc(const Utc_t &value);
+	void setWaypointFix(const PositionFix_t &value);
+	void setBearingTrue(const Offset_t &value);
+	void setBearingMagnetic(const Offset_t &value);
+	void setDistance(double value);
+	void setWaypointId(const std::string &value);
+	void setModeIndicator(const ModeIndicator_t &value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct bwr_t *() const;
-	virtual operator struct bwr_t *();
+	operator const struct bwr_t *() const;
+	operator struct bwr_t *();
 };
 
+inline Bwr_t::operator const struct bwr_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct bwr_t *)p;
+}
+
+inline Bwr_t::operator struct bwr_t *()
+{
+	void *p = (void *)(*this);
+	return (struct bwr_t *)p;
+}
+
+inline Utc_t Bwr_t::utc() const
+{
+	return Utc_t::fromUtcStruct(((const struct bwr_t *)(*this))->utc);
+}
+
+inline PositionFix_t Bwr_t::waypointFix() const
+{
+	return PositionFix_t::fromPosition(&((const struct bwr_t *)(*this))->waypointfix);
+}
+
+inline Offset_t Bwr_t::bearingTrue() const
+{
+	return Offset_t::fromOffset(&((const struct bwr_t *)(*this))->bearingT);
+}
+
+inline Offset_t Bwr_t::bearingMagnetic() const
+{
+	return Offset_t::fromOffset(&((const struct bwr_t *)(*this))->bearingM);
+}
+
+inline double Bwr_t::distance() const
+{
+	return ((const struct bwr_t *)(*this))->distance;
+}
+
+inline std::string Bwr_t::waypointId() const
+{
+	return std::string(((const struct bwr_t *)(*this))->waypoint_id);
+}
+
+inline ModeIndicator_t Bwr_t::modeIndicator() const
+{
+	return ModeIndicator_t::fromModeIndCode(((const struct bwr_t *)(*this))->mi);
+}
+
+inline void Bwr_t::setUtc(const Utc_t &value)
+{
+	((struct bwr_t *)(*this))->utc = value.toUtcStruct();
+}
+
+inline void Bwr_t::setWaypointFix(const PositionFix_t &value)
+{
+	((struct bwr_t *)(*this))->waypointfix = value.toPosition();
+}
+
+inline void Bwr_t::setBearingTrue(const Offset_t &value)
+{
+	((struct bwr_t *)(*this))->bearingT = value.toOffset();
+}
+
+inline void Bwr_t::setBearingMagnetic(const Offset_t &value)
+{
+	((struct bwr_t *)(*this))->bearingM = value.toOffset();
+}
+
+inline void Bwr_t::setDistance(double value)
+{
+	((struct bwr_t *)(*this))->distance = value;
+}
+
+inline void Bwr_t::setWaypointId(const std::string &value)
+{
+	(void)strncpy(((struct bwr_t *)(*this))->waypoint_id, value.c_str(),
+		sizeof(((struct bwr_t *)(*this))->waypoint_id));
+}
+
+inline void Bwr_t::setModeIndicator(const ModeIndicator_t &value)
+{
+	((struct bwr_t *)(*this))->mi = value.toModeIndCode();
+}
+
 }
 
 #endif // INCLUDE_navi_bwrplusplus
@@ -22,12 +22,13 @@
 
 #include "sentence.hpp"
 #include <libnavigate/bww.h>
+#include <string.h>
 #include <string>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Bww_t) : public Message_t
+NAVI_EXTERN_CLASS(Bww_t) NAVI_FINAL : public Message_t
 {
 public:
 	Bww_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -35,29 +36,79 @@ public:
 	virtual ~Bww_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-
-	virtual Offset_t bearingTrue() const;
-	virtual Offset_t bearingMagnetic() const;
-	virtual std::string toWaypointId() const;
-	virtual std::string fromWaypointId() const;
+	Offset_t bearingTrue() const;
+	Offset_t bearingMagnetic() const;
+	std::string toWaypointId() const;
+	std::string fromWaypointId() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setBearingTrue(const Offset_t &value);
-	virtual void setBearingMagnetic(const Offset_t &value);
-	virtual void setToWaypointId(const std::string &value);
-	virtual void setFromWaypointId(const std::string &value);
+	void setBearingTrue(const Offset_t &value);
+	void setBearingMagnetic(const Offset_t &value);
+	void setToWaypointId(const std::string &value);
+	void setFromWaypointId(const std::string &value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct bww_t *() const;
-	virtual operator struct bww_t *();
+	operator const struct bww_t *() const;
+	operator struct bww_t *();
 };
 
+inline Bww_t::operator const struct bww_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct bww_t *)p;
+}
+
+inline Bww_t::operator struct bww_t *()
+{
+	void *p = (void *)(*this);
+	return (struct bww_t *)p;
+}
+
+inline Offset_t Bww_t::bearingTrue() const
+{
+	return Offset_t::fromOffset(&((const struct bww_t *)(*this))->bearingT);
+}
+
+inline Offset_t Bww_t::bearingMagnetic() const
+{
+	return Offset_t::fromOffset(&((const struct bww_t *)(*this))->bearingM);
+}
+
+inline std::string Bww_t::toWaypointId() const
+{
+	return std::string(((const struct bww_t *)(*this))->to_waypoint);
+}
+
+inline std::string Bww_t::fromWaypointId() const
+{
+	return std::string(((const struct bww_t *)(*this))->from_waypoint);
+}
+
+inline void Bww_t::setBearingTrue(const Offset_t &value)
+{
+	((struct bww_t *)(*this))->bearingT = value.toOffset();
+}
+
+inline void Bww_t::setBearingMagnetic(const Offset_t &value)
+{
+	((struct bww_t *)(*this))->bearingM = value.toOffset();
+}
+
+inline void Bww_t::setToWaypointId(const std::string &value)
+{
+	(void)strncpy(((struct bww_t *)(*this))->to_waypoint, value.c_str(),
+		sizeof(((struct bww_t *)(*this))->to_waypoint));
+}
+
+inline void Bww_t::setFromWaypointId(const std::string &value)
+{
+	(void)strncpy(((struct bww_t *)(*this))->from_waypoint, value.c_str(),
+		sizeof(((struct bww_t *)(*this))->from_waypoint));
+}
+
 }
 
 #endif // INCLUDE_navi_bwwplusplus
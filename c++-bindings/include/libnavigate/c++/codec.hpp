@@ -0,0 +1,1502 @@
+/*
+ * codec.hpp - header-only C++17 sentence codec generated from field lists
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Each sentence is described by the compile-time list of its fields:
+// the member of the C structure, the codec of the field type, whether
+// a null field is allowed, and the validity flag to set. The parser and
+// the generator are instantiated from the list, so every field is parsed
+// inline, in order, without the per-sentence function of the C library.
+//
+// The results are the same as of navi_parse_msg() and navi_create_msg().
+// The field lists of the sentences of schema.def are expanded from it.
+// The sentences without the field list, i.e. all but RMC, GGA and those
+// of the schema so far, go through the C library.
+//
+
+#ifndef INCLUDE_navi_codecplusplus
+#define INCLUDE_navi_codecplusplus
+
+#include "typed.hpp"
+#include <libnavigate/config.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <charconv>
+
+namespace libnavigate
+{
+
+namespace codec
+{
+
+// The field parsers return the error class, navi_Undefined on success
+typedef navierr_class_t fieldresult_t;
+
+inline bool isDigit(int c)
+	{ return (c >= '0') && (c <= '9'); }
+
+inline bool isFieldEnd(int c)
+	{ return (c == ',') || (c == '*'); }
+
+inline int hexValue(int c)
+{
+	if ((c >= '0') && (c <= '9'))
+		return c - '0';
+	else if ((c >= 'A') && (c <= 'F'))
+		return c - 'A' + 10;
+	else if ((c >= 'a') && (c <= 'f'))
+		return c - 'a' + 10;
+	return -1;
+}
+
+//
+// 10^-k, k >= 1, the same as pow(10., -k) in the C parser
+inline double negativePow10(int k)
+{
+	static const double table[] =
+	{
+		1e0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8, 1e-9, 1e-10, 1e-11,
+		1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18, 1e-19, 1e-20, 1e-21, 1e-22
+	};
+
+	return k < int(sizeof(table) / sizeof(table[0])) ? table[k] : pow(10., -k);
+}
+
+//
+// Prints the unsigned integer with at least width digits, as "%0*u"
+inline char *printUnsigned(unsigned int value, int width, char *out, char *end)
+{
+	char digits[16];
+	int n = 0;
+
+	do
+	{
+		digits[n++] = char('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	while (n < width)
+		digits[n++] = '0';
+
+	if (end - out < n)
+		return nullptr;
+
+	while (n > 0)
+		*out++ = digits[--n];
+
+	return out;
+}
+
+//
+// Prints the number as "%0*.*f" and removes the trailing zeroes,
+// as remove_trailing_zeroes() does
+inline char *printFixed(double value, int precision, int width, char *out, char *end)
+{
+	char *p, *digits;
+	size_t length, pad;
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+	std::to_chars_result result = std::to_chars(out, end, value,
+		std::chars_format::fixed, precision);
+	if (result.ec != std::errc())
+		return nullptr;
+	p = result.ptr;
+#else
+	int result = snprintf(out, end - out, "%.*f", precision, value);
+	if ((result < 0) || (result >= end - out))
+		return nullptr;
+	p = out + result;
+#endif // __cpp_lib_to_chars
+
+	length = size_t(p - out);
+	if (length < size_t(width))
+	{
+		if (end - out < width)
+			return nullptr;
+
+		pad = size_t(width) - length;
+		digits = out + (*out == '-' ? 1 : 0);
+		memmove(digits + pad, digits, size_t(p - digits));
+		memset(digits, '0', pad);
+		p = out + width;
+	}
+
+	while (p > out)
+	{
+		if (p[-1] == '0')
+		{
+			p--;
+		}
+		else
+		{
+			if (p[-1] == '.')
+				p--;
+			break;
+		}
+	}
+
+	return p;
+}
+
+inline char *printString(const char *s, char *out, char *end)
+{
+	size_t length = strlen(s);
+
+	if (size_t(end - out) < length)
+		return nullptr;
+
+	memcpy(out, s, length);
+	return out + length;
+}
+
+//
+// Field codecs. parse() moves the pointer past the field terminator,
+// print() returns the end of the printed field or nullptr, if there is
+// no room.
+//
+
+// Variable length number 'x.x'
+struct Number_c
+{
+	typedef double value_t;
+
+	static fieldresult_t parse(const char *&p, double &value)
+	{
+		int c, j = 1, s = 1;
+		double d = 0.0;
+
+		value = nan("");
+
+		c = *p++;
+		if (isFieldEnd(c))
+			return navi_NullField;
+		else if (c == '-')
+			s = -1;
+		else if (isDigit(c))
+			d = c - '0';
+		else if (c == '.')
+			goto _Fraction;
+		else if (c != '+')
+			return navi_InvalidMessage;
+
+		for ( ; ; )
+		{
+			c = *p++;
+			if (isDigit(c))
+				d = d * 10. + (c - '0');
+			else if (c == '.')
+				break;
+			else if (isFieldEnd(c))
+				goto _Exit;
+			else
+				return navi_InvalidMessage;
+		}
+
+	_Fraction:
+		for ( ; ; )
+		{
+			c = *p++;
+			if (isDigit(c))
+				d = d + negativePow10(j++) * (c - '0');
+			else if (isFieldEnd(c))
+				break;
+			else
+				return navi_InvalidMessage;
+		}
+
+	_Exit:
+		value = s * d;
+		return navi_Undefined;
+	}
+
+	static char *print(double value, bool, char *out, char *end)
+	{
+		if (isnan(value))
+			return out;
+		return printFixed(value, naviconf_get_presicion(), 0, out, end);
+	}
+};
+
+// Integer parsed as a number and rounded, printed as a number
+struct RoundedInt_c
+{
+	typedef int value_t;
+
+	static fieldresult_t parse(const char *&p, int &value)
+	{
+		double d;
+		fieldresult_t result = Number_c::parse(p, d);
+
+		if (result == navi_Undefined)
+			value = int(round(d));
+		return result;
+	}
+
+	static char *print(int value, bool valid, char *out, char *end)
+		{ return Number_c::print(double(value), valid, out, end); }
+};
+
+// UTC time 'hhmmss.ss'
+struct Utc_c
+{
+	typedef struct navi_utc_t value_t;
+
+	static fieldresult_t parse(const char *&p, struct navi_utc_t &utc)
+	{
+		int c, k, j = 1;
+		double d;
+
+		utc.hour = 0;
+		utc.min = 0;
+		utc.sec = nan("");
+
+		c = *p++;
+		if (isFieldEnd(c))
+			return navi_NullField;
+		if (!isDigit(c) || !isDigit(p[0]) || !isDigit(p[1]) || !isDigit(p[2]) ||
+			!isDigit(p[3]) || !isDigit(p[4]))
+		{
+			return navi_InvalidMessage;
+		}
+
+		utc.hour = (c - '0') * 10 + (p[0] - '0');
+		utc.min = (p[1] - '0') * 10 + (p[2] - '0');
+		d = double(p[3] - '0');
+		d = d * 10. + (p[4] - '0');
+		utc.sec = d;
+		p += 5;
+
+		c = *p++;
+		if (isFieldEnd(c))
+			return navi_Undefined;
+		else if (c != '.')
+			return navi_InvalidMessage;
+
+		for (k = 0; ; k++)
+		{
+			c = *p++;
+			if (isDigit(c))
+				d = d + negativePow10(j++) * (c - '0');
+			else if (isFieldEnd(c))
+				break;
+			else
+				return navi_InvalidMessage;
+		}
+
+		utc.sec = d;
+		return navi_Undefined;
+	}
+
+	static char *print(const struct navi_utc_t &utc, bool, char *out, char *end)
+	{
+		int precision;
+
+		if (isnan(utc.sec))
+			return out;
+
+		precision = naviconf_get_presicion();
+
+		if ((out = printUnsigned(unsigned(utc.hour % 24), 2, out, end)) == nullptr)
+			return nullptr;
+		if ((out = printUnsigned(unsigned(utc.min % 60), 2, out, end)) == nullptr)
+			return nullptr;
+		return printFixed(utc.sec, precision, precision + 3, out, end);
+	}
+};
+
+// Status 'A' or 'V'
+struct Status_c
+{
+	typedef navi_status_t value_t;
+
+	static fieldresult_t parse(const char *&p, navi_status_t &status)
+	{
+		int c = *p++;
+
+		if ((c == 'A') || (c == 'V'))
+		{
+			status = c == 'A' ? navi_status_A : navi_status_V;
+			return isFieldEnd(*p++) ? navi_Undefined : navi_InvalidMessage;
+		}
+
+		return isFieldEnd(c) ? navi_NullField : navi_InvalidMessage;
+	}
+
+	static char *print(navi_status_t status, bool, char *out, char *end)
+	{
+		if (status == navi_status_A)
+			return printString("A", out, end);
+		else if (status == navi_status_V)
+			return printString("V", out, end);
+		return out;
+	}
+};
+
+// Mode indicator 'A', 'D', 'E', 'M', 'S' or 'N'
+struct ModeIndicator_c
+{
+	typedef navi_modeindicator_t value_t;
+
+	static fieldresult_t parse(const char *&p, navi_modeindicator_t &mi)
+	{
+		int c = *p++;
+
+		switch (c)
+		{
+		case 'A': mi = navi_Autonomous; break;
+		case 'D': mi = navi_Differential; break;
+		case 'E': mi = navi_Estimated; break;
+		case 'M': mi = navi_ManualInput; break;
+		case 'S': mi = navi_Simulator; break;
+		case 'N': mi = navi_DataNotValid; break;
+		default:
+			return isFieldEnd(c) ? navi_NullField : navi_InvalidMessage;
+		}
+
+		return isFieldEnd(*p++) ? navi_Undefined : navi_InvalidMessage;
+	}
+
+	static char *print(navi_modeindicator_t mi, bool, char *out, char *end)
+	{
+		const char *s = navi_modeindicator_str(mi);
+		return s != NULL ? printString(s, out, end) : out;
+	}
+};
+
+// Date 'ddmmyy'
+struct Date_c
+{
+	typedef struct navi_date_t value_t;
+
+	static fieldresult_t parse(const char *&p, struct navi_date_t &date)
+	{
+		int i, c;
+
+		for (i = 0; ; i++)
+		{
+			c = p[i];
+
+			if (isDigit(c))
+			{
+				if (i == 0)
+					date.day = c - '0';
+				else if (i == 1)
+					date.day = date.day * 10 + (c - '0');
+				else if (i == 2)
+					date.month = c - '0';
+				else if (i == 3)
+					date.month = date.month * 10 + (c - '0');
+				else if (i == 4)
+					date.year = c - '0';
+				else if ((i >= 5) && (i <= 7))
+					date.year = date.year * 10 + (c - '0');
+				else
+					break;
+			}
+			else if (isFieldEnd(c))
+			{
+				break;
+			}
+			else
+			{
+				return navi_InvalidMessage;
+			}
+		}
+
+		p += i + 1;
+
+		if (i == 0)
+			return navi_NullField;
+		else if ((i < 6) || (i >= 8))
+			return navi_InvalidMessage;
+		return navi_Undefined;
+	}
+
+	static char *print(const struct navi_date_t &date, bool valid, char *out, char *end)
+	{
+		if (!valid)
+			return out;
+
+		if ((out = printUnsigned(unsigned(date.day), 2, out, end)) == nullptr)
+			return nullptr;
+		if ((out = printUnsigned(unsigned(date.month), 2, out, end)) == nullptr)
+			return nullptr;
+		return printUnsigned(unsigned(date.year % 100), 2, out, end);
+	}
+};
+
+// Offset 'x.x,a'
+struct Offset_c
+{
+	typedef struct navi_offset_t value_t;
+
+	static fieldresult_t parse(const char *&p, struct navi_offset_t &offset)
+	{
+		int c, j = 1;
+		double t = 0.0;
+		navi_offset_sign_t s;
+
+		offset.offset = nan("");
+		offset.sign = navi_offset_NULL;
+
+		c = *p++;
+		if (c == ',')
+			return isFieldEnd(*p++) ? navi_NullField : navi_InvalidMessage;
+		else if (isDigit(c))
+			t = c - '0';
+		else if (c != '.')
+			return navi_InvalidMessage;
+
+		if (c != '.')
+		{
+			for ( ; ; )
+			{
+				c = *p++;
+				if (isDigit(c))
+					t = t * 10. + (c - '0');
+				else if ((c == '.') || (c == ','))
+					break;
+				else
+					return navi_InvalidMessage;
+			}
+		}
+
+		if (c == '.')
+		{
+			for ( ; ; )
+			{
+				c = *p++;
+				if (isDigit(c))
+					t = t + negativePow10(j++) * (c - '0');
+				else if (c == ',')
+					break;
+				else
+					return navi_InvalidMessage;
+			}
+		}
+
+		switch (*p++)
+		{
+		case 'N': s = navi_North; break;
+		case 'S': s = navi_South; break;
+		case 'E': s = navi_East; break;
+		case 'W': s = navi_West; break;
+		case 'L': s = navi_Left; break;
+		case 'R': s = navi_Right; break;
+		case 'T': s = navi_True; break;
+		case 'M': s = navi_Magnetic; break;
+		default:
+			return navi_InvalidMessage;
+		}
+
+		if (!isFieldEnd(*p++))
+			return navi_InvalidMessage;
+
+		offset.offset = t;
+		offset.sign = s;
+		return navi_Undefined;
+	}
+
+	static char *print(const struct navi_offset_t &offset, bool, char *out, char *end)
+	{
+		if ((offset.sign == navi_offset_NULL) || isnan(offset.offset))
+			return printString(",", out, end);
+
+		if ((out = Number_c::print(offset.offset, true, out, end)) == nullptr)
+			return nullptr;
+		if ((out = printString(",", out, end)) == nullptr)
+			return nullptr;
+		return printString(navi_fixsign_str(offset.sign), out, end);
+	}
+};
+
+// Position fix 'llll.ll,a,yyyyy.yy,a'
+struct Position_c
+{
+	typedef struct navi_position_t value_t;
+
+	// Parses 'DDmm.mm,' or 'DDDmm.mm,' with ndeg digits of degrees
+	static bool parseAngle(const char *&p, int ndeg, double &angle)
+	{
+		int c, k, j = 1;
+		double deg, min = 0.0;
+
+		// the first digit is checked by the caller, as in the C parser
+		deg = p[0] - '0';
+		for (k = 1; k < ndeg; k++)
+		{
+			if (!isDigit(p[k]))
+				return false;
+			deg = deg * 10. + (p[k] - '0');
+		}
+		for (k = ndeg; k < ndeg + 2; k++)
+		{
+			if (!isDigit(p[k]))
+				return false;
+			min = min * 10. + (p[k] - '0');
+		}
+		p += ndeg + 2;
+
+		c = *p++;
+		if (c == '.')
+		{
+			for ( ; ; )
+			{
+				c = *p++;
+				if (isDigit(c))
+					min = min + negativePow10(j++) * (c - '0');
+				else if (c == ',')
+					break;
+				else
+					return false;
+			}
+		}
+		else if (c != ',')
+		{
+			return false;
+		}
+
+		angle = deg + min / 60.;
+		return true;
+	}
+
+	static fieldresult_t parse(const char *&p, struct navi_position_t &fix)
+	{
+		fix.latitude.offset = nan("");
+		fix.latitude.sign = navi_offset_NULL;
+		fix.longitude.offset = nan("");
+		fix.longitude.sign = navi_offset_NULL;
+
+		if (p[0] == ',')
+		{	// ',,,' and the terminator
+			if ((p[1] != ',') || (p[2] != ','))
+				return navi_InvalidMessage;
+			p += 4;
+			return isFieldEnd(p[-1]) ? navi_NullField : navi_InvalidMessage;
+		}
+
+		if (!isDigit(p[0]) || !parseAngle(p, 2, fix.latitude.offset))
+			return navi_InvalidMessage;
+
+		if (p[0] == 'N')
+			fix.latitude.sign = navi_North;
+		else if (p[0] == 'S')
+			fix.latitude.sign = navi_South;
+		else
+			return navi_InvalidMessage;
+		if (p[1] != ',')
+			return navi_InvalidMessage;
+		p += 2;
+
+		if (!parseAngle(p, 3, fix.longitude.offset))
+			return navi_InvalidMessage;
+
+		if (p[0] == 'E')
+			fix.longitude.sign = navi_East;
+		else if (p[0] == 'W')
+			fix.longitude.sign = navi_West;
+		else
+			return navi_InvalidMessage;
+		p += 2;
+
+		return isFieldEnd(p[-1]) ? navi_Undefined : navi_InvalidMessage;
+	}
+
+	static char *printAngle(const struct navi_offset_t &angle, int width,
+		int precision, char *out, char *end)
+	{
+		double degrees, fraction;
+
+		fraction = modf(angle.offset, &degrees);
+		fraction = fraction * 60.0 + degrees * 100.0;
+
+		if ((out = printFixed(fraction, precision, width, out, end)) == nullptr)
+			return nullptr;
+		if ((out = printString(",", out, end)) == nullptr)
+			return nullptr;
+		return printString(navi_fixsign_str(angle.sign), out, end);
+	}
+
+	static char *print(const struct navi_position_t &fix, bool, char *out, char *end)
+	{
+		int precision;
+
+		if ((fix.latitude.sign == navi_offset_NULL) || isnan(fix.latitude.offset) ||
+			(fix.longitude.sign == navi_offset_NULL) || isnan(fix.longitude.offset))
+		{
+			return printString(",,,", out, end);
+		}
+
+		precision = naviconf_get_presicion();
+
+		if ((out = printAngle(fix.latitude, precision + 5, precision, out, end)) == nullptr)
+			return nullptr;
+		if ((out = printString(",", out, end)) == nullptr)
+			return nullptr;
+		return printAngle(fix.longitude, precision + 6, precision, out, end);
+	}
+};
+
+// Fixed width decimal or hexadecimal digits, composed as a decimal
+// number, with -1 for the null field, if Nullable
+template <int Width, int Radix, bool Nullable>
+struct Digits_c
+{
+	typedef int value_t;
+
+	template <typename V>
+	static fieldresult_t parse(const char *&p, V &value)
+	{
+		int k, d, result = 0;
+
+		if (isFieldEnd(p[0]))
+		{
+			p += 1;
+			return navi_NullField;
+		}
+
+		for (k = 0; k < Width; k++)
+		{
+			d = Radix == 16 ? hexValue(p[k]) : (isDigit(p[k]) ? p[k] - '0' : -1);
+			if (d < 0)
+				return navi_InvalidMessage;
+			result = result * 10 + d;
+		}
+
+		if (!isFieldEnd(p[Width]))
+			return navi_InvalidMessage;
+
+		p += Width + 1;
+		value = V(result);
+		return navi_Undefined;
+	}
+
+	static char *print(int value, bool, char *out, char *end)
+	{
+		int k;
+		unsigned int v = unsigned(value);
+
+		if (Nullable && (value == -1))
+			return out;
+		if (end - out < Width)
+			return nullptr;
+
+		for (k = Width - 1; k >= 0; k--)
+		{
+			out[k] = char('0' + v % 10);
+			v /= 10;
+		}
+
+		return out + Width;
+	}
+};
+
+// Integer parsed as a number and printed as fixed width digits
+template <int Width>
+struct RoundedDigits_c
+{
+	typedef int value_t;
+
+	static fieldresult_t parse(const char *&p, int &value)
+		{ return RoundedInt_c::parse(p, value); }
+
+	static char *print(int value, bool valid, char *out, char *end)
+		{ return Digits_c<Width, 10, true>::print(value, valid, out, end); }
+};
+
+//
+// Field descriptors
+//
+
+enum nullpolicy_t
+{
+	Optional,	// null field is allowed
+	Required,	// null field fails the sentence with the field error
+	Mandatory	// null or invalid field fails the sentence as invalid
+};
+
+template <auto Member, typename Codec, int Policy = Optional, unsigned int Valid = 0>
+struct Field_t
+{
+	template <typename T>
+	static fieldresult_t parse(const char *&p, T &msg)
+	{
+		fieldresult_t result = Codec::parse(p, msg.*Member);
+
+		if (result == navi_Undefined)
+		{
+			if constexpr (Valid != 0)
+				msg.vfields |= Valid;
+			return navi_Undefined;
+		}
+		else if ((result == navi_NullField) && (Policy == Optional))
+		{
+			return navi_Undefined;
+		}
+
+		return Policy == Mandatory ? navi_InvalidMessage : result;
+	}
+
+	template <typename T>
+	static char *print(const T &msg, char *out, char *end)
+	{
+		bool valid = true;
+
+		if constexpr (Valid != 0)
+			valid = (msg.vfields & Valid) != 0;
+
+		return Codec::print(msg.*Member, valid, out, end);
+	}
+};
+
+// The unit after a number, e.g. 'M' for meters, skipped while parsing
+template <char Unit>
+struct Unit_t
+{
+	template <typename T>
+	static fieldresult_t parse(const char *&p, T &)
+	{
+		p += 2;
+		return navi_Undefined;
+	}
+
+	template <typename T>
+	static char *print(const T &, char *out, char *end)
+	{
+		if (out >= end)
+			return nullptr;
+
+		*out++ = Unit;
+		return out;
+	}
+};
+
+template <typename... Fields>
+struct Fields_t
+{
+	// the error, if the fields do not fit into the sentence
+	static constexpr fieldresult_t overflow = navi_MsgExceedsMaxSize;
+
+	template <typename T>
+	static fieldresult_t parse(const char *p, T &msg)
+	{
+		fieldresult_t result = navi_Undefined;
+
+		(void)((((result = Fields::parse(p, msg)) == navi_Undefined)) && ...);
+		return result;
+	}
+
+	template <typename T>
+	static char *print(const T &msg, char *out, char *end)
+	{
+		bool first = true;
+
+		(void)(((out = printNext<Fields>(msg, out, end, first)) != nullptr) && ...);
+		return out;
+	}
+
+	// The values are checked by print()
+	template <typename T>
+	static fieldresult_t check(const T &)
+		{ return navi_Undefined; }
+
+private:
+	template <typename F, typename T>
+	static char *printNext(const T &msg, char *out, char *end, bool &first)
+	{
+		if (!first)
+		{
+			if (out >= end)
+				return nullptr;
+			*out++ = ',';
+		}
+		first = false;
+
+		return F::print(msg, out, end);
+	}
+};
+
+//
+// Field lists of the sentences
+//
+
+template <typename T> struct SentenceCodec_t;
+
+template <>
+struct SentenceCodec_t<struct rmc_t>
+{
+	static void init(struct rmc_t &msg)
+		{ navi_init_rmc(&msg); }
+
+	typedef Fields_t<
+		Field_t<&rmc_t::utc, Utc_c>,
+		Field_t<&rmc_t::status, Status_c, Mandatory>,
+		Field_t<&rmc_t::fix, Position_c>,
+		Field_t<&rmc_t::speedN, Number_c>,
+		Field_t<&rmc_t::courseT, Number_c>,
+		Field_t<&rmc_t::date, Date_c, Optional, RMC_VALID_DATE>,
+		Field_t<&rmc_t::magnVariation, Offset_c>,
+		Field_t<&rmc_t::mi, ModeIndicator_c, Mandatory> > fields_t;
+};
+
+template <>
+struct SentenceCodec_t<struct gga_t>
+{
+	static void init(struct gga_t &msg)
+		{ navi_init_gga(&msg); }
+
+	typedef Fields_t<
+		Field_t<&gga_t::utc, Utc_c>,
+		Field_t<&gga_t::fix, Position_c>,
+		Field_t<&gga_t::gpsindicator, Digits_c<1, 10, false>, Required>,
+		Field_t<&gga_t::nmsatellites, Digits_c<2, 16, true> >,
+		Field_t<&gga_t::hdop, Number_c>,
+		Field_t<&gga_t::antaltitude, Number_c>,
+		Unit_t<'M'>,
+		Field_t<&gga_t::geoidalsep, Number_c>,
+		Unit_t<'M'>,
+		Field_t<&gga_t::diffdata_age, RoundedInt_c>,
+		Field_t<&gga_t::station_id, RoundedDigits_c<4> > > fields_t;
+};
+
+//
+// Field codecs of the schema kinds, the same as in schema.c. Arg::value
+// is the argument of the field in schema.def.
+//
+
+template <typename Arg>
+struct SchemaNumber_c
+{
+	static fieldresult_t parse(const char *&p, double &value)
+		{ return Number_c::parse(p, value); }
+
+	static fieldresult_t check(double)
+		{ return navi_Undefined; }
+
+	static char *print(double value, char *out, char *end)
+		{ return Number_c::print(value, true, out, end); }
+};
+
+// Number and the unit letter Arg::value, the unit is optional
+template <typename Arg>
+struct SchemaMeasure_c
+{
+	static fieldresult_t parse(const char *&p, double &value)
+	{
+		fieldresult_t result = Number_c::parse(p, value);
+
+		if ((result != navi_Undefined) && (result != navi_NullField))
+			return result;
+
+		// the unit field, if the sentence does not end with the number
+		if (p[-1] == ',')
+		{
+			if (*p == Arg::value[0])
+				p++;
+			if (!isFieldEnd(*p++))
+				return navi_InvalidMessage;
+		}
+
+		return result;
+	}
+
+	static fieldresult_t check(double)
+		{ return navi_Undefined; }
+
+	static char *print(double value, char *out, char *end)
+	{
+		if ((out = Number_c::print(value, true, out, end)) == nullptr)
+			return nullptr;
+		if ((out = printString(",", out, end)) == nullptr)
+			return nullptr;
+		return isnan(value) ? out : printString(Arg::value, out, end);
+	}
+};
+
+// Unlike Offset_c, prints the sign of the null offset
+template <typename Arg>
+struct SchemaOffset_c
+{
+	static fieldresult_t parse(const char *&p, struct navi_offset_t &value)
+		{ return Offset_c::parse(p, value); }
+
+	static fieldresult_t check(const struct navi_offset_t &)
+		{ return navi_Undefined; }
+
+	static char *print(const struct navi_offset_t &value, char *out, char *end)
+	{
+		if (value.sign == navi_offset_NULL)
+			return printString(",", out, end);
+
+		if ((out = Number_c::print(value.offset, true, out, end)) == nullptr)
+			return nullptr;
+		if ((out = printString(",", out, end)) == nullptr)
+			return nullptr;
+		return printString(navi_fixsign_str(value.sign), out, end);
+	}
+};
+
+template <typename Arg>
+struct SchemaStatus_c
+{
+	static fieldresult_t parse(const char *&p, navi_status_t &value)
+		{ return Status_c::parse(p, value); }
+
+	static fieldresult_t check(navi_status_t value)
+		{ return navi_status_str(value) == NULL ? navi_InvalidParameter : navi_Undefined; }
+
+	static char *print(navi_status_t value, char *out, char *end)
+		{ return Status_c::print(value, true, out, end); }
+};
+
+// One of the letters of Arg::value, '\0' if null
+template <typename Arg>
+struct SchemaCharacter_c
+{
+	static fieldresult_t parse(const char *&p, char &value)
+	{
+		if (isFieldEnd(p[0]))
+		{
+			p += 1;
+			return navi_NullField;
+		}
+
+		if ((strchr(Arg::value, p[0]) == NULL) || !isFieldEnd(p[1]))
+			return navi_InvalidMessage;
+
+		value = p[0];
+		p += 2;
+		return navi_Undefined;
+	}
+
+	static fieldresult_t check(char value)
+	{
+		return (value != '\0') && (strchr(Arg::value, value) == NULL) ?
+			navi_InvalidParameter : navi_Undefined;
+	}
+
+	static char *print(char value, char *out, char *end)
+	{
+		if (value == '\0')
+			return out;
+		if (out >= end)
+			return nullptr;
+
+		*out++ = value;
+		return out;
+	}
+};
+
+namespace schemakind
+{
+	template <typename Arg> using number = SchemaNumber_c<Arg>;
+	template <typename Arg> using measure = SchemaMeasure_c<Arg>;
+	template <typename Arg> using offset = SchemaOffset_c<Arg>;
+	template <typename Arg> using status = SchemaStatus_c<Arg>;
+	template <typename Arg> using character = SchemaCharacter_c<Arg>;
+}
+
+template <auto Member, typename Codec>
+struct SchemaField_t
+{
+	template <typename T>
+	static fieldresult_t parse(const char *&p, T &msg)
+		{ return Codec::parse(p, msg.*Member); }
+
+	template <typename T>
+	static fieldresult_t check(const T &msg)
+		{ return Codec::check(msg.*Member); }
+
+	template <typename T>
+	static char *print(const T &msg, char *out, char *end)
+		{ return Codec::print(msg.*Member, out, end); }
+};
+
+// Closes the field list expanded from schema.def
+struct SchemaEnd_t { };
+
+//
+// Fields of the schema sentence. As in schema.c, the null fields are
+// allowed, the fields missing at the end of the sentence are left null,
+// and the printed fields keep room for the terminating null character.
+template <typename... Fields>
+struct SchemaFields_t
+{
+	static constexpr fieldresult_t overflow = navi_NotEnoughBuffer;
+
+	template <typename T>
+	static fieldresult_t parse(const char *p, T &msg)
+	{
+		const char *start = p;
+		fieldresult_t result = navi_Undefined;
+
+		(void)((((result = parseNext<Fields>(p, start, msg)) == navi_Undefined)) && ...);
+		return result;
+	}
+
+	template <typename T>
+	static fieldresult_t check(const T &msg)
+	{
+		fieldresult_t result = navi_Undefined;
+
+		(void)((((result = checkNext<Fields>(msg)) == navi_Undefined)) && ...);
+		return result;
+	}
+
+	template <typename T>
+	static char *print(const T &msg, char *out, char *end)
+	{
+		bool first = true;
+
+		end -= 1;
+		(void)(((out = printNext<Fields>(msg, out, end, first)) != nullptr) && ...);
+		return out;
+	}
+
+private:
+	template <typename F, typename T>
+	static fieldresult_t parseNext(const char *&p, const char *start, T &msg)
+	{
+		fieldresult_t result;
+
+		if constexpr (std::is_same_v<F, SchemaEnd_t>)
+		{
+			return navi_Undefined;
+		}
+		else
+		{
+			if ((p != start) && (p[-1] == '*'))
+				return navi_Undefined;
+
+			result = F::parse(p, msg);
+			return result == navi_NullField ? navi_Undefined : result;
+		}
+	}
+
+	template <typename F, typename T>
+	static fieldresult_t checkNext(const T &msg)
+	{
+		if constexpr (std::is_same_v<F, SchemaEnd_t>)
+			return navi_Undefined;
+		else
+			return F::check(msg);
+	}
+
+	template <typename F, typename T>
+	static char *printNext(const T &msg, char *out, char *end, bool &first)
+	{
+		if constexpr (std::is_same_v<F, SchemaEnd_t>)
+		{
+			return out;
+		}
+		else
+		{
+			if (!first)
+			{
+				if (out >= end)
+					return nullptr;
+				*out++ = ',';
+			}
+			first = false;
+
+			return F::print(msg, out, end);
+		}
+	}
+};
+
+namespace schemaarg
+{
+
+#define NAVI_SCHEMA_FIELD(name, kind, arg, member, getter, setter, validity) \
+	struct name##_##member##_a \
+		{ static constexpr const char *value = arg; };
+#include <libnavigate/schema.def>
+
+}
+
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	template <> \
+	struct SentenceCodec_t<struct name##_t> \
+	{ \
+		static void init(struct name##_t &msg) \
+			{ navi_init_##name(&msg); } \
+		\
+		typedef SchemaFields_t<
+#define NAVI_SCHEMA_FIELD(name, kind, arg, member, getter, setter, validity) \
+			SchemaField_t<&name##_t::member, schemakind::kind<schemaarg::name##_##member##_a> >,
+#define NAVI_SCHEMA_END(name, NAME, Class) \
+			SchemaEnd_t> fields_t; \
+	};
+#include <libnavigate/schema.def>
+
+template <typename T, typename = void>
+struct HasCodec_t : std::false_type { };
+
+template <typename T>
+struct HasCodec_t<T, std::void_t<typename SentenceCodec_t<T>::fields_t> > : std::true_type { };
+
+//
+// Framing, checksum and address
+//
+
+// Talker identifiers by their two letters
+inline navi_talkerid_t talkerIdOf(const char *p)
+{
+	struct table_t
+	{
+		signed char ids[26][26];
+
+		table_t()
+		{
+			int tid;
+			const char *s;
+
+			memset(ids, navi_talkerid_Unknown, sizeof(ids));
+			for (tid = navi_WI; tid >= navi_AG; tid--)
+			{
+				s = navi_talkerid_str(tid);
+				ids[s[0] - 'A'][s[1] - 'A'] = (signed char)tid;
+			}
+		}
+	};
+
+	static const table_t table;
+
+	if ((p[0] < 'A') || (p[0] > 'Z') || (p[1] < 'A') || (p[1] > 'Z'))
+		return navi_talkerid_Unknown;
+	return table.ids[p[0] - 'A'][p[1] - 'A'];
+}
+
+// Approved sentence formatters by their three letters
+inline navi_approved_fmt_t formatterOf(const char *p)
+{
+	struct table_t
+	{
+		signed char fmts[26][26][26];
+
+		table_t()
+		{
+			int fmt;
+			const char *s;
+
+			memset(fmts, navi_approvedfmt_Unknown, sizeof(fmts));
+			for (fmt = navi_ZTG; fmt >= navi_AAM; fmt--)
+			{
+				s = navi_sentencefmt_str(fmt);
+				fmts[s[0] - 'A'][s[1] - 'A'][s[2] - 'A'] = (signed char)fmt;
+			}
+		}
+	};
+
+	static const table_t table;
+
+	if ((p[0] < 'A') || (p[0] > 'Z') || (p[1] < 'A') || (p[1] > 'Z') ||
+		(p[2] < 'A') || (p[2] > 'Z'))
+	{
+		return navi_approvedfmt_Unknown;
+	}
+	return table.fmts[p[0] - 'A'][p[1] - 'A'][p[2] - 'A'];
+}
+
+// Finds the sentence and checks it, as navi_parse_msg() does.
+// Stores the index of '$' to som.
+inline fieldresult_t frameSentence(const char *buffer, size_t maxsize, size_t *nmread,
+	size_t *som)
+{
+	size_t eom, i;
+	unsigned int ucs = 0, cs = 0;
+	int d;
+
+	for (i = 0; (i < maxsize) && (buffer[i] != '$'); i++) { }
+	if (i >= maxsize)
+		return navi_NoValidMessage;
+	*som = i;
+
+	for (eom = i + 1; eom < maxsize; eom++)
+	{
+		if ((buffer[eom - 1] == '\r') && (buffer[eom] == '\n'))
+			break;
+	}
+	if (eom >= maxsize)
+		return navi_NoValidMessage;
+
+	*nmread = eom + 1;
+
+	for (i = i + 1; (i < eom) && (buffer[i] != '*'); i++)
+		ucs ^= buffer[i];
+	if (i >= eom)
+		return navi_InvalidMessage;
+
+	for (i = eom - 3; (i < eom) && ((d = hexValue(buffer[i])) >= 0); i++)
+		cs = cs * 16 + unsigned(d);
+	if (ucs != cs)
+		return navi_CrcEror;
+
+	// the fields parsers rely on '*hh' before <cr><lf>
+	if ((eom - *som < 5) || (buffer[eom - 4] != '*') || (hexValue(buffer[eom - 3]) < 0) ||
+		(hexValue(buffer[eom - 2]) < 0))
+	{
+		return navi_InvalidMessage;
+	}
+
+	return navi_Undefined;
+}
+
+// Parses the fields after the address '$ttsss,'
+template <typename T>
+inline fieldresult_t decodeFields(const char *address, Sentence_t<T> &msg)
+{
+	msg.tid = talkerIdOf(address);
+	SentenceCodec_t<T>::init(msg.data);
+	return SentenceCodec_t<T>::fields_t::parse(address + 6, msg.data);
+}
+
+inline bool isFormatter(const char *p, navi_approved_fmt_t fmt)
+	{ return memcmp(p, navi_sentencefmt_str(fmt), 3) == 0; }
+
+inline bool isApproved(const char *address)
+	{ return (address[0] != 'P') && (address[4] != 'Q'); }
+
+// Prints the sentence with the field list
+template <typename T>
+inline size_t encodeSentence(const Sentence_t<T> &msg, char *buffer, size_t maxsize,
+	fieldresult_t *error)
+{
+	char body[NAVI_SENTENCE_MAXSIZE + 1], *fields, *out;
+	size_t i, msglen;
+	int cs = 0;
+	static const char hex[] = "0123456789ABCDEF";
+
+	if ((msg.tid < navi_AG) || (msg.tid > navi_WI))
+	{
+		*error = navi_InvalidParameter;
+		return 0;
+	}
+
+	// the buffer with room for the longest sentence gets the fields
+	// in place. Otherwise they are printed apart, to tell the long
+	// sentence from the short buffer the same way as navi_create_msg()
+	fields = maxsize >= sizeof(body) + 7 ? buffer + 7 : body;
+
+	if ((*error = SentenceCodec_t<T>::fields_t::check(msg.data)) != navi_Undefined)
+		return 0;
+
+	out = SentenceCodec_t<T>::fields_t::print(msg.data, fields, fields + sizeof(body));
+	if (out == nullptr)
+	{
+		*error = SentenceCodec_t<T>::fields_t::overflow;
+		return 0;
+	}
+	if (size_t(out - fields) + 12 > NAVI_SENTENCE_MAXSIZE)
+	{
+		*error = navi_MsgExceedsMaxSize;
+		return 0;
+	}
+
+	msglen = size_t(out - fields);
+	if (msglen + 12 >= maxsize)
+	{
+		*error = navi_NotEnoughBuffer;
+		return 0;
+	}
+
+	buffer[0] = '$';
+	memcpy(buffer + 1, navi_talkerid_str(msg.tid), 2);
+	memcpy(buffer + 3, navi_sentencefmt_str(Sentence_t<T>::formatter), 3);
+	buffer[6] = ',';
+	if (fields == body)
+		memcpy(buffer + 7, body, msglen);
+
+	out = buffer + 7 + msglen;
+	for (i = 1; buffer + i < out; i++)
+		cs ^= buffer[i];
+
+	out[0] = '*';
+	out[1] = hex[(cs >> 4) & 0xf];
+	out[2] = hex[cs & 0xf];
+	out[3] = '\r';
+	out[4] = '\n';
+	out[5] = '\0';
+
+	return msglen + 12;
+}
+
+}
+
+//
+// Parses the sentence of the given type and returns true. In case of error,
+// or if the sentence is of the other type, returns false and sets error,
+// never throws.
+template <typename T>
+inline bool Decode(const char *buffer, size_t maxsize, Sentence_t<T> &msg, size_t *nmread,
+	NaviError_t &error)
+{
+	size_t som;
+	const char *address;
+	codec::fieldresult_t result = codec::frameSentence(buffer, maxsize, nmread, &som);
+
+	if (result == navi_Undefined)
+	{
+		address = buffer + som + 1;
+
+		if (!codec::isApproved(address) || !codec::isFormatter(address + 2, Sentence_t<T>::formatter))
+			result = navi_MsgNotSupported;
+		else
+			result = codec::decodeFields(address, msg);
+	}
+
+	if (result != navi_Undefined)
+	{
+		error = NaviError_t::fromErrorCode(result);
+		return false;
+	}
+
+	return true;
+}
+
+//
+// Parses the sentence of the given type. In case of error, or if the
+// sentence is of the other type, throws NaviError_t.
+template <typename T>
+inline void Decode(const char *buffer, size_t maxsize, Sentence_t<T> &msg, size_t *nmread)
+{
+	NaviError_t error;
+
+	if (!Decode(buffer, maxsize, msg, nmread, error))
+		throw error;
+}
+
+//
+// Parses any sentence. The sentences with the field list are parsed by
+// the codec, the others by the C library. In case of error returns
+// std::monostate and sets error, never throws.
+inline AnyMessage_t DecodeAny(char *buffer, size_t maxsize, size_t *nmread, NaviError_t &error)
+{
+	AnyMessage_t result;
+	size_t som;
+	const char *address;
+	codec::fieldresult_t status = codec::frameSentence(buffer, maxsize, nmread, &som);
+
+	if (status != navi_Undefined)
+	{
+		error = NaviError_t::fromErrorCode(status);
+		return result;
+	}
+
+	address = buffer + som + 1;
+
+	if (codec::isApproved(address))
+	{
+		if (codec::isFormatter(address + 2, navi_RMC))
+			status = codec::decodeFields(address, result.emplace<Rmc_v>());
+		else if (codec::isFormatter(address + 2, navi_GGA))
+			status = codec::decodeFields(address, result.emplace<Gga_v>());
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+		else if (codec::isFormatter(address + 2, navi_##NAME)) \
+			status = codec::decodeFields(address, result.emplace<Class##_v>());
+#include <libnavigate/schema.def>
+		else
+			return ParseAny(buffer, maxsize, nmread, error);
+
+		if (status != navi_Undefined)
+		{
+			error = NaviError_t::fromErrorCode(status);
+			result = std::monostate();
+		}
+
+		return result;
+	}
+
+	return ParseAny(buffer, maxsize, nmread, error);
+}
+
+//
+// Parses any sentence. In case of error throws NaviError_t.
+inline AnyMessage_t DecodeAny(char *buffer, size_t maxsize, size_t *nmread)
+{
+	NaviError_t error;
+	AnyMessage_t result = DecodeAny(buffer, maxsize, nmread, error);
+
+	if (std::holds_alternative<std::monostate>(result))
+		throw error;
+
+	return result;
+}
+
+//
+// Generates the sentence. Returns the number of characters written, not
+// counting the terminating null character. In case of error returns 0
+// and sets error, never throws.
+template <typename T>
+inline size_t Encode(const Sentence_t<T> &msg, char *buffer, size_t maxsize, NaviError_t &error)
+{
+	if constexpr (codec::HasCodec_t<T>::value)
+	{
+		codec::fieldresult_t status = navi_Undefined;
+		size_t nmwritten = codec::encodeSentence(msg, buffer, maxsize, &status);
+
+		if (nmwritten == 0)
+			error = NaviError_t::fromErrorCode(status);
+		return nmwritten;
+	}
+	else
+	{
+		return CreateSentence(msg, buffer, maxsize, error);
+	}
+}
+
+inline size_t EncodeAny(const AnyMessage_t &msg, char *buffer, size_t maxsize, NaviError_t &error)
+{
+	return std::visit(Overloaded_t{
+		[&](const auto &value) { return Encode(value, buffer, maxsize, error); },
+		[&](const std::monostate &) -> size_t { error = NaviError_t::InvalidParameter; return 0; } },
+		msg);
+}
+
+//
+// Generates the sentence. In case of error throws NaviError_t.
+template <typename T>
+inline size_t Encode(const Sentence_t<T> &msg, char *buffer, size_t maxsize)
+{
+	NaviError_t error;
+	size_t nmwritten = Encode(msg, buffer, maxsize, error);
+
+	if (nmwritten == 0)
+		throw error;
+
+	return nmwritten;
+}
+
+inline size_t EncodeAny(const AnyMessage_t &msg, char *buffer, size_t maxsize)
+{
+	NaviError_t error;
+	size_t nmwritten = EncodeAny(msg, buffer, maxsize, error);
+
+	if (nmwritten == 0)
+		throw error;
+
+	return nmwritten;
+}
+
+}
+
+#endif // INCLUDE_navi_codecplusplus
@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Dtm_t) : public Message_t
+NAVI_EXTERN_CLASS(Dtm_t) NAVI_FINAL : public Message_t
 {
 public:
 	Dtm_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -34,42 +34,103 @@ public:
 	virtual ~Dtm_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isLocalDatumValid() const;
+	bool isLocalDatumSubdivisionValid() const;
+	bool isOffsetValid() const;
+	bool isAltitudeOffsetValid() const;
+	bool isReferenceDatumValid() const;
 
 public:
-	virtual bool isLocalDatumValid() const;
-	virtual bool isLocalDatumSubdivisionValid() const;
-	virtual bool isOffsetValid() const;
-	virtual bool isAltitudeOffsetValid() const;
-	virtual bool isReferenceDatumValid() const;
+	Datum_t localDatum() const;
+	DatumSubdivision_t datumSubdivision() const;
+	Offset_t latitudeOffset() const;
+	Offset_t longitudeOffset() const;
+	double altitudeOffset() const;
+	Datum_t referenceDatum() const;
 
 public:
-	virtual Datum_t localDatum() const;
-	virtual DatumSubdivision_t datumSubdivision() const;
-	virtual Offset_t latitudeOffset() const;
-	virtual Offset_t longitudeOffset() const;
-	virtual double altitudeOffset() const;
-	virtual Datum_t referenceDatum() const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setLocalDatum(const Datum_t &datum);
-	virtual void setDatumSubdivision(const DatumSubdivision_t
+	void setLocalDatum(const Datum_t &datum);
+	void setDatumSubdivision(const DatumSubdivision_t
 		&datumSubdivision);
-	virtual void setLatitudeOffset(const Offset_t &offset);
-	virtual void setLongitudeOffset(const Offset_t &offset);
-	virtual void setAltitudeOffset(double offset);
-	virtual void setReferenceDatum(const Datum_t &datum);
+	void setLatitudeOffset(const Offset_t &offset);
+	void setLongitudeOffset(const Offset_t &offset);
+	void setAltitudeOffset(double offset);
+	void setReferenceDatum(const Datum_t &datum);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct dtm_t *() const;
-	virtual operator struct dtm_t *();
+	operator const struct dtm_t *() const;
+	operator struct dtm_t *();
 };
 
+inline Datum_t Dtm_t::localDatum() const
+{ return Datum_t::fromDatumCode(((const struct dtm_t *)(*this))->local_dtm); }
+
+inline DatumSubdivision_t Dtm_t::datumSubdivision() const
+{ return DatumSubdivision_t::fromDatumSubcode(((const struct dtm_t *)(*this))->local_dtmsd); }
+
+inline Offset_t Dtm_t::latitudeOffset() const
+{ return Offset_t::fromOffset(&((const struct dtm_t *)(*this))->lat_offset); }
+
+inline Offset_t Dtm_t::longitudeOffset() const
+{ return Offset_t::fromOffset(&((const struct dtm_t *)(*this))->long_offset); }
+
+inline double Dtm_t::altitudeOffset() const
+{ return ((const struct dtm_t *)(*this))->alt_offset; }
+
+inline Datum_t Dtm_t::referenceDatum() const
+{ return Datum_t::fromDatumCode(((const struct dtm_t *)(*this))->reference_dtm); }
+
+inline void Dtm_t::setLocalDatum(const Datum_t &datum)
+{ ((struct dtm_t *)(*this))->local_dtm = datum.toDatumCode(); }
+
+inline void Dtm_t::setDatumSubdivision(const DatumSubdivision_t &datumSubdivision)
+{ ((struct dtm_t *)(*this))->local_dtmsd = datumSubdivision.toDatumSubcode(); }
+
+inline void Dtm_t::setLatitudeOffset(const Offset_t &offset)
+{ ((struct dtm_t *)(*this))->lat_offset = offset.toOffset(); }
+
+inline void Dtm_t::setLongitudeOffset(const Offset_t &offset)
+{ ((struct dtm_t *)(*this))->long_offset = offset.toOffset(); }
+
+inline void Dtm_t::setAltitudeOffset(double offset)
+{ ((struct dtm_t *)(*this))->alt_offset = offset; }
+
+inline void Dtm_t::setReferenceDatum(const Datum_t &datum)
+{ ((struct dtm_t *)(*this))->reference_dtm = datum.toDatumCode(); }
+
+inline bool Dtm_t::isLocalDatumValid() const
+{ return ((const struct dtm_t *)(*this))->local_dtm != navi_datum_NULL; }
+
+inline bool Dtm_t::isLocalDatumSubdivisionValid() const
+{ return ((const struct dtm_t *)(*this))->local_dtmsd != navi_datumsub_NULL; }
+
+inline bool Dtm_t::isOffsetValid() const
+{
+	return (((const struct dtm_t *)(*this))->lat_offset.sign != navi_offset_NULL) &&
+		(((const struct dtm_t *)(*this))->long_offset.sign != navi_offset_NULL);
+}
+
+inline bool Dtm_t::isAltitudeOffsetValid() const
+{ return navi_check_validity_number(((const struct dtm_t *)(*this))->alt_offset) == navi_Ok; }
+
+inline bool Dtm_t::isReferenceDatumValid() const
+{ return ((const struct dtm_t *)(*this))->reference_dtm != navi_datum_NULL; }
+
+inline Dtm_t::operator const struct dtm_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct dtm_t *)p;
+}
+
+inline Dtm_t::operator struct dtm_t *()
+{
+	void *p = (void *)(*this);
+	return (struct dtm_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_dtmplusplus
@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Gbs_t) : public Message_t
+NAVI_EXTERN_CLASS(Gbs_t) NAVI_FINAL : public Message_t
 {
 public:
 	Gbs_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -34,46 +34,123 @@ public:
 	virtual ~Gbs_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isExpectedErrorValid() const;
+	bool isExpectedAltitudeErrorValid() const;
+	bool isFailedIdValid() const;
+	bool isProbabilityValid() const;
+	bool isEstimateValid() const;
+	bool isStandardDeviationValid() const;
 
 public:
-	virtual bool isExpectedErrorValid() const;
-	virtual bool isExpectedAltitudeErrorValid() const;
-	virtual bool isFailedIdValid() const;
-	virtual bool isProbabilityValid() const;
-	virtual bool isEstimateValid() const;
-	virtual bool isStandardDeviationValid() const;
+	Utc_t utc() const;
+	double expErrInLatitude() const;
+	double expErrInLongitude() const;
+	double expErrInAltitude() const;
+	int failedSatelliteId() const;
+	double probabilityOfMissedDetection() const;
+	double estimateOfBias() const;
+	double deviationOfBias() const;
 
 public:
-	virtual Utc_t utc() const;
-	virtual double expErrInLatitude() const;
-	virtual double expErrInLongitude() const;
-	virtual double expErrInAltitude() const;
-	virtual int failedSatelliteId() const;
-	virtual double probabilityOfMissedDetection() const;
-	virtual double estimateOfBias() const;
-	virtual double deviationOfBias() const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &utc);
-	virtual void setExpErrInLatitude(double value);
-	virtual void setExpErrInLongitude(double value);
-	virtual void setExpErrInAltitude(double value);
-	virtual void setFailedSatelliteId(int value);
-	virtual void setProbabilityOfMissedDetection(double value);
-	virtual void setEstimateOfBias(double value);
-	virtual void setDeviationOfBias(double value);
+	void setUtc(const Utc_t &utc);
+	void setExpErrInLatitude(double value);
+	void setExpErrInLongitude(double value);
+	void setExpErrInAltitude(double value);
+	void setFailedSatelliteId(int value);
+	void setProbabilityOfMissedDetection(double value);
+	void setEstimateOfBias(double value);
+	void setDeviationOfBias(double value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct gbs_t *() const;
-	virtual operator struct gbs_t *();
+	operator const struct gbs_t *() const;
+	operator struct gbs_t *();
 };
 
+inline Utc_t Gbs_t::utc() const
+{
+	return Utc_t(((const struct gbs_t *)(*this))->utc.hour,
+		((const struct gbs_t *)(*this))->utc.min,
+		((const struct gbs_t *)(*this))->utc.sec);
+}
+
+inline double Gbs_t::expErrInLatitude() const
+{ return ((const struct gbs_t *)(*this))->experrlat; }
+
+inline double Gbs_t::expErrInLongitude() const
+{ return ((const struct gbs_t *)(*this))->experrlon; }
+
+inline double Gbs_t::expErrInAltitude() const
+{ return ((const struct gbs_t *)(*this))->experralt; }
+
+inline int Gbs_t::failedSatelliteId() const
+{ return ((const struct gbs_t *)(*this))->failed_id; }
+
+inline double Gbs_t::probabilityOfMissedDetection() const
+{ return ((const struct gbs_t *)(*this))->probability; }
+
+inline double Gbs_t::estimateOfBias() const
+{ return ((const struct gbs_t *)(*this))->estimate; }
+
+inline double Gbs_t::deviationOfBias() const
+{ return ((const struct gbs_t *)(*this))->deviation; }
+
+inline void Gbs_t::setUtc(const Utc_t &utc)
+{ ((struct gbs_t *)(*this))->utc = utc.toUtcStruct(); }
+
+inline void Gbs_t::setExpErrInLatitude(double value)
+{ ((struct gbs_t *)(*this))->experrlat = value; }
+
+inline void Gbs_t::setExpErrInLongitude(double value)
+{ ((struct gbs_t *)(*this))->experrlon = value; }
+
+inline void Gbs_t::setExpErrInAltitude(double value)
+{ ((struct gbs_t *)(*this))->experralt = value; }
+
+inline void Gbs_t::setFailedSatelliteId(int value)
+{ ((struct gbs_t *)(*this))->failed_id = value; }
+
+inline void Gbs_t::setProbabilityOfMissedDetection(double value)
+{ ((struct gbs_t *)(*this))->probability = value; }
+
+inline void Gbs_t::setEstimateOfBias(double value)
+{ ((struct gbs_t *)(*this))->estimate = value; }
+
+inline void Gbs_t::setDeviationOfBias(double value)
+{ ((struct gbs_t *)(*this))->deviation = value; }
+
+inline bool Gbs_t::isExpectedErrorValid() const
+{ return navi_check_validity_number(((const struct gbs_t *)(*this))->experrlat) == navi_Ok; }
+
+inline bool Gbs_t::isExpectedAltitudeErrorValid() const
+{ return navi_check_validity_number(((const struct gbs_t *)(*this))->experralt) == navi_Ok; }
+
+inline bool Gbs_t::isFailedIdValid() const
+{ return ((const struct gbs_t *)(*this))->failed_id != -1; }
+
+inline bool Gbs_t::isProbabilityValid() const
+{ return navi_check_validity_number(((const struct gbs_t *)(*this))->probability) == navi_Ok; }
+
+inline bool Gbs_t::isEstimateValid() const
+{ return navi_check_validity_number(((const struct gbs_t *)(*this))->estimate) == navi_Ok; }
+
+inline bool Gbs_t::isStandardDeviationValid() const
+{ return navi_check_validity_number(((const struct gbs_t *)(*this))->deviation) == navi_Ok; }
+
+inline Gbs_t::operator const struct gbs_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct gbs_t *)p;
+}
+
+inline Gbs_t::operator struct gbs_t *()
+{
+	void *p = (void *)(*this);
+	return (struct gbs_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_gbsplusplus
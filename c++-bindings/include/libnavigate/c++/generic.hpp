@@ -23,5 +23,13 @@
 
 #endif // navigate_EXPORTS
 
+// The sentence classes are not meant to be derived from, so the calls
+// of their virtual members are resolved at compile time
+#if __cplusplus >= 201103L
+#define NAVI_FINAL		final
+#else
+#define NAVI_FINAL
+#endif // C++11
+
 #endif // INCLUDE_navi_genericplusplus
 
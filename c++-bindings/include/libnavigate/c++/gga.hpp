@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Gga_t) : public Message_t
+NAVI_EXTERN_CLASS(Gga_t) NAVI_FINAL : public Message_t
 {
 public:
 	Gga_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -34,50 +34,135 @@ public:
 	virtual ~Gga_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isUtcValid() const;
+	bool isPositionValid() const;
+	bool isNmSatellitesValid() const;
+	bool isHdopValid() const;
+	bool isAntennaAltitudeValid() const;
+	bool isGeoidalSeparationValid() const;
+	bool isDifferentialAgeValid() const;
+	bool isStationIdValid() const;
 
 public:
-	virtual bool isUtcValid() const;
-	virtual bool isPositionValid() const;
-	virtual bool isNmSatellitesValid() const;
-	virtual bool isHdopValid() const;
-	virtual bool isAntennaAltitudeValid() const;
-	virtual bool isGeoidalSeparationValid() const;
-	virtual bool isDifferentialAgeValid() const;
-	virtual bool isStationIdValid() const;
+	Utc_t utc() const;
+	PositionFix_t positionFix() const;
+	GpsQualityIndicator_t qualityIndicator() const;
+	int nmOfSatellites() const;
+	double hdop() const;
+	double antennaAltitude() const;
+	double geoidalSeparation() const;
+	int ageOfDiffData() const;
+	int diffReferenceStationId() const;
 
 public:
-	virtual Utc_t utc() const;
-	virtual PositionFix_t positionFix() const;
-	virtual GpsQualityIndicator_t qualityIndicator() const;
-	virtual int nmOfSatellites() const;
-	virtual double hdop() const;
-	virtual double antennaAltitude() const;
-	virtual double geoidalSeparation() const;
-	virtual int ageOfDiffData() const;
-	virtual int diffReferenceStationId() const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &utc);
-	virtual void setPositionFix(const PositionFix_t &fix);
-	virtual void setQualityIndicator(const GpsQualityIndicator_t &qi);
-	virtual void setNmOfSatellites(int value);
-	virtual void setHdop(double value);
-	virtual void setAntennaAltitude(double value);
-	virtual void setGeoidalSeparation(double value);
-	virtual void setAgeOfDiffData(int value);
-	virtual void setDiffReferenceStationId(int value);
+	void setUtc(const Utc_t &utc);
+	void setPositionFix(const PositionFix_t &fix);
+	void setQualityIndicator(const GpsQualityIndicator_t &qi);
+	void setNmOfSatellites(int value);
+	void setHdop(double value);
+	void setAntennaAltitude(double value);
+	void setGeoidalSeparation(double value);
+	void setAgeOfDiffData(int value);
+	void setDiffReferenceStationId(int value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct gga_t *() const;
-	virtual operator struct gga_t *();
+	operator const struct gga_t *() const;
+	operator struct gga_t *();
 };
 
+inline Utc_t Gga_t::utc() const
+{ return Utc_t::fromUtcStruct(((const struct gga_t *)(*this))->utc); }
+
+inline PositionFix_t Gga_t::positionFix() const
+{ return PositionFix_t::fromPosition(&((const struct gga_t *)(*this))->fix); }
+
+inline GpsQualityIndicator_t Gga_t::qualityIndicator() const
+{ return GpsQualityIndicator_t::fromQualityCode(((const struct gga_t *)(*this))->gpsindicator); }
+
+inline int Gga_t::nmOfSatellites() const
+{ return ((const struct gga_t *)(*this))->nmsatellites; }
+
+inline double Gga_t::hdop() const
+{ return ((const struct gga_t *)(*this))->hdop; }
+
+inline double Gga_t::antennaAltitude() const
+{ return ((const struct gga_t *)(*this))->antaltitude; }
+
+inline double Gga_t::geoidalSeparation() const
+{ return ((const struct gga_t *)(*this))->geoidalsep; }
+
+inline int Gga_t::ageOfDiffData() const
+{ return ((const struct gga_t *)(*this))->diffdata_age; }
+
+inline int Gga_t::diffReferenceStationId() const
+{ return ((const struct gga_t *)(*this))->station_id; }
+
+inline void Gga_t::setUtc(const Utc_t &utc)
+{ ((struct gga_t *)(*this))->utc = utc.toUtcStruct(); }
+
+inline void Gga_t::setPositionFix(const PositionFix_t &fix)
+{ ((struct gga_t *)(*this))->fix = fix.toPosition(); }
+
+inline void Gga_t::setQualityIndicator(const GpsQualityIndicator_t &qi)
+{ ((struct gga_t *)(*this))->gpsindicator = qi.toQualityCode(); }
+
+inline void Gga_t::setNmOfSatellites(int value)
+{ ((struct gga_t *)(*this))->nmsatellites = value; }
+
+inline void Gga_t::setHdop(double value)
+{ ((struct gga_t *)(*this))->hdop = value; }
+
+inline void Gga_t::setAntennaAltitude(double value)
+{ ((struct gga_t *)(*this))->antaltitude = value; }
+
+inline void Gga_t::setGeoidalSeparation(double value)
+{ ((struct gga_t *)(*this))->geoidalsep = value; }
+
+inline void Gga_t::setAgeOfDiffData(int value)
+{ ((struct gga_t *)(*this))->diffdata_age = value; }
+
+inline void Gga_t::setDiffReferenceStationId(int value)
+{ ((struct gga_t *)(*this))->station_id = value; }
+
+inline bool Gga_t::isUtcValid() const
+{ return navi_check_validity_utc(&((const struct gga_t *)(*this))->utc) == navi_Ok; }
+
+inline bool Gga_t::isPositionValid() const
+{ return ((const struct gga_t *)(*this))->fix.latitude.sign != navi_offset_NULL; }
+
+inline bool Gga_t::isNmSatellitesValid() const
+{ return ((const struct gga_t *)(*this))->nmsatellites != -1; }
+
+inline bool Gga_t::isHdopValid() const
+{ return navi_check_validity_number(((const struct gga_t *)(*this))->hdop) == navi_Ok; }
+
+inline bool Gga_t::isAntennaAltitudeValid() const
+{ return navi_check_validity_number(((const struct gga_t *)(*this))->antaltitude) == navi_Ok; }
+
+inline bool Gga_t::isGeoidalSeparationValid() const
+{ return navi_check_validity_number(((const struct gga_t *)(*this))->geoidalsep) == navi_Ok; }
+
+inline bool Gga_t::isDifferentialAgeValid() const
+{ return ((const struct gga_t *)(*this))->diffdata_age != -1; }
+
+inline bool Gga_t::isStationIdValid() const
+{ return ((const struct gga_t *)(*this))->station_id != -1; }
+
+inline Gga_t::operator const struct gga_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct gga_t *)p;
+}
+
+inline Gga_t::operator struct gga_t *()
+{
+	void *p = (void *)(*this);
+	return (struct gga_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_ggaplusplus
@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Gll_t) : public Message_t
+NAVI_EXTERN_CLASS(Gll_t) NAVI_FINAL : public Message_t
 {
 public:
 	Gll_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -34,34 +34,71 @@ public:
 	virtual ~Gll_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isPositionValid() const;
+	bool isUtcValid() const;
 
 public:
-	virtual bool isPositionValid() const;
-	virtual bool isUtcValid() const;
+	PositionFix_t positionFix() const;
+	Utc_t utc() const;
+	Status_t status() const;
+	ModeIndicator_t modeIndicator() const;
 
 public:
-	virtual PositionFix_t positionFix() const;
-	virtual Utc_t utc() const;
-	virtual Status_t status() const;
-	virtual ModeIndicator_t modeIndicator() const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setPositionFix(const PositionFix_t &fix);
-	virtual void setUtc(const Utc_t &utc);
-	virtual void setStatus(const Status_t &status);
-	virtual void setModeIndicator(const ModeIndicator_t &mi);
+	void setPositionFix(const PositionFix_t &fix);
+	void setUtc(const Utc_t &utc);
+	void setStatus(const Status_t &status);
+	void setModeIndicator(const ModeIndicator_t &mi);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct gll_t *() const;
-	virtual operator struct gll_t *();
+	operator const struct gll_t *() const;
+	operator struct gll_t *();
 };
 
+inline PositionFix_t Gll_t::positionFix() const
+	{ return PositionFix_t::fromPosition(&((const struct gll_t *)(*this))->fix); }
+
+inline Utc_t Gll_t::utc() const
+	{ return Utc_t::fromUtcStruct(((const struct gll_t *)(*this))->utc); }
+
+inline Status_t Gll_t::status() const
+	{ return Status_t::fromStatusCode(((const struct gll_t *)(*this))->status); }
+
+inline ModeIndicator_t Gll_t::modeIndicator() const
+	{ return ModeIndicator_t::fromModeIndCode(((const struct gll_t *)(*this))->mi); }
+
+inline void Gll_t::setPositionFix(const PositionFix_t &fix)
+	{ ((struct gll_t *)(*this))->fix = fix.toPosition(); }
+
+inline void Gll_t::setUtc(const Utc_t &utc)
+	{ ((struct gll_t *)(*this))->utc = utc.toUtcStruct(); }
+
+inline void Gll_t::setStatus(const Status_t &status)
+	{ ((struct gll_t *)(*this))->status = status.toStatusCode(); }
+
+inline void Gll_t::setModeIndicator(const ModeIndicator_t &mi)
+	{ ((struct gll_t *)(*this))->mi = mi.toModeIndCode(); }
+
+inline bool Gll_t::isPositionValid() const
+	{ return ((const struct gll_t *)(*this))->fix.latitude.sign != navi_offset_NULL; }
+
+inline bool Gll_t::isUtcValid() const
+	{ return navi_check_validity_utc(&((const struct gll_t *)(*this))->utc) == navi_Ok; }
+
+inline Gll_t::operator const struct gll_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct gll_t *)p;
+}
+
+inline Gll_t::operator struct gll_t *()
+{
+	void *p = (void *)(*this);
+	return (struct gll_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_gllplusplus
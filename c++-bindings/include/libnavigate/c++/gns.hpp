@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Gns_t) : public Message_t
+NAVI_EXTERN_CLASS(Gns_t) NAVI_FINAL : public Message_t
 {
 public:
 	Gns_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -34,49 +34,135 @@ public:
 	virtual ~Gns_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-	virtual void setTalkerId(const TalkerId_t &tid);
+	bool isUtcValid() const;
+	bool isPositionValid() const;
+	bool isNmSatellitesValid() const;
+	bool isHdopValid() const;
+	bool isAntennaAltitudeValid() const;
+	bool isGeoidalSeparationValid() const;
+	bool isDifferentialAgeValid() const;
+	bool isStationIdValid() const;
 
 public:
-	virtual bool isUtcValid() const;
-	virtual bool isPositionValid() const;
-	virtual bool isNmSatellitesValid() const;
-	virtual bool isHdopValid() const;
-	virtual bool isAntennaAltitudeValid() const;
-	virtual bool isGeoidalSeparationValid() const;
-	virtual bool isDifferentialAgeValid() const;
-	virtual bool isStationIdValid() const;
+	Utc_t utc() const;
+	PositionFix_t positionFix() const;
+	ModeIndicatorArray_t modeIndicatorArray() const;
+	int nmOfSatellites() const;
+	double hdop() const;
+	double antennaAltitude() const;
+	double geoidalSeparation() const;
+	int ageOfDiffData() const;
+	int diffReferenceStationId() const;
 
 public:
-	virtual Utc_t utc() const;
-	virtual PositionFix_t positionFix() const;
-	virtual ModeIndicatorArray_t modeIndicatorArray() const;
-	virtual int nmOfSatellites() const;
-	virtual double hdop() const;
-	virtual double antennaAltitude() const;
-	virtual double geoidalSeparation() const;
-	virtual int ageOfDiffData() const;
-	virtual int diffReferenceStationId() const;
-
-public:
-	virtual void setUtc(const Utc_t &utc);
-	virtual void setPositionFix(const PositionFix_t &fix);
-	virtual void setModeIndicatorArray(const ModeIndicatorArray_t &modeArray);
-	virtual void setNmOfSatellites(int value);
-	virtual void setHdop(double value);
-	virtual void setAntennaAltitude(double value);
-	virtual void setGeoidalSeparation(double value);
-	virtual void setAgeOfDiffData(int value);
-	virtual void setDiffReferenceStationId(int value);
+	void setUtc(const Utc_t &utc);
+	void setPositionFix(const PositionFix_t &fix);
+	void setModeIndicatorArray(const ModeIndicatorArray_t &modeArray);
+	void setNmOfSatellites(int value);
+	void setHdop(double value);
+	void setAntennaAltitude(double value);
+	void setGeoidalSeparation(double value);
+	void setAgeOfDiffData(int value);
+	void setDiffReferenceStationId(int value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct gns_t *() const;
-	virtual operator struct gns_t *();
+	operator const struct gns_t *() const;
+	operator struct gns_t *();
 };
 
+inline Utc_t Gns_t::utc() const
+{ return Utc_t::fromUtcStruct(((const struct gns_t *)(*this))->utc); }
+
+inline PositionFix_t Gns_t::positionFix() const
+{ return PositionFix_t::fromPosition(&((const struct gns_t *)(*this))->fix); }
+
+inline ModeIndicatorArray_t Gns_t::modeIndicatorArray() const
+{ return ModeIndicatorArray_t::fromModeIndicators(((const struct gns_t *)(*this))->mi); }
+
+inline int Gns_t::nmOfSatellites() const
+{ return ((const struct gns_t *)(*this))->nmsatellites; }
+
+inline double Gns_t::hdop() const
+{ return ((const struct gns_t *)(*this))->hdop; }
+
+inline double Gns_t::antennaAltitude() const
+{ return ((const struct gns_t *)(*this))->antaltitude; }
+
+inline double Gns_t::geoidalSeparation() const
+{ return ((const struct gns_t *)(*this))->geoidalsep; }
+
+inline int Gns_t::ageOfDiffData() const
+{ return ((const struct gns_t *)(*this))->diffdata_age; }
+
+inline int Gns_t::diffReferenceStationId() const
+{ return ((const struct gns_t *)(*this))->station_id; }
+
+inline void Gns_t::setUtc(const Utc_t &utc)
+{ ((struct gns_t *)(*this))->utc = utc.toUtcStruct(); }
+
+inline void Gns_t::setPositionFix(const PositionFix_t &fix)
+{ ((struct gns_t *)(*this))->fix = fix.toPosition(); }
+
+inline void Gns_t::setModeIndicatorArray(const ModeIndicatorArray_t &modeArray)
+{ modeArray.toModeIndicators(((struct gns_t *)(*this))->mi); }
+
+inline void Gns_t::setNmOfSatellites(int value)
+{ ((struct gns_t *)(*this))->nmsatellites = value; }
+
+inline void Gns_t::setHdop(double value)
+{ ((struct gns_t *)(*this))->hdop = value; }
+
+inline void Gns_t::setAntennaAltitude(double value)
+{ ((struct gns_t *)(*this))->antaltitude = value; }
+
+inline void Gns_t::setGeoidalSeparation(double value)
+{ ((struct gns_t *)(*this))->geoidalsep = value; }
+
+inline void Gns_t::setAgeOfDiffData(int value)
+{ ((struct gns_t *)(*this))->diffdata_age = value; }
+
+inline void Gns_t::setDiffReferenceStationId(int value)
+{ ((struct gns_t *)(*this))->station_id = value; }
+
+inline bool Gns_t::isUtcValid() const
+{ return navi_check_validity_utc(&((const struct gns_t *)(*this))->utc) == navi_Ok; }
+
+inline bool Gns_t::isPositionValid() const
+{ return ((const struct gns_t *)(*this))->fix.latitude.sign != navi_offset_NULL; }
+
+inline bool Gns_t::isNmSatellitesValid() const
+{ return ((const struct gns_t *)(*this))->nmsatellites != -1; }
+
+inline bool Gns_t::isHdopValid() const
+{ return navi_check_validity_number(((const struct gns_t *)(*this))->hdop) == navi_Ok; }
+
+inline bool Gns_t::isAntennaAltitudeValid() const
+{ return navi_check_validity_number(((const struct gns_t *)(*this))->antaltitude) == navi_Ok; }
+
+inline bool Gns_t::isGeoidalSeparationValid() const
+{ return navi_check_validity_number(((const struct gns_t *)(*this))->geoidalsep) == navi_Ok; }
+
+inline bool Gns_t::isDifferentialAgeValid() const
+{ return ((const struct gns_t *)(*this))->diffdata_age != -1; }
+
+inline bool Gns_t::isStationIdValid() const
+{ return ((const struct gns_t *)(*this))->station_id != -1; }
+
+inline Gns_t::operator const struct gns_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct gns_t *)p;
+}
+
+inline Gns_t::operator struct gns_t *()
+{
+	void *p = (void *)(*this);
+	return (struct gns_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_gnsplusplus
@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Grs_t) : public Message_t
+NAVI_EXTERN_CLASS(Grs_t) NAVI_FINAL : public Message_t
 {
 public:
 	static const int MaxSatellites = GRS_MAX_SATELLITES;
@@ -37,31 +37,59 @@ public:
 	virtual ~Grs_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isResidualValid(int satIdx) const;
 
 public:
-	virtual bool isResidualValid(int satIdx) const;
+	Utc_t utc() const;
+	int mode() const;
+	double residual(int satIdx) const;
 
 public:
-	virtual Utc_t utc() const;
-	virtual int mode() const;
-	virtual double residual(int satIdx) const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &utc);
-	virtual void setMode(int mode);
-	virtual void setResidual(int satIdx, double value);
+	void setUtc(const Utc_t &utc);
+	void setMode(int mode);
+	void setResidual(int satIdx, double value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct grs_t *() const;
-	virtual operator struct grs_t *();
+	operator const struct grs_t *() const;
+	operator struct grs_t *();
 };
 
+inline Utc_t Grs_t::utc() const
+{ return Utc_t::fromUtcStruct(((const struct grs_t *)(*this))->utc); }
+
+inline int Grs_t::mode() const
+{ return ((const struct grs_t *)(*this))->mode; }
+
+inline double Grs_t::residual(int satIdx) const
+{ return ((const struct grs_t *)(*this))->residuals[satIdx]; }
+
+inline void Grs_t::setUtc(const Utc_t &utc)
+{ ((struct grs_t *)(*this))->utc = utc.toUtcStruct(); }
+
+inline void Grs_t::setMode(int mode)
+{ ((struct grs_t *)(*this))->mode = mode; }
+
+inline void Grs_t::setResidual(int satIdx, double value)
+{ ((struct grs_t *)(*this))->residuals[satIdx] = value; }
+
+inline bool Grs_t::isResidualValid(int satIdx) const
+{ return navi_check_validity_number(((const struct grs_t *)(*this))->residuals[satIdx]) == navi_Ok; }
+
+inline Grs_t::operator const struct grs_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct grs_t *)p;
+}
+
+inline Grs_t::operator struct grs_t *()
+{
+	void *p = (void *)(*this);
+	return (struct grs_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_grsplusplus
@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Gsa_t) : public Message_t
+NAVI_EXTERN_CLASS(Gsa_t) NAVI_FINAL : public Message_t
 {
 public:
 	static const int MaxSatellites = GSA_MAX_SATELLITES;
@@ -37,42 +37,103 @@ public:
 	virtual ~Gsa_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isSwitchModeValid() const;
+	bool isFixModeValid() const;
+	bool isSatelliteIdValid(int satIdx) const;
+	bool isPdopValid() const;
+	bool isHdopValid() const;
+	bool isVdopValid() const;
 
 public:
-	virtual bool isSwitchModeValid() const;
-	virtual bool isFixModeValid() const;
-	virtual bool isSatelliteIdValid(int satIdx) const;
-	virtual bool isPdopValid() const;
-	virtual bool isHdopValid() const;
-	virtual bool isVdopValid() const;
+	GsaSwitchMode_t switchMode() const;
+	int fixMode() const;
+	int satelliteId(int satIdx) const;
+	double pdop() const;
+	double hdop() const;
+	double vdop() const;
 
 public:
-	virtual GsaSwitchMode_t switchMode() const;
-	virtual int fixMode() const;
-	virtual int satelliteId(int satIdx) const;
-	virtual double pdop() const;
-	virtual double hdop() const;
-	virtual double vdop() const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setSwitchMode(const GsaSwitchMode_t &mode);
-	virtual void setFixMode(int value);
-	virtual void setSatelliteId(int satIdx, int value);
-	virtual void setPdop(double value);
-	virtual void setHdop(double value);
-	virtual void setVdop(double value);
+	void setSwitchMode(const GsaSwitchMode_t &mode);
+	void setFixMode(int value);
+	void setSatelliteId(int satIdx, int value);
+	void setPdop(double value);
+	void setHdop(double value);
+	void setVdop(double value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct gsa_t *() const;
-	virtual operator struct gsa_t *();
+	operator const struct gsa_t *() const;
+	operator struct gsa_t *();
 };
 
+inline GsaSwitchMode_t Gsa_t::switchMode() const
+{ return GsaSwitchMode_t::fromSwitchModeCode(((const struct gsa_t *)(*this))->swmode); }
+
+inline int Gsa_t::fixMode() const
+{ return ((const struct gsa_t *)(*this))->fixmode; }
+
+inline int Gsa_t::satelliteId(int satIdx) const
+{ return ((const struct gsa_t *)(*this))->satellites[satIdx]; }
+
+inline double Gsa_t::pdop() const
+{ return ((const struct gsa_t *)(*this))->pdop; }
+
+inline double Gsa_t::hdop() const
+{ return ((const struct gsa_t *)(*this))->hdop; }
+
+inline double Gsa_t::vdop() const
+{ return ((const struct gsa_t *)(*this))->vdop; }
+
+inline void Gsa_t::setSwitchMode(const GsaSwitchMode_t &mode)
+{ ((struct gsa_t *)(*this))->swmode = mode.toSwitchModeCode(); }
+
+inline void Gsa_t::setFixMode(int value)
+{ ((struct gsa_t *)(*this))->fixmode = value; }
+
+inline void Gsa_t::setSatelliteId(int satIdx, int value)
+{ ((struct gsa_t *)(*this))->satellites[satIdx] = value; }
+
+inline void Gsa_t::setPdop(double value)
+{ ((struct gsa_t *)(*this))->pdop = value; }
+
+inline void Gsa_t::setHdop(double value)
+{ ((struct gsa_t *)(*this))->hdop = value; }
+
+inline void Gsa_t::setVdop(double value)
+{ ((struct gsa_t *)(*this))->vdop = value; }
+
+inline bool Gsa_t::isSwitchModeValid() const
+{ return ((const struct gsa_t *)(*this))->swmode != navi_gsa_NULL; }
+
+inline bool Gsa_t::isFixModeValid() const
+{ return ((const struct gsa_t *)(*this))->fixmode != -1; }
+
+inline bool Gsa_t::isSatelliteIdValid(int satIdx) const
+{ return ((const struct gsa_t *)(*this))->satellites[satIdx] != -1; }
+
+inline bool Gsa_t::isPdopValid() const
+{ return navi_check_validity_number(((const struct gsa_t *)(*this))->pdop) == navi_Ok; }
+
+inline bool Gsa_t::isHdopValid() const
+{ return navi_check_validity_number(((const struct gsa_t *)(*this))->hdop) == navi_Ok; }
+
+inline bool Gsa_t::isVdopValid() const
+{ return navi_check_validity_number(((const struct gsa_t *)(*this))->vdop) == navi_Ok; }
+
+inline Gsa_t::operator const struct gsa_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct gsa_t *)p;
+}
+
+inline Gsa_t::operator struct gsa_t *()
+{
+	void *p = (void *)(*this);
+	return (struct gsa_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_gsaplusplus
@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Gst_t) : public Message_t
+NAVI_EXTERN_CLASS(Gst_t) NAVI_FINAL : public Message_t
 {
 public:
 	Gst_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -34,44 +34,111 @@ public:
 	virtual ~Gst_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isRmsValid() const;
+	bool isStdDeviationOfEllipseValid() const;
+	bool isStdDeviationOfPositionValid() const;
+	bool isStdDevofAltitudeValid() const;
 
 public:
-	virtual bool isRmsValid() const;
-	virtual bool isStdDeviationOfEllipseValid() const;
-	virtual bool isStdDeviationOfPositionValid() const;
-	virtual bool isStdDevofAltitudeValid() const;
+	Utc_t utc() const;
+	double rmsOfStandardDeviation() const;
+	double deviationOfSemiMajorAxis() const;
+	double deviationOfSemiMinorAxis() const;
+	double orientationOfSemiMajorAxis() const;
+	double deviationOfLatitudeError() const;
+	double deviationOfLongitudeError() const;
+	double deviationOfAltitudeError() const;
 
 public:
-	virtual Utc_t utc() const;
-	virtual double rmsOfStandardDeviation() const;
-	virtual double deviationOfSemiMajorAxis() const;
-	virtual double deviationOfSemiMinorAxis() const;
-	virtual double orientationOfSemiMajorAxis() const;
-	virtual double deviationOfLatitudeError() const;
-	virtual double deviationOfLongitudeError() const;
-	virtual double deviationOfAltitudeError() const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &utc);
-	virtual void setRmsOfStandardDeviation(double value);
-	virtual void setDeviationOfSemiMajorAxis(double value);
-	virtual void setDeviationOfSemiMinorAxis(double value);
-	virtual void setOrientationOfSemiMajorAxis(double value);
-	virtual void setDeviationOfLatitudeError(double value);
-	virtual void setDeviationOfLongitudeError(double value);
-	virtual void setDeviationOfAltitudeError(double value);
+	void setUtc(const Utc_t &utc);
+	void setRmsOfStandardDeviation(double value);
+	void setDeviationOfSemiMajorAxis(double value);
+	void setDeviationOfSemiMinorAxis(double value);
+	void setOrientationOfSemiMajorAxis(double value);
+	void setDeviationOfLatitudeError(double value);
+	void setDeviationOfLongitudeError(double value);
+	void setDeviationOfAltitudeError(double value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct gst_t *() const;
-	virtual operator struct gst_t *();
+	operator const struct gst_t *() const;
+	operator struct gst_t *();
 };
 
+inline Utc_t Gst_t::utc() const
+{ return Utc_t::fromUtcStruct(((const struct gst_t *)(*this))->utc); }
+
+inline double Gst_t::rmsOfStandardDeviation() const
+{ return ((const struct gst_t *)(*this))->rms; }
+
+inline double Gst_t::deviationOfSemiMajorAxis() const
+{ return ((const struct gst_t *)(*this))->devmajor; }
+
+inline double Gst_t::deviationOfSemiMinorAxis() const
+{ return ((const struct gst_t *)(*this))->devminor; }
+
+inline double Gst_t::orientationOfSemiMajorAxis() const
+{ return ((const struct gst_t *)(*this))->orientmajor; }
+
+inline double Gst_t::deviationOfLatitudeError() const
+{ return ((const struct gst_t *)(*this))->devlaterr; }
+
+inline double Gst_t::deviationOfLongitudeError() const
+{ return ((const struct gst_t *)(*this))->devlonerr; }
+
+inline double Gst_t::deviationOfAltitudeError() const
+{ return ((const struct gst_t *)(*this))->devalterr; }
+
+inline void Gst_t::setUtc(const Utc_t &utc)
+{ ((struct gst_t *)(*this))->utc = utc.toUtcStruct(); }
+
+inline void Gst_t::setRmsOfStandardDeviation(double value)
+{ ((struct gst_t *)(*this))->rms = value; }
+
+inline void Gst_t::setDeviationOfSemiMajorAxis(double value)
+{ ((struct gst_t *)(*this))->devmajor = value; }
+
+inline void Gst_t::setDeviationOfSemiMinorAxis(double value)
+{ ((struct gst_t *)(*this))->devminor = value; }
+
+inline void Gst_t::setOrientationOfSemiMajorAxis(double value)
+{ ((struct gst_t *)(*this))->orientmajor = value; }
+
+inline void Gst_t::setDeviationOfLatitudeError(double value)
+{ ((struct gst_t *)(*this))->devlaterr = value; }
+
+inline void Gst_t::setDeviationOfLongitudeError(double value)
+{ ((struct gst_t *)(*this))->devlonerr = value; }
+
+inline void Gst_t::setDeviationOfAltitudeError(double value)
+{ ((struct gst_t *)(*this))->devalterr = value; }
+
+inline bool Gst_t::isRmsValid() const
+{ return navi_check_validity_number(((const struct gst_t *)(*this))->rms) == navi_Ok; }
+
+inline bool Gst_t::isStdDeviationOfEllipseValid() const
+{ return navi_check_validity_number(((const struct gst_t *)(*this))->devmajor) == navi_Ok; }
+
+inline bool Gst_t::isStdDeviationOfPositionValid() const
+{ return navi_check_validity_number(((const struct gst_t *)(*this))->devlaterr) == navi_Ok; }
+
+inline bool Gst_t::isStdDevofAltitudeValid() const
+{ return navi_check_validity_number(((const struct gst_t *)(*this))->devalterr) == navi_Ok; }
+
+inline Gst_t::operator const struct gst_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct gst_t *)p;
+}
+
+inline Gst_t::operator struct gst_t *()
+{
+	void *p = (void *)(*this);
+	return (struct gst_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_gstplusplus
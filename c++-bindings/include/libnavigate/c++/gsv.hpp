@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Gsv_t) : public Message_t
+NAVI_EXTERN_CLASS(Gsv_t) NAVI_FINAL : public Message_t
 {
 public:
 	static const int MaxSatellites = GSV_MAX_SATELLITES_PER_MESSAGE;
@@ -37,42 +37,108 @@ public:
 	virtual ~Gsv_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isOrientationValid(int satIdx) const;
+	bool isSnrValid(int satIdx) const;
 
 public:
-	virtual bool isOrientationValid(int satIdx) const;
-	virtual bool isSnrValid(int satIdx) const;
+	int nmOfSatellites() const;
+	int totalNmOfMessages() const;
+	int messageNumber() const;
 
-public:
-	virtual int nmOfSatellites() const;
-	virtual int totalNmOfMessages() const;
-	virtual int messageNumber() const;
-
-	virtual unsigned int satelliteId(int satIdx) const;
-	virtual unsigned int elevation(int satIdx) const;
-	virtual unsigned int azimuth(int satIdx) const;
-	virtual unsigned int snratio(int satIdx) const;
+	unsigned int satelliteId(int satIdx) const;
+	unsigned int elevation(int satIdx) const;
+	unsigned int azimuth(int satIdx) const;
+	unsigned int snratio(int satIdx) const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setNmOfSatellites(int value);
-	virtual void setTotalNmOfMessages(int value);
-	virtual void setMessageNumber(int value);
+	void setNmOfSatellites(int value);
+	void setTotalNmOfMessages(int value);
+	void setMessageNumber(int value);
 
-	virtual void setSatelliteId(int satIdx, unsigned int value);
-	virtual void setOrientation(int satIdx, unsigned int elevation,
+	void setSatelliteId(int satIdx, unsigned int value);
+	void setOrientation(int satIdx, unsigned int elevation,
 			unsigned int azimuth);
-	virtual void setSnratio(int satIdx, unsigned int value);
+	void setSnratio(int satIdx, unsigned int value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct gsv_t *() const;
-	virtual operator struct gsv_t *();
+	operator const struct gsv_t *() const;
+	operator struct gsv_t *();
 };
 
+inline int Gsv_t::nmOfSatellites() const
+	{ return ((const struct gsv_t *)(*this))->nmsatellites; }
+
+inline int Gsv_t::totalNmOfMessages() const
+	{ return ((const struct gsv_t *)(*this))->totalnm; }
+
+inline int Gsv_t::messageNumber() const
+	{ return ((const struct gsv_t *)(*this))->msgnm; }
+
+inline void Gsv_t::setNmOfSatellites(int value)
+	{ ((struct gsv_t *)(*this))->nmsatellites = value; }
+
+inline void Gsv_t::setTotalNmOfMessages(int value)
+	{ ((struct gsv_t *)(*this))->totalnm = value; }
+
+inline void Gsv_t::setMessageNumber(int value)
+	{ ((struct gsv_t *)(*this))->msgnm = value; }
+
+inline unsigned int Gsv_t::satelliteId(int satIdx) const
+	{ return ((const struct gsv_t *)(*this))->info[satIdx].id; }
+
+inline unsigned int Gsv_t::elevation(int satIdx) const
+	{ return ((const struct gsv_t *)(*this))->info[satIdx].elevation; }
+
+inline unsigned int Gsv_t::azimuth(int satIdx) const
+	{ return ((const struct gsv_t *)(*this))->info[satIdx].azimuth; }
+
+inline unsigned int Gsv_t::snratio(int satIdx) const
+	{ return ((const struct gsv_t *)(*this))->info[satIdx].snr; }
+
+inline void Gsv_t::setSatelliteId(int satIdx, unsigned int value)
+{
+	((struct gsv_t *)(*this))->info[satIdx].id = value;
+}
+
+inline void Gsv_t::setOrientation(int satIdx, unsigned int elevation,
+	unsigned int azimuth)
+{
+	((struct gsv_t *)(*this))->info[satIdx].elevation = elevation;
+	((struct gsv_t *)(*this))->info[satIdx].azimuth = azimuth;
+	((struct gsv_t *)(*this))->info[satIdx].vfields |= SATINFO_VALID_ORIENTATION;
+}
+
+inline void Gsv_t::setSnratio(int satIdx, unsigned int value)
+{
+	((struct gsv_t *)(*this))->info[satIdx].snr = value;
+	((struct gsv_t *)(*this))->info[satIdx].vfields |= SATINFO_VALID_SNR;
+}
+
+inline bool Gsv_t::isOrientationValid(int satIdx) const
+{
+	return (((const struct gsv_t *)(*this))->info[satIdx].vfields & SATINFO_VALID_ORIENTATION) != 0 ? true : false;
+}
+
+inline bool Gsv_t::isSnrValid(int satIdx) const
+{
+	return (((const struct gsv_t *)(*this))->info[satIdx].vfields & SATINFO_VALID_SNR) != 0 ? true : false;
+}
+
+inline Gsv_t::operator const struct gsv_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct gsv_t *)p;
+}
+
+inline Gsv_t::operator struct gsv_t *()
+{
+	void *p = (void *)(*this);
+	return (struct gsv_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_gsvplusplus
@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Mla_t) : public Message_t
+NAVI_EXTERN_CLASS(Mla_t) NAVI_FINAL : public Message_t
 {
 public:
 	static const int MaxSatellites = MLA_MAX_SATELLITES;
@@ -37,65 +37,256 @@ public:
 	virtual ~Mla_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-	virtual int totalNmOfMessages() const;
-	virtual int messageNumber() const;
+	int totalNmOfMessages() const;
+	int messageNumber() const;
 
 public:
-	virtual unsigned int satelliteSlot() const;
-	virtual unsigned int dayCount() const;
-	virtual unsigned int svHealth() const;
-	virtual unsigned int eccentricity() const;
-	virtual unsigned int rateOfChangeOfDraconicTime() const;
-	virtual unsigned int argumentOfPerigee() const;
-	virtual unsigned int systemTimescaleCorrection_High() const;
-	virtual unsigned int correctionToDraconicTime() const;
-	virtual unsigned int timeOfAscensionNode() const;
-	virtual unsigned int longitudeOfAscensionNode() const;
-	virtual unsigned int correctionToInclinationAngle() const;
-	virtual unsigned int systemTimescaleCorrection_Low() const;
-	virtual unsigned int courseValueOfTimescaleShift() const;
+	unsigned int satelliteSlot() const;
+	unsigned int dayCount() const;
+	unsigned int svHealth() const;
+	unsigned int eccentricity() const;
+	unsigned int rateOfChangeOfDraconicTime() const;
+	unsigned int argumentOfPerigee() const;
+	unsigned int systemTimescaleCorrection_High() const;
+	unsigned int correctionToDraconicTime() const;
+	unsigned int timeOfAscensionNode() const;
+	unsigned int longitudeOfAscensionNode() const;
+	unsigned int correctionToInclinationAngle() const;
+	unsigned int systemTimescaleCorrection_Low() const;
+	unsigned int courseValueOfTimescaleShift() const;
 
 public:
-	virtual bool isDayCountValid() const;
-	virtual bool isSvHealthValid() const;
-	virtual bool isEccentricityValid() const;
-	virtual bool isRateOfChangeOfDraconicTimeValid() const;
-	virtual bool isArgumentOfPerigeeValid() const;
-	virtual bool isSystemTimescaleCorrectionValid() const;
-	virtual bool isCorrectionToDraconicTimeValid() const;
-	virtual bool isTimeOfAscensionNodeValid() const;
-	virtual bool isLongitudeOfAscensionNodeValid() const;
-	virtual bool isCorrectionToInclinationAngleValid() const;
-	virtual bool isCourseValueOfTimescaleShiftValid() const;
+	bool isDayCountValid() const;
+	bool isSvHealthValid() const;
+	bool isEccentricityValid() const;
+	bool isRateOfChangeOfDraconicTimeValid() const;
+	bool isArgumentOfPerigeeValid() const;
+	bool isSystemTimescaleCorrectionValid() const;
+	bool isCorrectionToDraconicTimeValid() const;
+	bool isTimeOfAscensionNodeValid() const;
+	bool isLongitudeOfAscensionNodeValid() const;
+	bool isCorrectionToInclinationAngleValid() const;
+	bool isCourseValueOfTimescaleShiftValid() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-	virtual void setTotalNmOfMessages(int value);
-	virtual void setMessageNumber(int value);
-
-	virtual void setSatelliteSlot(unsigned int value);
-	virtual void setDayCount(unsigned int value);
-	virtual void setSvHealth(unsigned int value);
-	virtual void setEccentricity(unsigned int value);
-	virtual void setRateOfChangeOfDraconicTime(unsigned int value);
-	virtual void setArgumentOfPerigee(unsigned int value);
-	virtual void setSystemTimescaleCorrection_High(unsigned int value);
-	virtual void setCorrectionToDraconicTime(unsigned int value);
-	virtual void setTimeOfAscensionNode(unsigned int value);
-	virtual void setLongitudeOfAscensionNode(unsigned int value);
-	virtual void setCorrectionToInclinationAngle(unsigned int value);
-	virtual void setSystemTimescaleCorrection_Low(unsigned int value);
-	virtual void setCourseValueOfTimescaleShift(unsigned int value);
+	void setTotalNmOfMessages(int value);
+	void setMessageNumber(int value);
+
+	void setSatelliteSlot(unsigned int value);
+	void setDayCount(unsigned int value);
+	void setSvHealth(unsigned int value);
+	void setEccentricity(unsigned int value);
+	void setRateOfChangeOfDraconicTime(unsigned int value);
+	void setArgumentOfPerigee(unsigned int value);
+	void setSystemTimescaleCorrection_High(unsigned int value);
+	void setCorrectionToDraconicTime(unsigned int value);
+	void setTimeOfAscensionNode(unsigned int value);
+	void setLongitudeOfAscensionNode(unsigned int value);
+	void setCorrectionToInclinationAngle(unsigned int value);
+	void setSystemTimescaleCorrection_Low(unsigned int value);
+	void setCourseValueOfTimescaleShift(unsigned int value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct mla_t *() const;
-	virtual operator struct mla_t *();
+	operator const struct mla_t *() const;
+	operator struct mla_t *();
 };
 
+inline int Mla_t::totalNmOfMessages() const
+	{ return ((const struct mla_t *)(*this))->totalnm; }
+
+inline int Mla_t::messageNumber() const
+	{ return ((const struct mla_t *)(*this))->msgnm; }
+
+inline unsigned int Mla_t::satelliteSlot() const
+	{ return ((const struct mla_t *)(*this))->alm.satslot; }
+
+inline unsigned int Mla_t::dayCount() const
+	{ return ((const struct mla_t *)(*this))->alm.daycount; }
+
+inline unsigned int Mla_t::svHealth() const
+	{ return ((const struct mla_t *)(*this))->alm.svhealth; }
+
+inline unsigned int Mla_t::eccentricity() const
+	{ return ((const struct mla_t *)(*this))->alm.e; }
+
+inline unsigned int Mla_t::rateOfChangeOfDraconicTime() const
+	{ return ((const struct mla_t *)(*this))->alm.dot; }
+
+inline unsigned int Mla_t::argumentOfPerigee() const
+	{ return ((const struct mla_t *)(*this))->alm.omega; }
+
+inline unsigned int Mla_t::systemTimescaleCorrection_High() const
+	{ return ((const struct mla_t *)(*this))->alm.tauc_high; }
+
+inline unsigned int Mla_t::correctionToDraconicTime() const
+	{ return ((const struct mla_t *)(*this))->alm.deltat; }
+
+inline unsigned int Mla_t::timeOfAscensionNode() const
+	{ return ((const struct mla_t *)(*this))->alm.t; }
+
+inline unsigned int Mla_t::longitudeOfAscensionNode() const
+	{ return ((const struct mla_t *)(*this))->alm.lambda; }
+
+inline unsigned int Mla_t::correctionToInclinationAngle() const
+	{ return ((const struct mla_t *)(*this))->alm.deltai; }
+
+inline unsigned int Mla_t::systemTimescaleCorrection_Low() const
+	{ return ((const struct mla_t *)(*this))->alm.tauc_low; }
+
+inline unsigned int Mla_t::courseValueOfTimescaleShift() const
+	{ return ((const struct mla_t *)(*this))->alm.taun; }
+
+inline void Mla_t::setTotalNmOfMessages(int value)
+	{ ((struct mla_t *)(*this))->totalnm = value; }
+
+inline void Mla_t::setMessageNumber(int value)
+	{ ((struct mla_t *)(*this))->msgnm = value; }
+
+inline void Mla_t::setSatelliteSlot(unsigned int value)
+	{ ((struct mla_t *)(*this))->alm.satslot = value; }
+
+inline void Mla_t::setDayCount(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.daycount = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_DAYCOUNT;
+}
+
+inline void Mla_t::setSvHealth(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.svhealth = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_SVHEALTH;
+}
+
+inline void Mla_t::setEccentricity(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.e = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_E;
+}
+
+inline void Mla_t::setRateOfChangeOfDraconicTime(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.dot = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_DOT;
+}
+
+inline void Mla_t::setArgumentOfPerigee(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.omega = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_OMEGA;
+}
+
+inline void Mla_t::setSystemTimescaleCorrection_High(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.tauc_high = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_TAUC;
+}
+
+inline void Mla_t::setCorrectionToDraconicTime(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.deltat = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_DELTAT;
+}
+
+inline void Mla_t::setTimeOfAscensionNode(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.t = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_T;
+}
+
+inline void Mla_t::setLongitudeOfAscensionNode(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.lambda = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_LAMBDA;
+}
+
+inline void Mla_t::setCorrectionToInclinationAngle(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.deltai = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_DELTAI;
+}
+
+inline void Mla_t::setSystemTimescaleCorrection_Low(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.tauc_low = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_TAUC;
+}
+
+inline void Mla_t::setCourseValueOfTimescaleShift(unsigned int value)
+{
+	((struct mla_t *)(*this))->alm.taun = value;
+	((struct mla_t *)(*this))->alm.vfields |= GLOALM_VALID_TAUN;
+}
+
+inline bool Mla_t::isDayCountValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_DAYCOUNT) != 0 ? true : false;
+}
+
+inline bool Mla_t::isSvHealthValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_SVHEALTH) != 0 ? true : false;
+}
+
+inline bool Mla_t::isEccentricityValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_E) != 0 ? true : false;
+}
+
+inline bool Mla_t::isRateOfChangeOfDraconicTimeValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_DOT) != 0 ? true : false;
+}
+
+inline bool Mla_t::isArgumentOfPerigeeValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_OMEGA) != 0 ? true : false;
+}
+
+inline bool Mla_t::isSystemTimescaleCorrectionValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_TAUC) != 0 ? true : false;
+}
+
+inline bool Mla_t::isCorrectionToDraconicTimeValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_DELTAT) != 0 ? true : false;
+}
+
+inline bool Mla_t::isTimeOfAscensionNodeValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_T) != 0 ? true : false;
+}
+
+inline bool Mla_t::isLongitudeOfAscensionNodeValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_LAMBDA) != 0 ? true : false;
+}
+
+inline bool Mla_t::isCorrectionToInclinationAngleValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_DELTAI) != 0 ? true : false;
+}
+
+inline bool Mla_t::isCourseValueOfTimescaleShiftValid() const
+{
+	return (((const struct mla_t *)(*this))->alm.vfields & GLOALM_VALID_TAUN) != 0 ? true : false;
+}
+
+inline Mla_t::operator const struct mla_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct mla_t *)p;
+}
+
+inline Mla_t::operator struct mla_t *()
+{
+	void *p = (void *)(*this);
+	return (struct mla_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_mlaplusplus
@@ -5,6 +5,12 @@
 #include "ack.hpp"
 #include "alm.hpp"
 #include "alr.hpp"
+#include "apb.hpp"
+#include "bec.hpp"
+#include "bod.hpp"
+#include "bwc.hpp"
+#include "bwr.hpp"
+#include "bww.hpp"
 #include "dtm.hpp"
 #include "gbs.hpp"
 #include "gga.hpp"
@@ -19,6 +25,9 @@
 #include "txt.hpp"
 #include "vtg.hpp"
 #include "zda.hpp"
+#include "schema.hpp"
+#include "errors.hpp"
+#include "stats.hpp"
 
 namespace libnavigate
 {
@@ -30,6 +39,11 @@ public:
 	// in case of error throws an exception
 	size_t CreateMessage(const Message_t &msg, char *buffer, size_t maxsize);
 
+	// returns the number of characters written
+	// in case of error returns 0 and sets error, never throws
+	size_t CreateMessage(const Message_t &msg, char *buffer, size_t maxsize,
+		NaviError_t &error);
+
 	//
 	// Creates TXT message sequence rom text string
 	size_t CreateTxtSequence(const TalkerId_t &tid, int textId,
@@ -38,6 +52,11 @@ public:
 	// returns the parsed message
 	// in case of error throws an exception
 	Message_t ParseMessage(char *buffer, size_t maxsize, size_t *nmread);
+
+	// stores the parsed message to msg and returns true
+	// in case of error returns false and sets error, never throws
+	bool ParseMessage(char *buffer, size_t maxsize, size_t *nmread,
+		Message_t &msg, NaviError_t &error);
 };
 
 }
@@ -0,0 +1,304 @@
+/*
+ * parser.hpp - reusable parser dispatching the sentences to handlers
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// The parser is created once per input stream. It keeps the framer state
+// and the parsed sentences between the calls, and calls the handler
+// registered for the type of each sentence:
+//
+//	Parser_t parser;
+//
+//	parser.on<Rmc_v>([](const Rmc_v &rmc) { use(rmc.data.fix); });
+//	parser.on<Gga_v>([](const Gga_v &gga) { use(gga.data.nmsatellites); });
+//
+//	while ((size = read(fd, chunk, sizeof(chunk))) > 0)
+//		parser.push(chunk, size);
+//
+// The handler is found by the sentence formatter in a table. The sentences
+// without a handler are skipped unparsed. The sentence is parsed into the
+// storage owned by the parser, and the handler gets the reference to it,
+// valid until the handler returns.
+//
+// While navi_trace_enable() is on, the stages of every sentence, from
+// the framing to the call of the handler, are counted in the trace
+// histograms of the statistics.
+//
+
+#ifndef INCLUDE_navi_parserplusplus
+#define INCLUDE_navi_parserplusplus
+
+#include "codec.hpp"
+#include <libnavigate/framer.h>
+#include <libnavigate/stats.h>
+
+#include <functional>
+#include <memory>
+#include <string_view>
+
+namespace libnavigate
+{
+
+namespace detail
+{
+
+// Parses the sentence of one type and calls the handler of it
+class Handler_t
+{
+public:
+	virtual ~Handler_t() { }
+
+	// Returns the error class, navi_Undefined on success. The checksum
+	// is checked, unless the sentence is already checked.
+	virtual codec::fieldresult_t handle(char *sentence, size_t length, bool checked,
+		void *scratch, size_t scratchsize) = 0;
+};
+
+template <typename T>
+class TypedHandler_t final : public Handler_t
+{
+public:
+	template <typename Handler>
+	explicit TypedHandler_t(Handler &&handler)
+		: m_handler(std::forward<Handler>(handler)) { }
+
+	codec::fieldresult_t handle(char *sentence, size_t length, bool checked,
+		void *scratch, size_t scratchsize) override
+	{
+		codec::fieldresult_t result = navi_Undefined;
+
+		if constexpr (codec::HasCodec_t<T>::value)
+		{
+			size_t nmread, som;
+
+			(void)scratch;
+			(void)scratchsize;
+
+			if (!checked)
+				result = codec::frameSentence(sentence, length, &nmread, &som);
+			if (result == navi_Undefined)
+			{
+				NAVI_TRACE(navi_trace_Checked, 0);
+				result = codec::decodeFields(sentence + 1, m_msg);
+			}
+			if (result == navi_Undefined)
+				NAVI_TRACE(navi_trace_Decoded, Sentence_t<T>::formatter);
+		}
+		else
+		{
+			navi_addrfield_t msgtype;
+			size_t nmread;
+
+			if (navi_parse_msg(sentence, length, scratchsize, &msgtype, scratch, &nmread) != navi_Ok)
+				return navierr_get_last()->errclass;
+
+			m_msg.tid = static_cast<struct approved_field_t *>(scratch)->tid;
+			memcpy(&m_msg.data, static_cast<char *>(scratch) + sizeof(struct approved_field_t),
+				sizeof(m_msg.data));
+		}
+
+		if (result == navi_Undefined)
+		{
+			NAVI_TRACE(navi_trace_Delivered, 0);
+			m_handler(m_msg);
+		}
+
+		return result;
+	}
+
+private:
+	Sentence_t<T> m_msg;
+	std::function<void(const Sentence_t<T> &)> m_handler;
+};
+
+// The C structure of the sentence value
+template <typename S> struct SentenceData_t;
+
+template <typename T>
+struct SentenceData_t<Sentence_t<T> >
+	{ typedef T type; };
+
+}
+
+class Parser_t
+{
+public:
+	Parser_t()
+		: m_nmparsed(0), m_nmfailed(0), m_nmskipped(0)
+	{
+		navi_framer_init(&m_framer);
+	}
+
+	// Registers the handler of the sentences of type S, e.g. Rmc_v,
+	// replacing the previous one. The handler is called as
+	// handler(const S &).
+	template <typename S, typename Handler>
+	void on(Handler &&handler)
+	{
+		typedef typename detail::SentenceData_t<S>::type data_t;
+
+		m_handlers[S::formatter].reset(
+			new detail::TypedHandler_t<data_t>(std::forward<Handler>(handler)));
+	}
+
+	// Removes the handler, the sentences of type S are skipped
+	template <typename S>
+	void off()
+		{ m_handlers[S::formatter].reset(); }
+
+	// Registers the handler of the sentences failed to parse. The handler
+	// is called as handler(const NaviError_t &, std::string_view sentence).
+	template <typename Handler>
+	void onError(Handler &&handler)
+		{ m_errorHandler = std::forward<Handler>(handler); }
+
+	// Consumes the chunk of the input stream and handles the sentences
+	// completed by it. The incomplete sentence at the end is kept until
+	// the next call. Returns the number of the sentences handled.
+	size_t push(const char *data, size_t size)
+	{
+		size_t nmread, nmhandled = 0;
+		NaviError_t error;
+
+		while ((size > 0) && (navi_framer_push(&m_framer, data, size, &nmread) == navi_Ok))
+		{
+			data += nmread;
+			size -= nmread;
+
+			if (dispatch(m_framer.sentence, m_framer.length, false, error) == Handled)
+				nmhandled++;
+		}
+
+		return nmhandled;
+	}
+
+	// Handles the first sentence found in buffer, as push() does.
+	// Returns true if the sentence is handled or skipped. In case of error returns false
+	// and sets error, never throws.
+	bool parse(char *buffer, size_t maxsize, size_t *nmread, NaviError_t &error)
+	{
+		size_t som, eom = maxsize;
+		codec::fieldresult_t result;
+
+		NAVI_TRACE(navi_trace_Parsing, 0);
+		result = codec::frameSentence(buffer, maxsize, &eom, &som);
+
+		if (result == navi_NoValidMessage)
+		{
+			fail(result, buffer, maxsize, error);
+			return false;
+		}
+
+		*nmread = eom;
+
+		// only the frame of '$ttsss' at least is dispatched by its address
+		if (((result != navi_Undefined) && (result != navi_CrcEror)) || (eom - som < MinFrameSize))
+		{
+			NAVI_TRACE(navi_trace_Dropped, 0);
+			fail(navi_InvalidMessage, buffer + som, eom - som, error);
+			return false;
+		}
+
+		// the sentence with a bad checksum is skipped too, if not handled
+		return dispatch(buffer + som, eom - som, result == navi_Undefined, error) != Failed;
+	}
+
+	// Drops the incomplete sentence, e.g. after the input is reopened
+	void reset()
+		{ navi_framer_init(&m_framer); }
+
+	// The numbers of the sentences handled, failed to parse and skipped
+	size_t nmparsed() const
+		{ return m_nmparsed; }
+	size_t nmfailed() const
+		{ return m_nmfailed; }
+	size_t nmskipped() const
+		{ return m_nmskipped; }
+
+private:
+	Parser_t(const Parser_t &) = delete;
+	Parser_t &operator=(const Parser_t &) = delete;
+
+	enum dispatched_t { Handled, Skipped, Failed };
+
+	// The length of '$ttsss', the start of the sentence read by dispatch()
+	static const size_t MinFrameSize = 6;
+
+	// Calls the handler of the framed sentence
+	dispatched_t dispatch(char *sentence, size_t length, bool checked, NaviError_t &error)
+	{
+		const char *address = sentence + 1;
+		navi_approved_fmt_t fmt;
+		detail::Handler_t *handler;
+		codec::fieldresult_t result;
+
+		if (length < MinFrameSize)
+		{
+			NAVI_TRACE(navi_trace_Dropped, 0);
+			fail(navi_InvalidMessage, sentence, length, error);
+			return Failed;
+		}
+
+		if (!codec::isApproved(address) || ((fmt = codec::formatterOf(address + 2)) < 0) ||
+			((handler = m_handlers[fmt].get()) == nullptr))
+		{
+			NAVI_TRACE(navi_trace_Dropped, 0);
+			m_nmskipped++;
+			return Skipped;
+		}
+
+		result = handler->handle(sentence, length, checked, &m_scratch, sizeof(m_scratch));
+		if (result != navi_Undefined)
+		{
+			NAVI_TRACE(navi_trace_Dropped, 0);
+			fail(result, sentence, length, error);
+			return Failed;
+		}
+
+		m_nmparsed++;
+		return Handled;
+	}
+
+	void fail(codec::fieldresult_t result, const char *sentence, size_t length, NaviError_t &error)
+	{
+		error = NaviError_t::fromErrorCode(result);
+		m_nmfailed++;
+
+		if (m_errorHandler)
+			m_errorHandler(error, std::string_view(sentence, length));
+	}
+
+	struct navi_framer_t m_framer;
+
+	// The storage of the sentences parsed by the C library
+	union
+	{
+		struct approved_field_t address;
+		double align;
+		char bytes[sizeof(struct approved_field_t) + Message_t::MaxSize];
+	} m_scratch;
+
+	std::unique_ptr<detail::Handler_t> m_handlers[navi_ZTG + 1];
+	std::function<void(const NaviError_t &, std::string_view)> m_errorHandler;
+
+	size_t m_nmparsed, m_nmfailed, m_nmskipped;
+};
+
+}
+
+#endif // INCLUDE_navi_parserplusplus
@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Rmc_t) : public Message_t
+NAVI_EXTERN_CLASS(Rmc_t) NAVI_FINAL : public Message_t
 {
 public:
 	Rmc_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -34,46 +34,124 @@ public:
 	virtual ~Rmc_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isUtcValid() const;
+	bool isPositionValid() const;
+	bool isSpeedValid() const;
+	bool isCourseValid() const;
+	bool isDateValid() const;
+	bool isMagneticVariationValid() const;
 
 public:
-	virtual bool isUtcValid() const;
-	virtual bool isPositionValid() const;
-	virtual bool isSpeedValid() const;
-	virtual bool isCourseValid() const;
-	virtual bool isDateValid() const;
-	virtual bool isMagneticVariationValid() const;
+	Utc_t utc() const;
+	Status_t status() const;
+	PositionFix_t positionFix() const;
+	double speed() const;
+	double course() const;
+	Date_t date() const;
+	Offset_t magneticVariation() const;
+	ModeIndicator_t modeIndicator() const;
 
 public:
-	virtual Utc_t utc() const;
-	virtual Status_t status() const;
-	virtual PositionFix_t positionFix() const;
-	virtual double speed() const;
-	virtual double course() const;
-	virtual Date_t date() const;
-	virtual Offset_t magneticVariation() const;
-	virtual ModeIndicator_t modeIndicator() const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &utc);
-	virtual void setStatus(const Status_t &status);
-	virtual void setPositionFix(const PositionFix_t &fix);
-	virtual void setSpeed(double value);
-	virtual void setCourse(double value);
-	virtual void setDate(const Date_t &date);
-	virtual void setMagneticVariation(const Offset_t &offset);
-	virtual void setModeIndicator(const ModeIndicator_t &mi);
+	void setUtc(const Utc_t &utc);
+	void setStatus(const Status_t &status);
+	void setPositionFix(const PositionFix_t &fix);
+	void setSpeed(double value);
+	void setCourse(double value);
+	void setDate(const Date_t &date);
+	void setMagneticVariation(const Offset_t &offset);
+	void setModeIndicator(const ModeIndicator_t &mi);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct rmc_t *() const;
-	virtual operator struct rmc_t *();
+	operator const struct rmc_t *() const;
+	operator struct rmc_t *();
 };
 
+inline Utc_t Rmc_t::utc() const
+{ return Utc_t::fromUtcStruct(((const struct rmc_t *)(*this))->utc); }
+
+inline Status_t Rmc_t::status() const
+{ return Status_t::fromStatusCode(((const struct rmc_t *)(*this))->status); }
+
+inline PositionFix_t Rmc_t::positionFix() const
+{ return PositionFix_t::fromPosition(&((const struct rmc_t *)(*this))->fix); }
+
+inline double Rmc_t::speed() const
+{ return ((const struct rmc_t *)(*this))->speedN; }
+
+inline double Rmc_t::course() const
+{ return ((const struct rmc_t *)(*this))->courseT; }
+
+inline Date_t Rmc_t::date() const
+{ return Date_t::fromDateStruct(((const struct rmc_t *)(*this))->date); }
+
+inline Offset_t Rmc_t::magneticVariation() const
+{ return Offset_t::fromOffset(&((const struct rmc_t *)(*this))->magnVariation); }
+
+inline ModeIndicator_t Rmc_t::modeIndicator() const
+{ return ModeIndicator_t::fromModeIndCode(((const struct rmc_t *)(*this))->mi); }
+
+inline void Rmc_t::setUtc(const Utc_t &utc)
+{ ((struct rmc_t *)(*this))->utc = utc.toUtcStruct(); }
+
+inline void Rmc_t::setStatus(const Status_t &status)
+{ ((struct rmc_t *)(*this))->status = status.toStatusCode(); }
+
+inline void Rmc_t::setPositionFix(const PositionFix_t &fix)
+{ ((struct rmc_t *)(*this))->fix = fix.toPosition(); }
+
+inline void Rmc_t::setSpeed(double value)
+{ ((struct rmc_t *)(*this))->speedN = value; }
+
+inline void Rmc_t::setCourse(double value)
+{ ((struct rmc_t *)(*this))->courseT = value; }
+
+inline void Rmc_t::setDate(const Date_t &date)
+{
+	((struct rmc_t *)(*this))->date = date.toDateStruct();
+	((struct rmc_t *)(*this))->vfields |= RMC_VALID_DATE;
+}
+
+inline void Rmc_t::setMagneticVariation(const Offset_t &offset)
+{ ((struct rmc_t *)(*this))->magnVariation = offset.toOffset(); }
+
+inline void Rmc_t::setModeIndicator(const ModeIndicator_t &mi)
+{ ((struct rmc_t *)(*this))->mi = mi.toModeIndCode(); }
+
+inline bool Rmc_t::isUtcValid() const
+{ return navi_check_validity_utc(&((const struct rmc_t *)(*this))->utc) == navi_Ok; }
+
+inline bool Rmc_t::isPositionValid() const
+{ return ((const struct rmc_t *)(*this))->fix.latitude.sign != navi_offset_NULL; }
+
+inline bool Rmc_t::isSpeedValid() const
+{ return navi_check_validity_number(((const struct rmc_t *)(*this))->speedN) == navi_Ok; }
+
+inline bool Rmc_t::isCourseValid() const
+{ return navi_check_validity_number(((const struct rmc_t *)(*this))->courseT) == navi_Ok; }
+
+inline bool Rmc_t::isDateValid() const
+{
+	return (((const struct rmc_t *)(*this))->vfields & RMC_VALID_DATE) != 0 ? true : false;
+}
+
+inline bool Rmc_t::isMagneticVariationValid() const
+{ return navi_check_validity_offset(&((const struct rmc_t *)(*this))->magnVariation) == navi_Ok; }
+
+inline Rmc_t::operator const struct rmc_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct rmc_t *)p;
+}
+
+inline Rmc_t::operator struct rmc_t *()
+{
+	void *p = (void *)(*this);
+	return (struct rmc_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_rmcplusplus
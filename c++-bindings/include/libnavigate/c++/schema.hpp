@@ -0,0 +1,108 @@
+/*
+ * schema.hpp - wrappers of the sentences generated from the schema
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// For every sentence of schema.def declares the class Class_t, e.g. Dbt_t,
+// the same as the hand-written wrappers. Every field has the accessors
+// named in the schema, e.g. depthFeet(), setDepthFeet() and
+// isDepthFeetValid().
+//
+
+#ifndef INCLUDE_navi_schemaplusplus
+#define INCLUDE_navi_schemaplusplus
+
+#include "sentence.hpp"
+#include <libnavigate/schema.h>
+
+namespace libnavigate
+{
+
+namespace detail
+{
+
+// Conversions of the schema field kinds to the C++ types
+inline double schemaGet_number(double value)
+	{ return value; }
+inline double schemaGet_measure(double value)
+	{ return value; }
+inline Offset_t schemaGet_offset(const struct navi_offset_t &value)
+	{ return Offset_t::fromOffset(&value); }
+inline Status_t schemaGet_status(navi_status_t value)
+	{ return Status_t::fromStatusCode(value); }
+inline char schemaGet_character(char value)
+	{ return value; }
+
+inline void schemaSet_number(double &field, double value)
+	{ field = value; }
+inline void schemaSet_measure(double &field, double value)
+	{ field = value; }
+inline void schemaSet_offset(struct navi_offset_t &field, const Offset_t &value)
+	{ field = value.toOffset(); }
+inline void schemaSet_status(navi_status_t &field, const Status_t &value)
+	{ field = value.toStatusCode(); }
+inline void schemaSet_character(char &field, char value)
+	{ field = value; }
+
+}
+
+// The types of the values returned and taken by the accessors
+#define NAVI_SCHEMA_CXXTYPE_number		double
+#define NAVI_SCHEMA_CXXTYPE_measure		double
+#define NAVI_SCHEMA_CXXTYPE_offset		Offset_t
+#define NAVI_SCHEMA_CXXTYPE_status		Status_t
+#define NAVI_SCHEMA_CXXTYPE_character	char
+
+#define NAVI_SCHEMA_CXXARG_number		double
+#define NAVI_SCHEMA_CXXARG_measure		double
+#define NAVI_SCHEMA_CXXARG_offset		const Offset_t &
+#define NAVI_SCHEMA_CXXARG_status		const Status_t &
+#define NAVI_SCHEMA_CXXARG_character	char
+
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	NAVI_EXTERN_CLASS(Class##_t) NAVI_FINAL : public Message_t \
+	{ \
+	public: \
+		Class##_t(const TalkerId_t &tid = TalkerId_t::Unknown); \
+		Class##_t(const Message_t &msg); \
+		virtual ~Class##_t(); \
+		\
+	public: \
+		virtual void clearMessage(); \
+		\
+	public: \
+		operator const struct name##_t *() const \
+			{ const void *p = (const void *)(*this); return (const struct name##_t *)p; } \
+		operator struct name##_t *() \
+			{ void *p = (void *)(*this); return (struct name##_t *)p; } \
+		\
+	public:
+#define NAVI_SCHEMA_FIELD(name, kind, arg, member, getter, setter, validity) \
+		bool validity() const \
+			{ return navi_schema_valid_##kind(&((const struct name##_t *)(*this))->member) != 0; } \
+		NAVI_SCHEMA_CXXTYPE_##kind getter() const \
+			{ return detail::schemaGet_##kind(((const struct name##_t *)(*this))->member); } \
+		void setter(NAVI_SCHEMA_CXXARG_##kind value) \
+			{ detail::schemaSet_##kind(((struct name##_t *)(*this))->member, value); }
+#define NAVI_SCHEMA_END(name, NAME, Class) \
+	};
+#include <libnavigate/schema.def>
+
+}
+
+#endif // INCLUDE_navi_schemaplusplus
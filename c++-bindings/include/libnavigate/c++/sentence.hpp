@@ -5,6 +5,32 @@
 #include <libnavigate/generator.h>
 #include <libnavigate/parser.h>
 
+#include <libnavigate/aam.h>
+#include <libnavigate/ack.h>
+#include <libnavigate/alm.h>
+#include <libnavigate/alr.h>
+#include <libnavigate/apb.h>
+#include <libnavigate/bec.h>
+#include <libnavigate/bod.h>
+#include <libnavigate/bwc.h>
+#include <libnavigate/bwr.h>
+#include <libnavigate/bww.h>
+#include <libnavigate/dtm.h>
+#include <libnavigate/gbs.h>
+#include <libnavigate/gga.h>
+#include <libnavigate/gll.h>
+#include <libnavigate/gns.h>
+#include <libnavigate/grs.h>
+#include <libnavigate/gsa.h>
+#include <libnavigate/gst.h>
+#include <libnavigate/gsv.h>
+#include <libnavigate/mla.h>
+#include <libnavigate/rmc.h>
+#include <libnavigate/txt.h>
+#include <libnavigate/vtg.h>
+#include <libnavigate/zda.h>
+#include <libnavigate/schema.h>
+
 #include "generic.hpp"
 
 namespace libnavigate
@@ -538,36 +564,76 @@ private:
 	ModeIndicator_t m_array[MaxIndicators];
 };
 
+//
+// The message keeps its payload inline, so it is created, copied and
+// returned by value without touching the heap
 NAVI_EXTERN_CLASS(Message_t)
 {
 public:
-	Message_t(const MessageType_t &type);
+	// Storage for any of the supported sentences
+	union Payload_t
+	{
+		struct aam_t aam; struct ack_t ack; struct alm_t alm; struct alr_t alr;
+		struct apb_t apb; struct bec_t bec; struct bod_t bod; struct bwc_t bwc;
+		struct bwr_t bwr; struct bww_t bww; struct dtm_t dtm; struct gbs_t gbs;
+		struct gga_t gga; struct gll_t gll; struct gns_t gns; struct grs_t grs;
+		struct gsa_t gsa; struct gst_t gst; struct gsv_t gsv; struct mla_t mla;
+		struct rmc_t rmc; struct txt_t txt; struct vtg_t vtg; struct zda_t zda;
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class)	struct name##_t name;
+#include <libnavigate/schema.def>
+	};
+
+	// The size of the largest sentence structure
+	static const size_t MaxSize = sizeof(union Payload_t);
+
+public:
+	Message_t(const MessageType_t &type, const TalkerId_t &tid = TalkerId_t::Unknown);
 	Message_t(const MessageType_t &type, const void *data);
+	Message_t(const struct approved_field_t &address, const void *data);
 	Message_t(const Message_t &right);
+#if __cplusplus >= 201103L
+	Message_t(Message_t &&right) noexcept;
+#endif // C++11
 	virtual ~Message_t();
 
 public:
-	virtual const MessageType_t &type() const;
+	const MessageType_t &type() const
+		{ return m_type; }
+	TalkerId_t talkerId() const
+		{ return m_tid; }
+
+	// the address field for the generator
+	struct approved_field_t address() const;
+
+public:
+	void setTalkerId(const TalkerId_t &tid)
+		{ m_tid = tid; }
 
 public:
+	// reinitializes the sentence structure of the derived message
 	virtual void clearMessage();
 
 public:
-	virtual operator const void *() const
-		{ return (const void *)m_data; }
+	operator const void *() const
+		{ return (const void *)&m_data; }
 
-	virtual operator void *()
-		{ return m_data; }
+	operator void *()
+		{ return &m_data; }
 
-	virtual Message_t & operator=(const Message_t &right);
+	Message_t & operator=(const Message_t &right);
+#if __cplusplus >= 201103L
+	Message_t & operator=(Message_t &&right) noexcept;
+#endif // C++11
 
 private:
 	void setType(const MessageType_t &type);
+	void assign(const Message_t &right);
 
 private:
 	MessageType_t m_type;
+	TalkerId_t m_tid;
 	size_t m_size;
-	void *m_data;
+	union Payload_t m_data;
 };
 
 }
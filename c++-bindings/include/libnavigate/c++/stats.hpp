@@ -0,0 +1,80 @@
+/*
+ * stats.hpp - accounting of the copies and the dispatches of the C++ bindings
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_navi_statsplusplus
+#define INCLUDE_navi_statsplusplus
+
+#include <stddef.h>
+
+#include "generic.hpp"
+
+namespace libnavigate
+{
+
+//
+// When the library is built with WITH_STATS, the calls of Navigate_t are
+// counted, together with what they cost beyond the C library: the exceptions
+// thrown, the bytes of the sentences copied between Message_t objects and
+// the virtual calls. The virtual calls are not measured: the counter is
+// increased at the one annotated call site, TalkerId_t::toTalkerIdCode()
+// called through the reference in CreateTxtSequence(), once per call.
+//
+// Message_t keeps its payload inline, so the bindings allocate nothing
+// on the heap themselves; only the runtime does, for every exception.
+//
+// What happens outside of the calls, e.g. a message copied by the program,
+// is counted as Other. The counters are kept per thread, and snapshot()
+// sums all the threads, as navi_stats_snapshot() does.
+//
+NAVI_EXTERN_CLASS(BindingsStats_t)
+{
+public:
+	enum calls_t
+	{
+		ParseMessage,		// Navigate_t::ParseMessage()
+		CreateMessage,		// Navigate_t::CreateMessage()
+		CreateTxtSequence,	// Navigate_t::CreateTxtSequence()
+		Other,				// outside of the calls above
+		NmCalls
+	};
+
+	struct Counters_t
+	{
+		size_t calls;			// number of the calls, 0 for Other
+		size_t exceptions;		// exceptions thrown
+		size_t bytesCopied;		// bytes of the sentences copied
+		size_t virtualCalls;	// calls of the annotated virtual call site
+	};
+
+public:
+	// sums the counters of all the threads,
+	// throws NaviError_t::NotImplemented without WITH_STATS
+	static BindingsStats_t snapshot();
+
+public:
+	const struct Counters_t &operator[](enum calls_t call) const
+		{ return counters[call]; }
+
+public:
+	struct Counters_t counters[NmCalls];
+};
+
+}
+
+#endif // INCLUDE_navi_statsplusplus
@@ -22,12 +22,13 @@
 
 #include "sentence.hpp"
 #include <libnavigate/txt.h>
+#include <string.h>
 #include <string>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Txt_t) : public Message_t
+NAVI_EXTERN_CLASS(Txt_t) NAVI_FINAL : public Message_t
 {
 public:
 	static const int MaxTextMessageSize = 62;
@@ -38,23 +39,52 @@ public:
 	virtual ~Txt_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
-	virtual int textId() const;
-	virtual std::string textMessage() const;
+	int textId() const;
+	std::string textMessage() const;
 
 public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-	virtual void setTextId(int value);
-	virtual void setTextMessage(const std::string &value);
+	void setTextId(int value);
+	void setTextMessage(const std::string &value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct txt_t *() const;
-	virtual operator struct txt_t *();
+	operator const struct txt_t *() const;
+	operator struct txt_t *();
 };
 
+inline Txt_t::operator const struct txt_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct txt_t *)p;
+}
+
+inline Txt_t::operator struct txt_t *()
+{
+	void *p = (void *)(*this);
+	return (struct txt_t *)p;
+}
+
+inline std::string Txt_t::textMessage() const
+	{ return std::string(((const struct txt_t *)(*this))->textmsg); }
+
+inline void Txt_t::setTextMessage(const std::string &value)
+{
+	strncpy(((struct txt_t *)(*this))->textmsg, value.c_str(),
+		sizeof(((struct txt_t *)(*this))->textmsg));
+}
+
+inline int Txt_t::textId() const
+{
+	return ((const struct txt_t *)(*this))->textid;
+}
+
+inline void Txt_t::setTextId(int value)
+{
+	((struct txt_t *)(*this))->textid = value;
+}
+
 }
 
 #endif // INCLUDE_navi_txtplusplus
@@ -0,0 +1,273 @@
+/*
+ * typed.hpp - C++17 typed messages with std::variant
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Every sentence is a plain value Sentence_t<T> holding the talker id and
+// the C structure. A parsed sentence is returned as AnyMessage_t, a variant
+// of all of them, and is dispatched with std::visit:
+//
+//	std::visit(Overloaded_t{
+//		[](const Rmc_v &rmc) { use(rmc.data.fix); },
+//		[](const Gga_v &gga) { use(gga.data.nmsatellites); },
+//		[](const auto &) { } }, ParseAny(buffer, size, &nmread));
+//
+// Fields are accessed directly, without virtual calls or heap copies.
+//
+
+#ifndef INCLUDE_navi_typedplusplus
+#define INCLUDE_navi_typedplusplus
+
+#if !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#error "typed.hpp requires C++17"
+#endif // C++17
+
+#include "errors.hpp"
+#include "sentence.hpp"
+
+#include <variant>
+
+namespace libnavigate
+{
+
+// The sentence formatter of the C structure
+template <typename T> struct SentenceTraits_t;
+
+#define NAVI_SENTENCE_TRAITS(name, fmt) \
+	template <> struct SentenceTraits_t<struct name> \
+		{ static constexpr navi_approved_fmt_t formatter = fmt; };
+
+NAVI_SENTENCE_TRAITS(aam_t, navi_AAM)
+NAVI_SENTENCE_TRAITS(ack_t, navi_ACK)
+NAVI_SENTENCE_TRAITS(alm_t, navi_ALM)
+NAVI_SENTENCE_TRAITS(alr_t, navi_ALR)
+NAVI_SENTENCE_TRAITS(apb_t, navi_APB)
+NAVI_SENTENCE_TRAITS(bec_t, navi_BEC)
+NAVI_SENTENCE_TRAITS(bod_t, navi_BOD)
+NAVI_SENTENCE_TRAITS(bwc_t, navi_BWC)
+NAVI_SENTENCE_TRAITS(bwr_t, navi_BWR)
+NAVI_SENTENCE_TRAITS(bww_t, navi_BWW)
+NAVI_SENTENCE_TRAITS(dtm_t, navi_DTM)
+NAVI_SENTENCE_TRAITS(gbs_t, navi_GBS)
+NAVI_SENTENCE_TRAITS(gga_t, navi_GGA)
+NAVI_SENTENCE_TRAITS(gll_t, navi_GLL)
+NAVI_SENTENCE_TRAITS(gns_t, navi_GNS)
+NAVI_SENTENCE_TRAITS(grs_t, navi_GRS)
+NAVI_SENTENCE_TRAITS(gsa_t, navi_GSA)
+NAVI_SENTENCE_TRAITS(gst_t, navi_GST)
+NAVI_SENTENCE_TRAITS(gsv_t, navi_GSV)
+NAVI_SENTENCE_TRAITS(mla_t, navi_MLA)
+NAVI_SENTENCE_TRAITS(rmc_t, navi_RMC)
+NAVI_SENTENCE_TRAITS(txt_t, navi_TXT)
+NAVI_SENTENCE_TRAITS(vtg_t, navi_VTG)
+NAVI_SENTENCE_TRAITS(zda_t, navi_ZDA)
+
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class)	NAVI_SENTENCE_TRAITS(name##_t, navi_##NAME)
+#include <libnavigate/schema.def>
+
+#undef NAVI_SENTENCE_TRAITS
+
+//
+// The sentence as a plain value
+template <typename T>
+struct Sentence_t
+{
+	static constexpr navi_approved_fmt_t formatter = SentenceTraits_t<T>::formatter;
+
+	navi_talkerid_t tid;
+	T data;
+
+	// the address field for the generator
+	struct approved_field_t address() const
+		{ return { formatter, tid }; }
+};
+
+typedef Sentence_t<struct aam_t> Aam_v;
+typedef Sentence_t<struct ack_t> Ack_v;
+typedef Sentence_t<struct alm_t> Alm_v;
+typedef Sentence_t<struct alr_t> Alr_v;
+typedef Sentence_t<struct apb_t> Apb_v;
+typedef Sentence_t<struct bec_t> Bec_v;
+typedef Sentence_t<struct bod_t> Bod_v;
+typedef Sentence_t<struct bwc_t> Bwc_v;
+typedef Sentence_t<struct bwr_t> Bwr_v;
+typedef Sentence_t<struct bww_t> Bww_v;
+typedef Sentence_t<struct dtm_t> Dtm_v;
+typedef Sentence_t<struct gbs_t> Gbs_v;
+typedef Sentence_t<struct gga_t> Gga_v;
+typedef Sentence_t<struct gll_t> Gll_v;
+typedef Sentence_t<struct gns_t> Gns_v;
+typedef Sentence_t<struct grs_t> Grs_v;
+typedef Sentence_t<struct gsa_t> Gsa_v;
+typedef Sentence_t<struct gst_t> Gst_v;
+typedef Sentence_t<struct gsv_t> Gsv_v;
+typedef Sentence_t<struct mla_t> Mla_v;
+typedef Sentence_t<struct rmc_t> Rmc_v;
+typedef Sentence_t<struct txt_t> Txt_v;
+typedef Sentence_t<struct vtg_t> Vtg_v;
+typedef Sentence_t<struct zda_t> Zda_v;
+
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class)	typedef Sentence_t<struct name##_t> Class##_v;
+#include <libnavigate/schema.def>
+
+// Any of the sentences. std::monostate stands for no message.
+typedef std::variant<std::monostate,
+	Aam_v, Ack_v, Alm_v, Alr_v, Apb_v, Bec_v, Bod_v, Bwc_v, Bwr_v, Bww_v,
+	Dtm_v, Gbs_v, Gga_v, Gll_v, Gns_v, Grs_v, Gsa_v, Gst_v, Gsv_v, Mla_v,
+	Rmc_v, Txt_v, Vtg_v, Zda_v
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class)	, Class##_v
+#include <libnavigate/schema.def>
+	> AnyMessage_t;
+
+//
+// Builds the visitor from several lambdas
+template <typename... Ts>
+struct Overloaded_t : Ts...
+	{ using Ts::operator()...; };
+
+template <typename... Ts>
+Overloaded_t(Ts...) -> Overloaded_t<Ts...>;
+
+namespace detail
+{
+
+// Moves the parsed structure into the alternative of the variant
+template <size_t I = 1>
+inline bool emplaceParsed(AnyMessage_t &result, const struct approved_field_t &address,
+	const void *data)
+{
+	if constexpr (I < std::variant_size_v<AnyMessage_t>)
+	{
+		typedef std::variant_alternative_t<I, AnyMessage_t> value_t;
+
+		if (address.afmt == value_t::formatter)
+		{
+			value_t &value = result.emplace<I>();
+
+			value.tid = address.tid;
+			value.data = *static_cast<const decltype(value_t::data) *>(data);
+			return true;
+		}
+		else
+		{
+			return emplaceParsed<I + 1>(result, address, data);
+		}
+	}
+	else
+	{
+		return false;
+	}
+}
+
+}
+
+//
+// Parses the sentence from buffer. In case of error returns std::monostate
+// and sets error, never throws.
+inline AnyMessage_t ParseAny(char *buffer, size_t maxsize, size_t *nmread, NaviError_t &error)
+{
+	union
+	{
+		struct approved_field_t address;
+		double align;
+		char bytes[sizeof(struct approved_field_t) + Message_t::MaxSize];
+	} parsed;
+
+	navi_addrfield_t msgtype;
+	AnyMessage_t result;
+
+	if (navi_parse_msg(buffer, maxsize, sizeof(parsed), &msgtype, &parsed, nmread) != navi_Ok)
+		error = NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+	else if ((msgtype != navi_af_Approved) ||
+			!detail::emplaceParsed(result, parsed.address, parsed.bytes + sizeof(struct approved_field_t)))
+		error = NaviError_t::MsgNotSupported;
+
+	return result;
+}
+
+//
+// Parses the sentence from buffer. In case of error throws NaviError_t.
+inline AnyMessage_t ParseAny(char *buffer, size_t maxsize, size_t *nmread)
+{
+	NaviError_t error;
+	AnyMessage_t result = ParseAny(buffer, maxsize, nmread, error);
+
+	if (std::holds_alternative<std::monostate>(result))
+		throw error;
+
+	return result;
+}
+
+//
+// Creates the sentence. Returns the number of characters written,
+// in case of error returns 0 and sets error, never throws.
+template <typename T>
+inline size_t CreateSentence(const Sentence_t<T> &msg, char *buffer, size_t maxsize,
+	NaviError_t &error)
+{
+	size_t nmwritten;
+	struct approved_field_t address = msg.address();
+
+	if (navi_create_msg(navi_af_Approved, &address, &msg.data, buffer,
+			maxsize, &nmwritten) != navi_Ok)
+	{
+		error = NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+		return 0;
+	}
+
+	return nmwritten;
+}
+
+inline size_t CreateSentence(const AnyMessage_t &msg, char *buffer, size_t maxsize,
+	NaviError_t &error)
+{
+	return std::visit(Overloaded_t{
+		[&](const auto &value) { return CreateSentence(value, buffer, maxsize, error); },
+		[&](const std::monostate &) -> size_t { error = NaviError_t::InvalidParameter; return 0; } },
+		msg);
+}
+
+//
+// Creates the sentence. Returns the number of characters written,
+// in case of error throws NaviError_t.
+template <typename T>
+inline size_t CreateSentence(const Sentence_t<T> &msg, char *buffer, size_t maxsize)
+{
+	NaviError_t error;
+	size_t nmwritten = CreateSentence(msg, buffer, maxsize, error);
+
+	if (nmwritten == 0)
+		throw error;
+
+	return nmwritten;
+}
+
+inline size_t CreateSentence(const AnyMessage_t &msg, char *buffer, size_t maxsize)
+{
+	NaviError_t error;
+	size_t nmwritten = CreateSentence(msg, buffer, maxsize, error);
+
+	if (nmwritten == 0)
+		throw error;
+
+	return nmwritten;
+}
+
+}
+
+#endif // INCLUDE_navi_typedplusplus
@@ -26,7 +26,7 @@
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Vtg_t) : public Message_t
+NAVI_EXTERN_CLASS(Vtg_t) NAVI_FINAL : public Message_t
 {
 public:
 	Vtg_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -34,38 +34,87 @@ public:
 	virtual ~Vtg_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isCourseTrueValid() const;
+	bool isCourseMagneticValid() const;
+	bool isSpeedKnotsValid() const;
+	bool isSpeedKmphValid() const;
 
 public:
-	virtual bool isCourseTrueValid() const;
-	virtual bool isCourseMagneticValid() const;
-	virtual bool isSpeedKnotsValid() const;
-	virtual bool isSpeedKmphValid() const;
+	double courseTrue() const;
+	double courseMagnetic() const;
+	double speedKnots() const;
+	double speedKmph() const;
+	ModeIndicator_t modeIndicator() const;
 
 public:
-	virtual double courseTrue() const;
-	virtual double courseMagnetic() const;
-	virtual double speedKnots() const;
-	virtual double speedKmph() const;
-	virtual ModeIndicator_t modeIndicator() const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setCourseTrue(double value);
-	virtual void setCourseMagnetic(double value);
-	virtual void setSpeedKnots(double value);
-	virtual void setSpeedKmph(double value);
-	virtual void setModeIndicator(const ModeIndicator_t &mi);
+	void setCourseTrue(double value);
+	void setCourseMagnetic(double value);
+	void setSpeedKnots(double value);
+	void setSpeedKmph(double value);
+	void setModeIndicator(const ModeIndicator_t &mi);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct vtg_t *() const;
-	virtual operator struct vtg_t *();
+	operator const struct vtg_t *() const;
+	operator struct vtg_t *();
 };
 
+inline double Vtg_t::courseTrue() const
+{ return ((const struct vtg_t *)(*this))->courseT; }
+
+inline double Vtg_t::courseMagnetic() const
+{ return ((const struct vtg_t *)(*this))->courseM; }
+
+inline double Vtg_t::speedKnots() const
+{ return ((const struct vtg_t *)(*this))->speedN; }
+
+inline double Vtg_t::speedKmph() const
+{ return ((const struct vtg_t *)(*this))->speedK; }
+
+inline ModeIndicator_t Vtg_t::modeIndicator() const
+{ return ModeIndicator_t::fromModeIndCode(((const struct vtg_t *)(*this))->mi); }
+
+inline void Vtg_t::setCourseTrue(double value)
+{ ((struct vtg_t *)(*this))->courseT = value; }
+
+inline void Vtg_t::setCourseMagnetic(double value)
+{ ((struct vtg_t *)(*this))->courseM = value; }
+
+inline void Vtg_t::setSpeedKnots(double value)
+{ ((struct vtg_t *)(*this))->speedN = value; }
+
+inline void Vtg_t::setSpeedKmph(double value)
+{ ((struct vtg_t *)(*this))->speedK = value; }
+
+inline void Vtg_t::setModeIndicator(const ModeIndicator_t &mi)
+{ ((struct vtg_t *)(*this))->mi = mi.toModeIndCode(); }
+
+inline bool Vtg_t::isCourseTrueValid() const
+{ return navi_check_validity_number(((const struct vtg_t *)(*this))->courseT) == navi_Ok; }
+
+inline bool Vtg_t::isCourseMagneticValid() const
+{ return navi_check_validity_number(((const struct vtg_t *)(*this))->courseM) == navi_Ok; }
+
+inline bool Vtg_t::isSpeedKnotsValid() const
+{ return navi_check_validity_number(((const struct vtg_t *)(*this))->speedN) == navi_Ok; }
+
+inline bool Vtg_t::isSpeedKmphValid() const
+{ return navi_check_validity_number(((const struct vtg_t *)(*this))->speedK) == navi_Ok; }
+
+inline Vtg_t::operator const struct vtg_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct vtg_t *)p;
+}
+
+inline Vtg_t::operator struct vtg_t *()
+{
+	void *p = (void *)(*this);
+	return (struct vtg_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_vtgplusplus
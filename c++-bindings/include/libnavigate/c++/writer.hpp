@@ -0,0 +1,165 @@
+/*
+ * writer.hpp - generator of the sentences into the caller's output buffer
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// The writer appends the sentences one after another to the output
+// owned by the caller, e.g. all the sentences of an epoch:
+//
+//	std::string epoch;
+//	Writer_t writer(epoch);
+//
+//	writer.append(rmc);
+//	writer.append(gga);
+//	send(socket, epoch.data(), epoch.size(), 0);
+//
+// Each sentence is generated right in the output, and the returned
+// std::string_view refers to it there. The RMC and GGA sentences are
+// generated by the template codec (see codec.hpp), the others by the
+// C library.
+//
+
+#ifndef INCLUDE_navi_writerplusplus
+#define INCLUDE_navi_writerplusplus
+
+#include "codec.hpp"
+
+#include <string>
+#include <string_view>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif // __has_include(<version>)
+#endif // __has_include
+
+#if defined(__cpp_lib_span)
+#include <span>
+#endif // __cpp_lib_span
+
+namespace libnavigate
+{
+
+class Writer_t
+{
+public:
+	// The room reserved in the growable output for one sentence,
+	// enough for the codec to print it in place
+	static const size_t SentenceRoom = NAVI_SENTENCE_MAXSIZE + 8;
+
+	// Writes to the buffer of maxsize bytes. The sentences are null
+	// terminated, so the room for the null character is needed.
+	Writer_t(char *buffer, size_t maxsize)
+		: m_buffer(buffer), m_maxsize(maxsize), m_size(0), m_string(nullptr) { }
+
+#if defined(__cpp_lib_span)
+	explicit Writer_t(std::span<char> buffer)
+		: Writer_t(buffer.data(), buffer.size()) { }
+#endif // __cpp_lib_span
+
+	// Appends to the string, growing it as needed. The views returned
+	// by append() are valid until the string is changed.
+	explicit Writer_t(std::string &output)
+		: m_buffer(nullptr), m_maxsize(0), m_size(0), m_string(&output) { }
+
+	// Generates the sentence after the ones already written. Returns
+	// the view of the sentence in the output. In case of error returns
+	// an empty view and sets error, never throws. The sentences written
+	// before are kept.
+	template <typename T>
+	std::string_view append(const Sentence_t<T> &msg, NaviError_t &error)
+	{
+		return write([&](char *out, size_t room) { return Encode(msg, out, room, error); });
+	}
+
+	std::string_view append(const AnyMessage_t &msg, NaviError_t &error)
+	{
+		return write([&](char *out, size_t room) { return EncodeAny(msg, out, room, error); });
+	}
+
+	// Generates the sentence. In case of error throws NaviError_t.
+	template <typename T>
+	std::string_view append(const Sentence_t<T> &msg)
+	{
+		NaviError_t error;
+		std::string_view result = append(msg, error);
+
+		if (result.empty())
+			throw error;
+
+		return result;
+	}
+
+	std::string_view append(const AnyMessage_t &msg)
+	{
+		NaviError_t error;
+		std::string_view result = append(msg, error);
+
+		if (result.empty())
+			throw error;
+
+		return result;
+	}
+
+	// All the sentences written
+	std::string_view view() const
+		{ return m_string ? std::string_view(*m_string) : std::string_view(m_buffer, m_size); }
+
+	size_t size() const
+		{ return m_string ? m_string->size() : m_size; }
+
+	// Starts over from the beginning of the output
+	void clear()
+	{
+		if (m_string)
+			m_string->clear();
+		m_size = 0;
+	}
+
+private:
+	template <typename Encoder>
+	std::string_view write(Encoder encode)
+	{
+		size_t oldsize, nmwritten;
+
+		if (m_string)
+		{
+			oldsize = m_string->size();
+			m_string->resize(oldsize + SentenceRoom);
+
+			nmwritten = encode(&(*m_string)[oldsize], SentenceRoom);
+			m_string->resize(oldsize + nmwritten);
+
+			return std::string_view(m_string->data() + oldsize, nmwritten);
+		}
+
+		oldsize = m_size;
+		nmwritten = encode(m_buffer + oldsize, m_maxsize - oldsize);
+		m_size += nmwritten;
+
+		return std::string_view(m_buffer + oldsize, nmwritten);
+	}
+
+	char *m_buffer;
+	size_t m_maxsize, m_size;
+	std::string *m_string;
+};
+
+}
+
+#endif // INCLUDE_navi_writerplusplus
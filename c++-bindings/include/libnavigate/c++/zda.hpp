@@ -22,11 +22,12 @@
 
 #include "sentence.hpp"
 #include <libnavigate/zda.h>
+#include <libnavigate/common.h>
 
 namespace libnavigate
 {
 
-NAVI_EXTERN_CLASS(Zda_t) : public Message_t
+NAVI_EXTERN_CLASS(Zda_t) NAVI_FINAL : public Message_t
 {
 public:
 	Zda_t(const TalkerId_t &tid = TalkerId_t::Unknown);
@@ -34,33 +35,77 @@ public:
 	virtual ~Zda_t();
 
 public:
-	virtual TalkerId_t talkerId() const;
+	bool isUtcValid() const;
+	bool isDateValid() const;
+	bool isLocalZoneOffsetValid() const;
 
 public:
-	virtual bool isUtcValid() const;
-	virtual bool isDateValid() const;
-	virtual bool isLocalZoneOffsetValid() const;
+	Utc_t utc() const;
+	Date_t date() const;
+	int localZoneOffset() const;
 
 public:
-	virtual Utc_t utc() const;
-	virtual Date_t date() const;
-	virtual int localZoneOffset() const;
-
-public:
-	virtual void setTalkerId(const TalkerId_t &tid);
-
-	virtual void setUtc(const Utc_t &utc);
-	virtual void setDate(const Date_t &date);
-	virtual void setLocalZoneOffset(int value);
+	void setUtc(const Utc_t &utc);
+	void setDate(const Date_t &date);
+	void setLocalZoneOffset(int value);
 
 public:
 	virtual void clearMessage();
 
 public:
-	virtual operator const struct zda_t *() const;
-	virtual operator struct zda_t *();
+	operator const struct zda_t *() const;
+	operator struct zda_t *();
 };
 
+inline Utc_t Zda_t::utc() const
+	{ return Utc_t::fromUtcStruct(((const struct zda_t *)(*this))->utc); }
+
+inline Date_t Zda_t::date() const
+	{ return Date_t::fromDateStruct(((const struct zda_t *)(*this))->date); }
+
+inline int Zda_t::localZoneOffset() const
+	{ return ((const struct zda_t *)(*this))->lzoffset; }
+
+inline void Zda_t::setUtc(const Utc_t &utc)
+	{ ((struct zda_t *)(*this))->utc = utc.toUtcStruct(); }
+
+inline void Zda_t::setDate(const Date_t &date)
+{
+	((struct zda_t *)(*this))->date = date.toDateStruct();
+	((struct zda_t *)(*this))->vfields |= ZDA_VALID_DATE;
+}
+
+inline void Zda_t::setLocalZoneOffset(int value)
+{
+	((struct zda_t *)(*this))->lzoffset = value;
+	((struct zda_t *)(*this))->vfields |= ZDA_VALID_LOCALZONE;
+}
+
+inline bool Zda_t::isUtcValid() const
+	{ return navi_check_validity_utc(&((const struct zda_t *)(*this))->utc) == navi_Ok; }
+
+inline bool Zda_t::isDateValid() const
+{
+	return (((const struct zda_t *)(*this))->vfields & ZDA_VALID_DATE) != 0 ? true : false;
+}
+
+inline bool Zda_t::isLocalZoneOffsetValid() const
+{
+	return (((const struct zda_t *)(*this))->vfields & ZDA_VALID_LOCALZONE) != 0 ? true : false;
+}
+
+inline Zda_t::operator const struct zda_t *() const
+{
+	const void *p = (const void *)(*this);
+	return (const struct zda_t *)p;
+}
+
+inline Zda_t::operator struct zda_t *()
+{
+	void *p = (void *)(*this);
+	return (struct zda_t *)p;
+}
+
 }
 
 #endif // INCLUDE_navi_zdaplusplus
@@ -0,0 +1,75 @@
+/*
+ * instrument.hpp - hooks of the accounting in the C++ bindings
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_navi_instrumentplusplus
+#define INCLUDE_navi_instrumentplusplus
+
+#include "include/libnavigate/c++/stats.hpp"
+
+namespace libnavigate
+{
+
+//
+// The counters of BindingsStats_t are kept in the counters of the bindings
+// of the C statistics: the first one holds the call in progress plus one,
+// or 0, then go the counters of every call.
+//
+enum statscounter_t
+{
+	StatsCalls,
+	StatsExceptions,
+	StatsBytesCopied,
+	StatsVirtualCalls,
+	NmStatsCounters
+};
+
+#ifdef WITH_STATS
+
+//
+// Adds the value to the counter of the call in progress
+void countStats(enum statscounter_t counter, size_t value = 1);
+
+//
+// Counts the call of Navigate_t from the construction to the destruction.
+// The calls made by the call are counted as its part.
+class StatsScope_t
+{
+public:
+	StatsScope_t(enum BindingsStats_t::calls_t call);
+	~StatsScope_t();
+
+private:
+	bool m_entered;
+};
+
+#else
+
+inline void countStats(enum statscounter_t, size_t = 1) { }
+
+class StatsScope_t
+{
+public:
+	StatsScope_t(enum BindingsStats_t::calls_t) { }
+};
+
+#endif // WITH_STATS
+
+}
+
+#endif // INCLUDE_navi_instrumentplusplus
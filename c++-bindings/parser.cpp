@@ -1,19 +1,52 @@
 #include "include/libnavigate/c++/errors.hpp"
 #include "include/libnavigate/c++/navigate.hpp"
+#include "instrument.hpp"
 
 namespace libnavigate
 {
 
 Message_t Navigate_t::ParseMessage(char *buffer, size_t maxsize, size_t *nmread)
 {
-	char parsed[2 * 1024];
-	navierr_status_t result;
-	navi_approved_fmt_t msgtype;
+	StatsScope_t scope(BindingsStats_t::ParseMessage);
+	Message_t msg(MessageType_t::Unknown);
+	NaviError_t error;
 
-	if ((result = navi_parse_msg(buffer, maxsize, sizeof(parsed), parsed, &msgtype, nmread)) != navi_Ok)
-		throw NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+	if (!ParseMessage(buffer, maxsize, nmread, msg, error))
+	{
+		countStats(StatsExceptions);
+		throw error;
+	}
 
-	return Message_t(MessageType_t::fromSentenceFormatter(msgtype), parsed);
+	return msg;
+}
+
+bool Navigate_t::ParseMessage(char *buffer, size_t maxsize, size_t *nmread,
+	Message_t &msg, NaviError_t &error)
+{
+	// the address field followed by the sentence, as written by the parser
+	union
+	{
+		struct approved_field_t address;
+		double align;
+		char bytes[sizeof(struct approved_field_t) + Message_t::MaxSize];
+	} parsed;
+
+	StatsScope_t scope(BindingsStats_t::ParseMessage);
+	navi_addrfield_t msgtype;
+
+	if (navi_parse_msg(buffer, maxsize, sizeof(parsed), &msgtype, &parsed, nmread) != navi_Ok)
+	{
+		error = NaviError_t::fromErrorCode(navierr_get_last()->errclass);
+		return false;
+	}
+	if (msgtype != navi_af_Approved)
+	{
+		error = NaviError_t::MsgNotSupported;
+		return false;
+	}
+
+	msg = Message_t(parsed.address, parsed.bytes + sizeof(struct approved_field_t));
+	return true;
 }
 
 }
@@ -22,103 +22,17 @@
 namespace libnavigate
 {
 
-Rmc_t::Rmc_t(const TalkerId_t &tid) : Message_t(MessageType_t::RMC)
-{ navi_init_rmc((struct rmc_t *)(*this), tid.toTalkerIdCode()); }
+Rmc_t::Rmc_t(const TalkerId_t &tid) : Message_t(MessageType_t::RMC, tid)
+{ navi_init_rmc((struct rmc_t *)(*this)); }
 
 Rmc_t::Rmc_t(const Message_t &msg) : Message_t(msg) { }
 
 Rmc_t::~Rmc_t() { }
 
-TalkerId_t Rmc_t::talkerId() const
-{ return TalkerId_t::fromTalkerIdCode(((const struct rmc_t *)(*this))->tid); }
-
-Utc_t Rmc_t::utc() const
-{ return Utc_t::fromUtcStruct(((const struct rmc_t *)(*this))->utc); }
-
-Status_t Rmc_t::status() const
-{ return Status_t::fromStatusCode(((const struct rmc_t *)(*this))->status); }
-
-PositionFix_t Rmc_t::positionFix() const
-{ return PositionFix_t::fromPosition(&((const struct rmc_t *)(*this))->fix); }
-
-double Rmc_t::speed() const
-{ return ((const struct rmc_t *)(*this))->speedN; }
-
-double Rmc_t::course() const
-{ return ((const struct rmc_t *)(*this))->courseT; }
-
-Date_t Rmc_t::date() const
-{ return Date_t::fromDateStruct(((const struct rmc_t *)(*this))->date); }
-
-Offset_t Rmc_t::magneticVariation() const
-{ return Offset_t::fromOffset(&((const struct rmc_t *)(*this))->magnVariation); }
-
-ModeIndicator_t Rmc_t::modeIndicator() const
-{ return ModeIndicator_t::fromModeIndCode(((const struct rmc_t *)(*this))->mi); }
-
-void Rmc_t::setTalkerId(const TalkerId_t &tid)
-{ ((struct rmc_t *)(*this))->tid = tid.toTalkerIdCode(); }
-
-void Rmc_t::setUtc(const Utc_t &utc)
-{ ((struct rmc_t *)(*this))->utc = utc.toUtcStruct(); }
-
-void Rmc_t::setStatus(const Status_t &status)
-{ ((struct rmc_t *)(*this))->status = status.toStatusCode(); }
-
-void Rmc_t::setPositionFix(const PositionFix_t &fix)
-{ ((struct rmc_t *)(*this))->fix = fix.toPosition(); }
-
-void Rmc_t::setSpeed(double value)
-{ ((struct rmc_t *)(*this))->speedN = value; }
-
-void Rmc_t::setCourse(double value)
-{ ((struct rmc_t *)(*this))->courseT = value; }
-
-void Rmc_t::setDate(const Date_t &date)
-{
-	((struct rmc_t *)(*this))->date = date.toDateStruct();
-	((struct rmc_t *)(*this))->vfields |= RMC_VALID_DATE;
-}
-
-void Rmc_t::setMagneticVariation(const Offset_t &offset)
-{ ((struct rmc_t *)(*this))->magnVariation = offset.toOffset(); }
-
-void Rmc_t::setModeIndicator(const ModeIndicator_t &mi)
-{ ((struct rmc_t *)(*this))->mi = mi.toModeIndCode(); }
-
-bool Rmc_t::isUtcValid() const
-{ return navi_check_validity_utc(&((const struct rmc_t *)(*this))->utc) == navi_Ok; }
-
-bool Rmc_t::isPositionValid() const
-{ return ((const struct rmc_t *)(*this))->fix.latitude.sign != navi_offset_NULL; }
-
-bool Rmc_t::isSpeedValid() const
-{ return navi_check_validity_number(((const struct rmc_t *)(*this))->speedN) == navi_Ok; }
-
-bool Rmc_t::isCourseValid() const
-{ return navi_check_validity_number(((const struct rmc_t *)(*this))->courseT) == navi_Ok; }
-
-bool Rmc_t::isDateValid() const
-{
-	return (((const struct rmc_t *)(*this))->vfields & RMC_VALID_DATE) != 0 ? true : false;
-}
-
-bool Rmc_t::isMagneticVariationValid() const
-{ return navi_check_validity_offset(&((const struct rmc_t *)(*this))->magnVariation) == navi_Ok; }
-
 void Rmc_t::clearMessage()
-{ navi_init_rmc((struct rmc_t *)(*this), navi_talkerid_Unknown); }
-
-Rmc_t::operator const struct rmc_t *() const
-{
-	const void *p = (const void *)(*this);
-	return (const struct rmc_t *)p;
-}
-
-Rmc_t::operator struct rmc_t *()
 {
-	void *p = (void *)(*this);
-	return (struct rmc_t *)p;
+	navi_init_rmc((struct rmc_t *)(*this));
+	Message_t::setTalkerId(TalkerId_t::Unknown);
 }
 
 }
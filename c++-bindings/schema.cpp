@@ -0,0 +1,40 @@
+/*
+* schema.cpp - implementation of the classes generated from the schema
+*
+* Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "include/libnavigate/c++/schema.hpp"
+
+namespace libnavigate
+{
+
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	Class##_t::Class##_t(const TalkerId_t &tid) : Message_t(MessageType_t::NAME, tid) \
+	{ navi_init_##name((struct name##_t *)(*this)); } \
+	\
+	Class##_t::Class##_t(const Message_t &msg) : Message_t(msg) { } \
+	\
+	Class##_t::~Class##_t() { } \
+	\
+	void Class##_t::clearMessage() \
+	{ \
+		navi_init_##name((struct name##_t *)(*this)); \
+		Message_t::setTalkerId(TalkerId_t::Unknown); \
+	}
+#include <libnavigate/schema.def>
+
+}
@@ -1,26 +1,7 @@
 #include "include/libnavigate/c++/errors.hpp"
 #include "include/libnavigate/c++/sentence.hpp"
+#include "instrument.hpp"
 #include <string.h>
-#include <stdlib.h>
-
-#include <libnavigate/aam.h>
-#include <libnavigate/ack.h>
-#include <libnavigate/alm.h>
-#include <libnavigate/alr.h>
-#include <libnavigate/dtm.h>
-#include <libnavigate/gbs.h>
-#include <libnavigate/gga.h>
-#include <libnavigate/gll.h>
-#include <libnavigate/gns.h>
-#include <libnavigate/grs.h>
-#include <libnavigate/gsa.h>
-#include <libnavigate/gst.h>
-#include <libnavigate/gsv.h>
-#include <libnavigate/mla.h>
-#include <libnavigate/rmc.h>
-#include <libnavigate/txt.h>
-#include <libnavigate/vtg.h>
-#include <libnavigate/zda.h>
 
 #include <libnavigate/common.h>
 
@@ -247,7 +228,6 @@ TalkerId_t TalkerId_t::fromTalkerIdCode(navi_talkerid_t tid)
 	case navi_ZQ: return ZQ;
 	case navi_ZV: return ZV;
 	case navi_WI: return WI;
-	case navi_talkerid_Proprietary: return P;
 	default:
 		return Unknown;
 	}
@@ -298,7 +278,6 @@ navi_talkerid_t TalkerId_t::toTalkerIdCode() const
 	case ZQ: return navi_ZQ;
 	case ZV: return navi_ZV;
 	case WI: return navi_WI;
-	case P: return navi_talkerid_Proprietary;
 	default:
 		return navi_talkerid_Unknown;
 	}
@@ -541,48 +520,55 @@ struct navi_offset_t Offset_t::toOffset() const
 	return result;
 }
 
-Message_t::Message_t(const MessageType_t &type)
+Message_t::Message_t(const MessageType_t &type, const TalkerId_t &tid)
+	: m_type(MessageType_t::Unknown), m_tid(tid), m_size(0)
 {
-	m_type = MessageType_t::Unknown;
-	m_data = 0;
-	m_size = 0;
-
 	setType(type);
+	memset(&m_data, 0, m_size);
 }
 
 Message_t::Message_t(const MessageType_t &type, const void *data)
+	: m_type(MessageType_t::Unknown), m_size(0)
 {
-	m_type = MessageType_t::Unknown;
-	m_data = 0;
-	m_size = 0;
-
 	setType(type);
-	memcpy(m_data, data, m_size);
+	memcpy(&m_data, data, m_size);
+	countStats(StatsBytesCopied, m_size);
 }
 
-Message_t::Message_t(const Message_t &right)
+Message_t::Message_t(const struct approved_field_t &address, const void *data)
+	: m_type(MessageType_t::Unknown), m_tid(TalkerId_t::fromTalkerIdCode(address.tid)), m_size(0)
 {
-	m_type = MessageType_t::Unknown;
-	m_data = 0;
-	m_size = 0;
-
-	setType(right.type());
-	memcpy(m_data, right, m_size);
+	setType(MessageType_t::fromSentenceFormatter(address.afmt));
+	memcpy(&m_data, data, m_size);
+	countStats(StatsBytesCopied, m_size);
 }
 
-Message_t::~Message_t()
+Message_t::Message_t(const Message_t &right)
+	{ assign(right); }
+
+#if __cplusplus >= 201103L
+Message_t::Message_t(Message_t &&right) noexcept
+	{ assign(right); }
+#endif // C++11
+
+Message_t::~Message_t() { }
+
+struct approved_field_t Message_t::address() const
 {
-	clearMessage();
-}
+	struct approved_field_t result;
 
-const MessageType_t & Message_t::type() const
-	{ return m_type; }
+	result.afmt = m_type.toSentenceFormatter();
+	result.tid = m_tid.toTalkerIdCode();
 
+	return result;
+}
+
+//
+// Sets the type and the size of payload. The storage is always large enough.
 void Message_t::setType(const MessageType_t &type)
 {
-	clearMessage();
-
 	m_type = type;
+	m_size = 0;
 
 	switch (m_type)
 	{
@@ -599,14 +585,24 @@ void Message_t::setType(const MessageType_t &type)
 		m_size = sizeof(struct alr_t);
 		break;
 	case MessageType_t::APB:
+		m_size = sizeof(struct apb_t);
+		break;
 	case MessageType_t::BEC:
+		m_size = sizeof(struct bec_t);
+		break;
 	case MessageType_t::BOD:
+		m_size = sizeof(struct bod_t);
+		break;
 	case MessageType_t::BWC:
+		m_size = sizeof(struct bwc_t);
+		break;
 	case MessageType_t::BWR:
+		m_size = sizeof(struct bwr_t);
+		break;
 	case MessageType_t::BWW:
-	case MessageType_t::DBT:
+		m_size = sizeof(struct bww_t);
+		break;
 	case MessageType_t::DCN:
-	case MessageType_t::DPT:
 	case MessageType_t::DSC:
 	case MessageType_t::DSE:
 	case MessageType_t::DSI:
@@ -643,8 +639,6 @@ void Message_t::setType(const MessageType_t &type)
 	case MessageType_t::GSV:
 		m_size = sizeof(struct gsv_t);
 		break;
-	case MessageType_t::HDG:
-	case MessageType_t::HDT:
 	case MessageType_t::HMR:
 	case MessageType_t::HMS:
 	case MessageType_t::HSC:
@@ -659,7 +653,6 @@ void Message_t::setType(const MessageType_t &type)
 	case MessageType_t::MSS:
 	case MessageType_t::MTW:
 	case MessageType_t::MWD:
-	case MessageType_t::MWV:
 	case MessageType_t::OSD:
 	case MessageType_t::RMA:
 	case MessageType_t::RMB:
@@ -704,36 +697,50 @@ void Message_t::setType(const MessageType_t &type)
 	case MessageType_t::ZFO:
 	case MessageType_t::ZTG:
 		throw NaviError_t::NotImplemented;
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	case MessageType_t::NAME: \
+		m_size = sizeof(struct name##_t); \
+		break;
+#include <libnavigate/schema.def>
 	default:
-		m_data = 0;
-		m_size = 0;
 		break;
 	}
+}
 
-	if (m_size > 0)
-		m_data = ::malloc(m_size);
+//
+// Copies only the bytes used by the sentence
+void Message_t::assign(const Message_t &right)
+{
+	m_type = right.m_type;
+	m_tid = right.m_tid;
+	m_size = right.m_size;
+	memcpy(&m_data, &right.m_data, m_size);
+	countStats(StatsBytesCopied, m_size);
 }
 
 void Message_t::clearMessage()
 {
-	if (m_data)
-		::free(m_data);
-
-	m_data = 0;
-	m_size = 0;
-	m_type = MessageType_t::Unknown;
+	memset(&m_data, 0, m_size);
+	m_tid = TalkerId_t::Unknown;
 }
 
 Message_t & Message_t::operator=(const Message_t &right)
 {
 	if (this != &right)
-	{
-		setType(right.type());
-		memcpy(m_data, right, m_size);
-	}
+		assign(right);
+
+	return *this;
+}
+
+#if __cplusplus >= 201103L
+Message_t & Message_t::operator=(Message_t &&right) noexcept
+{
+	if (this != &right)
+		assign(right);
 
 	return *this;
 }
+#endif // C++11
 
 Datum_t Datum_t::fromDatumCode(navi_datum_t code)
 {
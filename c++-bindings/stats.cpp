@@ -0,0 +1,113 @@
+/*
+* stats.cpp - accounting of the copies and the dispatches of the C++ bindings
+*
+* Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "include/libnavigate/c++/errors.hpp"
+#include "include/libnavigate/c++/stats.hpp"
+#include "instrument.hpp"
+
+#ifdef WITH_STATS
+
+#include "../src/atomic.h"
+#include "../src/instrument.h"
+
+#endif // WITH_STATS
+
+namespace libnavigate
+{
+
+#ifdef WITH_STATS
+
+// All the counters fit in the ones the C statistics keep for the bindings
+typedef char statsfit_t[(1 + BindingsStats_t::NmCalls * NmStatsCounters <=
+	NAVI_STATS_NM_BINDINGS) ? 1 : -1];
+
+//
+// Only the thread itself writes its counters, so the relaxed load and store
+// are enough
+static inline void addCounter(volatile size_t *counter, size_t value)
+{
+	navi_atomic_store(counter, navi_atomic_load(counter) + value);
+}
+
+void countStats(enum statscounter_t counter, size_t value)
+{
+	volatile size_t *counters = navi_stats_bindings();
+	size_t call;
+
+	if (counters == NULL)
+		return;
+
+	call = navi_atomic_load(&counters[0]);
+	call = call != 0 ? call - 1 : size_t(BindingsStats_t::Other);
+
+	addCounter(&counters[1 + call * NmStatsCounters + counter], value);
+}
+
+StatsScope_t::StatsScope_t(enum BindingsStats_t::calls_t call)
+	: m_entered(false)
+{
+	volatile size_t *counters = navi_stats_bindings();
+
+	if ((counters == NULL) || (navi_atomic_load(&counters[0]) != 0))
+		return;	// a part of the call in progress
+
+	navi_atomic_store(&counters[0], size_t(call) + 1);
+	addCounter(&counters[1 + call * NmStatsCounters + StatsCalls], 1);
+	m_entered = true;
+}
+
+StatsScope_t::~StatsScope_t()
+{
+	if (m_entered)
+		navi_atomic_store(&navi_stats_bindings()[0], 0);
+}
+
+#endif // WITH_STATS
+
+BindingsStats_t BindingsStats_t::snapshot()
+{
+	BindingsStats_t result;
+
+#ifdef WITH_STATS
+
+	size_t counters[NAVI_STATS_NM_BINDINGS];
+	const size_t *from;
+
+	navi_stats_bindings_snapshot(counters);
+
+	for (int i = 0; i < NmCalls; i++)
+	{
+		from = &counters[1 + i * NmStatsCounters];
+
+		result.counters[i].calls = from[StatsCalls];
+		result.counters[i].exceptions = from[StatsExceptions];
+		result.counters[i].bytesCopied = from[StatsBytesCopied];
+		result.counters[i].virtualCalls = from[StatsVirtualCalls];
+	}
+
+#else
+
+	throw NaviError_t(NaviError_t::NotImplemented);
+
+#endif // WITH_STATS
+
+	return result;
+}
+
+}
@@ -18,60 +18,21 @@
  */
 
 #include "include/libnavigate/c++/txt.hpp"
-#include <string.h>
 
 namespace libnavigate
 {
 
-Txt_t::Txt_t(const TalkerId_t &tid) : Message_t(MessageType_t::TXT)
-	{ navi_init_txt((struct txt_t *)(*this), tid.toTalkerIdCode()); }
+Txt_t::Txt_t(const TalkerId_t &tid) : Message_t(MessageType_t::TXT, tid)
+	{ navi_init_txt((struct txt_t *)(*this)); }
 
 Txt_t::Txt_t(const Message_t &msg) : Message_t(msg) { }
 
 Txt_t::~Txt_t() { }
 
-TalkerId_t Txt_t::talkerId() const
-{
-	return TalkerId_t::fromTalkerIdCode(((const struct txt_t *)(*this))->tid);
-}
-
-void Txt_t::setTalkerId(const TalkerId_t &tid)
-	{ ((struct txt_t *)(*this))->tid = tid.toTalkerIdCode(); }
-
 void Txt_t::clearMessage()
 {
-	navi_init_txt((struct txt_t *)(*this), TalkerId_t::Unknown);
-}
-
-Txt_t::operator const struct txt_t *() const
-{
-	const void *p = (const void *)(*this);
-	return (const struct txt_t *)p;
-}
-
-Txt_t::operator struct txt_t *()
-{
-	void *p = (void *)(*this);
-	return (struct txt_t *)p;
-}
-
-std::string Txt_t::textMessage() const
-	{ return std::string(((const struct txt_t *)(*this))->textmsg); }
-
-void Txt_t::setTextMessage(const std::string &value)
-{
-	strncpy(((struct txt_t *)(*this))->textmsg, value.c_str(),
-		sizeof(((struct txt_t *)(*this))->textmsg));
-}
-
-int Txt_t::textId() const
-{
-	return ((const struct txt_t *)(*this))->textid;
-}
-
-void Txt_t::setTextId(int value)
-{
-	((struct txt_t *)(*this))->textid = value;
+	navi_init_txt((struct txt_t *)(*this));
+	Message_t::setTalkerId(TalkerId_t::Unknown);
 }
 
 }
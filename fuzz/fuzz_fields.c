@@ -0,0 +1,126 @@
+/*
+ * fuzz_fields.c - fuzzing target of the field parsers
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// The first byte of the input selects the field parser, the rest is
+// the field. It is given to the parser as the last field of a sentence
+// is, followed by "*hh<cr><lf>" at the end of a buffer of the exact size.
+// A parser must neither step over the first '*' nor read behind the buffer.
+//
+
+#include <navigate.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NM_PARSERS		15
+
+// The size of the arrays the parsers fill
+#define NM_VALUES		16
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	char *buffer, *end, bytes[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t length, nmread = 0, misize = NM_VALUES;
+	navi_modeindicator_t mi[NM_VALUES];
+	union
+	{
+		double number;
+		int integer;
+		struct navi_offset_t offset;
+		struct navi_position_t fix;
+		struct navi_utc_t utc;
+		struct navi_date_t date;
+		navi_status_t status;
+		navi_gsaswitchmode_t mode;
+		navi_modeindicator_t mi;
+		navi_datum_t datum;
+		navi_datum_subdivision_t datumsub;
+	} value;
+
+	if ((size == 0) || (size > NAVI_SENTENCE_MAXSIZE))
+		return 0;
+
+	length = size - 1;
+	buffer = (char *)malloc(length + 5);
+	if (buffer == NULL)
+		return 0;
+	memcpy(buffer, data + 1, length);
+	memcpy(buffer + length, "*00\r\n", 5);
+	end = (char *)memchr(buffer, '*', length + 1);
+
+	switch (data[0] % NM_PARSERS)
+	{
+	case 0:
+		(void)navi_parse_offset(buffer, &value.offset, &nmread);
+		break;
+	case 1:
+		(void)navi_parse_position_fix(buffer, &value.fix, &nmread);
+		break;
+	case 2:
+		(void)navi_parse_utc(buffer, &value.utc, &nmread);
+		break;
+	case 3:
+		(void)navi_parse_status(buffer, &value.status, &nmread);
+		break;
+	case 4:
+		(void)navi_parse_gsamode(buffer, &value.mode, &nmread);
+		break;
+	case 5:
+		(void)navi_parse_modeindicator(buffer, &value.mi, &nmread);
+		break;
+	case 6:
+		(void)navi_parse_number(buffer, &value.number, &nmread);
+		break;
+	case 7:
+		(void)navi_parse_hexfield(buffer, 1 + data[0] / NM_PARSERS % 8, bytes, &nmread);
+		break;
+	case 8:
+		(void)navi_parse_decfield(buffer, 1 + data[0] / NM_PARSERS % 8, bytes, &nmread);
+		break;
+	case 9:
+		(void)navi_parse_datum(buffer, &value.datum, &nmread);
+		break;
+	case 10:
+		(void)navi_parse_datumsub(buffer, &value.datumsub, &nmread);
+		break;
+	case 11:
+		(void)navi_parse_miarray(buffer, mi, &misize, &nmread);
+		break;
+	case 12:
+		(void)navi_parse_date(buffer, &value.date, &nmread);
+		break;
+	case 13:
+		(void)navi_parse_localzone(buffer, &value.integer, &nmread);
+		break;
+	case 14:
+		(void)navi_parse_character_field(buffer, bytes,
+			1 + data[0] / NM_PARSERS % sizeof(bytes), &nmread);
+		break;
+	}
+
+	// the next field starts behind the '*' the latest
+	if (buffer + nmread > end + 1)
+		abort();
+
+	free(buffer);
+
+	return 0;
+}
@@ -0,0 +1,335 @@
+/*
+ * fuzz_main.c - driver of the fuzzing targets without libFuzzer
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Usage: fuzz_xxx [-runs=N] [-seed=S] [-max_len=L] file...
+//
+// Runs the target on every file, then on N inputs mutated at random from
+// them, so that the targets are run with the sanitizers by compilers
+// without libFuzzer. The mutations are blind, not guided by the coverage,
+// but the checksums of the mutated sentences are fixed in a half of cases.
+// The input is written to crash-input, when the target crashes or
+// the sanitizer reports an error.
+//
+
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define FUZZ_SANITIZER
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define FUZZ_SANITIZER
+#endif
+#endif
+
+#ifdef FUZZ_SANITIZER
+#include <sanitizer/common_interface_defs.h>
+#endif // FUZZ_SANITIZER
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+// The maximum number of the seed files
+#define NM_SEEDS		64
+
+// The bytes the sentences are made of, inserted more often than the others
+static const char g_alphabet[] = "$*,\r\n.^-+0123456789ABCDEFNSEWTMLRAVPQ";
+
+static uint64_t g_state = 88172645463325252ULL;
+
+// The input being run
+static const uint8_t *g_data;
+static size_t g_size;
+
+struct input_t
+{
+	uint8_t *data;
+	size_t size;
+};
+
+//
+// Returns the next pseudo-random number, xorshift64
+static uint64_t fuzz_random(void)
+{
+	g_state ^= g_state << 13;
+	g_state ^= g_state >> 7;
+	g_state ^= g_state << 17;
+
+	return g_state;
+}
+
+//
+// Returns a random byte, of the alphabet in 3/4 of cases
+static uint8_t fuzz_byte(void)
+{
+	if (fuzz_random() % 4 != 0)
+		return (uint8_t)g_alphabet[fuzz_random() % (sizeof(g_alphabet) - 1)];
+
+	return (uint8_t)fuzz_random();
+}
+
+//
+// Writes the right checksums of the sentences in the input, else the most
+// of the mutated sentences are rejected before their fields are parsed
+static void fuzz_fix_checksums(uint8_t *data, size_t size)
+{
+	static const char hex[] = "0123456789ABCDEF";
+	size_t i, start = size;
+	unsigned int cs = 0;
+
+	for (i = 0; i < size; i++)
+	{
+		if (data[i] == '$')
+		{
+			start = i;
+			cs = 0;
+		}
+		else if ((data[i] == '*') && (start < size))
+		{
+			if (i + 2 < size)
+			{
+				data[i + 1] = (uint8_t)hex[(cs >> 4) & 0x0f];
+				data[i + 2] = (uint8_t)hex[cs & 0x0f];
+			}
+			start = size;
+		}
+		else if (start < size)
+		{
+			cs ^= data[i];
+		}
+	}
+}
+
+//
+// Mutates the input of the size in the buffer of maxsize bytes, returns
+// the new size
+static size_t fuzz_mutate(uint8_t *data, size_t size, size_t maxsize,
+	const struct input_t *seeds, int nmseeds)
+{
+	size_t pos, n, i;
+	int k, nmmutations = 1 + (int)(fuzz_random() % 8);
+	const struct input_t *other;
+
+	for (k = 0; k < nmmutations; k++)
+	{
+		pos = size > 0 ? fuzz_random() % size : 0;
+
+		switch (fuzz_random() % 7)
+		{
+		case 0:		// flip a bit
+			if (size > 0)
+				data[pos] ^= (uint8_t)(1 << (fuzz_random() % 8));
+			break;
+		case 1:		// replace a byte
+			if (size > 0)
+				data[pos] = fuzz_byte();
+			break;
+		case 2:		// insert bytes
+			n = 1 + fuzz_random() % 4;
+			if (size + n > maxsize)
+				break;
+			memmove(data + pos + n, data + pos, size - pos);
+			for (i = 0; i < n; i++)
+				data[pos + i] = fuzz_byte();
+			size += n;
+			break;
+		case 3:		// erase bytes
+			n = 1 + fuzz_random() % 8;
+			if (pos + n > size)
+				n = size - pos;
+			memmove(data + pos, data + pos + n, size - pos - n);
+			size -= n;
+			break;
+		case 4:		// truncate
+			size = pos;
+			break;
+		case 5:		// duplicate a chunk
+			n = 1 + fuzz_random() % 16;
+			if ((pos + n > size) || (size + n > maxsize))
+				break;
+			memmove(data + pos + n, data + pos, size - pos);
+			size += n;
+			break;
+		case 6:		// splice with a seed
+			if (nmseeds == 0)
+				break;
+			other = &seeds[fuzz_random() % nmseeds];
+			if (other->size == 0)
+				break;
+			i = fuzz_random() % other->size;
+			n = 1 + fuzz_random() % (other->size - i);
+			if (pos + n > maxsize)
+				n = maxsize - pos;
+			memcpy(data + pos, other->data + i, n);
+			if (pos + n > size)
+				size = pos + n;
+			break;
+		}
+	}
+
+	if (fuzz_random() % 2 == 0)
+		fuzz_fix_checksums(data, size);
+
+	return size;
+}
+
+//
+// Reads the whole file
+static int read_file(const char *filename, struct input_t *input)
+{
+	uint8_t chunk[65536], *data;
+	size_t size;
+	FILE *f;
+
+	input->data = NULL;
+	input->size = 0;
+
+	if ((f = fopen(filename, "rb")) == NULL)
+		return 1;
+
+	while ((size = fread(chunk, 1, sizeof(chunk), f)) > 0)
+	{
+		data = (uint8_t *)realloc(input->data, input->size + size);
+		if (data == NULL)
+		{
+			fclose(f);
+			return 1;
+		}
+
+		input->data = data;
+		memcpy(input->data + input->size, chunk, size);
+		input->size += size;
+	}
+	fclose(f);
+
+	return 0;
+}
+
+//
+// Saves the input being run to reproduce the crash
+static void save_input(void)
+{
+	FILE *f = fopen("crash-input", "wb");
+
+	if (f != NULL)
+	{
+		fwrite(g_data, 1, g_size, f);
+		fclose(f);
+	}
+
+	fprintf(stderr, "The input of %lu bytes is saved to crash-input\n", (unsigned long)g_size);
+}
+
+//
+// Saves the input and crashes again
+static void on_crash(int sig)
+{
+	save_input();
+
+	signal(sig, SIG_DFL);
+	raise(sig);
+}
+
+//
+// Runs the target on the input
+static void run_input(const uint8_t *data, size_t size)
+{
+	g_data = data;
+	g_size = size;
+
+	LLVMFuzzerTestOneInput(data, size);
+}
+
+int main(int argc, char *argv[])
+{
+	struct input_t seeds[NM_SEEDS];
+	unsigned long runs = 0, run;
+	size_t maxlen = 4096, size;
+	int i, nmseeds = 0;
+	uint8_t *data;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strncmp(argv[i], "-runs=", 6) == 0)
+			runs = strtoul(argv[i] + 6, NULL, 10);
+		else if (strncmp(argv[i], "-seed=", 6) == 0)
+			g_state = strtoul(argv[i] + 6, NULL, 10) * 2654435761ULL + 1;
+		else if (strncmp(argv[i], "-max_len=", 9) == 0)
+			maxlen = strtoul(argv[i] + 9, NULL, 10);
+		else if (argv[i][0] == '-')
+			continue;	// the other options of libFuzzer
+		else if (nmseeds < NM_SEEDS)
+		{
+			if (read_file(argv[i], &seeds[nmseeds]) != 0)
+			{
+				printf("Cannot read %s\n", argv[i]);
+				return 1;
+			}
+			nmseeds++;
+		}
+	}
+
+	signal(SIGSEGV, on_crash);
+	signal(SIGABRT, on_crash);
+#ifdef FUZZ_SANITIZER
+	__sanitizer_set_death_callback(save_input);
+#endif // FUZZ_SANITIZER
+
+	// the seeds as they are
+	for (i = 0; i < nmseeds; i++)
+		run_input(seeds[i].data, seeds[i].size);
+
+	data = (uint8_t *)malloc(maxlen > 0 ? maxlen : 1);
+	if (data == NULL)
+		return 1;
+
+	for (run = 0; run < runs; run++)
+	{
+		size = 0;
+		if (nmseeds > 0)
+		{	// a piece of a seed
+			i = (int)(fuzz_random() % nmseeds);
+			size = seeds[i].size;
+			if (size > maxlen)
+			{
+				memcpy(data, seeds[i].data + fuzz_random() % (size - maxlen + 1), maxlen);
+				size = fuzz_random() % (maxlen + 1);
+			}
+			else
+			{
+				memcpy(data, seeds[i].data, size);
+			}
+		}
+
+		size = fuzz_mutate(data, size, maxlen, seeds, nmseeds);
+
+		run_input(data, size);
+	}
+
+	printf("Done %lu runs on %d seeds\n", runs + nmseeds, nmseeds);
+
+	free(data);
+	for (i = 0; i < nmseeds; i++)
+		free(seeds[i].data);
+
+	return 0;
+}
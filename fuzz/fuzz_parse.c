@@ -0,0 +1,69 @@
+/*
+ * fuzz_parse.c - fuzzing target of navi_parse_msg()
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// The input is a stream of untrusted bytes, parsed sentence by sentence
+// as the readers do. It is copied to a buffer of the exact size, so that
+// the sanitizer catches any read behind it.
+//
+
+#include <navigate.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The storage of a parsed sentence
+union parsed_t
+{
+	struct approved_field_t address;
+	double align;
+	char bytes[1024];
+};
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	char *buffer;
+	size_t offset, nmread;
+	navi_addrfield_t type;
+	union parsed_t parsed;
+
+	if (size == 0)
+		return 0;
+
+	buffer = (char *)malloc(size);
+	if (buffer == NULL)
+		return 0;
+	memcpy(buffer, data, size);
+
+	for (offset = 0; offset < size; offset += nmread)
+	{
+		nmread = 0;
+		if ((navi_parse_msg(buffer + offset, size - offset, sizeof(parsed), &type,
+				&parsed, &nmread) != navi_Ok) &&
+			((navierr_get_last()->errclass == navi_NoValidMessage) || (nmread == 0)))
+		{
+			break;
+		}
+	}
+
+	free(buffer);
+
+	return 0;
+}
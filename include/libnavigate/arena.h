@@ -0,0 +1,110 @@
+/*
+ * arena.h - arena of parsed IEC sentences
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! @file arena.h
+ *  @brief Declares the arena of parsed sentences.
+ *
+ *  The arena hands out memory from large slabs, so that storing millions
+ *  of parsed sentences costs a few allocations, and the sentences stored
+ *  one after another lie next to each other. A stored sentence takes the
+ *  slot of the size of its type: the address field followed by
+ *  the sentence structure, the same layout as navi_parse_msg() produces.
+ *
+ *  Slots of single sentences may be freed and are reused for the sentences
+ *  of the same type. All the memory is released at once by
+ *  navi_arena_reset(), e.g. per epoch or per file, and the slabs are kept
+ *  for reuse.
+ *
+ *  The arena is not thread-safe, use one arena per thread.
+ */
+
+#ifndef INCLUDE_navi_arena_h
+#define INCLUDE_navi_arena_h
+
+#include "sentence.h"
+
+NAVI_BEGIN_DECL
+
+//! @brief Default size of one slab
+#define NAVI_ARENA_SLABSIZE		65536
+
+//! @brief Arena state, opaque
+struct navi_arena_t;
+
+//! @brief Returns the size of the structure of the approved sentence
+//!
+//! @return the size, or 0 if the sentence is not supported
+NAVI_EXTERN(size_t) navi_sentence_size(navi_approved_fmt_t fmt);
+
+//! @brief Creates an empty arena
+//!
+//! @param[in] slabsize the size of one slab, or 0 for NAVI_ARENA_SLABSIZE.
+//! Larger requests get their own slabs.
+//! @return the arena, or NULL with the last error set to navi_SystemError
+NAVI_EXTERN(struct navi_arena_t *) navi_arena_create(size_t slabsize);
+
+//! @brief Frees the arena and all the memory handed out by it
+NAVI_EXTERN(void) navi_arena_destroy(struct navi_arena_t *arena);
+
+//! @brief Allocates size bytes aligned for any type
+//!
+//! The memory is released only by navi_arena_reset() or navi_arena_destroy().
+//! @return the memory, or NULL with the last error set to navi_SystemError
+NAVI_EXTERN(void *) navi_arena_alloc(struct navi_arena_t *arena, size_t size);
+
+//! @brief Allocates the slot of the approved sentence
+//!
+//! The address field of the slot is set to fmt and navi_talkerid_Unknown,
+//! the sentence structure that follows it is not initialized.
+//! @return the slot, or NULL with the last error set to navi_MsgNotSupported
+//! or navi_SystemError
+NAVI_EXTERN(struct approved_field_t *) navi_arena_alloc_msg(struct navi_arena_t *arena,
+	navi_approved_fmt_t fmt);
+
+//! @brief Frees the slot allocated by navi_arena_alloc_msg() or navi_arena_parse()
+//!
+//! The slot is reused by the next sentence of the same type.
+NAVI_EXTERN(void) navi_arena_free_msg(struct navi_arena_t *arena,
+	struct approved_field_t *msg);
+
+//! @brief Parses the approved sentence into the slot of its size
+//!
+//! The arguments buffer, maxsize and nmread are the same as for
+//! navi_parse_msg(). The sentence is parsed in place and then moved to
+//! the freed slot of its type, if there is one.
+//! @return the slot, or NULL with the last error set as by navi_parse_msg(),
+//! or to navi_MsgNotSupported for the query and proprietary sentences
+NAVI_EXTERN(struct approved_field_t *) navi_arena_parse(struct navi_arena_t *arena,
+	char *buffer, size_t maxsize, size_t *nmread);
+
+//! @brief Returns the sentence structure stored in the slot
+#define navi_arena_msgdata(msg)		((void *)((struct approved_field_t *)(msg) + 1))
+
+//! @brief Releases all the memory handed out, keeping the slabs for reuse
+NAVI_EXTERN(void) navi_arena_reset(struct navi_arena_t *arena);
+
+//! @brief Returns the number of bytes handed out since the last reset
+NAVI_EXTERN(size_t) navi_arena_used(const struct navi_arena_t *arena);
+
+//! @brief Returns the total size of the slabs
+NAVI_EXTERN(size_t) navi_arena_reserved(const struct navi_arena_t *arena);
+
+NAVI_END_DECL
+
+#endif // INCLUDE_navi_arena_h
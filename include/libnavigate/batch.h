@@ -0,0 +1,115 @@
+/*
+ * batch.h - parsing of buffers and track files with many sentences
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! @file batch.h
+ *  @brief Declares API-calls for parsing buffers with many sentences.
+ *
+ *  A buffer (or a recorded track file) is parsed sentence by sentence
+ *  with navi_parse_msg(). The parallel variant splits the buffer into
+ *  chunks at &lt;cr&gt;&lt;lf&gt;, parses the chunks on a pool of worker
+ *  threads and passes the results to the handler in the order of the
+ *  sentences in the buffer, exactly as the sequential variant does.
+ */
+
+#ifndef INCLUDE_navi_batch_h
+#define INCLUDE_navi_batch_h
+
+#include "sentence.h"
+
+NAVI_BEGIN_DECL
+
+//! @brief Size of the storage for one parsed message
+//!
+//! Enough for approved_field_t followed by any supported sentence structure.
+//! Proprietary sentence parsers must not write more.
+#define NAVI_BATCH_MSGSIZE		256
+
+//! @brief Result of parsing of one sentence
+struct navi_parsed_t
+{
+	//! the message as stored by navi_parse_msg(), placed first to be aligned
+	char msg[NAVI_BATCH_MSGSIZE];
+
+	size_t offset;				//!< offset of the sentence in the buffer
+	size_t length;				//!< length of the sentence, including &lt;cr&gt;&lt;lf&gt;
+	navi_addrfield_t type;		//!< address field type
+	navierr_status_t status;	//!< status returned by navi_parse_msg()
+	navierr_class_t errclass;	//!< error class, if status is navi_Error
+};
+
+//! @brief Callback receiving the results of parsing in the order of sentences
+//!
+//! The result is valid only until the callback returns.
+//! @return 0 to continue parsing, or non-zero to stop
+typedef int (*navi_batch_handler_t)(const struct navi_parsed_t *parsed, void *context);
+
+//! @brief Parses all sentences in buffer one by one
+//!
+//! Every sentence terminated by &lt;cr&gt;&lt;lf&gt;, valid or not, is passed
+//! to the handler. The number of bytes up to the end of the last sentence
+//! is stored to nmread, if it is not NULL.
+//! @return navi_Ok, or navi_Error with navi_InvalidParameter
+NAVI_EXTERN(navierr_status_t) navi_parse_batch(char *buffer, size_t size,
+	navi_batch_handler_t handler, void *context, size_t *nmread);
+
+//! @brief Parses all sentences in buffer on nmthreads worker threads
+//!
+//! The handler is called from the calling thread only, in the same order
+//! and with the same results as navi_parse_batch() gives. If nmthreads is 0,
+//! the number of processors is used. The buffer must not change while it
+//! is parsed.
+//! @return navi_Ok, or navi_Error with navi_InvalidParameter or navi_SystemError
+NAVI_EXTERN(navierr_status_t) navi_parse_parallel(char *buffer, size_t size,
+	int nmthreads, navi_batch_handler_t handler, void *context);
+
+//! @brief Maps the track file to memory and parses it with navi_parse_parallel()
+//!
+//! @return navi_Ok, or navi_Error with navi_InvalidParameter or navi_SystemError,
+//! if the file cannot be opened or mapped
+NAVI_EXTERN(navierr_status_t) navi_parse_track(const char *filename,
+	int nmthreads, navi_batch_handler_t handler, void *context);
+
+//! @brief Backends of navi_read_track()
+enum _navi_reader_backend_t
+{
+	navi_reader_Auto = 0,	//!< io_uring if available, pread() otherwise
+	navi_reader_Pread = 1,	//!< one pread() at a time
+	navi_reader_Uring = 2	//!< several reads in flight with io_uring (Linux)
+};
+
+//! @brief Reads the track file with large reads and parses it
+//!
+//! Unlike navi_parse_track(), the file is not mapped, but read in large
+//! blocks. With io_uring several blocks are in flight at once on registered
+//! buffers, which keeps a fast disk busy while the previous block is parsed.
+//! The blocks are parsed as navi_parse_parallel() does, by one pool of
+//! nmthreads workers for the whole file (0 for the number of processors,
+//! 1 for the calling thread only), and the
+//! handler gets the same results as from navi_parse_track(), with offsets
+//! from the beginning of the file. The only exception is junk longer than
+//! 64 KB without &lt;cr&gt;&lt;lf&gt;, which is skipped.
+//! @return navi_Ok, or navi_Error with navi_InvalidParameter,
+//! navi_SystemError, or navi_NotImplemented, if navi_reader_Uring is
+//! requested, but is not available
+NAVI_EXTERN(navierr_status_t) navi_read_track(const char *filename, int backend,
+	int nmthreads, navi_batch_handler_t handler, void *context);
+
+NAVI_END_DECL
+
+#endif // INCLUDE_navi_batch_h
@@ -50,7 +50,8 @@ enum _navierr_class_t
 	navi_NullField = 6,			//!< null field in a message, where it is not allowed
 	navi_InvalidMessage = 7,	//!< message does not conform to protocol
 	navi_NotImplemented = 8,	//!< method not implemented
-	navi_InvalidParameter = 9	//!< invalid parameter to method
+	navi_InvalidParameter = 9,	//!< invalid parameter to method
+	navi_SystemError = 10		//!< system call failed, see errno or GetLastError()
 };
 
 //! @brief Error status
@@ -0,0 +1,105 @@
+/*
+ * framer.h - streaming framer of IEC sentences
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! @file framer.h
+ *  @brief Declares the streaming framer of IEC sentences.
+ *
+ *  The framer accepts arbitrary chunks of an input stream (as they are
+ *  read from a serial port, socket or file) and cuts complete sentences
+ *  from '$' up to and including &lt;cr&gt;&lt;lf&gt; out of them. Bytes
+ *  between sentences are skipped.
+ *
+ *  The framer accounts for the health of the stream: the bytes skipped
+ *  and dropped, the sentences cut by a '$', those too long or without
+ *  &lt;cr&gt;, and the checksum failures. A noisy serial link shows up
+ *  in these counters long before it loses the fix.
+ */
+
+#ifndef INCLUDE_navi_framer_h
+#define INCLUDE_navi_framer_h
+
+#include "sentence.h"
+
+NAVI_BEGIN_DECL
+
+//! @brief Maximum size of a framed sentence, including '$' and &lt;cr&gt;&lt;lf&gt;
+#define NAVI_FRAME_MAXSIZE		(NAVI_SENTENCE_MAXSIZE + 2)
+
+//! @brief Framer states
+enum _navi_framer_state_t
+{
+	navi_framer_Idle = 0,		//!< waiting for '$'
+	navi_framer_Collecting = 1,	//!< collecting sentence bytes
+	navi_framer_Complete = 2	//!< a complete sentence is in the buffer
+};
+
+//! @brief Health counters of the framed stream
+//!
+//! The garbage bytes are all the consumed bytes not delivered in
+//! a complete sentence, so garbage / bytes is the share of the link
+//! wasted on noise. The counters are reset by navi_framer_init() only.
+struct navi_framestats_t
+{
+	size_t bytes;		//!< bytes consumed
+	size_t garbage;		//!< bytes skipped between sentences or dropped
+	size_t sentences;	//!< complete sentences
+	size_t resyncs;		//!< sentences cut by a '$' in the middle
+	size_t overlong;	//!< sentences longer than NAVI_FRAME_MAXSIZE
+	size_t unterminated;	//!< lines terminated by &lt;lf&gt; without &lt;cr&gt;
+	size_t crcerrors;	//!< complete sentences with the wrong checksum
+};
+
+//! @brief Streaming framer state
+struct navi_framer_t
+{
+	int state;		//!< current state, one of navi_framer_xxx
+
+	//! @brief The number of bytes in sentence buffer
+	//!
+	//! When state is navi_framer_Complete, it is the length of the sentence
+	//! including &lt;cr&gt;&lt;lf&gt;.
+	size_t length;
+
+	//! @brief Sentence buffer, null-terminated when the sentence is complete
+	char sentence[NAVI_FRAME_MAXSIZE + 1];
+
+	//! @brief Health counters of the stream
+	struct navi_framestats_t stats;
+};
+
+//! @brief Initializes the framer
+NAVI_EXTERN(navierr_status_t) navi_framer_init(struct navi_framer_t *fr);
+
+//! @brief Consumes bytes from the input stream up to the end of the next sentence
+//!
+//! Reads from data which has the size of size, until a sentence is complete
+//! or the data is exhausted. The number of consumed bytes is stored to nmread.
+//! When the sentence is complete, it stays in fr->sentence until the next call.
+//! Sentences longer than NAVI_FRAME_MAXSIZE and those which are not
+//! terminated by &lt;cr&gt;&lt;lf&gt; are dropped. A '$' in the middle of
+//! a sentence restarts the framing. A complete sentence with the wrong
+//! checksum is still delivered, and is only counted in fr->stats.
+//! @return navi_Ok if a sentence is complete, or navi_Error with the last
+//! error set to navi_NoValidMessage if all the data is consumed
+NAVI_EXTERN(navierr_status_t) navi_framer_push(struct navi_framer_t *fr,
+	const char *data, size_t size, size_t *nmread);
+
+NAVI_END_DECL
+
+#endif // INCLUDE_navi_framer_h
@@ -0,0 +1,116 @@
+/*
+ * ingest.h - multi-stream ingest engine
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! @file ingest.h
+ *  @brief Declares the multi-stream ingest engine.
+ *
+ *  The engine accepts raw data of many input streams, frames it into
+ *  sentences and parses them with navi_parse_msg() on a pool of worker
+ *  threads. A stream with queued sentences is a task. Every worker keeps
+ *  a deque of tasks and idle workers steal tasks from the others, so the
+ *  backlog of a busy stream does not wait behind other streams of the same
+ *  worker. A stream is handled by one worker at a time, therefore its
+ *  sentences are passed to the handler in the order of arrival.
+ */
+
+#ifndef INCLUDE_navi_ingest_h
+#define INCLUDE_navi_ingest_h
+
+#include "sentence.h"
+#include "batch.h"
+#include "framer.h"
+
+NAVI_BEGIN_DECL
+
+//! @brief The ingest engine, opaque to the user
+struct navi_ingest_t;
+
+//! @brief Callback receiving the parsed sentences of a stream
+//!
+//! Called from worker threads, concurrently for different streams, but
+//! never concurrently for the same stream. The offset field of parsed
+//! is not used. The result is valid only until the callback returns.
+typedef void (*navi_ingest_handler_t)(size_t stream,
+	const struct navi_parsed_t *parsed, void *context);
+
+//! @brief Per-stream counters and lag metrics
+//!
+//! The lag of a sentence is the time from its arrival with
+//! navi_ingest_feed() to the start of its parsing. The framing counters
+//! are those of the raw data consumed by navi_ingest_feed() so far. They
+//! are published without a lock, so while the stream is fed they may come
+//! from different calls of navi_ingest_feed().
+struct navi_streamstats_t
+{
+	size_t received;	//!< sentences queued by navi_ingest_feed()
+	size_t parsed;		//!< sentences parsed successfully
+	size_t failed;		//!< sentences failed to parse
+	size_t overflows;	//!< calls of navi_ingest_feed() stopped by the full queue
+	size_t backlog;		//!< sentences waiting in the queue
+
+	double lastlag;		//!< lag of the last handled sentence, in seconds
+	double maxlag;		//!< maximum lag, in seconds
+	double meanlag;		//!< mean lag, in seconds
+
+	struct navi_framestats_t frames;	//!< framing counters of the raw data
+};
+
+//! @brief Creates the ingest engine and starts its workers
+//!
+//! @param[in] nmstreams the number of input streams
+//! @param[in] depth the queue size of a stream in sentences, a power of 2
+//! @param[in] nmworkers the number of worker threads, or 0 for the number
+//! of processors
+//! @param[in] handler the callback receiving the parsed sentences
+//! @param[in] context the user pointer passed to the handler
+//! @return the engine, or NULL with the last error set to navi_InvalidParameter
+//! or navi_SystemError
+NAVI_EXTERN(struct navi_ingest_t *) navi_ingest_create(size_t nmstreams,
+	size_t depth, int nmworkers, navi_ingest_handler_t handler, void *context);
+
+//! @brief Stops the workers and frees the engine
+//!
+//! The sentences not yet handled are discarded. Call navi_ingest_drain()
+//! before, if they are needed.
+NAVI_EXTERN(void) navi_ingest_destroy(struct navi_ingest_t *engine);
+
+//! @brief Queues raw data of the stream
+//!
+//! Only one thread at a time may feed the same stream. The number of
+//! consumed bytes is stored to nmread. When the stream queue is full,
+//! the rest of data is left to the caller. The sentence framed, but not
+//! queued yet, is kept until the next call, which may have no data.
+//! @return navi_Ok if all the data is consumed, or navi_Error with
+//! navi_NotEnoughBuffer, if the queue of the stream is full, or with
+//! navi_InvalidParameter
+NAVI_EXTERN(navierr_status_t) navi_ingest_feed(struct navi_ingest_t *engine,
+	size_t stream, const char *data, size_t size, size_t *nmread);
+
+//! @brief Waits until all queued sentences are handled
+NAVI_EXTERN(navierr_status_t) navi_ingest_drain(struct navi_ingest_t *engine);
+
+//! @brief Copies the counters and lag metrics of the stream to stats
+//!
+//! @return navi_Ok, or navi_Error with navi_InvalidParameter
+NAVI_EXTERN(navierr_status_t) navi_ingest_stats(struct navi_ingest_t *engine,
+	size_t stream, struct navi_streamstats_t *stats);
+
+NAVI_END_DECL
+
+#endif // INCLUDE_navi_ingest_h
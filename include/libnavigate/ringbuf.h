@@ -0,0 +1,155 @@
+/*
+ * ringbuf.h - lock-free ring buffer of IEC sentences
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! @file ringbuf.h
+ *  @brief Declares the lock-free ring buffer of framed sentences.
+ *
+ *  The ring buffer hands sentences from reader threads to a parser thread
+ *  without locks. It works either with a single producer (SPSC) or with
+ *  several producers (MPSC), but always with a single consumer. The storage
+ *  for records is supplied by the caller.
+ */
+
+#ifndef INCLUDE_navi_ringbuf_h
+#define INCLUDE_navi_ringbuf_h
+
+#include "sentence.h"
+#include "framer.h"
+
+NAVI_BEGIN_DECL
+
+//! @brief Assumed size of CPU cache line
+#define NAVI_CACHELINE_SIZE		64
+
+//! @brief Ring buffer modes
+enum _navi_ringbuf_mode_t
+{
+	navi_ringbuf_SPSC = 0,	//!< single producer, single consumer
+	navi_ringbuf_MPSC = 1	//!< multiple producers, single consumer
+};
+
+//! @brief One record of the ring buffer
+struct navi_record_t
+{
+	volatile size_t seq;	//!< sequence number of the slot, used internally
+	size_t length;			//!< length of the sentence, including <cr><lf>
+	double stamp;			//!< time stamp given by navi_ringbuf_feed_stamped()
+
+	//! null-terminated sentence
+	char sentence[NAVI_FRAME_MAXSIZE + 1];
+};
+
+//! @brief Ring buffer state
+//!
+//! The producers' and the consumer's positions are placed on separate
+//! cache lines, so that the threads do not contend for them.
+struct navi_ringbuf_t
+{
+	struct navi_record_t *slots;	//!< storage for records
+	size_t mask;					//!< capacity - 1
+	int mode;						//!< one of navi_ringbuf_xxx
+
+	char pad0[NAVI_CACHELINE_SIZE];
+
+	volatile size_t tail;	//!< producers' position
+	size_t headcache;		//!< producer's copy of the consumer's position (SPSC)
+
+	char pad1[NAVI_CACHELINE_SIZE];
+
+	volatile size_t head;	//!< consumer's position
+	size_t tailcache;		//!< consumer's copy of the producer's position (SPSC)
+
+	char pad2[NAVI_CACHELINE_SIZE];
+};
+
+//! @brief Callback receiving records from navi_ringbuf_pop_batch()
+//!
+//! The record is valid only until the callback returns.
+typedef void (*navi_ringbuf_reader_t)(struct navi_record_t *record, void *context);
+
+//! @brief Initializes the ring buffer
+//!
+//! @param[in] rb the ring buffer
+//! @param[in] slots the storage for records
+//! @param[in] capacity the number of records in slots, must be a power of 2
+//! @param[in] mode navi_ringbuf_SPSC or navi_ringbuf_MPSC
+//! @return navi_Ok, or navi_Error with navi_InvalidParameter
+NAVI_EXTERN(navierr_status_t) navi_ringbuf_init(struct navi_ringbuf_t *rb,
+	struct navi_record_t slots[], size_t capacity, int mode);
+
+//! @brief Pushes one sentence to the ring buffer
+//!
+//! @return navi_Ok, or navi_Error with navi_NotEnoughBuffer, if the buffer
+//! is full, or with navi_MsgExceedsMaxSize, if the sentence is too long
+NAVI_EXTERN(navierr_status_t) navi_ringbuf_push(struct navi_ringbuf_t *rb,
+	const char *sentence, size_t length);
+
+//! @brief Frames the input stream and pushes the sentences to the ring buffer
+//!
+//! All sentences completed by the data are pushed. In SPSC mode they are
+//! published to the consumer at once. The number of consumed bytes is put
+//! to nmread. If the ring buffer becomes full, the completed sentence is
+//! held by the framer and pushed on the next call.
+//! @return navi_Ok if all the data is consumed, or navi_Error with
+//! navi_NotEnoughBuffer, if the ring buffer is full
+NAVI_EXTERN(navierr_status_t) navi_ringbuf_feed(struct navi_ringbuf_t *rb,
+	struct navi_framer_t *fr, const char *data, size_t size, size_t *nmread);
+
+//! @brief Same as navi_ringbuf_feed(), but stamps the pushed records
+//!
+//! The stamp is usually the time when the data has been received.
+//! navi_ringbuf_feed() and navi_ringbuf_push() stamp records with 0.
+NAVI_EXTERN(navierr_status_t) navi_ringbuf_feed_stamped(struct navi_ringbuf_t *rb,
+	struct navi_framer_t *fr, const char *data, size_t size, double stamp,
+	size_t *nmread);
+
+//! @brief Pops one sentence from the ring buffer and copies it to sentence
+//!
+//! The copied sentence is null-terminated.
+//! @return navi_Ok, or navi_Error with navi_NoValidMessage, if the buffer is
+//! empty, or with navi_NotEnoughBuffer, if maxsize is too small
+NAVI_EXTERN(navierr_status_t) navi_ringbuf_pop(struct navi_ringbuf_t *rb,
+	char *sentence, size_t maxsize, size_t *length);
+
+//! @brief Pops up to maxcount sentences and passes them to the reader in place
+//!
+//! The records are released at once after the reader has seen them.
+//! The number of popped records is stored to nmpopped.
+//! @return navi_Ok, or navi_Error with navi_NoValidMessage, if the buffer is empty
+NAVI_EXTERN(navierr_status_t) navi_ringbuf_pop_batch(struct navi_ringbuf_t *rb,
+	size_t maxcount, navi_ringbuf_reader_t reader, void *context, size_t *nmpopped);
+
+//! @brief Pops one sentence and parses it in place with navi_parse_msg()
+//!
+//! The arguments msgsize, type and msg are the same as for navi_parse_msg().
+//! The record is popped even if the parsing fails.
+//! @return the status of navi_parse_msg(), or navi_Error with navi_NoValidMessage,
+//! if the buffer is empty
+NAVI_EXTERN(navierr_status_t) navi_ringbuf_parse(struct navi_ringbuf_t *rb,
+	size_t msgsize, navi_addrfield_t *type, void *msg);
+
+//! @brief Returns the number of records in the ring buffer
+//!
+//! The value is exact only if called from the consumer or the producer thread
+//! while the other side is idle.
+NAVI_EXTERN(size_t) navi_ringbuf_size(const struct navi_ringbuf_t *rb);
+
+NAVI_END_DECL
+
+#endif // INCLUDE_navi_ringbuf_h
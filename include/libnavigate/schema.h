@@ -0,0 +1,69 @@
+/*
+ * schema.h - sentences generated from the schema
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! @file schema.h
+ *  @brief Declares the sentences described in schema.def.
+ *
+ *  For every sentence NAME of the schema declares struct name_t with
+ *  the fields in the order of the sentence, and the initializer, generator
+ *  and parser navi_init_name(), navi_create_name() and navi_parse_name(),
+ *  the same as for the other sentences. These are DBT, DPT, HDG, HDT
+ *  and MWV, the sentences added with the schema; the others are not
+ *  described in it yet.
+ */
+
+#ifndef INCLUDE_navi_schema_h
+#define INCLUDE_navi_schema_h
+
+#include "sentence.h"
+
+//! @brief C types of the schema field kinds
+#define NAVI_SCHEMA_CTYPE_number	double
+#define NAVI_SCHEMA_CTYPE_measure	double
+#define NAVI_SCHEMA_CTYPE_offset	struct navi_offset_t
+#define NAVI_SCHEMA_CTYPE_status	navi_status_t
+#define NAVI_SCHEMA_CTYPE_character	char
+
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	struct name##_t {
+#define NAVI_SCHEMA_FIELD(name, kind, arg, member, getter, setter, validity) \
+	NAVI_SCHEMA_CTYPE_##kind member;
+#define NAVI_SCHEMA_END(name, NAME, Class) \
+	};
+#include "schema.def"
+
+NAVI_BEGIN_DECL
+
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	NAVI_EXTERN(navierr_status_t) navi_init_##name(struct name##_t *msg); \
+	NAVI_EXTERN(navierr_status_t) navi_create_##name(const struct name##_t *msg, \
+		char *buffer, size_t maxsize, size_t *nmwritten); \
+	NAVI_EXTERN(navierr_status_t) navi_parse_##name(struct name##_t *msg, char *buffer);
+#include "schema.def"
+
+//! @brief Checks if the field of the schema kind is not null
+NAVI_EXTERN(int) navi_schema_valid_number(const double *value);
+NAVI_EXTERN(int) navi_schema_valid_measure(const double *value);
+NAVI_EXTERN(int) navi_schema_valid_offset(const struct navi_offset_t *value);
+NAVI_EXTERN(int) navi_schema_valid_status(const navi_status_t *value);
+NAVI_EXTERN(int) navi_schema_valid_character(const char *value);
+
+NAVI_END_DECL
+
+#endif // INCLUDE_navi_schema_h
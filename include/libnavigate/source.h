@@ -0,0 +1,112 @@
+/*
+ * source.h - non-blocking input sources for the parser
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! @file source.h
+ *  @brief Declares the set of input sources multiplexed in one thread.
+ *
+ *  Serial ports, ptys, files, UDP sockets and arbitrary descriptors are
+ *  read without blocking into a pool of buffers shared by all sources,
+ *  and fed to a streaming framer per source. Complete sentences are passed
+ *  to the handler. The sources are multiplexed with epoll, so one thread
+ *  services hundreds of them. Available on Linux only, on the other systems
+ *  the calls fail with navi_NotImplemented.
+ */
+
+#ifndef INCLUDE_navi_source_h
+#define INCLUDE_navi_source_h
+
+#include "sentence.h"
+#include "framer.h"
+
+NAVI_BEGIN_DECL
+
+//! @brief The set of sources, opaque to the user
+struct navi_sources_t;
+
+//! @brief Callback receiving the framed sentences
+//!
+//! The sentence is null-terminated and is valid only until the callback
+//! returns. When the source reaches the end of file or fails, the callback
+//! is called with sentence equal to NULL and the source is closed.
+typedef void (*navi_source_handler_t)(int source, char *sentence,
+	size_t length, void *context);
+
+//! @brief Creates an empty set for up to maxsources sources
+//!
+//! @return the set, or NULL with the last error set to navi_InvalidParameter,
+//! navi_SystemError or navi_NotImplemented
+NAVI_EXTERN(struct navi_sources_t *) navi_sources_create(int maxsources,
+	navi_source_handler_t handler, void *context);
+
+//! @brief Closes all sources and frees the set
+NAVI_EXTERN(void) navi_sources_destroy(struct navi_sources_t *sources);
+
+//! @brief Opens the serial port or pty in raw mode
+//!
+//! @param[in] device the path to the device
+//! @param[in] baudrate the speed, or 0 to keep the current one
+//! @param[out] source the identifier of the new source
+//! @return navi_Ok, or navi_Error with navi_SystemError, navi_InvalidParameter
+//! (unsupported speed) or navi_NotEnoughBuffer (too many sources)
+NAVI_EXTERN(navierr_status_t) navi_source_open_serial(struct navi_sources_t *sources,
+	const char *device, int baudrate, int *source);
+
+//! @brief Opens the file, e.g. a recorded track
+//!
+//! Files are always ready, so they are read on every call of navi_sources_poll().
+NAVI_EXTERN(navierr_status_t) navi_source_open_file(struct navi_sources_t *sources,
+	const char *filename, int *source);
+
+//! @brief Opens the UDP socket bound to the IPv4 address and port
+//!
+//! @param[in] address the local address in dotted form, or NULL for any
+//! @param[in] port the local port
+//! @param[out] source the identifier of the new source
+NAVI_EXTERN(navierr_status_t) navi_source_open_udp(struct navi_sources_t *sources,
+	const char *address, unsigned short port, int *source);
+
+//! @brief Adds the descriptor opened by the user, e.g. a pipe or a pty master
+//!
+//! The descriptor is switched to non-blocking mode. It is not closed
+//! by navi_source_close().
+NAVI_EXTERN(navierr_status_t) navi_source_add_fd(struct navi_sources_t *sources,
+	int fd, int *source);
+
+//! @brief Closes the source
+NAVI_EXTERN(navierr_status_t) navi_source_close(struct navi_sources_t *sources,
+	int source);
+
+//! @brief Copies the health counters of the source framer to stats
+//!
+//! The counters are kept from the opening of the source until it is closed.
+//! @return navi_Ok, or navi_Error with navi_InvalidParameter
+NAVI_EXTERN(navierr_status_t) navi_source_stats(struct navi_sources_t *sources,
+	int source, struct navi_framestats_t *stats);
+
+//! @brief Waits up to timeout milliseconds for input and handles it
+//!
+//! Every ready source is read once. The timeout of -1 waits infinitely.
+//! The number of handled sentences is stored to nmsentences, if it is not NULL.
+//! @return navi_Ok, or navi_Error with navi_SystemError
+NAVI_EXTERN(navierr_status_t) navi_sources_poll(struct navi_sources_t *sources,
+	int timeout, size_t *nmsentences);
+
+NAVI_END_DECL
+
+#endif // INCLUDE_navi_source_h
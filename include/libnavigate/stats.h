@@ -0,0 +1,176 @@
+/*
+ * stats.h - statistics of the parser and the generator
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! @file stats.h
+ *  @brief Declares the statistics of the parser and the generator.
+ *
+ *  When the library is built with WITH_STATS, every call of navi_parse_msg()
+ *  and navi_create_msg() is counted: the sentences per formatter and talker
+ *  identifier, the failures per error class, and the duration of the call
+ *  in the latency histogram of its sentence type. The durations are
+ *  measured in the ticks of the time stamp counter, where the processor
+ *  has one.
+ *
+ *  The counters are kept per thread and are updated without locks.
+ *  navi_stats_snapshot() sums the counters of all the threads, including
+ *  the finished ones, so the values only grow, as the exporters of
+ *  the metrics expect.
+ *
+ *  The tracing, enabled with navi_trace_enable(), follows every sentence
+ *  through the stages: from the last byte taken by navi_framer_push() to
+ *  the checksum verified, to the fields decoded, to the sentence passed
+ *  to the handler of navi_parse_batch(), navi_ingest_t or Parser_t of
+ *  the C++ bindings. The durations of the stages are counted in the trace
+ *  histograms of the sentence type. A program delivering the sentences on
+ *  its own marks the delivery with NAVI_TRACE(), which calls
+ *  navi_trace_mark() only while the tracing is on.
+ *
+ *  Without WITH_STATS the calls are not instrumented at all, and
+ *  navi_stats_snapshot() and navi_trace_enable() fail with
+ *  navi_NotImplemented.
+ */
+
+#ifndef INCLUDE_navi_stats_h
+#define INCLUDE_navi_stats_h
+
+#include "sentence.h"
+
+//! @brief Number of the approved sentence formatters
+#define NAVI_STATS_NM_FORMATTERS	(navi_ZTG + 1)
+
+//! @brief Number of the talker identifiers
+#define NAVI_STATS_NM_TALKERS		(navi_WI + 1)
+
+//! @brief Number of the error classes
+#define NAVI_STATS_NM_ERRCLASSES	(navi_SystemError + 1)
+
+//! @brief Histogram of the query sentences
+#define NAVI_STATS_QUERY			(NAVI_STATS_NM_FORMATTERS)
+
+//! @brief Histogram of the proprietary sentences
+#define NAVI_STATS_PROPRIETARY		(NAVI_STATS_NM_FORMATTERS + 1)
+
+//! @brief Histogram of the calls failed before the type is known,
+//! e.g. with navi_CrcEror
+#define NAVI_STATS_OTHER			(NAVI_STATS_NM_FORMATTERS + 2)
+
+//! @brief Number of the latency histograms, one per approved formatter,
+//! then the query, proprietary and other ones
+#define NAVI_STATS_NM_TYPES			(NAVI_STATS_NM_FORMATTERS + 3)
+
+//! @brief Number of the buckets of a latency histogram
+//!
+//! The bucket 0 counts the calls of 0 ticks, the bucket i counts the calls
+//! from 2^(i - 1) to 2^i - 1 ticks, and the last one all the longer calls.
+#define NAVI_STATS_NM_BUCKETS		24
+
+//! @brief Trace span from the sentence framed to the checksum verified
+#define NAVI_TRACE_CHECKSUM			0
+
+//! @brief Trace span from the checksum verified to the fields decoded
+#define NAVI_TRACE_DECODE			1
+
+//! @brief Trace span from the fields decoded to the handler called
+#define NAVI_TRACE_DELIVER			2
+
+//! @brief Trace span from the sentence framed to the handler called
+#define NAVI_TRACE_TOTAL			3
+
+//! @brief Number of the trace spans
+#define NAVI_TRACE_NM_SPANS			4
+
+//! @brief Statistics of the parser and the generator
+struct navi_stats_t
+{
+	//! Sentences parsed successfully per formatter and talker identifier
+	size_t parsed[NAVI_STATS_NM_FORMATTERS][NAVI_STATS_NM_TALKERS];
+
+	//! Sentences generated successfully per formatter and talker identifier
+	size_t generated[NAVI_STATS_NM_FORMATTERS][NAVI_STATS_NM_TALKERS];
+
+	//! Failed calls of navi_parse_msg() per error class
+	size_t parse_errors[NAVI_STATS_NM_ERRCLASSES];
+
+	//! Failed calls of navi_create_msg() per error class
+	size_t create_errors[NAVI_STATS_NM_ERRCLASSES];
+
+	//! Latency histograms of all the calls of navi_parse_msg()
+	size_t parse_latency[NAVI_STATS_NM_TYPES][NAVI_STATS_NM_BUCKETS];
+
+	//! Latency histograms of all the calls of navi_create_msg()
+	size_t create_latency[NAVI_STATS_NM_TYPES][NAVI_STATS_NM_BUCKETS];
+
+	//! Histograms of the trace spans of the sentences decoded, while traced
+	size_t trace_latency[NAVI_STATS_NM_TYPES][NAVI_TRACE_NM_SPANS][NAVI_STATS_NM_BUCKETS];
+
+	//! Ticks per second, measured since the first instrumented call
+	double ticks_per_second;
+};
+
+//! @brief Trace points of a sentence
+//!
+//! The points are marked by the thread parsing the sentence, and the stamps
+//! are kept per thread, so the stages of a sentence are matched, when all
+//! of them happen in one thread, one sentence after another.
+typedef enum
+{
+	navi_trace_Framed,		//!< the last byte of the sentence is taken
+	navi_trace_Parsing,		//!< the parsing started, the sentence is framed, if not yet
+	navi_trace_Checked,		//!< the checksum is verified
+	navi_trace_Decoded,		//!< the fields are decoded
+	navi_trace_Delivered,	//!< the sentence is passed to the handler
+	navi_trace_Dropped		//!< the sentence failed, or is skipped
+} navi_trace_point_t;
+
+NAVI_BEGIN_DECL
+
+//! @brief Sums the statistics of all the threads
+//!
+//! The counters are read while the other threads update them, so the
+//! snapshot is not atomic as a whole, but every counter is exact.
+//! @return navi_Ok, or navi_Error with the last error set to
+//! navi_NotImplemented, if the library is built without WITH_STATS
+NAVI_EXTERN(navierr_status_t) navi_stats_snapshot(struct navi_stats_t *stats);
+
+//! @brief Enables or disables the tracing of the sentences
+//!
+//! The tracing is off by default. When off, a trace point marked with
+//! NAVI_TRACE() costs a load and a branch.
+//! @return navi_Ok, or navi_Error with the last error set to
+//! navi_NotImplemented, if the library is built without WITH_STATS
+NAVI_EXTERN(navierr_status_t) navi_trace_enable(int enable);
+
+//! @brief Marks the trace point of the sentence parsed by the calling thread
+//!
+//! The type is the histogram of the sentence, i.e. the formatter,
+//! NAVI_STATS_QUERY, NAVI_STATS_PROPRIETARY or NAVI_STATS_OTHER, used by
+//! navi_trace_Decoded only. Does nothing, while the tracing is off.
+NAVI_EXTERN(void) navi_trace_mark(navi_trace_point_t point, int type);
+
+//! @brief Nonzero while the tracing is enabled, always 0 without WITH_STATS
+NAVI_EXTERN(volatile size_t) navi_trace_enabled;
+
+NAVI_END_DECL
+
+//! @brief Marks the trace point, calling navi_trace_mark() only while
+//! the tracing is enabled
+#define NAVI_TRACE(point, type) \
+	(navi_trace_enabled ? navi_trace_mark((point), (type)) : (void)0)
+
+#endif // INCLUDE_navi_stats_h
@@ -48,10 +48,19 @@
 #include "libnavigate/txt.h"
 #include "libnavigate/vtg.h"
 #include "libnavigate/zda.h"
+#include "libnavigate/schema.h"
 
 #include "libnavigate/proprietarymsg.h"
 
 #include "libnavigate/generator.h"
 #include "libnavigate/parser.h"
 
+#include "libnavigate/framer.h"
+#include "libnavigate/ringbuf.h"
+#include "libnavigate/batch.h"
+#include "libnavigate/ingest.h"
+#include "libnavigate/source.h"
+#include "libnavigate/arena.h"
+#include "libnavigate/stats.h"
+
 #endif // INCLUDE_navi_navigate_h
@@ -0,0 +1,477 @@
+/*
+ * arena.c - arena of parsed IEC sentences
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/arena.h>
+#include <libnavigate/parser.h>
+
+#include <libnavigate/aam.h>
+#include <libnavigate/ack.h>
+#include <libnavigate/alm.h>
+#include <libnavigate/alr.h>
+#include <libnavigate/apb.h>
+#include <libnavigate/bec.h>
+#include <libnavigate/bod.h>
+#include <libnavigate/bwc.h>
+#include <libnavigate/bwr.h>
+#include <libnavigate/bww.h>
+#include <libnavigate/dtm.h>
+#include <libnavigate/gbs.h>
+#include <libnavigate/gga.h>
+#include <libnavigate/gll.h>
+#include <libnavigate/gns.h>
+#include <libnavigate/grs.h>
+#include <libnavigate/gsa.h>
+#include <libnavigate/gst.h>
+#include <libnavigate/gsv.h>
+#include <libnavigate/mla.h>
+#include <libnavigate/rmc.h>
+#include <libnavigate/txt.h>
+#include <libnavigate/vtg.h>
+#include <libnavigate/zda.h>
+#include <libnavigate/schema.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+//
+// The slabs are kept in the list in the order of allocation. The arena
+// hands out memory from the current slab and goes to the next one, when
+// the current one is full. After reset the arena starts over from the
+// first slab. The slabs for the requests larger than the slab size are
+// kept apart and freed by reset.
+//
+// A freed sentence slot is put to the list of free slots of its type.
+// The first bytes of a free slot point to the next free slot.
+//
+
+// The alignment of the memory handed out
+typedef union
+{
+	double d;
+	void *p;
+	long l;
+} navi_align_t;
+
+#define NAVI_ALIGN(size)	(((size) + sizeof(navi_align_t) - 1) & ~(sizeof(navi_align_t) - 1))
+
+// The largest of the sentence structures
+union navi_sentence_storage_t
+{
+	struct aam_t aam; struct ack_t ack; struct alm_t alm; struct alr_t alr;
+	struct apb_t apb; struct bec_t bec; struct bod_t bod; struct bwc_t bwc;
+	struct bwr_t bwr; struct bww_t bww; struct dtm_t dtm; struct gbs_t gbs;
+	struct gga_t gga; struct gll_t gll; struct gns_t gns; struct grs_t grs;
+	struct gsa_t gsa; struct gst_t gst; struct gsv_t gsv; struct mla_t mla;
+	struct rmc_t rmc; struct txt_t txt; struct vtg_t vtg; struct zda_t zda;
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class)	struct name##_t name;
+#include <libnavigate/schema.def>
+};
+
+#define NAVI_ARENA_MAXSLOT	NAVI_ALIGN(sizeof(struct approved_field_t) + \
+	sizeof(union navi_sentence_storage_t))
+
+struct navi_slab_t
+{
+	struct navi_slab_t *next;
+	size_t size;	// the size of memory after the header
+	navi_align_t memory[1];
+};
+
+#define NAVI_SLAB_HEADER	offsetof(struct navi_slab_t, memory)
+
+struct navi_arena_t
+{
+	size_t slabsize;
+
+	struct navi_slab_t *first, *current, *large;
+	char *pos, *end;
+
+	size_t used, reserved;
+
+	void *freeslots[navi_ZTG + 1];
+};
+
+//
+// Returns the size of the structure of the approved sentence
+size_t navi_sentence_size(navi_approved_fmt_t fmt)
+{
+	switch (fmt)
+	{
+	case navi_AAM:
+		return sizeof(struct aam_t);
+	case navi_ACK:
+		return sizeof(struct ack_t);
+	case navi_ALM:
+		return sizeof(struct alm_t);
+	case navi_ALR:
+		return sizeof(struct alr_t);
+	case navi_APB:
+		return sizeof(struct apb_t);
+	case navi_BEC:
+		return sizeof(struct bec_t);
+	case navi_BOD:
+		return sizeof(struct bod_t);
+	case navi_BWC:
+		return sizeof(struct bwc_t);
+	case navi_BWR:
+		return sizeof(struct bwr_t);
+	case navi_BWW:
+		return sizeof(struct bww_t);
+	case navi_DTM:
+		return sizeof(struct dtm_t);
+	case navi_GBS:
+		return sizeof(struct gbs_t);
+	case navi_GGA:
+		return sizeof(struct gga_t);
+	case navi_GLL:
+		return sizeof(struct gll_t);
+	case navi_GNS:
+		return sizeof(struct gns_t);
+	case navi_GRS:
+		return sizeof(struct grs_t);
+	case navi_GSA:
+		return sizeof(struct gsa_t);
+	case navi_GST:
+		return sizeof(struct gst_t);
+	case navi_GSV:
+		return sizeof(struct gsv_t);
+	case navi_MLA:
+		return sizeof(struct mla_t);
+	case navi_RMC:
+		return sizeof(struct rmc_t);
+	case navi_TXT:
+		return sizeof(struct txt_t);
+	case navi_VTG:
+		return sizeof(struct vtg_t);
+	case navi_ZDA:
+		return sizeof(struct zda_t);
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	case navi_##NAME: \
+		return sizeof(struct name##_t);
+#include <libnavigate/schema.def>
+	default:
+		return 0;
+	}
+}
+
+//
+// The size of the slot of the sentence, 0 if not supported
+static size_t navi_arena_slotsize(navi_approved_fmt_t fmt)
+{
+	size_t size = navi_sentence_size(fmt);
+
+	return size > 0 ? NAVI_ALIGN(sizeof(struct approved_field_t) + size) : 0;
+}
+
+//
+// Creates an empty arena
+struct navi_arena_t *navi_arena_create(size_t slabsize)
+{
+	struct navi_arena_t *arena;
+
+	arena = (struct navi_arena_t *)calloc(1, sizeof(*arena));
+	if (arena == NULL)
+	{
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	// every slab takes at least one slot of any sentence
+	arena->slabsize = NAVI_ALIGN(slabsize > 0 ? slabsize : NAVI_ARENA_SLABSIZE);
+	if (arena->slabsize < NAVI_ARENA_MAXSLOT)
+		arena->slabsize = NAVI_ARENA_MAXSLOT;
+
+	return arena;
+}
+
+//
+// Frees the list of slabs
+static void navi_arena_free_slabs(struct navi_slab_t *slab)
+{
+	struct navi_slab_t *next;
+
+	for ( ; slab != NULL; slab = next)
+	{
+		next = slab->next;
+		free(slab);
+	}
+}
+
+//
+// Frees the arena and all its slabs
+void navi_arena_destroy(struct navi_arena_t *arena)
+{
+	if (arena == NULL)
+		return;
+
+	navi_arena_free_slabs(arena->first);
+	navi_arena_free_slabs(arena->large);
+	free(arena);
+}
+
+//
+// Makes the next slab current, allocating it if needed
+static int navi_arena_next_slab(struct navi_arena_t *arena)
+{
+	struct navi_slab_t *slab;
+
+	if ((arena->current != NULL) && (arena->current->next != NULL))
+	{
+		slab = arena->current->next;
+	}
+	else
+	{
+		slab = (struct navi_slab_t *)malloc(NAVI_SLAB_HEADER + arena->slabsize);
+		if (slab == NULL)
+			return 0;
+
+		slab->next = NULL;
+		slab->size = arena->slabsize;
+		arena->reserved += slab->size;
+
+		if (arena->current != NULL)
+			arena->current->next = slab;
+		else
+			arena->first = slab;
+	}
+
+	arena->current = slab;
+	arena->pos = (char *)slab->memory;
+	arena->end = arena->pos + slab->size;
+
+	return 1;
+}
+
+//
+// Returns the room of at least size bytes at arena->pos
+static int navi_arena_reserve(struct navi_arena_t *arena, size_t size)
+{
+	if ((arena->current != NULL) && ((size_t)(arena->end - arena->pos) >= size))
+		return 1;
+
+	if (arena->current == NULL)
+	{
+		if (arena->first == NULL)
+			return navi_arena_next_slab(arena);
+
+		arena->current = arena->first;
+		arena->pos = (char *)arena->current->memory;
+		arena->end = arena->pos + arena->current->size;
+
+		return 1;
+	}
+
+	return navi_arena_next_slab(arena);
+}
+
+//
+// Allocates size bytes aligned for any type
+void *navi_arena_alloc(struct navi_arena_t *arena, size_t size)
+{
+	void *result;
+	struct navi_slab_t *slab;
+
+	size = NAVI_ALIGN(size > 0 ? size : 1);
+
+	if (size > arena->slabsize)
+	{
+		slab = (struct navi_slab_t *)malloc(NAVI_SLAB_HEADER + size);
+		if (slab == NULL)
+		{
+			navierr_set_last(navi_SystemError);
+			return NULL;
+		}
+
+		slab->next = arena->large;
+		slab->size = size;
+		arena->large = slab;
+		arena->reserved += size;
+		arena->used += size;
+
+		return slab->memory;
+	}
+
+	if (!navi_arena_reserve(arena, size))
+	{
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	result = arena->pos;
+	arena->pos += size;
+	arena->used += size;
+
+	return result;
+}
+
+//
+// Allocates the slot of the approved sentence, reusing a freed one
+struct approved_field_t *navi_arena_alloc_msg(struct navi_arena_t *arena,
+	navi_approved_fmt_t fmt)
+{
+	struct approved_field_t *msg;
+	size_t size = navi_arena_slotsize(fmt);
+
+	if (size == 0)
+	{
+		navierr_set_last(navi_MsgNotSupported);
+		return NULL;
+	}
+
+	if (arena->freeslots[fmt] != NULL)
+	{
+		msg = (struct approved_field_t *)arena->freeslots[fmt];
+		arena->freeslots[fmt] = *(void **)msg;
+	}
+	else if ((msg = (struct approved_field_t *)navi_arena_alloc(arena, size)) == NULL)
+	{
+		return NULL;
+	}
+
+	msg->afmt = fmt;
+	msg->tid = navi_talkerid_Unknown;
+
+	return msg;
+}
+
+//
+// Puts the slot to the list of free slots of its type
+void navi_arena_free_msg(struct navi_arena_t *arena, struct approved_field_t *msg)
+{
+	navi_approved_fmt_t fmt;
+
+	if (msg == NULL)
+		return;
+
+	fmt = msg->afmt;
+	*(void **)msg = arena->freeslots[fmt];
+	arena->freeslots[fmt] = msg;
+}
+
+//
+// Checks if the first sentence in buffer is proprietary, and if so, finds
+// its end as navi_parse_msg() does. Returns 0, if it is not proprietary,
+// 1, if it is, and -1, if it is not terminated by <cr><lf>.
+static int navi_arena_is_proprietary(const char *buffer, size_t maxsize, size_t *nmread)
+{
+	size_t som, eom;
+
+	for (som = 0; (som < maxsize) && (buffer[som] != '$'); som++) { }
+	if ((som + 1 >= maxsize) || (buffer[som + 1] != 'P'))
+		return 0;
+
+	for (eom = som + 1; eom < maxsize; eom++)
+	{
+		if ((buffer[eom - 1] == '\r') && (buffer[eom] == '\n'))
+		{
+			*nmread = eom + 1;
+			return 1;
+		}
+	}
+
+	return -1;
+}
+
+//
+// Parses the approved sentence into the slot of its size, reusing a freed one
+struct approved_field_t *navi_arena_parse(struct navi_arena_t *arena,
+	char *buffer, size_t maxsize, size_t *nmread)
+{
+	struct approved_field_t *msg, *slot;
+	navi_addrfield_t type;
+	size_t size;
+	int proprietary;
+
+	// the proprietary sentences are parsed by the user's callbacks,
+	// which may write more than the slot takes
+	proprietary = navi_arena_is_proprietary(buffer, maxsize, nmread);
+	if (proprietary != 0)
+	{	// nmread is not set for the incomplete one, as by navi_parse_msg()
+		navierr_set_last(proprietary > 0 ? navi_MsgNotSupported : navi_NoValidMessage);
+		return NULL;
+	}
+
+	if (!navi_arena_reserve(arena, NAVI_ARENA_MAXSLOT))
+	{
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	// parse in place into the largest slot, then trim it
+	msg = (struct approved_field_t *)arena->pos;
+
+	if (navi_parse_msg(buffer, maxsize, NAVI_ARENA_MAXSLOT, &type, msg, nmread) != navi_Ok)
+		return NULL;
+
+	if ((type != navi_af_Approved) || ((size = navi_arena_slotsize(msg->afmt)) == 0))
+	{
+		navierr_set_last(navi_MsgNotSupported);
+		return NULL;
+	}
+
+	// move the sentence to the freed slot of its type, if there is one
+	if (arena->freeslots[msg->afmt] != NULL)
+	{
+		slot = (struct approved_field_t *)arena->freeslots[msg->afmt];
+		arena->freeslots[msg->afmt] = *(void **)slot;
+		memcpy(slot, msg, size);
+
+		return slot;
+	}
+
+	arena->pos += size;
+	arena->used += size;
+
+	return msg;
+}
+
+//
+// Releases all the memory handed out, keeping the slabs
+void navi_arena_reset(struct navi_arena_t *arena)
+{
+	struct navi_slab_t *slab;
+
+	navi_arena_free_slabs(arena->large);
+	arena->large = NULL;
+
+	arena->current = NULL;
+	arena->pos = arena->end = NULL;
+
+	arena->used = 0;
+	arena->reserved = 0;
+	for (slab = arena->first; slab != NULL; slab = slab->next)
+		arena->reserved += slab->size;
+
+	memset(arena->freeslots, 0, sizeof(arena->freeslots));
+}
+
+//
+// Returns the number of bytes handed out since the last reset
+size_t navi_arena_used(const struct navi_arena_t *arena)
+{
+	return arena->used;
+}
+
+//
+// Returns the total size of the slabs
+size_t navi_arena_reserved(const struct navi_arena_t *arena)
+{
+	return arena->reserved;
+}
@@ -0,0 +1,106 @@
+/*
+ * atomic.h - atomic operations used by lock-free structures of libnavigate
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_navi_atomic_h
+#define INCLUDE_navi_atomic_h
+
+#include <stddef.h>
+
+//
+// All operations work on 'volatile size_t' variables.
+//
+// navi_atomic_load(p)				- relaxed load
+// navi_atomic_store(p, v)			- relaxed store
+// navi_atomic_load_acquire(p)		- load with acquire semantics
+// navi_atomic_store_release(p, v)	- store with release semantics
+// navi_atomic_cas(p, e, d)			- strong compare-and-swap with full barrier,
+//									  evaluates to non-zero on success
+// navi_atomic_fetch_add(p, v)		- atomic add with full barrier, evaluates
+//									  to the previous value
+// navi_atomic_fence()				- full memory barrier
+//
+
+#if defined(__GNUC__)
+
+#define navi_atomic_load(p)				__atomic_load_n((p), __ATOMIC_RELAXED)
+#define navi_atomic_store(p, v)			__atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define navi_atomic_load_acquire(p)		__atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define navi_atomic_store_release(p, v)	__atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define navi_atomic_fetch_add(p, v)		__atomic_fetch_add((p), (v), __ATOMIC_SEQ_CST)
+#define navi_atomic_fence()				__atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+static __inline__ int navi_atomic_cas(volatile size_t *p, size_t expected, size_t desired)
+{
+	return __atomic_compare_exchange_n(p, &expected, desired, 0,
+		__ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+#elif defined(_MSC_VER)
+
+#include <windows.h>
+#include <intrin.h>
+
+#define navi_atomic_load(p)				(*(p))
+#define navi_atomic_store(p, v)			(*(p) = (v))
+#define navi_atomic_fence()				MemoryBarrier()
+
+static __inline size_t navi_atomic_load_acquire(volatile size_t *p)
+{
+	size_t v = *p;
+	_ReadWriteBarrier();
+	return v;
+}
+
+static __inline void navi_atomic_store_release(volatile size_t *p, size_t v)
+{
+	_ReadWriteBarrier();
+	*p = v;
+}
+
+#ifdef _WIN64
+
+static __inline int navi_atomic_cas(volatile size_t *p, size_t expected, size_t desired)
+{
+	return (size_t)InterlockedCompareExchange64((volatile LONGLONG *)p,
+		(LONGLONG)desired, (LONGLONG)expected) == expected;
+}
+
+#define navi_atomic_fetch_add(p, v)	\
+	((size_t)InterlockedExchangeAdd64((volatile LONGLONG *)(p), (LONGLONG)(v)))
+
+#else
+
+static __inline int navi_atomic_cas(volatile size_t *p, size_t expected, size_t desired)
+{
+	return (size_t)InterlockedCompareExchange((volatile LONG *)p,
+		(LONG)desired, (LONG)expected) == expected;
+}
+
+#define navi_atomic_fetch_add(p, v)	\
+	((size_t)InterlockedExchangeAdd((volatile LONG *)(p), (LONG)(v)))
+
+#endif // _WIN64
+
+#else
+
+#error "Atomic operations are not implemented for this compiler"
+
+#endif // __GNUC__, _MSC_VER or other compiler
+
+#endif // INCLUDE_navi_atomic_h
@@ -0,0 +1,647 @@
+/*
+ * batch.c - parsing of buffers and track files with many sentences
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/batch.h>
+#include <libnavigate/parser.h>
+
+#include <libnavigate/aam.h>
+#include <libnavigate/ack.h>
+#include <libnavigate/alm.h>
+#include <libnavigate/alr.h>
+#include <libnavigate/apb.h>
+#include <libnavigate/bec.h>
+#include <libnavigate/bod.h>
+#include <libnavigate/bwc.h>
+#include <libnavigate/bwr.h>
+#include <libnavigate/bww.h>
+#include <libnavigate/dtm.h>
+#include <libnavigate/gbs.h>
+#include <libnavigate/gga.h>
+#include <libnavigate/gll.h>
+#include <libnavigate/gns.h>
+#include <libnavigate/grs.h>
+#include <libnavigate/gsa.h>
+#include <libnavigate/gst.h>
+#include <libnavigate/gsv.h>
+#include <libnavigate/mla.h>
+#include <libnavigate/rmc.h>
+#include <libnavigate/txt.h>
+#include <libnavigate/vtg.h>
+#include <libnavigate/zda.h>
+#include <libnavigate/schema.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#include "instrument.h"
+#include "pool.h"
+#include "thread.h"
+
+//
+// Any approved sentence must fit into navi_parsed_t::msg
+union navi_anymsg_t
+{
+	struct aam_t aam; struct ack_t ack; struct alm_t alm; struct alr_t alr;
+	struct apb_t apb; struct bec_t bec; struct bod_t bod; struct bwc_t bwc;
+	struct bwr_t bwr; struct bww_t bww; struct dtm_t dtm; struct gbs_t gbs;
+	struct gga_t gga; struct gll_t gll; struct gns_t gns; struct grs_t grs;
+	struct gsa_t gsa; struct gst_t gst; struct gsv_t gsv; struct mla_t mla;
+	struct rmc_t rmc; struct txt_t txt; struct vtg_t vtg; struct zda_t zda;
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class)	struct name##_t name;
+#include <libnavigate/schema.def>
+	struct query_field_t query;
+};
+
+typedef char navi_msgsize_check_t[(sizeof(struct approved_field_t) +
+	sizeof(union navi_anymsg_t) <= NAVI_BATCH_MSGSIZE) ? 1 : -1];
+
+//! Nominal size of a chunk parsed by a worker
+#define NAVI_BATCH_CHUNKSIZE	(256 * 1024)
+
+//! Minimum size of a chunk, to keep the synchronization cheap
+#define NAVI_BATCH_MINCHUNK		(16 * 1024)
+
+//
+// Parses the sentence at or after offset. Returns 0 if there are no
+// more sentences terminated by <cr><lf>.
+static int navi_parse_next(char *buffer, size_t size, size_t offset,
+	struct navi_parsed_t *parsed)
+{
+	const char *som;
+	size_t nmread = 0;
+
+	som = (const char *)memchr(buffer + offset, '$', size - offset);
+	if (som == NULL)
+		return 0;
+
+	parsed->offset = som - buffer;
+	parsed->type = navi_af_Unknown;
+	parsed->status = navi_parse_msg(buffer + parsed->offset, size - parsed->offset,
+		sizeof(parsed->msg), &parsed->type, parsed->msg, &nmread);
+	if (nmread == 0)
+		return 0;	// the sentence is not terminated
+
+	parsed->length = nmread;
+	parsed->errclass = parsed->status == navi_Ok ? navi_Undefined : navierr_get_last()->errclass;
+
+	return 1;
+}
+
+//
+// Parses all sentences in buffer one by one
+navierr_status_t navi_parse_batch(char *buffer, size_t size,
+	navi_batch_handler_t handler, void *context, size_t *nmread)
+{
+	size_t offset = 0;
+	struct navi_parsed_t parsed;
+
+	if ((buffer == NULL && size > 0) || (handler == NULL))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	while (navi_parse_next(buffer, size, offset, &parsed))
+	{
+		offset = parsed.offset + parsed.length;
+
+		navi_trace(navi_trace_Delivered, 0);
+		if (handler(&parsed, context) != 0)
+			break;
+	}
+
+	if (nmread)
+		*nmread = offset;
+
+	return navi_Ok;
+}
+
+//
+// Parallel parsing
+//
+// The buffer is cut into chunks of nominal size. The real border of a chunk
+// is moved forward to the byte after the next <cr><lf>, so that the next
+// chunk starts at the following sentence. As navi_parse_msg() never reads
+// a sentence past its <cr><lf>, each chunk yields exactly the sentences that
+// navi_parse_batch() would find there.
+//
+// The chunks are queued to a window of slots, which the workers of the pool
+// take in order and store the results to. The calling thread passes
+// the results to the handler chunk by chunk and frees the slots. When all
+// the slots are taken, the submission delivers the oldest chunk first,
+// which bounds the memory used. The pool outlives a buffer, so the workers
+// parse the next buffer, while the previous one is being delivered.
+//
+
+struct navi_chunk_t
+{
+	size_t ready;	// number of the parsed chunk + 1, or 0
+	int failed;		// no memory for the results
+
+	char *buffer;
+	size_t begin, end;
+	navi_batch_handler_t handler;
+	void *context;
+
+	struct navi_parsed_t *results;
+	size_t nmresults, capacity;
+};
+
+struct navi_pool_t
+{
+	size_t submitted;	// the number of queued chunks
+	size_t next;		// next chunk to parse
+	size_t delivered;	// the number of delivered chunks
+	int stop;			// set under the mutex
+	int stopped;		// the copy of the submitting thread
+
+	size_t window;
+	struct navi_chunk_t *slots;
+
+	int nmthreads;
+	navi_thread_t *threads;
+
+	navi_mutex_t mutex;
+	navi_cond_t cond;
+};
+
+//
+// Returns the offset of the chunk border for the nominal position pos
+static size_t navi_chunk_border(const char *buffer, size_t size, size_t pos)
+{
+	const char *p;
+
+	if (pos == 0)
+		return 0;
+	if (pos >= size)
+		return size;
+
+	// <cr> may be just before the nominal position
+	for (pos -= 1; pos + 1 < size; pos = p - buffer + 1)
+	{
+		p = (const char *)memchr(buffer + pos, '\r', size - pos - 1);
+		if (p == NULL)
+			break;
+		if (p[1] == '\n')
+			return p - buffer + 2;
+	}
+
+	return size;
+}
+
+//
+// Parses the chunk in the slot
+static void navi_parse_chunk(struct navi_chunk_t *slot)
+{
+	size_t begin = slot->begin, capacity;
+	struct navi_parsed_t *results;
+
+	slot->nmresults = 0;
+	slot->failed = 0;
+
+	for ( ; ; )
+	{
+		if (slot->nmresults == slot->capacity)
+		{
+			capacity = slot->capacity > 0 ? slot->capacity * 2 : 256;
+			results = (struct navi_parsed_t *)realloc(slot->results,
+				capacity * sizeof(*results));
+			if (results == NULL)
+			{
+				slot->failed = 1;
+				return;
+			}
+			slot->results = results;
+			slot->capacity = capacity;
+		}
+
+		if (!navi_parse_next(slot->buffer, slot->end, begin, &slot->results[slot->nmresults]))
+			break;
+
+		begin = slot->results[slot->nmresults].offset + slot->results[slot->nmresults].length;
+		slot->nmresults++;
+	}
+}
+
+//
+// Returns the nominal size of the chunks of the buffer, a few per worker
+static size_t navi_chunk_size(size_t size, int nmthreads)
+{
+	size_t chunksize = size / ((size_t)nmthreads * 4);
+
+	if (chunksize > NAVI_BATCH_CHUNKSIZE)
+		chunksize = NAVI_BATCH_CHUNKSIZE;
+	if (chunksize < NAVI_BATCH_MINCHUNK)
+		chunksize = NAVI_BATCH_MINCHUNK;
+
+	return chunksize;
+}
+
+//
+// Stops the workers, the chunks they parse are not delivered
+static void navi_pool_stop(struct navi_pool_t *pool)
+{
+	navi_mutex_lock(&pool->mutex);
+	pool->stop = 1;
+	navi_cond_broadcast(&pool->cond);
+	navi_mutex_unlock(&pool->mutex);
+
+	pool->stopped = 1;
+}
+
+//
+// Worker thread
+static NAVI_THREAD_PROC(navi_parse_worker, arg)
+{
+	size_t index;
+	struct navi_pool_t *pool = (struct navi_pool_t *)arg;
+	struct navi_chunk_t *slot;
+
+	navi_mutex_lock(&pool->mutex);
+
+	for ( ; ; )
+	{
+		while (!pool->stop && (pool->next >= pool->submitted))
+			navi_cond_wait(&pool->cond, &pool->mutex);
+
+		if (pool->stop)
+			break;
+
+		index = pool->next++;
+		slot = &pool->slots[index % pool->window];
+
+		navi_mutex_unlock(&pool->mutex);
+		navi_parse_chunk(slot);
+		navi_mutex_lock(&pool->mutex);
+
+		slot->ready = index + 1;
+		navi_cond_broadcast(&pool->cond);
+	}
+
+	navi_mutex_unlock(&pool->mutex);
+
+	return 0;
+}
+
+//
+// navi_pool_create
+//
+struct navi_pool_t *navi_pool_create(int nmthreads)
+{
+	struct navi_pool_t *pool;
+	int i;
+
+	if (nmthreads <= 0)
+		nmthreads = navi_cpu_count();
+
+	pool = (struct navi_pool_t *)calloc(1, sizeof(*pool));
+	if (pool == NULL)
+	{
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	// a few chunks per worker, the next buffer is parsed meanwhile
+	pool->window = (size_t)nmthreads * 4;
+	pool->slots = (struct navi_chunk_t *)calloc(pool->window, sizeof(*pool->slots));
+	pool->threads = (navi_thread_t *)malloc(nmthreads * sizeof(*pool->threads));
+	if ((pool->slots == NULL) || (pool->threads == NULL))
+	{
+		free(pool->slots);
+		free(pool->threads);
+		free(pool);
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	navi_mutex_init(&pool->mutex);
+	navi_cond_init(&pool->cond);
+
+	for (i = 0; i < nmthreads; i++)
+	{
+		if (navi_thread_create(&pool->threads[i], navi_parse_worker, pool) != navi_Ok)
+			break;
+		pool->nmthreads++;
+	}
+
+	if (pool->nmthreads == 0)
+	{
+		navi_pool_destroy(pool);
+		return NULL;
+	}
+
+	return pool;
+}
+
+//
+// navi_pool_destroy
+//
+void navi_pool_destroy(struct navi_pool_t *pool)
+{
+	size_t k;
+	int i;
+
+	navi_pool_stop(pool);
+
+	for (i = 0; i < pool->nmthreads; i++)
+		navi_thread_join(&pool->threads[i]);
+
+	for (k = 0; k < pool->window; k++)
+		free(pool->slots[k].results);
+	free(pool->slots);
+	free(pool->threads);
+
+	navi_cond_destroy(&pool->cond);
+	navi_mutex_destroy(&pool->mutex);
+
+	free(pool);
+}
+
+//
+// navi_pool_nmthreads
+//
+int navi_pool_nmthreads(const struct navi_pool_t *pool)
+{
+	return pool->nmthreads;
+}
+
+//
+// navi_pool_submitted
+//
+size_t navi_pool_submitted(const struct navi_pool_t *pool)
+{
+	return pool->submitted;
+}
+
+//
+// navi_pool_stopped
+//
+int navi_pool_stopped(const struct navi_pool_t *pool)
+{
+	return pool->stopped;
+}
+
+//
+// navi_pool_deliver
+//
+navierr_status_t navi_pool_deliver(struct navi_pool_t *pool, size_t upto)
+{
+	struct navi_chunk_t *slot;
+	size_t index, k;
+
+	for (index = pool->delivered; !pool->stopped && (index < upto); index++)
+	{
+		slot = &pool->slots[index % pool->window];
+
+		navi_mutex_lock(&pool->mutex);
+		while (slot->ready != index + 1)
+			navi_cond_wait(&pool->cond, &pool->mutex);
+		navi_mutex_unlock(&pool->mutex);
+
+		if (slot->failed)
+		{
+			navi_pool_stop(pool);
+			navierr_set_last(navi_SystemError);
+			return navi_Error;
+		}
+
+		// the sentences are decoded by the workers, so the delivery is not traced
+		for (k = 0; k < slot->nmresults; k++)
+		{
+			if (slot->handler(&slot->results[k], slot->context) != 0)
+			{
+				navi_pool_stop(pool);
+				return navi_Ok;
+			}
+		}
+
+		navi_mutex_lock(&pool->mutex);
+		slot->ready = 0;
+		pool->delivered++;
+		navi_mutex_unlock(&pool->mutex);
+	}
+
+	return navi_Ok;
+}
+
+//
+// navi_pool_submit
+//
+navierr_status_t navi_pool_submit(struct navi_pool_t *pool, char *buffer, size_t size,
+	size_t chunksize, navi_batch_handler_t handler, void *context)
+{
+	struct navi_chunk_t *slot;
+	size_t begin, end;
+
+	if (chunksize == 0)
+		chunksize = navi_chunk_size(size, pool->nmthreads);
+
+	for (begin = 0; !pool->stopped && (begin < size); begin = end)
+	{
+		end = navi_chunk_border(buffer, size, begin + chunksize);
+
+		if ((pool->submitted - pool->delivered == pool->window) &&
+			(navi_pool_deliver(pool, pool->delivered + 1) != navi_Ok))
+		{
+			return navi_Error;
+		}
+		if (pool->stopped)
+			break;
+
+		slot = &pool->slots[pool->submitted % pool->window];
+		slot->buffer = buffer;
+		slot->begin = begin;
+		slot->end = end;
+		slot->handler = handler;
+		slot->context = context;
+
+		navi_mutex_lock(&pool->mutex);
+		pool->submitted++;
+		navi_cond_signal(&pool->cond);
+		navi_mutex_unlock(&pool->mutex);
+	}
+
+	return navi_Ok;
+}
+
+//
+// Parses all sentences in buffer on nmthreads worker threads
+navierr_status_t navi_parse_parallel(char *buffer, size_t size,
+	int nmthreads, navi_batch_handler_t handler, void *context)
+{
+	navierr_status_t result;
+	struct navi_pool_t *pool;
+	size_t chunksize, nmchunks;
+
+	if ((buffer == NULL && size > 0) || (handler == NULL) || (nmthreads < 0))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	if (nmthreads == 0)
+		nmthreads = navi_cpu_count();
+
+	chunksize = navi_chunk_size(size, nmthreads);
+	nmchunks = (size + chunksize - 1) / chunksize;
+
+	if ((nmthreads == 1) || (nmchunks < 2))
+		return navi_parse_batch(buffer, size, handler, context, NULL);
+
+	if ((size_t)nmthreads > nmchunks)
+		nmthreads = (int)nmchunks;
+
+	pool = navi_pool_create(nmthreads);
+	if (pool == NULL)
+		return navi_Error;
+
+	result = navi_pool_submit(pool, buffer, size, chunksize, handler, context);
+	if (result == navi_Ok)
+		result = navi_pool_deliver(pool, navi_pool_submitted(pool));
+
+	navi_pool_destroy(pool);
+
+	return result;
+}
+
+//
+// Maps the track file to memory and parses it with navi_parse_parallel()
+navierr_status_t navi_parse_track(const char *filename,
+	int nmthreads, navi_batch_handler_t handler, void *context)
+{
+	navierr_status_t result;
+	char *buffer;
+	size_t size;
+
+#ifdef _WIN32
+
+	HANDLE file, mapping;
+	LARGE_INTEGER filesize;
+
+#else
+
+	int fd;
+	struct stat st;
+
+#endif // _WIN32
+
+	if (filename == NULL || handler == NULL)
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+#ifdef _WIN32
+
+	file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	if (!GetFileSizeEx(file, &filesize) || ((ULONGLONG)filesize.QuadPart > (size_t)-1))
+	{
+		CloseHandle(file);
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	size = (size_t)filesize.QuadPart;
+	if (size == 0)
+	{
+		CloseHandle(file);
+		return navi_Ok;
+	}
+
+	// Copy-on-write view, as the buffer is not const for the parser
+	mapping = CreateFileMapping(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	buffer = mapping != NULL ? (char *)MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : NULL;
+	if (buffer == NULL)
+	{
+		if (mapping != NULL)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	result = navi_parse_parallel(buffer, size, nmthreads, handler, context);
+
+	UnmapViewOfFile(buffer);
+	CloseHandle(mapping);
+	CloseHandle(file);
+
+#else
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0)
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	if ((fstat(fd, &st) != 0) || ((unsigned long long)st.st_size > (size_t)-1))
+	{
+		close(fd);
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	size = (size_t)st.st_size;
+	if (size == 0)
+	{
+		close(fd);
+		return navi_Ok;
+	}
+
+	// Private writable mapping, as the buffer is not const for the parser
+	buffer = (char *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (buffer == (char *)MAP_FAILED)
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+#ifdef MADV_WILLNEED
+	(void)madvise(buffer, size, MADV_WILLNEED);
+#endif // MADV_WILLNEED
+
+	result = navi_parse_parallel(buffer, size, nmthreads, handler, context);
+
+	munmap(buffer, size);
+
+#endif // _WIN32
+
+	return result;
+}
@@ -19,6 +19,7 @@
 
 #include <libnavigate/errors.h>
 #include <libnavigate/common.h>
+#include <libnavigate/parser.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -39,12 +40,13 @@
 //
 // navi_parse_status
 //
-navierr_status_t navi_parse_status(char *buffer, int *status, int *nmread)
+navierr_status_t navi_parse_status(char *buffer, navi_status_t *status, size_t *nmread)
 {
 
 #ifndef NO_PARSER
 
-	int i = 0, c, error = 0;
+	int c, error = 0;
+	size_t i = 0;
 
 	assert(buffer != NULL);
 	assert(status != NULL);
@@ -91,12 +93,13 @@ navierr_status_t navi_parse_status(char *buffer, int *status, int *nmread)
 //
 // navi_parse_modeindicator
 //
-navierr_status_t navi_parse_modeindicator(char *buffer, int *mi, int *nmread)
+navierr_status_t navi_parse_modeindicator(char *buffer, navi_modeindicator_t *mi, size_t *nmread)
 {
 
 #ifndef NO_PARSER
 
-	int i = 0, c, error = 0;
+	int c, error = 0;
+	size_t i = 0;
 
 	assert(buffer != NULL);
 	assert(mi != NULL);
@@ -421,7 +424,7 @@ navierr_status_t navi_checksum(char *msg, size_t maxsize, char *csstr, unsigned
 	assert(maxsize > 0);
 
 	// Skip up to next character after '$'
-	for (i = 0; msg[i] != '$' && i < maxsize; i++) { }
+	for (i = 0; i < maxsize && msg[i] != '$'; i++) { }
 
 	if (i >= maxsize)
 	{
@@ -429,7 +432,7 @@ navierr_status_t navi_checksum(char *msg, size_t maxsize, char *csstr, unsigned
 		return navi_Error;
 	}
 
-	for (i += 1; msg[i] != '*' && i < maxsize; i++)
+	for (i += 1; i < maxsize && msg[i] != '*'; i++)
 		ucs = ucs ^ msg[i];
 
 	if (i >= maxsize)
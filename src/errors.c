@@ -18,8 +18,12 @@
  */
 
 #include <libnavigate/errors.h>
+#include "thread.h"
 
-navi_error_t g_navi_error = { navi_Undefined };
+//
+// The last error is kept per thread, since sentences may be parsed
+// and generated by several threads at once
+static NAVI_THREAD_LOCAL navi_error_t g_navi_error = { navi_Undefined };
 
 const navi_error_t *navierr_get_last(void)
 {
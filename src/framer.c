@@ -0,0 +1,178 @@
+/*
+ * framer.c - streaming framer of IEC sentences
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/framer.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include "instrument.h"
+
+//
+// Returns the value of the hex digit, or -1
+static int navi_framer_hexdigit(char c)
+{
+	if ((c >= '0') && (c <= '9'))
+		return c - '0';
+	if ((c >= 'A') && (c <= 'F'))
+		return c - 'A' + 10;
+	if ((c >= 'a') && (c <= 'f'))
+		return c - 'a' + 10;
+
+	return -1;
+}
+
+//
+// Checks the checksum of the complete sentence, if it has one
+static int navi_framer_crcok(const char *sentence, size_t length)
+{
+	size_t i;
+	int hi, lo;
+	unsigned int cs = 0;
+
+	// $<body>*hh<cr><lf>
+	if ((length < 6) || (sentence[length - 5] != '*'))
+		return 1;
+
+	hi = navi_framer_hexdigit(sentence[length - 4]);
+	lo = navi_framer_hexdigit(sentence[length - 3]);
+	if ((hi < 0) || (lo < 0))
+		return 0;
+
+	for (i = 1; i < length - 5; i++)
+		cs ^= (unsigned char)sentence[i];
+
+	return cs == (unsigned int)(hi * 16 + lo);
+}
+
+//
+// Initializes the framer
+navierr_status_t navi_framer_init(struct navi_framer_t *fr)
+{
+	assert(fr != NULL);
+
+	fr->state = navi_framer_Idle;
+	fr->length = 0;
+	fr->sentence[0] = '\0';
+	memset(&fr->stats, 0, sizeof(fr->stats));
+
+	return navi_Ok;
+}
+
+//
+// Consumes bytes from the input stream up to the end of the next sentence
+navierr_status_t navi_framer_push(struct navi_framer_t *fr, const char *data,
+	size_t size, size_t *nmread)
+{
+	const char *p, *eol;
+	size_t i = 0, span, room;
+
+	assert(fr != NULL);
+	assert(data != NULL || size == 0);
+	assert(nmread != NULL);
+
+	if (fr->state == navi_framer_Complete)
+	{	// the previous sentence has been taken
+		fr->state = navi_framer_Idle;
+		fr->length = 0;
+	}
+
+	while (i < size)
+	{
+		if (fr->state == navi_framer_Idle)
+		{	// skip up to the beginning of the next sentence
+			p = (const char *)memchr(data + i, '$', size - i);
+			if (p == NULL)
+			{
+				fr->stats.garbage += size - i;
+				i = size;
+				break;
+			}
+
+			fr->stats.garbage += (p - data) - i;
+			i = p - data;
+			fr->state = navi_framer_Collecting;
+			fr->sentence[0] = '$';
+			fr->length = 1;
+			i += 1;
+			continue;
+		}
+
+		// collect up to <lf>, but no more than the buffer is able to hold
+		room = NAVI_FRAME_MAXSIZE - fr->length;
+		span = size - i < room ? size - i : room;
+
+		eol = (const char *)memchr(data + i, '\n', span);
+		if (eol != NULL)
+			span = eol - (data + i) + 1;
+
+		// '$' in the middle of a sentence starts a new one
+		p = (const char *)memchr(data + i, '$', span);
+		if (p != NULL)
+		{
+			fr->stats.garbage += fr->length + (p - (data + i));
+			fr->stats.resyncs++;
+			fr->state = navi_framer_Idle;
+			fr->length = 0;
+			i = p - data;
+			continue;
+		}
+
+		memcpy(fr->sentence + fr->length, data + i, span);
+		fr->length += span;
+		i += span;
+
+		if (eol != NULL)
+		{
+			if (fr->length >= 3 && fr->sentence[fr->length - 2] == '\r')
+			{
+				fr->sentence[fr->length] = '\0';
+				fr->state = navi_framer_Complete;
+				navi_trace(navi_trace_Framed, 0);
+
+				fr->stats.sentences++;
+				if (!navi_framer_crcok(fr->sentence, fr->length))
+					fr->stats.crcerrors++;
+
+				fr->stats.bytes += i;
+				*nmread = i;
+				return navi_Ok;
+			}
+
+			// not terminated with <cr><lf>
+			fr->stats.garbage += fr->length;
+			fr->stats.unterminated++;
+			fr->state = navi_framer_Idle;
+			fr->length = 0;
+		}
+		else if (fr->length >= NAVI_FRAME_MAXSIZE)
+		{	// the sentence is too long
+			fr->stats.garbage += fr->length;
+			fr->stats.overlong++;
+			fr->state = navi_framer_Idle;
+			fr->length = 0;
+		}
+	}
+
+	fr->stats.bytes += i;
+	*nmread = i;
+
+	navierr_set_last(navi_NoValidMessage);
+	return navi_Error;
+}
@@ -27,6 +27,8 @@
 #include <libnavigate/generator.h>
 #include <libnavigate/common.h>
 
+#include "instrument.h"
+
 #ifndef NO_GENERATOR
 
 #include <libnavigate/aam.h>
@@ -53,6 +55,7 @@
 #include <libnavigate/txt.h>
 #include <libnavigate/vtg.h>
 #include <libnavigate/zda.h>
+#include <libnavigate/schema.h>
 
 #include <libnavigate/proprietarymsg.h>
 
@@ -80,12 +83,44 @@ static navierr_status_t navi_create_approved(struct approved_field_t *address,
 static navierr_status_t navi_create_query(struct query_field_t *address,
 	navi_approved_fmt_t msg, char *buffer, size_t maxsize, size_t *nmwritten);
 
+//
+// Creates the sentence, the same as navi_create_msg()
+static navierr_status_t navi_create_sentence(navi_addrfield_t type, const void *address,
+	const void *msg, char *buffer, size_t maxsize, size_t *nmwritten);
+
 //
 // IEC message generator
 //
 navierr_status_t navi_create_msg(navi_addrfield_t type, const void *address,
 	const void *msg, char *buffer, size_t maxsize, size_t *nmwritten)
 {
+	navierr_status_t result;
+
+#ifdef WITH_STATS
+
+	navi_stats_tick_t start = navi_stats_ticks();
+
+	result = navi_create_sentence(type, address, msg, buffer, maxsize, nmwritten);
+	navi_stats_created(type, address, result, start);
+
+#else
+
+	result = navi_create_sentence(type, address, msg, buffer, maxsize, nmwritten);
+
+#endif // WITH_STATS
+
+	if (result == navi_Ok)
+		navi_probe_generated(type, address, *nmwritten);
+
+	return result;
+}
+
+//
+// navi_create_sentence
+//
+static navierr_status_t navi_create_sentence(navi_addrfield_t type, const void *address,
+	const void *msg, char *buffer, size_t maxsize, size_t *nmwritten)
+{
 
 #ifndef NO_GENERATOR
 
@@ -200,9 +235,7 @@ static navierr_status_t navi_create_approved(struct approved_field_t *address,
 			return navi_Error;
 		}
 		break;
-	case navi_DBT:
 	case navi_DCN:
-	case navi_DPT:
 	case navi_DSC:
 	case navi_DSE:
 	case navi_DSI:
@@ -278,8 +311,6 @@ static navierr_status_t navi_create_approved(struct approved_field_t *address,
 			return navi_Error;
 		}
 		break;
-	case navi_HDG:
-	case navi_HDT:
 	case navi_HMR:
 	case navi_HMS:
 	case navi_HSC:
@@ -299,7 +330,6 @@ static navierr_status_t navi_create_approved(struct approved_field_t *address,
 	case navi_MSS:
 	case navi_MTW:
 	case navi_MWD:
-	case navi_MWV:
 	case navi_OSD:
 	case navi_RMA:
 	case navi_RMB:
@@ -365,6 +395,18 @@ static navierr_status_t navi_create_approved(struct approved_field_t *address,
 	case navi_ZTG:
 		navierr_set_last(navi_NotImplemented);
 		return navi_Error;
+
+	// the sentences of the schema
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	case navi_##NAME: \
+		if (navi_create_##name((const struct name##_t *)msg, msgbody, \
+			sizeof(msgbody), &msglen) != navi_Ok) \
+		{ \
+			return navi_Error; \
+		} \
+		break;
+#include <libnavigate/schema.def>
+
 	default:
 		navierr_set_last(navi_MsgNotSupported);
 		return navi_Error;
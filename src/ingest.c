@@ -0,0 +1,642 @@
+/*
+ * ingest.c - multi-stream ingest engine
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/ingest.h>
+#include <libnavigate/ringbuf.h>
+#include <libnavigate/parser.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "atomic.h"
+#include "instrument.h"
+#include "thread.h"
+
+//
+// A stream with queued sentences is a task. The 'scheduled' flag of the
+// stream guarantees that the task is present only once in all queues and
+// is run by one worker at a time. The feeding thread schedules an idle
+// stream through the injection queue. A worker runs the task for up to
+// NAVI_INGEST_BUDGET sentences and, if the stream still has a backlog,
+// pushes it back to its own deque, from where idle workers may steal it.
+//
+// The deques are Chase-Lev deques of stream indices. Since a stream is
+// queued at most once, a deque of nmstreams entries never overflows.
+//
+
+//! The number of sentences handled per run of a task
+#define NAVI_INGEST_BUDGET		32
+
+struct navi_deque_t
+{
+	volatile size_t top;		// thieves' end
+	char pad0[NAVI_CACHELINE_SIZE];
+	volatile size_t bottom;		// owner's end
+	char pad1[NAVI_CACHELINE_SIZE];
+
+	volatile size_t *tasks;
+	size_t mask;
+};
+
+struct navi_stream_t
+{
+	struct navi_ringbuf_t rb;
+	struct navi_framer_t fr;
+	struct navi_record_t *slots;
+
+	volatile size_t scheduled;
+
+	// updated by the feeding thread
+	volatile size_t received;
+	volatile size_t overflows;
+
+	// copy of fr.stats, published by the feeding thread field by field
+	struct navi_framestats_t frames;
+
+	// updated by workers under the mutex
+	navi_mutex_t mutex;
+	size_t parsed, failed;
+	double lastlag, maxlag, lagsum;
+};
+
+struct navi_worker_t
+{
+	struct navi_ingest_t *engine;
+	size_t index;
+	unsigned int seed;
+
+	navi_thread_t thread;
+	struct navi_deque_t deque;
+};
+
+struct navi_ingest_t
+{
+	size_t nmstreams;
+	struct navi_stream_t *streams;
+
+	int nmworkers;		// deques of all workers are valid, even if not started
+	int nmstarted;
+	struct navi_worker_t *workers;
+
+	navi_ingest_handler_t handler;
+	void *context;
+
+	// injection queue of newly scheduled streams, guarded by the mutex
+	navi_mutex_t mutex;
+	size_t *injected;
+	size_t injhead, injcount;
+
+	navi_cond_t wakeup;		// signaled when tasks appear
+	navi_cond_t drained;	// signaled when nmqueued drops to 0
+
+	volatile size_t nmtasks;	// tasks in the deques and the injection queue
+	volatile size_t nmsleeping;	// workers waiting for wakeup
+	volatile size_t nmqueued;	// sentences not handled yet
+	volatile size_t stop;
+};
+
+// Context of a task run
+struct navi_run_t
+{
+	struct navi_ingest_t *engine;
+	size_t stream;
+
+	size_t parsed, failed;
+	double lastlag, maxlag, lagsum;
+
+	struct navi_parsed_t result;
+};
+
+//
+// Pushes the task to the owner's end of the deque
+static void navi_deque_push(struct navi_deque_t *dq, size_t task)
+{
+	size_t b = dq->bottom;
+
+	navi_atomic_store_release(&dq->tasks[b & dq->mask], task);
+	navi_atomic_store_release(&dq->bottom, b + 1);
+}
+
+//
+// Pops the task from the owner's end of the deque
+static int navi_deque_pop(struct navi_deque_t *dq, size_t *task)
+{
+	int taken;
+	size_t b = dq->bottom - 1, t;
+
+	navi_atomic_store_release(&dq->bottom, b);
+	navi_atomic_fence();
+	t = navi_atomic_load(&dq->top);
+
+	if ((ptrdiff_t)(b - t) < 0)
+	{	// empty
+		navi_atomic_store_release(&dq->bottom, b + 1);
+		return 0;
+	}
+
+	*task = navi_atomic_load(&dq->tasks[b & dq->mask]);
+	if (b != t)
+		return 1;
+
+	// the last task, race with thieves for it
+	taken = navi_atomic_cas(&dq->top, t, t + 1);
+	navi_atomic_store_release(&dq->bottom, b + 1);
+
+	return taken;
+}
+
+//
+// Steals the task from the thieves' end of the deque
+static int navi_deque_steal(struct navi_deque_t *dq, size_t *task)
+{
+	size_t t, b;
+
+	t = navi_atomic_load_acquire(&dq->top);
+	navi_atomic_fence();
+	b = navi_atomic_load_acquire(&dq->bottom);
+
+	if ((ptrdiff_t)(b - t) <= 0)
+		return 0;
+
+	*task = navi_atomic_load(&dq->tasks[t & dq->mask]);
+	return navi_atomic_cas(&dq->top, t, t + 1);
+}
+
+//
+// Adds delta to the number of queued sentences and wakes up
+// navi_ingest_drain(), when it drops to 0
+static void navi_ingest_account(struct navi_ingest_t *engine, size_t delta)
+{
+	if (navi_atomic_fetch_add(&engine->nmqueued, delta) + delta == 0)
+	{
+		navi_mutex_lock(&engine->mutex);
+		navi_cond_broadcast(&engine->drained);
+		navi_mutex_unlock(&engine->mutex);
+	}
+}
+
+//
+// Counts a new task and wakes up a sleeping worker
+static void navi_ingest_notify(struct navi_ingest_t *engine)
+{
+	(void)navi_atomic_fetch_add(&engine->nmtasks, 1);
+
+	if (navi_atomic_load_acquire(&engine->nmsleeping) > 0)
+	{
+		navi_mutex_lock(&engine->mutex);
+		navi_cond_signal(&engine->wakeup);
+		navi_mutex_unlock(&engine->mutex);
+	}
+}
+
+//
+// Puts the newly scheduled stream to the injection queue
+static void navi_ingest_inject(struct navi_ingest_t *engine, size_t stream)
+{
+	navi_mutex_lock(&engine->mutex);
+	engine->injected[(engine->injhead + engine->injcount) % engine->nmstreams] = stream;
+	engine->injcount++;
+	navi_mutex_unlock(&engine->mutex);
+
+	navi_ingest_notify(engine);
+}
+
+//
+// Takes the next task for the worker: from its own deque, from the
+// injection queue, or from the deque of another worker
+static int navi_ingest_take(struct navi_worker_t *worker, size_t *stream)
+{
+	int i, victim;
+	struct navi_ingest_t *engine = worker->engine;
+
+	if (navi_deque_pop(&worker->deque, stream))
+		goto taken;
+
+	navi_mutex_lock(&engine->mutex);
+	if (engine->injcount > 0)
+	{
+		*stream = engine->injected[engine->injhead];
+		engine->injhead = (engine->injhead + 1) % engine->nmstreams;
+		engine->injcount--;
+		navi_mutex_unlock(&engine->mutex);
+		goto taken;
+	}
+	navi_mutex_unlock(&engine->mutex);
+
+	// start from a random victim, so that thieves spread
+	worker->seed = worker->seed * 1103515245 + 12345;
+	victim = (int)((worker->seed >> 16) % (unsigned int)engine->nmworkers);
+
+	for (i = 0; i < engine->nmworkers; i++, victim = (victim + 1) % engine->nmworkers)
+	{
+		if ((size_t)victim == worker->index)
+			continue;
+		if (navi_deque_steal(&engine->workers[victim].deque, stream))
+			goto taken;
+	}
+
+	return 0;
+
+taken:
+	(void)navi_atomic_fetch_add(&engine->nmtasks, (size_t)-1);
+	return 1;
+}
+
+//
+// Parses one sentence of the stream and passes it to the handler
+static void navi_ingest_reader(struct navi_record_t *record, void *context)
+{
+	double lag;
+	size_t nmread;
+	struct navi_run_t *run = (struct navi_run_t *)context;
+	struct navi_parsed_t *result = &run->result;
+
+	lag = navi_clock_now() - record->stamp;
+	run->lastlag = lag;
+	run->lagsum += lag;
+	if (lag > run->maxlag)
+		run->maxlag = lag;
+
+	result->offset = 0;
+	result->length = record->length;
+	result->type = navi_af_Unknown;
+	result->status = navi_parse_msg(record->sentence, record->length,
+		sizeof(result->msg), &result->type, result->msg, &nmread);
+
+	if (result->status == navi_Ok)
+	{
+		result->errclass = navi_Undefined;
+		run->parsed++;
+	}
+	else
+	{
+		result->errclass = navierr_get_last()->errclass;
+		run->failed++;
+	}
+
+	// the sentence is traced from the parsing, the time in the queue is the lag
+	navi_trace(navi_trace_Delivered, 0);
+	run->engine->handler(run->stream, result, run->engine->context);
+}
+
+//
+// Runs the task of the stream and reschedules it, if needed
+static void navi_ingest_run(struct navi_worker_t *worker, struct navi_run_t *run)
+{
+	size_t n = 0;
+	struct navi_ingest_t *engine = worker->engine;
+	struct navi_stream_t *st = &engine->streams[run->stream];
+
+	run->parsed = run->failed = 0;
+	run->lastlag = run->maxlag = run->lagsum = 0.0;
+
+	(void)navi_ringbuf_pop_batch(&st->rb, NAVI_INGEST_BUDGET, navi_ingest_reader, run, &n);
+
+	if (n > 0)
+	{
+		navi_mutex_lock(&st->mutex);
+		st->parsed += run->parsed;
+		st->failed += run->failed;
+		st->lastlag = run->lastlag;
+		st->lagsum += run->lagsum;
+		if (run->maxlag > st->maxlag)
+			st->maxlag = run->maxlag;
+		navi_mutex_unlock(&st->mutex);
+
+		navi_ingest_account(engine, (size_t)0 - n);
+	}
+
+	if (navi_ringbuf_size(&st->rb) == 0)
+	{
+		navi_atomic_store_release(&st->scheduled, 0);
+
+		// the feeding thread could miss the flag while it was set
+		navi_atomic_fence();
+		if ((navi_ringbuf_size(&st->rb) == 0) || !navi_atomic_cas(&st->scheduled, 0, 1))
+			return;
+	}
+
+	navi_deque_push(&worker->deque, run->stream);
+	navi_ingest_notify(engine);
+}
+
+//
+// Worker thread
+static NAVI_THREAD_PROC(navi_ingest_worker, arg)
+{
+	struct navi_worker_t *worker = (struct navi_worker_t *)arg;
+	struct navi_ingest_t *engine = worker->engine;
+	struct navi_run_t run;
+
+	run.engine = engine;
+
+	while (!navi_atomic_load_acquire(&engine->stop))
+	{
+		if (navi_ingest_take(worker, &run.stream))
+		{
+			navi_ingest_run(worker, &run);
+			continue;
+		}
+
+		navi_mutex_lock(&engine->mutex);
+		(void)navi_atomic_fetch_add(&engine->nmsleeping, 1);
+
+		while (!navi_atomic_load(&engine->stop) &&
+			((ptrdiff_t)navi_atomic_load(&engine->nmtasks) <= 0))
+		{
+			navi_cond_wait(&engine->wakeup, &engine->mutex);
+		}
+
+		(void)navi_atomic_fetch_add(&engine->nmsleeping, (size_t)-1);
+		navi_mutex_unlock(&engine->mutex);
+	}
+
+	return 0;
+}
+
+//
+// Frees the engine after the workers have stopped
+static void navi_ingest_free(struct navi_ingest_t *engine)
+{
+	size_t i;
+	int k;
+
+	if (engine->streams != NULL)
+	{
+		for (i = 0; i < engine->nmstreams; i++)
+		{
+			navi_mutex_destroy(&engine->streams[i].mutex);
+			free(engine->streams[i].slots);
+		}
+	}
+
+	if (engine->workers != NULL)
+	{
+		for (k = 0; k < engine->nmworkers; k++)
+			free((void *)engine->workers[k].deque.tasks);
+	}
+
+	navi_cond_destroy(&engine->drained);
+	navi_cond_destroy(&engine->wakeup);
+	navi_mutex_destroy(&engine->mutex);
+
+	free(engine->injected);
+	free(engine->workers);
+	free(engine->streams);
+	free(engine);
+}
+
+//
+// Creates the ingest engine and starts its workers
+struct navi_ingest_t *navi_ingest_create(size_t nmstreams, size_t depth,
+	int nmworkers, navi_ingest_handler_t handler, void *context)
+{
+	size_t i, capacity;
+	int k, failed = 0;
+	struct navi_ingest_t *engine;
+	struct navi_stream_t *st;
+	struct navi_worker_t *worker;
+
+	if ((nmstreams == 0) || (depth < 2) || ((depth & (depth - 1)) != 0) ||
+		(nmworkers < 0) || (handler == NULL))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return NULL;
+	}
+
+	if (nmworkers == 0)
+		nmworkers = navi_cpu_count();
+
+	for (capacity = 1; capacity < nmstreams; capacity <<= 1) { }
+
+	engine = (struct navi_ingest_t *)calloc(1, sizeof(*engine));
+	if (engine == NULL)
+	{
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	engine->nmstreams = nmstreams;
+	engine->nmworkers = nmworkers;
+	engine->handler = handler;
+	engine->context = context;
+
+	navi_mutex_init(&engine->mutex);
+	navi_cond_init(&engine->wakeup);
+	navi_cond_init(&engine->drained);
+
+	engine->streams = (struct navi_stream_t *)calloc(nmstreams, sizeof(*engine->streams));
+	engine->workers = (struct navi_worker_t *)calloc(nmworkers, sizeof(*engine->workers));
+	engine->injected = (size_t *)malloc(nmstreams * sizeof(*engine->injected));
+	if ((engine->streams == NULL) || (engine->workers == NULL) || (engine->injected == NULL))
+	{
+		if (engine->streams != NULL)
+		{	// no stream is initialized yet
+			free(engine->streams);
+			engine->streams = NULL;
+		}
+		navi_ingest_free(engine);
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	for (i = 0; i < nmstreams; i++)
+	{
+		st = &engine->streams[i];
+		navi_mutex_init(&st->mutex);
+		navi_framer_init(&st->fr);
+
+		st->slots = (struct navi_record_t *)malloc(depth * sizeof(*st->slots));
+		if (st->slots == NULL)
+			failed = 1;
+		else
+			navi_ringbuf_init(&st->rb, st->slots, depth, navi_ringbuf_SPSC);
+	}
+
+	for (k = 0; k < nmworkers; k++)
+	{
+		worker = &engine->workers[k];
+		worker->engine = engine;
+		worker->index = (size_t)k;
+		worker->seed = (unsigned int)k + 1;
+		worker->deque.mask = capacity - 1;
+		worker->deque.tasks = (volatile size_t *)malloc(capacity * sizeof(size_t));
+		if (worker->deque.tasks == NULL)
+			failed = 1;
+	}
+
+	if (failed)
+	{
+		navi_ingest_free(engine);
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	navi_atomic_fence();
+
+	for (k = 0; k < nmworkers; k++)
+	{
+		if (navi_thread_create(&engine->workers[k].thread, navi_ingest_worker,
+				&engine->workers[k]) != navi_Ok)
+			break;
+		engine->nmstarted++;
+	}
+
+	if (engine->nmstarted == 0)
+	{
+		navi_ingest_free(engine);
+		return NULL;
+	}
+
+	return engine;
+}
+
+//
+// Stops the workers and frees the engine
+void navi_ingest_destroy(struct navi_ingest_t *engine)
+{
+	int k;
+
+	if (engine == NULL)
+		return;
+
+	navi_mutex_lock(&engine->mutex);
+	navi_atomic_store_release(&engine->stop, 1);
+	navi_cond_broadcast(&engine->wakeup);
+	navi_mutex_unlock(&engine->mutex);
+
+	for (k = 0; k < engine->nmstarted; k++)
+		navi_thread_join(&engine->workers[k].thread);
+
+	navi_ingest_free(engine);
+}
+
+//
+// Publishes the framing counters without a lock, the readers may see
+// the counters of different calls of navi_ingest_feed()
+static void navi_ingest_publish_frames(struct navi_framestats_t *frames,
+	const struct navi_framestats_t *stats)
+{
+	navi_atomic_store(&frames->bytes, stats->bytes);
+	navi_atomic_store(&frames->garbage, stats->garbage);
+	navi_atomic_store(&frames->sentences, stats->sentences);
+	navi_atomic_store(&frames->resyncs, stats->resyncs);
+	navi_atomic_store(&frames->overlong, stats->overlong);
+	navi_atomic_store(&frames->unterminated, stats->unterminated);
+	navi_atomic_store(&frames->crcerrors, stats->crcerrors);
+}
+
+//
+// Queues raw data of the stream
+navierr_status_t navi_ingest_feed(struct navi_ingest_t *engine,
+	size_t stream, const char *data, size_t size, size_t *nmread)
+{
+	navierr_status_t result;
+	size_t before, pushed;
+	struct navi_stream_t *st;
+
+	if ((engine == NULL) || (stream >= engine->nmstreams) ||
+		(data == NULL && size > 0) || (nmread == NULL))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	st = &engine->streams[stream];
+
+	before = st->rb.tail;
+	result = navi_ringbuf_feed_stamped(&st->rb, &st->fr, data, size,
+		navi_clock_now(), nmread);
+	pushed = st->rb.tail - before;
+
+	if (result != navi_Ok)
+		navi_atomic_store_release(&st->overflows, st->overflows + 1);
+
+	navi_ingest_publish_frames(&st->frames, &st->fr.stats);
+
+	if (pushed > 0)
+	{
+		navi_atomic_store_release(&st->received, st->received + pushed);
+		navi_ingest_account(engine, pushed);
+
+		navi_atomic_fence();
+		if ((navi_atomic_load(&st->scheduled) == 0) && navi_atomic_cas(&st->scheduled, 0, 1))
+			navi_ingest_inject(engine, stream);
+	}
+
+	return result;
+}
+
+//
+// Waits until all queued sentences are handled
+navierr_status_t navi_ingest_drain(struct navi_ingest_t *engine)
+{
+	if (engine == NULL)
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	navi_mutex_lock(&engine->mutex);
+	while (navi_atomic_load_acquire(&engine->nmqueued) != 0)
+		navi_cond_wait(&engine->drained, &engine->mutex);
+	navi_mutex_unlock(&engine->mutex);
+
+	return navi_Ok;
+}
+
+//
+// Copies the counters and lag metrics of the stream to stats
+navierr_status_t navi_ingest_stats(struct navi_ingest_t *engine,
+	size_t stream, struct navi_streamstats_t *stats)
+{
+	size_t handled;
+	struct navi_stream_t *st;
+
+	if ((engine == NULL) || (stream >= engine->nmstreams) || (stats == NULL))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	st = &engine->streams[stream];
+
+	stats->received = navi_atomic_load_acquire(&st->received);
+	stats->overflows = navi_atomic_load_acquire(&st->overflows);
+	stats->backlog = navi_ringbuf_size(&st->rb);
+
+	navi_mutex_lock(&st->mutex);
+	stats->parsed = st->parsed;
+	stats->failed = st->failed;
+	stats->lastlag = st->lastlag;
+	stats->maxlag = st->maxlag;
+	handled = st->parsed + st->failed;
+	stats->meanlag = handled > 0 ? st->lagsum / (double)handled : 0.0;
+	navi_mutex_unlock(&st->mutex);
+
+	stats->frames.bytes = navi_atomic_load(&st->frames.bytes);
+	stats->frames.garbage = navi_atomic_load(&st->frames.garbage);
+	stats->frames.sentences = navi_atomic_load(&st->frames.sentences);
+	stats->frames.resyncs = navi_atomic_load(&st->frames.resyncs);
+	stats->frames.overlong = navi_atomic_load(&st->frames.overlong);
+	stats->frames.unterminated = navi_atomic_load(&st->frames.unterminated);
+	stats->frames.crcerrors = navi_atomic_load(&st->frames.crcerrors);
+
+	return navi_Ok;
+}
@@ -0,0 +1,145 @@
+/*
+ * instrument.h - hooks of the statistics and the probes in the parser and the generator
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_navi_instrument_h
+#define INCLUDE_navi_instrument_h
+
+#include <libnavigate/stats.h>
+
+#ifdef WITH_STATS
+
+typedef unsigned long long navi_stats_tick_t;
+
+//
+// navi_stats_ticks()	- the time stamp counter, or the monotonic clock
+//						  in nanoseconds where there is none
+//
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+
+#include <intrin.h>
+#define navi_stats_ticks()		((navi_stats_tick_t)__rdtsc())
+
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#include <x86intrin.h>
+#define navi_stats_ticks()		((navi_stats_tick_t)__rdtsc())
+
+#elif defined(__GNUC__) && defined(__aarch64__)
+
+static __inline__ navi_stats_tick_t navi_stats_ticks(void)
+{
+	navi_stats_tick_t ticks;
+
+	__asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (ticks));
+	return ticks;
+}
+
+#else
+
+#include "thread.h"
+#define navi_stats_ticks()		((navi_stats_tick_t)(navi_clock_now() * 1e9))
+
+#endif // the processor
+
+NAVI_BEGIN_DECL
+
+//
+// Counts the call of navi_parse_msg() started at the tick start. The type
+// is navi_af_Unknown, if the call failed before the type is known.
+void navi_stats_parsed(navi_addrfield_t type, const void *msg,
+	navierr_status_t result, navi_stats_tick_t start);
+
+//
+// Counts the call of navi_create_msg() started at the tick start
+void navi_stats_created(navi_addrfield_t type, const void *address,
+	navierr_status_t result, navi_stats_tick_t start);
+
+//
+// The counters of the C++ bindings are kept in the blocks of the threads
+// next to the statistics, and summed the same way. Their meaning is up to
+// the bindings.
+#define NAVI_STATS_NM_BINDINGS		32
+
+//
+// Returns the counters of the C++ bindings of the calling thread,
+// NULL if out of memory
+volatile size_t *navi_stats_bindings(void);
+
+//
+// Sums the counters of the C++ bindings of all the threads
+void navi_stats_bindings_snapshot(size_t counters[NAVI_STATS_NM_BINDINGS]);
+
+NAVI_END_DECL
+
+//
+// navi_trace()	- marks the trace point, if the tracing is enabled
+//
+#define navi_trace(point, type)		NAVI_TRACE(point, type)
+
+#else
+
+#define navi_trace(point, type)		((void)0)
+
+#endif // WITH_STATS
+
+//
+// The static probes of the provider libnavigate, for perf, bpftrace and
+// SystemTap. Each one compiles to a nop and a note telling the tracer where
+// its arguments are, so until a tracer attaches, a probe costs no more than
+// having its arguments at hand. The arguments:
+//
+// sentence__framed		- the length of the sentence from '$' to <lf>
+// sentence__parsed		- the address field type, the formatter, the talker
+//						  and the length; the formatter and the talker are -1
+//						  for the query and proprietary sentences
+// parse__error			- the error class and the length, 0 when the sentence
+//						  is not found
+// sentence__generated	- the address field type, the formatter, the talker
+//						  and the length
+//
+#if defined(HAVE_SYS_SDT_H) && !defined(NO_PROBES)
+
+#include <sys/sdt.h>
+
+#define NAVI_PROBE_AFMT(type, address) \
+	(int)((type) == navi_af_Approved ? ((const struct approved_field_t *)(address))->afmt : -1)
+#define NAVI_PROBE_TID(type, address) \
+	(int)((type) == navi_af_Approved ? ((const struct approved_field_t *)(address))->tid : -1)
+
+#define navi_probe_framed(length) \
+	DTRACE_PROBE1(libnavigate, sentence__framed, (size_t)(length))
+#define navi_probe_parsed(type, msg, length) \
+	DTRACE_PROBE4(libnavigate, sentence__parsed, (int)(type), NAVI_PROBE_AFMT(type, msg), \
+		NAVI_PROBE_TID(type, msg), (size_t)(length))
+#define navi_probe_parse_error(errclass, length) \
+	DTRACE_PROBE2(libnavigate, parse__error, (int)(errclass), (size_t)(length))
+#define navi_probe_generated(type, address, length) \
+	DTRACE_PROBE4(libnavigate, sentence__generated, (int)(type), NAVI_PROBE_AFMT(type, address), \
+		NAVI_PROBE_TID(type, address), (size_t)(length))
+
+#else
+
+#define navi_probe_framed(length)						((void)0)
+#define navi_probe_parsed(type, msg, length)			((void)0)
+#define navi_probe_parse_error(errclass, length)		((void)0)
+#define navi_probe_generated(type, address, length)		((void)0)
+
+#endif // HAVE_SYS_SDT_H
+
+#endif // INCLUDE_navi_instrument_h
@@ -27,6 +27,8 @@
 #include <libnavigate/parser.h>
 #include <libnavigate/common.h>
 
+#include "instrument.h"
+
 #ifndef NO_PARSER
 
 #include <libnavigate/aam.h>
@@ -53,6 +55,7 @@
 #include <libnavigate/txt.h>
 #include <libnavigate/vtg.h>
 #include <libnavigate/zda.h>
+#include <libnavigate/schema.h>
 
 #include <libnavigate/proprietarymsg.h>
 
@@ -101,6 +104,11 @@ static navierr_status_t navi_parse_approved(char *msgstring, size_t maxout, void
 // Parses the query sentence
 static navierr_status_t navi_parse_query(char *msgstring, size_t maxout, void *msg);
 
+//
+// Parses the next sentence of the buffer, the same as navi_parse_msg()
+static navierr_status_t navi_parse_sentence(char *buffer, size_t maxsize, size_t msgsize,
+	navi_addrfield_t *type, void *msg, size_t *nmread);
+
 //
 // IEC message parser
 //
@@ -108,22 +116,55 @@ navierr_status_t navi_parse_msg(char *buffer, size_t maxsize, size_t msgsize,
 	navi_addrfield_t *type, void *msg, size_t *nmread)
 {
 
+#ifdef WITH_STATS
+
+	navi_stats_tick_t start = navi_stats_ticks();
+	navi_addrfield_t parsed = navi_af_Unknown;
+	navierr_status_t result;
+
+	navi_trace(navi_trace_Parsing, 0);
+	result = navi_parse_sentence(buffer, maxsize, msgsize, &parsed, msg, nmread);
+	navi_stats_parsed(parsed, msg, result, start);
+
+	// the type is left as is, if the sentence is not found
+	if (parsed != navi_af_Unknown)
+		*type = parsed;
+
+	return result;
+
+#else
+
+	return navi_parse_sentence(buffer, maxsize, msgsize, type, msg, nmread);
+
+#endif // WITH_STATS
+
+}
+
+//
+// navi_parse_sentence
+//
+static navierr_status_t navi_parse_sentence(char *buffer, size_t maxsize, size_t msgsize,
+	navi_addrfield_t *type, void *msg, size_t *nmread)
+{
+
 #ifndef NO_PARSER
 
 	size_t som;	// start of message index
 	size_t eom;	// end of message index
 
 	unsigned int ucs, cs;
+	navierr_status_t result;
 
 	//
 	//	Determine the borders of message in buffer
 	//
 
 	// Skip up to beginning of the next message
-	for (som = 0; buffer[som] != '$' && som < maxsize; som++) { }
+	for (som = 0; som < maxsize && buffer[som] != '$'; som++) { }
 
 	if (som >= maxsize)
 	{	// No valid message
+		navi_probe_parse_error(navi_NoValidMessage, 0);
 		navierr_set_last(navi_NoValidMessage);
 		return navi_Error;
 	}
@@ -136,16 +177,20 @@ navierr_status_t navi_parse_msg(char *buffer, size_t maxsize, size_t msgsize,
 	}
 	if (eom >= maxsize)
 	{	// No valid message
+		navi_probe_parse_error(navi_NoValidMessage, 0);
 		navierr_set_last(navi_NoValidMessage);
 		return navi_Error;
 	}
 
+	navi_probe_framed(eom - som + 1);
+
 	// At least read a message
 	*nmread = eom + 1;
 
 	// Check that the message is not broken
 	if (navi_checksum(buffer + som, eom - som, NULL, &ucs) != navi_Ok)
 	{
+		navi_probe_parse_error(navi_InvalidMessage, eom - som + 1);
 		navierr_set_last(navi_InvalidMessage);
 		return navi_Error;
 	}
@@ -153,23 +198,49 @@ navierr_status_t navi_parse_msg(char *buffer, size_t maxsize, size_t msgsize,
 	cs = strtoul(buffer + eom - 3, NULL, 16);
 	if (ucs != cs)
 	{
+		navi_probe_parse_error(navi_CrcEror, eom - som + 1);
 		navierr_set_last(navi_CrcEror);
 		return navi_Error;
 	}
 
+	// The fields end with '*' followed by two hex digits and <cr><lf>. The field
+	// parsers stop at '*', or fail on <cr> after the digits, so they never read
+	// past the frame, and need not check the length at every byte.
+	if ((eom - som < 5) || (buffer[eom - 4] != '*') || !isxdigit((unsigned char)buffer[eom - 3]) ||
+		!isxdigit((unsigned char)buffer[eom - 2]))
+	{
+		navi_probe_parse_error(navi_InvalidMessage, eom - som + 1);
+		navierr_set_last(navi_InvalidMessage);
+		return navi_Error;
+	}
+
+	navi_trace(navi_trace_Checked, 0);
+
 	// Determine the talker ID and message type
 	*type = navi_get_address_field_type(buffer + som + 1);
 	switch (*type)
 	{
 	case navi_af_Approved:
-		return navi_parse_approved(buffer + som + 1, msgsize, msg);
+		result = navi_parse_approved(buffer + som + 1, msgsize, msg);
+		break;
 	case navi_af_Query:
-		return navi_parse_query(buffer + som + 1, msgsize, msg);
+		result = navi_parse_query(buffer + som + 1, msgsize, msg);
+		break;
 	case navi_af_Proprietary:
-		return navi_parse_proprietary(msg, buffer + som + 1);
+		result = navi_parse_proprietary(msg, buffer + som + 1);
+		break;
+	default:
+		navierr_set_last(navi_MsgNotSupported);
+		result = navi_Error;
+		break;
 	}
 
-	navierr_set_last(navi_MsgNotSupported);
+	if (result == navi_Ok)
+		navi_probe_parsed(*type, msg, eom - som + 1);
+	else
+		navi_probe_parse_error(navierr_get_last()->errclass, eom - som + 1);
+
+	return result;
 
 #else
 
@@ -584,11 +655,16 @@ navierr_status_t navi_parse_position_fix(char *buffer, struct navi_position_t *f
 					goto _Exit;
 				}
 			}
-			else
+			else if (c == ',')
 			{	// indeed null field
 				state = PARSE_POSITION_FINI;
 				error = navi_NullField;
 			}
+			else
+			{
+				error = navi_InvalidMessage;
+				goto _Exit;
+			}
 			break;
 		case PARSE_POSITION_FINI:
 			if (c != ',' && c != '*')
@@ -958,7 +1034,7 @@ navierr_status_t navi_parse_datum(char *buffer, navi_datum_t *datum, size_t *nmr
 //
 navierr_status_t navi_parse_datumsub(char *buffer, navi_datum_subdivision_t *datumsub, size_t *nmread)
 {
-	if (strncmp(",", buffer, 1) == 0)
+	if ((buffer[0] == ',') || (buffer[0] == '*'))
 	{
 		*nmread = 1;
 		*datumsub = navi_datumsub_NULL;
@@ -981,16 +1057,24 @@ navierr_status_t navi_parse_datumsub(char *buffer, navi_datum_subdivision_t *dat
 navierr_status_t navi_parse_miarray(char *buffer, navi_modeindicator_t mi[], size_t *misize, size_t *nmread)
 {
 	int i = 0, c, error = 0;
+	size_t capacity;
 
 	assert(misize != NULL);
 	assert(*misize >= 2);
 
+	capacity = *misize;
 	*misize = 0;
 
 	for (i = 0; ; i++)
 	{
 		c = buffer[i];
 
+		if (((size_t)i >= capacity) && (c != ',') && (c != '*'))
+		{	// more modes than the array holds
+			error = 1;
+			goto _Exit;
+		}
+
 		switch (c)
 		{
 		case 'A':
@@ -1087,7 +1171,8 @@ navierr_status_t navi_parse_date(char *buffer, struct navi_date_t *date, size_t
 		else
 		{
 			*nmread = i;
-			return navi_InvalidMessage;
+			navierr_set_last(navi_InvalidMessage);
+			return navi_Error;
 		}
 	}
 
@@ -1133,6 +1218,12 @@ navierr_status_t navi_parse_localzone(char *buffer, int *offset, size_t *nmread)
 				state = PARSE_LOCALZONE_HOURS;
 				h = c - '0';
 			}
+			else if (c == '*')
+			{	// null field at the end of the sentence
+				navierr_set_last(navi_NullField);
+				error = 1;
+				goto _Exit;
+			}
 			else if (c == ',')
 			{	// null field
 				state = PARSE_LOCALZONE_FINI;
@@ -1150,12 +1241,13 @@ navierr_status_t navi_parse_localzone(char *buffer, int *offset, size_t *nmread)
 			}
 			else
 			{
+				navierr_set_last(navi_InvalidMessage);
 				error = 1;
 				goto _Exit;
 			}
 			break;
 		case PARSE_LOCALZONE_HOURS:
-			if (isdigit(c))
+			if (isdigit(c) && (h < 100))
 			{
 				h = h * 10 + c - '0';
 			}
@@ -1165,12 +1257,13 @@ navierr_status_t navi_parse_localzone(char *buffer, int *offset, size_t *nmread)
 			}
 			else
 			{
+				navierr_set_last(navi_InvalidMessage);
 				error = 1;
 				goto _Exit;
 			}
 			break;
 		case PARSE_LOCALZONE_MINUTES:
-			if (isdigit(c))
+			if (isdigit(c) && (m < 100))
 			{
 				m = m * 10 + c - '0';
 			}
@@ -1180,6 +1273,7 @@ navierr_status_t navi_parse_localzone(char *buffer, int *offset, size_t *nmread)
 			}
 			else
 			{
+				navierr_set_last(navi_InvalidMessage);
 				error = 1;
 				goto _Exit;
 			}
@@ -1195,7 +1289,7 @@ navierr_status_t navi_parse_localzone(char *buffer, int *offset, size_t *nmread)
 
 _Exit:
 	*offset = s * (h * 60 + m);
-	*nmread = i + 1;
+	*nmread = i;
 
 	if (error)
 	{
@@ -1375,7 +1469,8 @@ navierr_status_t navi_parse_gsamode(char *buffer, navi_gsaswitchmode_t *mode, si
 	else
 	{
 		navierr_set_last(navi_InvalidMessage);
-		result = navi_Error;
+		*nmread = i;
+		return navi_Error;
 	}
 
 	c = buffer[i++];
@@ -1393,15 +1488,15 @@ navierr_status_t navi_parse_gsamode(char *buffer, navi_gsaswitchmode_t *mode, si
 // Parses a buffer with valid characters from the given string
 navierr_status_t navi_parse_character_field(const char *from, char *to, size_t maxsize, size_t *nmread)
 {
-	int i, j, c;
-	char bytes[2];
+	int i, hi, lo, c, error = 0;
+	size_t j;
 
 	assert(from != NULL);
 	assert(to != NULL);
 	assert(maxsize > 0);
 	assert(nmread != NULL);
 
-	for (i = j = 0; i < NAVI_SENTENCE_MAXSIZE; i++)
+	for (i = 0, j = 0; i < NAVI_SENTENCE_MAXSIZE; i++)
 	{
 		c = from[i];
 
@@ -1409,25 +1504,31 @@ navierr_status_t navi_parse_character_field(const char *from, char *to, size_t m
 		{
 			break;
 		}
-		else if (c == '^')
+		else if ((c >= 0) && (c < 0x20))
+		{	// <cr> behind the end of the fields, or garbage
+			error = navi_InvalidMessage;
+			break;
+		}
+		else if (j + 1 >= maxsize)
 		{
-			c = from[++i];
-			if (c >= '0' && c <= '9')
-				bytes[0] = (char)(c - '0');
-			else if (c >= 'A' && c <= 'F')
-				bytes[0] = (char)(c - 'A' + 10);
-			else
-				bytes[0] = (char)(c - 'a' + 10);
+			error = navi_NotEnoughBuffer;
+			break;
+		}
+		else if (c == '^')
+		{	// the reserved character, '^' and two hex digits
+			hi = (unsigned char)from[i + 1];
+			lo = isxdigit(hi) ? (unsigned char)from[i + 2] : 0;
+			if (!isxdigit(lo))
+			{
+				error = navi_InvalidMessage;
+				break;
+			}
 
-			c = from[++i];
-			if (c >= '0' && c <= '9')
-				bytes[1] = (char)(c - '0');
-			else if (c >= 'A' && c <= 'F')
-				bytes[1] = (char)(c - 'A' + 10);
-			else
-				bytes[1] = (char)(c - 'a' + 10);
+			hi = isdigit(hi) ? hi - '0' : toupper(hi) - 'A' + 10;
+			lo = isdigit(lo) ? lo - '0' : toupper(lo) - 'A' + 10;
 
-			to[j++] = (char)navi_compose_integer(bytes, 2, 16);
+			to[j++] = (char)(hi * 16 + lo);
+			i += 2;
 		}
 		else
 		{
@@ -1438,6 +1539,12 @@ navierr_status_t navi_parse_character_field(const char *from, char *to, size_t m
 	to[j] = '\0';
 	*nmread = i + 1;
 
+	if (error)
+	{
+		navierr_set_last(error);
+		return navi_Error;
+	}
+
 	return navi_Ok;
 }
 
@@ -1536,9 +1643,7 @@ static navierr_status_t navi_parse_approved(char *msgstring, size_t maxout, void
 		}
 		navi_init_bww((struct bww_t *)msg);
 		return navi_parse_bww((struct bww_t *)msg, msgstring);
-	case navi_DBT:
 	case navi_DCN:
-	case navi_DPT:
 	case navi_DSC:
 	case navi_DSE:
 	case navi_DSI:
@@ -1620,8 +1725,6 @@ static navierr_status_t navi_parse_approved(char *msgstring, size_t maxout, void
 		}
 		navi_init_gsv((struct gsv_t *)msg);
 		return navi_parse_gsv((struct gsv_t *)msg, msgstring);
-	case navi_HDG:
-	case navi_HDT:
 	case navi_HMR:
 	case navi_HMS:
 	case navi_HSC:
@@ -1640,7 +1743,6 @@ static navierr_status_t navi_parse_approved(char *msgstring, size_t maxout, void
 	case navi_MSS:
 	case navi_MTW:
 	case navi_MWD:
-	case navi_MWV:
 	case navi_OSD:
 	case navi_RMA:
 	case navi_RMB:
@@ -1704,6 +1806,18 @@ static navierr_status_t navi_parse_approved(char *msgstring, size_t maxout, void
 	case navi_ZFO:
 	case navi_ZTG:
 		break;
+
+	// the sentences of the schema
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	case navi_##NAME: \
+		if (maxout < sizeof(struct name##_t)) \
+		{ \
+			navierr_set_last(navi_NotEnoughBuffer); \
+			return navi_Error; \
+		} \
+		navi_init_##name((struct name##_t *)msg); \
+		return navi_parse_##name((struct name##_t *)msg, msgstring);
+#include <libnavigate/schema.def>
 	}
 
 	navierr_set_last(navi_MsgNotSupported);
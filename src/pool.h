@@ -0,0 +1,67 @@
+/*
+ * pool.h - workers of the parallel parser used internally by libnavigate
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_navi_pool_h
+#define INCLUDE_navi_pool_h
+
+#include <libnavigate/batch.h>
+
+//
+// The pool keeps its workers for many buffers. The buffers are submitted
+// one after another and cut into chunks, the workers parse the chunks,
+// and the thread that submits them delivers the results in order.
+// A buffer must stay intact, until its chunks are delivered.
+//
+struct navi_pool_t;
+
+//
+// Starts nmthreads workers, the number of processors, if 0. Returns NULL
+// and sets the last error, if out of memory, or no worker starts.
+struct navi_pool_t *navi_pool_create(int nmthreads);
+
+//
+// Stops and joins the workers, the results not delivered are dropped
+void navi_pool_destroy(struct navi_pool_t *pool);
+
+//
+// Returns the number of the workers
+int navi_pool_nmthreads(const struct navi_pool_t *pool);
+
+//
+// Queues the sentences of the buffer for the handler. The buffer is cut
+// into chunks of about chunksize bytes, or a few per worker, if 0. When
+// the queue is full, the oldest chunks are delivered first. The offsets
+// passed to the handler are from the beginning of the buffer.
+navierr_status_t navi_pool_submit(struct navi_pool_t *pool, char *buffer, size_t size,
+	size_t chunksize, navi_batch_handler_t handler, void *context);
+
+//
+// Returns the number of the chunks submitted so far
+size_t navi_pool_submitted(const struct navi_pool_t *pool);
+
+//
+// Delivers the results of the chunks up to the number upto, as returned
+// by navi_pool_submitted()
+navierr_status_t navi_pool_deliver(struct navi_pool_t *pool, size_t upto);
+
+//
+// Returns nonzero, once a handler has stopped the parsing
+int navi_pool_stopped(const struct navi_pool_t *pool);
+
+#endif // INCLUDE_navi_pool_h
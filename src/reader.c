@@ -0,0 +1,635 @@
+/*
+ * reader.c - bulk reader of track files with pread() and io_uring backends
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/batch.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#ifdef HAVE_IO_URING
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#include "atomic.h"
+#endif // HAVE_IO_URING
+
+#include "pool.h"
+#include "thread.h"
+
+//
+// The file is read in blocks of NAVI_READER_BLOCKSIZE into NAVI_READER_NMBLOCKS
+// buffers. The sentence cut by the end of a block is copied to the carry area
+// just before the data of the next buffer, so the parser sees it whole.
+// With io_uring all buffers are registered and stay in flight, while the
+// oldest one is parsed. The pread() backend reads one block at a time.
+//
+// One pool of workers parses all the blocks. The sentences of a block are
+// submitted to it as soon as the block is read, and the results of
+// the previous block are delivered meanwhile, so the workers do not wait
+// at the end of each block. A buffer is reused, once its sentences
+// are delivered.
+//
+
+#define NAVI_READER_BLOCKSIZE	(1024 * 1024)
+#define NAVI_READER_CARRYSIZE	(64 * 1024)
+#define NAVI_READER_NMBLOCKS	4
+
+struct navi_reader_t;
+
+// The sentences submitted from a buffer
+struct navi_reader_block_t
+{
+	struct navi_reader_t *reader;
+
+	// file offset of the first byte passed to the parser
+	unsigned long long base;
+
+	// the chunks of the pool up to the last one of the buffer
+	size_t submitted;
+};
+
+struct navi_reader_t
+{
+	int fd;
+	unsigned long long filesize;
+
+	// buffers of CARRYSIZE + BLOCKSIZE bytes
+	char *buffers[NAVI_READER_NMBLOCKS];
+
+	struct navi_reader_block_t blocks[NAVI_READER_NMBLOCKS];
+
+	// the unparsed tail of the previous block
+	const char *carry;
+	size_t carrysize;
+
+	// the workers, or NULL, if the blocks are parsed by the calling thread
+	struct navi_pool_t *pool;
+	int stopped;
+	navi_batch_handler_t handler;
+	void *context;
+};
+
+//
+// Passes the result to the user handler with the offset from the file beginning
+static int navi_reader_handler(const struct navi_parsed_t *parsed, void *context)
+{
+	struct navi_reader_block_t *block = (struct navi_reader_block_t *)context;
+	struct navi_reader_t *reader = block->reader;
+	struct navi_parsed_t result;
+
+	memcpy(&result, parsed, sizeof(result));
+	result.offset = (size_t)(block->base + parsed->offset);
+
+	if (reader->handler(&result, reader->context) != 0)
+		reader->stopped = 1;
+
+	return reader->stopped;
+}
+
+//
+// Waits until the sentences of the buffer k are delivered, so the buffer
+// may be reused
+static navierr_status_t navi_reader_release(struct navi_reader_t *reader, int k)
+{
+	if (reader->pool == NULL)
+		return navi_Ok;
+
+	return navi_pool_deliver(reader->pool, reader->blocks[k].submitted);
+}
+
+//
+// Parses the block of size bytes, read at the offset into the buffer k,
+// together with the carried tail of the previous block. With the pool
+// the sentences are only submitted.
+static navierr_status_t navi_reader_parse(struct navi_reader_t *reader,
+	int k, size_t size, unsigned long long offset, int last)
+{
+	char *data = reader->buffers[k] + NAVI_READER_CARRYSIZE, *start, *p;
+	struct navi_reader_block_t *block = &reader->blocks[k];
+	navierr_status_t result = navi_Ok;
+	size_t length, cut;
+
+	// Join the carried tail and the block
+	start = data - reader->carrysize;
+	if (reader->carrysize > 0)
+		memmove(start, reader->carry, reader->carrysize);
+	length = reader->carrysize + size;
+	block->base = offset - reader->carrysize;
+
+	// Only complete sentences are parsed, unless this is the last block
+	if (last)
+	{
+		cut = length;
+	}
+	else
+	{
+		for (cut = length; cut >= 2; cut--)
+		{
+			if (start[cut - 2] == '\r' && start[cut - 1] == '\n')
+				break;
+		}
+		if (cut < 2)
+			cut = 0;
+	}
+
+	if ((cut > 0) && (reader->pool != NULL))
+	{
+		result = navi_pool_submit(reader->pool, start, cut, 0, navi_reader_handler, block);
+		block->submitted = navi_pool_submitted(reader->pool);
+		if (navi_pool_stopped(reader->pool))
+			reader->stopped = 1;
+	}
+	else if (cut > 0)
+	{
+		result = navi_parse_batch(start, cut, navi_reader_handler, block, NULL);
+	}
+
+	if (result != navi_Ok)
+		return navi_Error;
+
+	// Keep the tail from its first '$' for the next block
+	p = (char *)memchr(start + cut, '$', length - cut);
+	reader->carry = p;
+	reader->carrysize = p != NULL ? (size_t)(start + length - p) : 0;
+
+	if (reader->carrysize > NAVI_READER_CARRYSIZE)
+	{	// junk without <cr><lf>, keep from the last '$' only
+		for (p = start + length - 1; p >= reader->carry && *p != '$'; p--) { }
+		reader->carrysize = (size_t)(start + length - p);
+		reader->carry = p;
+
+		if (reader->carrysize > NAVI_READER_CARRYSIZE)
+		{
+			reader->carry = NULL;
+			reader->carrysize = 0;
+		}
+	}
+
+	return navi_Ok;
+}
+
+//
+// Moves the carried tail out of the buffer before the buffer is reused
+static void navi_reader_save_carry(struct navi_reader_t *reader, char *next)
+{
+	char *to;
+
+	if (reader->carrysize == 0)
+		return;
+
+	to = next + NAVI_READER_CARRYSIZE - reader->carrysize;
+	memmove(to, reader->carry, reader->carrysize);
+	reader->carry = to;
+}
+
+#ifndef _WIN32
+
+//
+// Reads the whole block with pread(), retrying short reads
+static ssize_t navi_reader_pread(int fd, char *buffer, size_t size, unsigned long long offset)
+{
+	ssize_t n;
+	size_t total = 0;
+
+	while (total < size)
+	{
+		n = pread(fd, buffer + total, size - total, (off_t)(offset + total));
+		if (n < 0)
+			return -1;
+		if (n == 0)
+			break;
+		total += (size_t)n;
+	}
+
+	return (ssize_t)total;
+}
+
+//
+// The pread() backend
+static navierr_status_t navi_reader_run_pread(struct navi_reader_t *reader)
+{
+	int k = 0;
+	ssize_t n;
+	unsigned long long offset;
+
+	for (offset = 0; !reader->stopped && (offset < reader->filesize); offset += NAVI_READER_BLOCKSIZE)
+	{
+		n = navi_reader_pread(reader->fd, reader->buffers[k] + NAVI_READER_CARRYSIZE,
+			NAVI_READER_BLOCKSIZE, offset);
+		if (n < 0)
+		{
+			navierr_set_last(navi_SystemError);
+			return navi_Error;
+		}
+
+		if (navi_reader_parse(reader, k, (size_t)n, offset,
+			offset + n >= reader->filesize) != navi_Ok)
+		{
+			return navi_Error;
+		}
+
+		// the next buffer is parsed NMBLOCKS - 1 blocks ago
+		k = (k + 1) % NAVI_READER_NMBLOCKS;
+		if (navi_reader_release(reader, k) != navi_Ok)
+			return navi_Error;
+		navi_reader_save_carry(reader, reader->buffers[k]);
+	}
+
+	return navi_Ok;
+}
+
+#endif // _WIN32
+
+#ifdef HAVE_IO_URING
+
+//
+// Minimal io_uring over the raw system calls
+//
+
+struct navi_uring_t
+{
+	int fd;
+
+	unsigned int *sqhead, *sqtail, *sqmask, *sqarray;
+	struct io_uring_sqe *sqes;
+	unsigned int *cqhead, *cqtail, *cqmask;
+	struct io_uring_cqe *cqes;
+
+	void *sqring, *cqring;
+	size_t sqringsize, cqringsize, sqessize;
+};
+
+static void navi_uring_close(struct navi_uring_t *ring)
+{
+	if (ring->sqes != NULL)
+		munmap(ring->sqes, ring->sqessize);
+	if (ring->cqring != NULL)
+		munmap(ring->cqring, ring->cqringsize);
+	if (ring->sqring != NULL)
+		munmap(ring->sqring, ring->sqringsize);
+	close(ring->fd);
+}
+
+static int navi_uring_open(struct navi_uring_t *ring, unsigned int entries)
+{
+	struct io_uring_params params;
+	char *sq, *cq;
+
+	memset(ring, 0, sizeof(*ring));
+	memset(&params, 0, sizeof(params));
+
+	ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+	if (ring->fd < 0)
+		return 0;
+
+	ring->sqringsize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+	ring->cqringsize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	ring->sqessize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	ring->sqring = mmap(NULL, ring->sqringsize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	ring->cqring = mmap(NULL, ring->cqringsize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+	ring->sqes = (struct io_uring_sqe *)mmap(NULL, ring->sqessize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+
+	if (ring->sqring == MAP_FAILED)
+		ring->sqring = NULL;
+	if (ring->cqring == MAP_FAILED)
+		ring->cqring = NULL;
+	if (ring->sqes == MAP_FAILED)
+		ring->sqes = NULL;
+
+	if ((ring->sqring == NULL) || (ring->cqring == NULL) || (ring->sqes == NULL))
+	{
+		navi_uring_close(ring);
+		return 0;
+	}
+
+	sq = (char *)ring->sqring;
+	ring->sqhead = (unsigned int *)(sq + params.sq_off.head);
+	ring->sqtail = (unsigned int *)(sq + params.sq_off.tail);
+	ring->sqmask = (unsigned int *)(sq + params.sq_off.ring_mask);
+	ring->sqarray = (unsigned int *)(sq + params.sq_off.array);
+
+	cq = (char *)ring->cqring;
+	ring->cqhead = (unsigned int *)(cq + params.cq_off.head);
+	ring->cqtail = (unsigned int *)(cq + params.cq_off.tail);
+	ring->cqmask = (unsigned int *)(cq + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+
+	return 1;
+}
+
+//
+// Queues and submits the read of the registered buffer
+static int navi_uring_read(struct navi_uring_t *ring, int fd, int index,
+	char *buffer, size_t size, unsigned long long offset)
+{
+	unsigned int tail, slot;
+	struct io_uring_sqe *sqe;
+
+	tail = *ring->sqtail;
+	slot = tail & *ring->sqmask;
+	sqe = &ring->sqes[slot];
+
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = IORING_OP_READ_FIXED;
+	sqe->fd = fd;
+	sqe->addr = (unsigned long long)(size_t)buffer;
+	sqe->len = (unsigned int)size;
+	sqe->off = offset;
+	sqe->buf_index = (unsigned short)index;
+	sqe->user_data = (unsigned long long)index;
+
+	ring->sqarray[slot] = slot;
+	__atomic_store_n(ring->sqtail, tail + 1, __ATOMIC_RELEASE);
+
+	return syscall(__NR_io_uring_enter, ring->fd, 1, 0, 0, NULL, 0) == 1;
+}
+
+//
+// Waits for the next completion
+static int navi_uring_wait(struct navi_uring_t *ring, int *index, int *res)
+{
+	unsigned int head;
+	struct io_uring_cqe *cqe;
+
+	for ( ; ; )
+	{
+		head = *ring->cqhead;
+		if (head != __atomic_load_n(ring->cqtail, __ATOMIC_ACQUIRE))
+			break;
+
+		if ((syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0) &&
+			(errno != EINTR))
+		{
+			return 0;
+		}
+	}
+
+	cqe = &ring->cqes[head & *ring->cqmask];
+	*index = (int)cqe->user_data;
+	*res = cqe->res;
+
+	__atomic_store_n(ring->cqhead, head + 1, __ATOMIC_RELEASE);
+
+	return 1;
+}
+
+//
+// The io_uring backend. Returns 0, if io_uring is not available and
+// nothing has been read yet.
+static int navi_reader_run_uring(struct navi_reader_t *reader, navierr_status_t *status)
+{
+	int k, prev, index, res, inflight = 0;
+	int result[NAVI_READER_NMBLOCKS], done[NAVI_READER_NMBLOCKS];
+	unsigned long long next = 0, offset;
+	struct navi_uring_t ring;
+	struct iovec iov[NAVI_READER_NMBLOCKS];
+	ssize_t n;
+
+	if (!navi_uring_open(&ring, NAVI_READER_NMBLOCKS))
+		return 0;
+
+	for (k = 0; k < NAVI_READER_NMBLOCKS; k++)
+	{
+		iov[k].iov_base = reader->buffers[k] + NAVI_READER_CARRYSIZE;
+		iov[k].iov_len = NAVI_READER_BLOCKSIZE;
+		done[k] = 0;
+	}
+
+	if (syscall(__NR_io_uring_register, ring.fd, IORING_REGISTER_BUFFERS,
+		iov, NAVI_READER_NMBLOCKS) != 0)
+	{
+		navi_uring_close(&ring);
+		return 0;
+	}
+
+	*status = navi_Ok;
+
+	// Fill the queue, the block k goes to the buffer k % NMBLOCKS
+	for (k = 0; (k < NAVI_READER_NMBLOCKS) && (next < reader->filesize); k++)
+	{
+		if (!navi_uring_read(&ring, reader->fd, k, (char *)iov[k].iov_base,
+			NAVI_READER_BLOCKSIZE, next))
+		{
+			break;
+		}
+		inflight++;
+		next += NAVI_READER_BLOCKSIZE;
+	}
+
+	for (offset = 0, k = 0; (offset < reader->filesize) && (*status == navi_Ok);
+		offset += NAVI_READER_BLOCKSIZE, k = (k + 1) % NAVI_READER_NMBLOCKS)
+	{
+		// Wait for the block in order
+		while (!done[k] && (inflight > 0))
+		{
+			if (!navi_uring_wait(&ring, &index, &res))
+				break;
+			done[index] = 1;
+			result[index] = res;
+			inflight--;
+		}
+
+		if (!done[k])
+		{	// submission has failed, read the rest synchronously
+			result[k] = (int)navi_reader_pread(reader->fd, (char *)iov[k].iov_base,
+				NAVI_READER_BLOCKSIZE, offset);
+		}
+		else if ((result[k] >= 0) && (result[k] < NAVI_READER_BLOCKSIZE) &&
+			(offset + result[k] < reader->filesize))
+		{	// a short read
+			n = navi_reader_pread(reader->fd, (char *)iov[k].iov_base + result[k],
+				NAVI_READER_BLOCKSIZE - result[k], offset + result[k]);
+			result[k] = n < 0 ? -1 : result[k] + (int)n;
+		}
+		done[k] = 0;
+
+		if (result[k] < 0)
+		{
+			navierr_set_last(navi_SystemError);
+			*status = navi_Error;
+			break;
+		}
+
+		*status = navi_reader_parse(reader, k, (size_t)result[k],
+			offset, offset + result[k] >= reader->filesize);
+		if ((*status != navi_Ok) || reader->stopped)
+			break;
+
+		// the next buffer is read already, its previous block is released
+		navi_reader_save_carry(reader, reader->buffers[(k + 1) % NAVI_READER_NMBLOCKS]);
+
+		if (offset == 0)
+			continue;
+
+		// Reuse the buffer of the previous block for the block NMBLOCKS ahead
+		// of it, once its sentences are delivered
+		prev = (k + NAVI_READER_NMBLOCKS - 1) % NAVI_READER_NMBLOCKS;
+		*status = navi_reader_release(reader, prev);
+		if ((*status != navi_Ok) || reader->stopped)
+			break;
+
+		if ((next < reader->filesize) && navi_uring_read(&ring, reader->fd, prev,
+			(char *)iov[prev].iov_base, NAVI_READER_BLOCKSIZE, next))
+		{
+			inflight++;
+			next += NAVI_READER_BLOCKSIZE;
+		}
+	}
+
+	// Collect the reads still in flight, before the buffers are freed
+	while ((inflight > 0) && navi_uring_wait(&ring, &index, &res))
+		inflight--;
+
+	navi_uring_close(&ring);
+
+	return 1;
+}
+
+#endif // HAVE_IO_URING
+
+//
+// Reads the track file with large reads and parses it
+navierr_status_t navi_read_track(const char *filename, int backend,
+	int nmthreads, navi_batch_handler_t handler, void *context)
+{
+	int k, done = 0;
+	navierr_status_t result = navi_Ok;
+	struct navi_reader_t reader;
+
+#ifndef _WIN32
+	struct stat st;
+#endif // _WIN32
+
+	if ((filename == NULL) || (handler == NULL) || (nmthreads < 0) ||
+		(backend < navi_reader_Auto) || (backend > navi_reader_Uring))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+#if defined(_WIN32)
+
+	// Memory mapping is the best there
+	if (backend == navi_reader_Uring)
+	{
+		navierr_set_last(navi_NotImplemented);
+		return navi_Error;
+	}
+
+	(void)k; (void)done; (void)result; (void)reader;
+
+	return navi_parse_track(filename, nmthreads, handler, context);
+
+#else
+
+#ifndef HAVE_IO_URING
+	if (backend == navi_reader_Uring)
+	{
+		navierr_set_last(navi_NotImplemented);
+		return navi_Error;
+	}
+#endif // HAVE_IO_URING
+
+	memset(&reader, 0, sizeof(reader));
+	reader.handler = handler;
+	reader.context = context;
+
+	reader.fd = open(filename, O_RDONLY);
+	if ((reader.fd < 0) || (fstat(reader.fd, &st) != 0))
+	{
+		if (reader.fd >= 0)
+			close(reader.fd);
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+	reader.filesize = (unsigned long long)st.st_size;
+
+#ifdef POSIX_FADV_SEQUENTIAL
+	(void)posix_fadvise(reader.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif // POSIX_FADV_SEQUENTIAL
+
+	for (k = 0; k < NAVI_READER_NMBLOCKS; k++)
+	{
+		reader.blocks[k].reader = &reader;
+		reader.buffers[k] = (char *)malloc(NAVI_READER_CARRYSIZE + NAVI_READER_BLOCKSIZE);
+		if (reader.buffers[k] == NULL)
+		{
+			navierr_set_last(navi_SystemError);
+			result = navi_Error;
+			done = 1;
+		}
+	}
+
+	if (nmthreads == 0)
+		nmthreads = navi_cpu_count();
+
+	if (!done && (nmthreads > 1) && ((reader.pool = navi_pool_create(nmthreads)) == NULL))
+	{
+		result = navi_Error;
+		done = 1;
+	}
+
+#ifdef HAVE_IO_URING
+	if (!done && (backend != navi_reader_Pread))
+	{
+		done = navi_reader_run_uring(&reader, &result);
+		if (!done && (backend == navi_reader_Uring))
+		{
+			navierr_set_last(navi_NotImplemented);
+			result = navi_Error;
+			done = 1;
+		}
+	}
+#endif // HAVE_IO_URING
+
+	if (!done)
+		result = navi_reader_run_pread(&reader);
+
+	// The sentences of the last blocks
+	if (reader.pool != NULL)
+	{
+		if (result == navi_Ok)
+			result = navi_pool_deliver(reader.pool, navi_pool_submitted(reader.pool));
+		navi_pool_destroy(reader.pool);
+	}
+
+	for (k = 0; k < NAVI_READER_NMBLOCKS; k++)
+		free(reader.buffers[k]);
+	close(reader.fd);
+
+	return result;
+
+#endif // _WIN32
+}
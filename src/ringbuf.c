@@ -0,0 +1,384 @@
+/*
+ * ringbuf.c - lock-free ring buffer of IEC sentences
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/ringbuf.h>
+#include <libnavigate/parser.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include "atomic.h"
+
+//
+// SPSC mode works as a classic single-writer queue. Each side keeps a
+// private copy of the other side's position and rereads the shared one
+// only when the copy says the buffer is full (or empty). Records pushed by
+// navi_ringbuf_feed() are published with a single store.
+//
+// MPSC mode uses a sequence number per slot. A producer owns the slot at
+// position pos when its sequence equals pos, claims it by advancing the tail
+// with compare-and-swap and publishes it by setting the sequence to pos + 1.
+// The consumer frees the slot by setting the sequence to pos + capacity.
+//
+
+//
+// Checks if the SPSC producer may write at position tail
+static int navi_ringbuf_spsc_room(struct navi_ringbuf_t *rb, size_t tail)
+{
+	if (tail - rb->headcache <= rb->mask)
+		return 1;
+
+	rb->headcache = navi_atomic_load_acquire(&rb->head);
+	return tail - rb->headcache <= rb->mask;
+}
+
+//
+// Claims one slot for the MPSC producer
+static int navi_ringbuf_mpsc_claim(struct navi_ringbuf_t *rb, size_t *pos)
+{
+	size_t p, seq;
+	struct navi_record_t *slot;
+
+	p = navi_atomic_load(&rb->tail);
+
+	for ( ; ; )
+	{
+		slot = &rb->slots[p & rb->mask];
+		seq = navi_atomic_load_acquire(&slot->seq);
+
+		if (seq == p)
+		{
+			if (navi_atomic_cas(&rb->tail, p, p + 1))
+			{
+				*pos = p;
+				return 1;
+			}
+		}
+		else if ((ptrdiff_t)(seq - p) < 0)
+		{	// the slot is not freed by consumer yet
+			return 0;
+		}
+
+		p = navi_atomic_load(&rb->tail);
+	}
+}
+
+//
+// Returns the number of records ready for the consumer, but no more than maxcount
+static size_t navi_ringbuf_ready(struct navi_ringbuf_t *rb, size_t maxcount)
+{
+	size_t head = rb->head, n;
+
+	if (rb->mode == navi_ringbuf_SPSC)
+	{
+		if (rb->tailcache - head < maxcount)
+			rb->tailcache = navi_atomic_load_acquire(&rb->tail);
+
+		n = rb->tailcache - head;
+		return n < maxcount ? n : maxcount;
+	}
+
+	for (n = 0; n < maxcount; n++)
+	{
+		if (navi_atomic_load_acquire(&rb->slots[(head + n) & rb->mask].seq) != head + n + 1)
+			break;
+	}
+
+	return n;
+}
+
+//
+// Frees count records for the producers
+static void navi_ringbuf_release(struct navi_ringbuf_t *rb, size_t count)
+{
+	size_t head = rb->head, i;
+
+	if (rb->mode == navi_ringbuf_MPSC)
+	{
+		for (i = 0; i < count; i++)
+		{
+			navi_atomic_store_release(&rb->slots[(head + i) & rb->mask].seq,
+				head + i + rb->mask + 1);
+		}
+	}
+
+	navi_atomic_store_release(&rb->head, head + count);
+}
+
+//
+// Initializes the ring buffer
+navierr_status_t navi_ringbuf_init(struct navi_ringbuf_t *rb,
+	struct navi_record_t slots[], size_t capacity, int mode)
+{
+	size_t i;
+
+	assert(rb != NULL);
+
+	if ((slots == NULL) || (capacity < 2) || ((capacity & (capacity - 1)) != 0) ||
+		((mode != navi_ringbuf_SPSC) && (mode != navi_ringbuf_MPSC)))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	memset(rb, 0, sizeof(*rb));
+	rb->slots = slots;
+	rb->mask = capacity - 1;
+	rb->mode = mode;
+
+	for (i = 0; i < capacity; i++)
+	{
+		slots[i].seq = i;
+		slots[i].length = 0;
+	}
+
+	navi_atomic_fence();
+
+	return navi_Ok;
+}
+
+//
+// Pushes one sentence to the ring buffer
+navierr_status_t navi_ringbuf_push(struct navi_ringbuf_t *rb,
+	const char *sentence, size_t length)
+{
+	size_t pos;
+	struct navi_record_t *slot;
+
+	assert(rb != NULL);
+	assert(sentence != NULL);
+
+	if (length > NAVI_FRAME_MAXSIZE)
+	{
+		navierr_set_last(navi_MsgExceedsMaxSize);
+		return navi_Error;
+	}
+
+	if (rb->mode == navi_ringbuf_SPSC)
+	{
+		pos = rb->tail;
+		if (!navi_ringbuf_spsc_room(rb, pos))
+		{
+			navierr_set_last(navi_NotEnoughBuffer);
+			return navi_Error;
+		}
+	}
+	else if (!navi_ringbuf_mpsc_claim(rb, &pos))
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	slot = &rb->slots[pos & rb->mask];
+	memcpy(slot->sentence, sentence, length);
+	slot->sentence[length] = '\0';
+	slot->length = length;
+	slot->stamp = 0.0;
+
+	if (rb->mode == navi_ringbuf_SPSC)
+		navi_atomic_store_release(&rb->tail, pos + 1);
+	else
+		navi_atomic_store_release(&slot->seq, pos + 1);
+
+	return navi_Ok;
+}
+
+//
+// Frames the input stream and pushes the sentences to the ring buffer
+navierr_status_t navi_ringbuf_feed(struct navi_ringbuf_t *rb,
+	struct navi_framer_t *fr, const char *data, size_t size, size_t *nmread)
+{
+	return navi_ringbuf_feed_stamped(rb, fr, data, size, 0.0, nmread);
+}
+
+//
+// Frames the input stream and pushes the stamped sentences to the ring buffer
+navierr_status_t navi_ringbuf_feed_stamped(struct navi_ringbuf_t *rb,
+	struct navi_framer_t *fr, const char *data, size_t size, double stamp,
+	size_t *nmread)
+{
+	int full = 0;
+	size_t i = 0, n, pos, tail;
+	struct navi_record_t *slot;
+
+	assert(rb != NULL);
+	assert(fr != NULL);
+	assert(nmread != NULL);
+
+	tail = rb->mode == navi_ringbuf_SPSC ? rb->tail : 0;
+
+	for ( ; ; )
+	{
+		if (fr->state != navi_framer_Complete)
+		{
+			if (i >= size)
+				break;
+
+			if (navi_framer_push(fr, data + i, size - i, &n) != navi_Ok)
+			{
+				i += n;
+				break;
+			}
+			i += n;
+		}
+
+		if (rb->mode == navi_ringbuf_SPSC)
+		{
+			if (!navi_ringbuf_spsc_room(rb, tail))
+			{
+				full = 1;
+				break;
+			}
+			pos = tail++;
+		}
+		else if (!navi_ringbuf_mpsc_claim(rb, &pos))
+		{
+			full = 1;
+			break;
+		}
+
+		slot = &rb->slots[pos & rb->mask];
+		memcpy(slot->sentence, fr->sentence, fr->length + 1);
+		slot->length = fr->length;
+		slot->stamp = stamp;
+
+		if (rb->mode == navi_ringbuf_MPSC)
+			navi_atomic_store_release(&slot->seq, pos + 1);
+
+		// the sentence is taken from the framer
+		fr->state = navi_framer_Idle;
+		fr->length = 0;
+	}
+
+	if ((rb->mode == navi_ringbuf_SPSC) && (tail != rb->tail))
+		navi_atomic_store_release(&rb->tail, tail);
+
+	*nmread = i;
+
+	if (full)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	return navi_Ok;
+}
+
+//
+// Pops one sentence from the ring buffer and copies it to sentence
+navierr_status_t navi_ringbuf_pop(struct navi_ringbuf_t *rb,
+	char *sentence, size_t maxsize, size_t *length)
+{
+	struct navi_record_t *slot;
+
+	assert(rb != NULL);
+	assert(sentence != NULL);
+	assert(length != NULL);
+
+	if (navi_ringbuf_ready(rb, 1) == 0)
+	{
+		navierr_set_last(navi_NoValidMessage);
+		return navi_Error;
+	}
+
+	slot = &rb->slots[rb->head & rb->mask];
+	if (slot->length + 1 > maxsize)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	memcpy(sentence, slot->sentence, slot->length + 1);
+	*length = slot->length;
+
+	navi_ringbuf_release(rb, 1);
+
+	return navi_Ok;
+}
+
+//
+// Pops up to maxcount sentences and passes them to the reader in place
+navierr_status_t navi_ringbuf_pop_batch(struct navi_ringbuf_t *rb,
+	size_t maxcount, navi_ringbuf_reader_t reader, void *context, size_t *nmpopped)
+{
+	size_t i, n;
+	struct navi_record_t *slot;
+
+	assert(rb != NULL);
+	assert(reader != NULL);
+	assert(nmpopped != NULL);
+
+	n = navi_ringbuf_ready(rb, maxcount);
+	*nmpopped = n;
+
+	if (n == 0)
+	{
+		navierr_set_last(navi_NoValidMessage);
+		return navi_Error;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		slot = &rb->slots[(rb->head + i) & rb->mask];
+		reader(slot, context);
+	}
+
+	navi_ringbuf_release(rb, n);
+
+	return navi_Ok;
+}
+
+//
+// Pops one sentence and parses it in place
+navierr_status_t navi_ringbuf_parse(struct navi_ringbuf_t *rb,
+	size_t msgsize, navi_addrfield_t *type, void *msg)
+{
+	navierr_status_t result;
+	size_t nmread;
+	struct navi_record_t *slot;
+
+	assert(rb != NULL);
+
+	if (navi_ringbuf_ready(rb, 1) == 0)
+	{
+		navierr_set_last(navi_NoValidMessage);
+		return navi_Error;
+	}
+
+	slot = &rb->slots[rb->head & rb->mask];
+	result = navi_parse_msg(slot->sentence, slot->length, msgsize, type, msg, &nmread);
+
+	navi_ringbuf_release(rb, 1);
+
+	return result;
+}
+
+//
+// Returns the number of records in the ring buffer
+size_t navi_ringbuf_size(const struct navi_ringbuf_t *rb)
+{
+	size_t head, tail;
+
+	assert(rb != NULL);
+
+	head = navi_atomic_load_acquire((volatile size_t *)&rb->head);
+	tail = navi_atomic_load_acquire((volatile size_t *)&rb->tail);
+
+	return tail - head;
+}
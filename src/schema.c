@@ -0,0 +1,415 @@
+/*
+ * schema.c - sentences generated from the schema
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/schema.h>
+#include <libnavigate/common.h>
+#include <libnavigate/generator.h>
+#include <libnavigate/parser.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef _MSC_VER
+	#include "win32/win32navi.h"
+#endif // MSVC_VER
+
+//
+// The functions of the sentences are expanded from schema.def, field by
+// field, into calls of the functions of the field kinds below. So the
+// field handling is written once for all the sentences of the schema.
+//
+// The generator prints the fields right into the output, one after
+// another, without intermediate strings.
+//
+
+//
+// Initializers of the field kinds
+static void navi_schema_init_number(double *value)
+{
+	(void)navi_init_number(value);
+}
+
+static void navi_schema_init_measure(double *value)
+{
+	(void)navi_init_number(value);
+}
+
+static void navi_schema_init_offset(struct navi_offset_t *value)
+{
+	(void)navi_init_offset(value);
+}
+
+static void navi_schema_init_status(navi_status_t *value)
+{
+	*value = navi_status_NULL;
+}
+
+static void navi_schema_init_character(char *value)
+{
+	*value = '\0';
+}
+
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	navierr_status_t navi_init_##name(struct name##_t *msg) \
+	{ \
+		assert(msg != NULL);
+#define NAVI_SCHEMA_FIELD(name, kind, arg, member, getter, setter, validity) \
+		navi_schema_init_##kind(&msg->member);
+#define NAVI_SCHEMA_END(name, NAME, Class) \
+		return navi_Ok; \
+	}
+#include <libnavigate/schema.def>
+
+//
+// Checks if the field is not null
+int navi_schema_valid_number(const double *value)
+{
+	return navi_check_validity_number(*value) == navi_Ok;
+}
+
+int navi_schema_valid_measure(const double *value)
+{
+	return navi_check_validity_number(*value) == navi_Ok;
+}
+
+int navi_schema_valid_offset(const struct navi_offset_t *value)
+{
+	return value->sign != navi_offset_NULL;
+}
+
+int navi_schema_valid_status(const navi_status_t *value)
+{
+	return *value != navi_status_NULL;
+}
+
+int navi_schema_valid_character(const char *value)
+{
+	return *value != '\0';
+}
+
+#ifndef NO_GENERATOR
+
+// The output of the generator
+struct navi_schema_out_t
+{
+	char *buffer;
+	size_t maxsize, length;
+	int nmfields;
+};
+
+//
+// Starts the next field, returns the room left for it
+static size_t navi_schema_next_field(struct navi_schema_out_t *out)
+{
+	if (out->length + (out->nmfields > 0 ? 1 : 0) >= out->maxsize)
+		return 0;
+
+	if (out->nmfields++ > 0)
+		out->buffer[out->length++] = ',';
+
+	out->buffer[out->length] = '\0';
+	return out->maxsize - out->length;
+}
+
+//
+// Appends the string to the field
+static navierr_status_t navi_schema_append(struct navi_schema_out_t *out, const char *s)
+{
+	size_t length = strlen(s);
+
+	if (out->length + length >= out->maxsize)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	memcpy(out->buffer + out->length, s, length + 1);
+	out->length += length;
+
+	return navi_Ok;
+}
+
+//
+// Appends the number to the field, nothing if null
+static navierr_status_t navi_schema_append_number(struct navi_schema_out_t *out, double value)
+{
+	size_t room = out->maxsize - out->length, length;
+
+	length = navi_print_number(value, out->buffer + out->length, room);
+	if (length >= room)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	out->length += length;
+	return navi_Ok;
+}
+
+//
+// Printers of the field kinds
+static navierr_status_t navi_schema_print_number(const double *value,
+	const char *arg, struct navi_schema_out_t *out)
+{
+	(void)arg;
+
+	if (navi_schema_next_field(out) == 0)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	return navi_schema_append_number(out, *value);
+}
+
+static navierr_status_t navi_schema_print_measure(const double *value,
+	const char *arg, struct navi_schema_out_t *out)
+{
+	int valid = navi_schema_valid_measure(value);
+
+	if (navi_schema_print_number(value, NULL, out) != navi_Ok)
+		return navi_Error;
+
+	if (navi_schema_next_field(out) == 0)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	return valid ? navi_schema_append(out, arg) : navi_Ok;
+}
+
+static navierr_status_t navi_schema_print_offset(const struct navi_offset_t *value,
+	const char *arg, struct navi_schema_out_t *out)
+{
+	int valid = navi_schema_valid_offset(value);
+
+	(void)arg;
+
+	if (navi_schema_next_field(out) == 0)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	if (valid && (navi_schema_append_number(out, value->offset) != navi_Ok))
+		return navi_Error;
+
+	if (navi_schema_next_field(out) == 0)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	return valid ? navi_schema_append(out, navi_fixsign_str(value->sign)) : navi_Ok;
+}
+
+static navierr_status_t navi_schema_print_status(const navi_status_t *value,
+	const char *arg, struct navi_schema_out_t *out)
+{
+	const char *s = navi_status_str(*value);
+
+	(void)arg;
+
+	if (s == NULL)
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	if (navi_schema_next_field(out) == 0)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	return navi_schema_append(out, s);
+}
+
+static navierr_status_t navi_schema_print_character(const char *value,
+	const char *arg, struct navi_schema_out_t *out)
+{
+	char s[2];
+
+	if ((*value != '\0') && (strchr(arg, *value) == NULL))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	if (navi_schema_next_field(out) == 0)
+	{
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	s[0] = *value;
+	s[1] = '\0';
+
+	return navi_schema_append(out, s);
+}
+
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	navierr_status_t navi_create_##name(const struct name##_t *msg, char *buffer, \
+		size_t maxsize, size_t *nmwritten) \
+	{ \
+		struct navi_schema_out_t out; \
+		\
+		assert(msg != NULL); \
+		assert(buffer != NULL); \
+		\
+		out.buffer = buffer; \
+		out.maxsize = maxsize; \
+		out.length = 0; \
+		out.nmfields = 0;
+#define NAVI_SCHEMA_FIELD(name, kind, arg, member, getter, setter, validity) \
+		if (navi_schema_print_##kind(&msg->member, arg, &out) != navi_Ok) \
+			return navi_Error;
+#define NAVI_SCHEMA_END(name, NAME, Class) \
+		*nmwritten = out.length; \
+		return navi_Ok; \
+	}
+#include <libnavigate/schema.def>
+
+#endif // NO_GENERATOR
+
+#ifndef NO_PARSER
+
+//
+// Checks if the character ends the field
+#define NAVI_SCHEMA_FIELD_END(c)	(((c) == ',') || ((c) == '*'))
+
+//
+// Parsers of the field kinds. All of them read the field with
+// the following ',' or '*'.
+static navierr_status_t navi_schema_parse_number(char *buffer, double *value,
+	const char *arg, size_t *nmread)
+{
+	(void)arg;
+
+	return navi_parse_number(buffer, value, nmread);
+}
+
+static navierr_status_t navi_schema_parse_measure(char *buffer, double *value,
+	const char *arg, size_t *nmread)
+{
+	navierr_status_t result;
+	int error;
+	size_t i;
+
+	result = navi_parse_number(buffer, value, &i);
+	error = result != navi_Ok ? navierr_get_last()->errclass : 0;
+
+	if ((error != 0) && (error != navi_NullField))
+	{
+		*nmread = i;
+		return navi_Error;
+	}
+
+	// the unit field, if the sentence does not end with the number
+	if (buffer[i - 1] == ',')
+	{
+		if (buffer[i] == arg[0])
+			i++;
+		if (!NAVI_SCHEMA_FIELD_END(buffer[i]))
+		{
+			*nmread = i;
+			navierr_set_last(navi_InvalidMessage);
+			return navi_Error;
+		}
+		i++;
+	}
+
+	*nmread = i;
+
+	if (error != 0)
+	{
+		navierr_set_last(error);
+		return navi_Error;
+	}
+
+	return navi_Ok;
+}
+
+static navierr_status_t navi_schema_parse_offset(char *buffer, struct navi_offset_t *value,
+	const char *arg, size_t *nmread)
+{
+	(void)arg;
+
+	return navi_parse_offset(buffer, value, nmread);
+}
+
+static navierr_status_t navi_schema_parse_status(char *buffer, navi_status_t *value,
+	const char *arg, size_t *nmread)
+{
+	(void)arg;
+
+	return navi_parse_status(buffer, value, nmread);
+}
+
+static navierr_status_t navi_schema_parse_character(char *buffer, char *value,
+	const char *arg, size_t *nmread)
+{
+	if (NAVI_SCHEMA_FIELD_END(buffer[0]))
+	{
+		*nmread = 1;
+		navierr_set_last(navi_NullField);
+		return navi_Error;
+	}
+
+	if ((strchr(arg, buffer[0]) == NULL) || !NAVI_SCHEMA_FIELD_END(buffer[1]))
+	{
+		*nmread = 1;
+		navierr_set_last(navi_InvalidMessage);
+		return navi_Error;
+	}
+
+	*value = buffer[0];
+	*nmread = 2;
+
+	return navi_Ok;
+}
+
+// The fields missing at the end of the sentence, e.g. of the older
+// versions of the standard, are left null
+#define NAVI_SCHEMA_SENTENCE(name, NAME, Class) \
+	navierr_status_t navi_parse_##name(struct name##_t *msg, char *buffer) \
+	{ \
+		size_t i = 0, nmread; \
+		\
+		assert(msg != NULL); \
+		assert(buffer != NULL);
+#define NAVI_SCHEMA_FIELD(name, kind, arg, member, getter, setter, validity) \
+		if ((i > 0) && (buffer[i - 1] == '*')) \
+			return navi_Ok; \
+		if (navi_schema_parse_##kind(buffer + i, &msg->member, arg, &nmread) != navi_Ok) \
+		{ \
+			if (navierr_get_last()->errclass != navi_NullField) \
+				return navi_Error; \
+		} \
+		i += nmread;
+#define NAVI_SCHEMA_END(name, NAME, Class) \
+		return navi_Ok; \
+	}
+#include <libnavigate/schema.def>
+
+#undef NAVI_SCHEMA_FIELD_END
+
+#endif // NO_PARSER
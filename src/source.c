@@ -0,0 +1,611 @@
+/*
+ * source.c - non-blocking input sources for the parser
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE		// recvmmsg()
+#endif // __linux__
+
+#include <libnavigate/source.h>
+#include <libnavigate/framer.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+//
+// All sources share a pool of NAVI_SOURCE_NMBUFFERS buffers. A stream
+// source is read into the first one, a UDP socket receives up to
+// NAVI_SOURCE_NMBUFFERS datagrams at once with recvmmsg(). Since the data
+// is framed right after reading, a source keeps only its framer between
+// reads. Regular files are not supported by epoll and are read on every
+// poll while they are open.
+//
+
+#define NAVI_SOURCE_NMBUFFERS	16
+#define NAVI_SOURCE_BUFSIZE		4096
+#define NAVI_SOURCE_NMEVENTS	64
+
+//! Source types
+enum
+{
+	navi_source_Closed = 0,
+	navi_source_Stream,		// serial port, pty, pipe
+	navi_source_File,
+	navi_source_Udp
+};
+
+struct navi_source_t
+{
+	int type;
+	int fd;
+	int owned;		// the descriptor is closed with the source
+
+	struct navi_framer_t fr;
+};
+
+struct navi_sources_t
+{
+	int epfd;
+	int maxsources;
+	int nmfiles;
+
+	navi_source_handler_t handler;
+	void *context;
+
+	struct navi_source_t *sources;
+
+	char buffers[NAVI_SOURCE_NMBUFFERS][NAVI_SOURCE_BUFSIZE];
+	struct iovec iov[NAVI_SOURCE_NMBUFFERS];
+	struct mmsghdr msgs[NAVI_SOURCE_NMBUFFERS];
+};
+
+//
+// Creates an empty set for up to maxsources sources
+struct navi_sources_t *navi_sources_create(int maxsources,
+	navi_source_handler_t handler, void *context)
+{
+	int i;
+	struct navi_sources_t *s;
+
+	if ((maxsources <= 0) || (handler == NULL))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return NULL;
+	}
+
+	s = (struct navi_sources_t *)calloc(1, sizeof(*s));
+	if (s == NULL)
+	{
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	s->sources = (struct navi_source_t *)calloc(maxsources, sizeof(*s->sources));
+	s->epfd = epoll_create1(EPOLL_CLOEXEC);
+	if ((s->sources == NULL) || (s->epfd < 0))
+	{
+		if (s->epfd >= 0)
+			close(s->epfd);
+		free(s->sources);
+		free(s);
+		navierr_set_last(navi_SystemError);
+		return NULL;
+	}
+
+	s->maxsources = maxsources;
+	s->handler = handler;
+	s->context = context;
+
+	for (i = 0; i < NAVI_SOURCE_NMBUFFERS; i++)
+	{
+		s->iov[i].iov_base = s->buffers[i];
+		s->iov[i].iov_len = NAVI_SOURCE_BUFSIZE;
+		s->msgs[i].msg_hdr.msg_iov = &s->iov[i];
+		s->msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	return s;
+}
+
+//
+// Closes all sources and frees the set
+void navi_sources_destroy(struct navi_sources_t *sources)
+{
+	int i;
+
+	if (sources == NULL)
+		return;
+
+	for (i = 0; i < sources->maxsources; i++)
+	{
+		if (sources->sources[i].type != navi_source_Closed)
+			(void)navi_source_close(sources, i);
+	}
+
+	close(sources->epfd);
+	free(sources->sources);
+	free(sources);
+}
+
+//
+// Registers the open descriptor as a new source
+static navierr_status_t navi_source_add(struct navi_sources_t *sources,
+	int fd, int type, int owned, int *source)
+{
+	int i;
+	struct epoll_event ev;
+	struct navi_source_t *src;
+
+	for (i = 0; i < sources->maxsources; i++)
+	{
+		if (sources->sources[i].type == navi_source_Closed)
+			break;
+	}
+
+	if (i >= sources->maxsources)
+	{
+		if (owned)
+			close(fd);
+		navierr_set_last(navi_NotEnoughBuffer);
+		return navi_Error;
+	}
+
+	if (type != navi_source_File)
+	{
+		memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.u32 = (unsigned int)i;
+
+		if (epoll_ctl(sources->epfd, EPOLL_CTL_ADD, fd, &ev) != 0)
+		{
+			if (owned)
+				close(fd);
+			navierr_set_last(navi_SystemError);
+			return navi_Error;
+		}
+	}
+	else
+	{
+		sources->nmfiles++;
+	}
+
+	src = &sources->sources[i];
+	src->type = type;
+	src->fd = fd;
+	src->owned = owned;
+	navi_framer_init(&src->fr);
+
+	if (source)
+		*source = i;
+
+	return navi_Ok;
+}
+
+//
+// Returns the termios speed for the baud rate, or B0 if unsupported
+static speed_t navi_source_speed(int baudrate)
+{
+	switch (baudrate)
+	{
+	case 1200: return B1200;
+	case 2400: return B2400;
+	case 4800: return B4800;
+	case 9600: return B9600;
+	case 19200: return B19200;
+	case 38400: return B38400;
+	case 57600: return B57600;
+	case 115200: return B115200;
+	case 230400: return B230400;
+	}
+
+	return B0;
+}
+
+//
+// Opens the serial port or pty in raw mode
+navierr_status_t navi_source_open_serial(struct navi_sources_t *sources,
+	const char *device, int baudrate, int *source)
+{
+	int fd;
+	speed_t speed = B0;
+	struct termios tio;
+
+	if ((sources == NULL) || (device == NULL) ||
+		((baudrate != 0) && ((speed = navi_source_speed(baudrate)) == B0)))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	fd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+	if (fd < 0)
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	if (tcgetattr(fd, &tio) != 0)
+	{
+		close(fd);
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	cfmakeraw(&tio);
+	tio.c_cflag |= CLOCAL | CREAD;
+	if (speed != B0)
+	{
+		cfsetispeed(&tio, speed);
+		cfsetospeed(&tio, speed);
+	}
+
+	if (tcsetattr(fd, TCSANOW, &tio) != 0)
+	{
+		close(fd);
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	return navi_source_add(sources, fd, navi_source_Stream, 1, source);
+}
+
+//
+// Opens the file
+navierr_status_t navi_source_open_file(struct navi_sources_t *sources,
+	const char *filename, int *source)
+{
+	int fd;
+
+	if ((sources == NULL) || (filename == NULL))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	fd = open(filename, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	return navi_source_add(sources, fd, navi_source_File, 1, source);
+}
+
+//
+// Opens the UDP socket bound to the IPv4 address and port
+navierr_status_t navi_source_open_udp(struct navi_sources_t *sources,
+	const char *address, unsigned short port, int *source)
+{
+	int fd;
+	struct sockaddr_in sa;
+
+	if (sources == NULL)
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sin_family = AF_INET;
+	sa.sin_port = htons(port);
+	sa.sin_addr.s_addr = htonl(INADDR_ANY);
+
+	if ((address != NULL) && (inet_pton(AF_INET, address, &sa.sin_addr) != 1))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	if (bind(fd, (struct sockaddr *)&sa, sizeof(sa)) != 0)
+	{
+		close(fd);
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	return navi_source_add(sources, fd, navi_source_Udp, 1, source);
+}
+
+//
+// Adds the descriptor opened by the user
+navierr_status_t navi_source_add_fd(struct navi_sources_t *sources,
+	int fd, int *source)
+{
+	int flags;
+
+	if ((sources == NULL) || (fd < 0))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	flags = fcntl(fd, F_GETFL);
+	if ((flags < 0) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0))
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	return navi_source_add(sources, fd, navi_source_Stream, 0, source);
+}
+
+//
+// Closes the source
+navierr_status_t navi_source_close(struct navi_sources_t *sources, int source)
+{
+	struct navi_source_t *src;
+
+	if ((sources == NULL) || (source < 0) || (source >= sources->maxsources) ||
+		(sources->sources[source].type == navi_source_Closed))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	src = &sources->sources[source];
+
+	if (src->type == navi_source_File)
+		sources->nmfiles--;
+	else
+		(void)epoll_ctl(sources->epfd, EPOLL_CTL_DEL, src->fd, NULL);
+
+	if (src->owned)
+		close(src->fd);
+
+	src->type = navi_source_Closed;
+	src->fd = -1;
+
+	return navi_Ok;
+}
+
+//
+// Copies the health counters of the source framer
+navierr_status_t navi_source_stats(struct navi_sources_t *sources,
+	int source, struct navi_framestats_t *stats)
+{
+	if ((sources == NULL) || (source < 0) || (source >= sources->maxsources) ||
+		(sources->sources[source].type == navi_source_Closed) || (stats == NULL))
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	*stats = sources->sources[source].fr.stats;
+
+	return navi_Ok;
+}
+
+//
+// Returns nonzero, if the source is still open on the descriptor fd,
+// i.e. the handler neither closed it, nor reopened another one in its slot
+static int navi_source_alive(const struct navi_sources_t *sources, int source, int fd)
+{
+	return (sources->sources[source].type != navi_source_Closed) &&
+		(sources->sources[source].fd == fd);
+}
+
+//
+// Feeds the data to the framer of the source and passes the sentences.
+// The rest of the data is dropped, if the handler closes the source.
+static size_t navi_source_feed(struct navi_sources_t *sources, int source,
+	const char *data, size_t size)
+{
+	size_t offset, nmread, count = 0;
+	struct navi_framer_t *fr = &sources->sources[source].fr;
+	int fd = sources->sources[source].fd;
+
+	for (offset = 0; offset < size; offset += nmread)
+	{
+		if (navi_framer_push(fr, data + offset, size - offset, &nmread) == navi_Ok)
+		{
+			sources->handler(source, fr->sentence, fr->length, sources->context);
+			count++;
+
+			if (!navi_source_alive(sources, source, fd))
+				break;
+		}
+	}
+
+	return count;
+}
+
+//
+// Reads the ready source once
+static size_t navi_source_read(struct navi_sources_t *sources, int source)
+{
+	int i, n;
+	ssize_t nmread;
+	size_t count = 0;
+	struct navi_source_t *src = &sources->sources[source];
+	int fd = src->fd;
+
+	if (src->type == navi_source_Udp)
+	{
+		for (i = 0; i < NAVI_SOURCE_NMBUFFERS; i++)
+			sources->msgs[i].msg_len = 0;
+
+		n = recvmmsg(src->fd, sources->msgs, NAVI_SOURCE_NMBUFFERS, MSG_DONTWAIT, NULL);
+
+		for (i = 0; (i < n) && navi_source_alive(sources, source, fd); i++)
+		{
+			count += navi_source_feed(sources, source, sources->buffers[i],
+				sources->msgs[i].msg_len);
+		}
+
+		return count;
+	}
+
+	nmread = read(src->fd, sources->buffers[0], NAVI_SOURCE_BUFSIZE);
+	if (nmread > 0)
+		return navi_source_feed(sources, source, sources->buffers[0], (size_t)nmread);
+
+	if ((nmread < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+		return 0;
+
+	// The end of file, or the other side of pty is closed
+	(void)navi_source_close(sources, source);
+	sources->handler(source, NULL, 0, sources->context);
+
+	return 0;
+}
+
+//
+// Waits up to timeout milliseconds for input and handles it
+navierr_status_t navi_sources_poll(struct navi_sources_t *sources,
+	int timeout, size_t *nmsentences)
+{
+	int i, n;
+	size_t count = 0;
+	struct epoll_event events[NAVI_SOURCE_NMEVENTS];
+
+	if (sources == NULL)
+	{
+		navierr_set_last(navi_InvalidParameter);
+		return navi_Error;
+	}
+
+	n = epoll_wait(sources->epfd, events, NAVI_SOURCE_NMEVENTS,
+		sources->nmfiles > 0 ? 0 : timeout);
+	if ((n < 0) && (errno != EINTR))
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		// the source may be closed by the handler
+		if (sources->sources[events[i].data.u32].type != navi_source_Closed)
+			count += navi_source_read(sources, (int)events[i].data.u32);
+	}
+
+	for (i = 0; (sources->nmfiles > 0) && (i < sources->maxsources); i++)
+	{
+		if (sources->sources[i].type == navi_source_File)
+			count += navi_source_read(sources, i);
+	}
+
+	if (nmsentences)
+		*nmsentences = count;
+
+	return navi_Ok;
+}
+
+#else
+
+//
+// The source layer is implemented for Linux only
+//
+
+struct navi_sources_t *navi_sources_create(int maxsources,
+	navi_source_handler_t handler, void *context)
+{
+	(void)maxsources; (void)handler; (void)context;
+
+	navierr_set_last(navi_NotImplemented);
+	return NULL;
+}
+
+void navi_sources_destroy(struct navi_sources_t *sources)
+{
+	(void)sources;
+}
+
+navierr_status_t navi_source_open_serial(struct navi_sources_t *sources,
+	const char *device, int baudrate, int *source)
+{
+	(void)sources; (void)device; (void)baudrate; (void)source;
+
+	navierr_set_last(navi_NotImplemented);
+	return navi_Error;
+}
+
+navierr_status_t navi_source_open_file(struct navi_sources_t *sources,
+	const char *filename, int *source)
+{
+	(void)sources; (void)filename; (void)source;
+
+	navierr_set_last(navi_NotImplemented);
+	return navi_Error;
+}
+
+navierr_status_t navi_source_open_udp(struct navi_sources_t *sources,
+	const char *address, unsigned short port, int *source)
+{
+	(void)sources; (void)address; (void)port; (void)source;
+
+	navierr_set_last(navi_NotImplemented);
+	return navi_Error;
+}
+
+navierr_status_t navi_source_add_fd(struct navi_sources_t *sources,
+	int fd, int *source)
+{
+	(void)sources; (void)fd; (void)source;
+
+	navierr_set_last(navi_NotImplemented);
+	return navi_Error;
+}
+
+navierr_status_t navi_source_close(struct navi_sources_t *sources, int source)
+{
+	(void)sources; (void)source;
+
+	navierr_set_last(navi_NotImplemented);
+	return navi_Error;
+}
+
+navierr_status_t navi_source_stats(struct navi_sources_t *sources,
+	int source, struct navi_framestats_t *stats)
+{
+	(void)sources; (void)source; (void)stats;
+
+	navierr_set_last(navi_NotImplemented);
+	return navi_Error;
+}
+
+navierr_status_t navi_sources_poll(struct navi_sources_t *sources,
+	int timeout, size_t *nmsentences)
+{
+	(void)sources; (void)timeout; (void)nmsentences;
+
+	navierr_set_last(navi_NotImplemented);
+	return navi_Error;
+}
+
+#endif // __linux__
@@ -0,0 +1,457 @@
+/*
+ * stats.c - statistics of the parser and the generator
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/stats.h>
+#include "instrument.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef WITH_STATS
+
+#include "atomic.h"
+#include "thread.h"
+
+//
+// Every thread counts into its own block, allocated on the first call.
+// The blocks are linked into the list, which only grows, and are never
+// freed: when the thread finishes, its block is released and taken by
+// the next new thread, with the counters kept. So the snapshot reads
+// the list without locks, and the sums never decrease.
+//
+// The counters of the block are written by its thread only, and read
+// by the snapshot, with relaxed atomic loads and stores. These compile
+// to the plain moves.
+//
+
+//
+// The stamps of the sentence traced by the thread. The sentence is framed,
+// checked and decoded, then it is delivered, while the next one is framed.
+//
+struct navi_trace_t
+{
+	navi_stats_tick_t framed;	// the sentence framed, or 0
+	navi_stats_tick_t checked;	// its checksum verified, or 0
+	navi_stats_tick_t origin;	// the decoded sentence framed
+	navi_stats_tick_t decoded;	// the sentence decoded, or 0 if delivered
+	int type;					// the histogram of the decoded sentence
+};
+
+struct navi_stats_block_t
+{
+	struct navi_stats_block_t *next;
+	volatile size_t inuse;
+	struct navi_stats_t stats;
+	size_t bindings[NAVI_STATS_NM_BINDINGS];
+	struct navi_trace_t trace;
+};
+
+// The list of all the blocks, struct navi_stats_block_t *
+static volatile size_t g_blocks;
+
+// The block of the calling thread
+static NAVI_THREAD_LOCAL struct navi_stats_block_t *g_block;
+
+// The tick and the time of the first call, for ticks_per_second
+static navi_stats_tick_t g_start_ticks;
+static double g_start_time;
+
+#define NAVI_STATS_ADD(counter) \
+	navi_atomic_store((volatile size_t *)&(counter), \
+		navi_atomic_load((volatile size_t *)&(counter)) + 1)
+
+#ifdef _WIN32
+
+static INIT_ONCE g_once = INIT_ONCE_STATIC_INIT;
+static DWORD g_key;
+
+//
+// Releases the block of the finished thread
+static void WINAPI navi_stats_release(void *block)
+{
+	if (block != NULL)
+	{
+		g_block = NULL;
+		navi_atomic_store_release(&((struct navi_stats_block_t *)block)->inuse, 0);
+	}
+}
+
+static BOOL CALLBACK navi_stats_init(PINIT_ONCE once, void *param, void **context)
+{
+	(void)once;
+	(void)param;
+	(void)context;
+
+	g_key = FlsAlloc(navi_stats_release);
+	g_start_ticks = navi_stats_ticks();
+	g_start_time = navi_clock_now();
+
+	return TRUE;
+}
+
+#define navi_stats_once()			InitOnceExecuteOnce(&g_once, navi_stats_init, NULL, NULL)
+#define navi_stats_bind(block)		FlsSetValue(g_key, (block))
+
+#else
+
+static pthread_once_t g_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_key;
+
+//
+// Releases the block of the finished thread
+static void navi_stats_release(void *block)
+{
+	g_block = NULL;
+	navi_atomic_store_release(&((struct navi_stats_block_t *)block)->inuse, 0);
+}
+
+static void navi_stats_init(void)
+{
+	(void)pthread_key_create(&g_key, navi_stats_release);
+	g_start_ticks = navi_stats_ticks();
+	g_start_time = navi_clock_now();
+}
+
+#define navi_stats_once()			pthread_once(&g_once, navi_stats_init)
+#define navi_stats_bind(block)		pthread_setspecific(g_key, (block))
+
+#endif // _WIN32
+
+//
+// Returns the block of the calling thread, NULL if out of memory
+static struct navi_stats_block_t *navi_stats_block(void)
+{
+	struct navi_stats_block_t *block;
+	size_t head;
+
+	if (g_block != NULL)
+		return g_block;
+
+	navi_stats_once();
+
+	// the block of a finished thread
+	for (block = (struct navi_stats_block_t *)navi_atomic_load_acquire(&g_blocks);
+		block != NULL; block = block->next)
+	{
+		if ((navi_atomic_load(&block->inuse) == 0) && navi_atomic_cas(&block->inuse, 0, 1))
+			break;
+	}
+
+	if (block == NULL)
+	{
+		block = (struct navi_stats_block_t *)calloc(1, sizeof(*block));
+		if (block == NULL)
+			return NULL;
+
+		block->inuse = 1;
+		do
+		{
+			head = navi_atomic_load(&g_blocks);
+			block->next = (struct navi_stats_block_t *)head;
+		} while (!navi_atomic_cas(&g_blocks, head, (size_t)block));
+	}
+
+	// the sentence of the finished thread is not traced further
+	memset(&block->trace, 0, sizeof(block->trace));
+
+	(void)navi_stats_bind(block);
+	g_block = block;
+
+	return block;
+}
+
+//
+// Returns the bucket of the duration
+static int navi_stats_bucket(navi_stats_tick_t ticks)
+{
+	int bucket;
+
+#if defined(__GNUC__)
+	bucket = ticks != 0 ? 64 - __builtin_clzll(ticks) : 0;
+#else
+	for (bucket = 0; ticks != 0; ticks >>= 1)
+		bucket++;
+#endif // __GNUC__
+
+	return bucket < NAVI_STATS_NM_BUCKETS ? bucket : NAVI_STATS_NM_BUCKETS - 1;
+}
+
+//
+// Returns the histogram of the sentence type
+static int navi_stats_type(navi_addrfield_t type, const struct approved_field_t *address)
+{
+	switch (type)
+	{
+	case navi_af_Approved:
+		return (address->afmt >= 0) && (address->afmt < NAVI_STATS_NM_FORMATTERS) ?
+			address->afmt : NAVI_STATS_OTHER;
+	case navi_af_Query:
+		return NAVI_STATS_QUERY;
+	case navi_af_Proprietary:
+		return NAVI_STATS_PROPRIETARY;
+	default:
+		return NAVI_STATS_OTHER;
+	}
+}
+
+//
+// Counts the result of the call into the counters
+static void navi_stats_count(size_t counters[][NAVI_STATS_NM_TALKERS], size_t errors[],
+	navi_addrfield_t type, const struct approved_field_t *address, navierr_status_t result)
+{
+	int errclass;
+
+	if (result != navi_Ok)
+	{
+		errclass = navierr_get_last()->errclass;
+		if ((errclass >= 0) && (errclass < NAVI_STATS_NM_ERRCLASSES))
+			NAVI_STATS_ADD(errors[errclass]);
+	}
+	else if ((type == navi_af_Approved) &&
+		(address->afmt >= 0) && (address->afmt < NAVI_STATS_NM_FORMATTERS) &&
+		(address->tid >= 0) && (address->tid < NAVI_STATS_NM_TALKERS))
+	{
+		NAVI_STATS_ADD(counters[address->afmt][address->tid]);
+	}
+}
+
+//
+// navi_stats_parsed
+//
+void navi_stats_parsed(navi_addrfield_t type, const void *msg,
+	navierr_status_t result, navi_stats_tick_t start)
+{
+	navi_stats_tick_t ticks = navi_stats_ticks() - start;
+	const struct approved_field_t *address = (const struct approved_field_t *)msg;
+	struct navi_stats_block_t *block = navi_stats_block();
+
+	if (block == NULL)
+		return;
+
+	NAVI_STATS_ADD(block->stats.parse_latency[navi_stats_type(type, address)]
+		[navi_stats_bucket(ticks)]);
+	navi_stats_count(block->stats.parsed, block->stats.parse_errors, type, address, result);
+
+	navi_trace(result == navi_Ok ? navi_trace_Decoded : navi_trace_Dropped,
+		navi_stats_type(type, address));
+}
+
+//
+// navi_stats_created
+//
+void navi_stats_created(navi_addrfield_t type, const void *address,
+	navierr_status_t result, navi_stats_tick_t start)
+{
+	navi_stats_tick_t ticks = navi_stats_ticks() - start;
+	const struct approved_field_t *approved = (const struct approved_field_t *)address;
+	struct navi_stats_block_t *block = navi_stats_block();
+
+	if (block == NULL)
+		return;
+
+	NAVI_STATS_ADD(block->stats.create_latency[navi_stats_type(type, approved)]
+		[navi_stats_bucket(ticks)]);
+	navi_stats_count(block->stats.generated, block->stats.create_errors, type, approved, result);
+}
+
+//
+// navi_stats_bindings
+//
+volatile size_t *navi_stats_bindings(void)
+{
+	struct navi_stats_block_t *block = navi_stats_block();
+
+	return block != NULL ? block->bindings : NULL;
+}
+
+//
+// navi_stats_bindings_snapshot
+//
+void navi_stats_bindings_snapshot(size_t counters[NAVI_STATS_NM_BINDINGS])
+{
+	const struct navi_stats_block_t *block;
+	size_t i;
+
+	memset(counters, 0, NAVI_STATS_NM_BINDINGS * sizeof(size_t));
+
+	for (block = (const struct navi_stats_block_t *)navi_atomic_load_acquire(&g_blocks);
+		block != NULL; block = block->next)
+	{
+		for (i = 0; i < NAVI_STATS_NM_BINDINGS; i++)
+			counters[i] += navi_atomic_load((const volatile size_t *)&block->bindings[i]);
+	}
+}
+
+#endif // WITH_STATS
+
+// Stays 0 without WITH_STATS, so the trace points are never taken
+volatile size_t navi_trace_enabled;
+
+//
+// navi_trace_enable
+//
+navierr_status_t navi_trace_enable(int enable)
+{
+
+#ifdef WITH_STATS
+
+	navi_atomic_store(&navi_trace_enabled, enable != 0);
+	return navi_Ok;
+
+#else
+
+	(void)enable;
+
+	navierr_set_last(navi_NotImplemented);
+	return navi_Error;
+
+#endif // WITH_STATS
+
+}
+
+//
+// navi_trace_mark
+//
+void navi_trace_mark(navi_trace_point_t point, int type)
+{
+
+#ifdef WITH_STATS
+
+	struct navi_stats_block_t *block;
+	struct navi_trace_t *trace;
+	size_t (*histogram)[NAVI_STATS_NM_BUCKETS];
+	navi_stats_tick_t now;
+
+	if (!navi_atomic_load(&navi_trace_enabled) || ((block = navi_stats_block()) == NULL))
+		return;
+
+	trace = &block->trace;
+	now = navi_stats_ticks();
+
+	switch (point)
+	{
+	case navi_trace_Framed:
+		trace->framed = now;
+		trace->checked = 0;
+		break;
+	case navi_trace_Parsing:
+		if (trace->framed == 0)
+		{	// not taken by the framer
+			trace->framed = now;
+			trace->checked = 0;
+		}
+		break;
+	case navi_trace_Checked:
+		trace->checked = trace->framed != 0 ? now : 0;
+		break;
+	case navi_trace_Decoded:
+		if (trace->checked != 0)
+		{
+			if ((type < 0) || (type >= NAVI_STATS_NM_TYPES))
+				type = NAVI_STATS_OTHER;
+
+			histogram = block->stats.trace_latency[type];
+			NAVI_STATS_ADD(histogram[NAVI_TRACE_CHECKSUM]
+				[navi_stats_bucket(trace->checked - trace->framed)]);
+			NAVI_STATS_ADD(histogram[NAVI_TRACE_DECODE]
+				[navi_stats_bucket(now - trace->checked)]);
+
+			trace->origin = trace->framed;
+			trace->decoded = now;
+			trace->type = type;
+		}
+		trace->framed = trace->checked = 0;
+		break;
+	case navi_trace_Delivered:
+		if (trace->decoded != 0)
+		{
+			histogram = block->stats.trace_latency[trace->type];
+			NAVI_STATS_ADD(histogram[NAVI_TRACE_DELIVER]
+				[navi_stats_bucket(now - trace->decoded)]);
+			NAVI_STATS_ADD(histogram[NAVI_TRACE_TOTAL]
+				[navi_stats_bucket(now - trace->origin)]);
+
+			trace->decoded = 0;
+		}
+		break;
+	default:	// navi_trace_Dropped
+		trace->framed = trace->checked = trace->decoded = 0;
+		break;
+	}
+
+#else
+
+	(void)point;
+	(void)type;
+
+#endif // WITH_STATS
+
+}
+
+//
+// navi_stats_snapshot
+//
+navierr_status_t navi_stats_snapshot(struct navi_stats_t *stats)
+{
+
+#ifdef WITH_STATS
+
+	const struct navi_stats_block_t *block;
+	const volatile size_t *from;
+	size_t *to, i;
+	double elapsed;
+
+	// all the counters are the arrays of size_t before ticks_per_second
+	const size_t nmcounters = offsetof(struct navi_stats_t, ticks_per_second) / sizeof(size_t);
+
+	assert(stats != NULL);
+
+	memset(stats, 0, sizeof(*stats));
+
+	for (block = (const struct navi_stats_block_t *)navi_atomic_load_acquire(&g_blocks);
+		block != NULL; block = block->next)
+	{
+		from = (const volatile size_t *)&block->stats;
+		to = (size_t *)stats;
+
+		for (i = 0; i < nmcounters; i++)
+			to[i] += navi_atomic_load(&from[i]);
+	}
+
+	if (g_blocks != 0)
+	{
+		elapsed = navi_clock_now() - g_start_time;
+		if (elapsed > 0.0)
+			stats->ticks_per_second = (double)(navi_stats_ticks() - g_start_ticks) / elapsed;
+	}
+
+	return navi_Ok;
+
+#else
+
+	(void)stats;
+
+	navierr_set_last(navi_NotImplemented);
+	return navi_Error;
+
+#endif // WITH_STATS
+
+}
@@ -0,0 +1,162 @@
+/*
+ * thread.c - threads and synchronization used internally by libnavigate
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "thread.h"
+
+#ifndef _WIN32
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#ifdef _WIN32
+
+//
+// navi_thread_create
+//
+navierr_status_t navi_thread_create(navi_thread_t *thread,
+	navi_thread_proc_t proc, void *arg)
+{
+	*thread = CreateThread(NULL, 0, proc, arg, 0, NULL);
+	if (*thread == NULL)
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	return navi_Ok;
+}
+
+//
+// navi_thread_join
+//
+void navi_thread_join(navi_thread_t *thread)
+{
+	WaitForSingleObject(*thread, INFINITE);
+	CloseHandle(*thread);
+}
+
+//
+// navi_thread_yield
+//
+void navi_thread_yield(void)
+{
+	SwitchToThread();
+}
+
+//
+// navi_cpu_count
+//
+int navi_cpu_count(void)
+{
+	SYSTEM_INFO si;
+
+	GetSystemInfo(&si);
+	return si.dwNumberOfProcessors > 0 ? (int)si.dwNumberOfProcessors : 1;
+}
+
+//
+// navi_clock_now
+//
+double navi_clock_now(void)
+{
+	LARGE_INTEGER counter, frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
+
+void navi_mutex_init(navi_mutex_t *mutex) { InitializeCriticalSection(mutex); }
+void navi_mutex_destroy(navi_mutex_t *mutex) { DeleteCriticalSection(mutex); }
+void navi_mutex_lock(navi_mutex_t *mutex) { EnterCriticalSection(mutex); }
+void navi_mutex_unlock(navi_mutex_t *mutex) { LeaveCriticalSection(mutex); }
+
+void navi_cond_init(navi_cond_t *cond) { InitializeConditionVariable(cond); }
+void navi_cond_destroy(navi_cond_t *cond) { (void)cond; }
+void navi_cond_wait(navi_cond_t *cond, navi_mutex_t *mutex) { SleepConditionVariableCS(cond, mutex, INFINITE); }
+void navi_cond_signal(navi_cond_t *cond) { WakeConditionVariable(cond); }
+void navi_cond_broadcast(navi_cond_t *cond) { WakeAllConditionVariable(cond); }
+
+#else
+
+//
+// navi_thread_create
+//
+navierr_status_t navi_thread_create(navi_thread_t *thread,
+	navi_thread_proc_t proc, void *arg)
+{
+	if (pthread_create(thread, NULL, proc, arg) != 0)
+	{
+		navierr_set_last(navi_SystemError);
+		return navi_Error;
+	}
+
+	return navi_Ok;
+}
+
+//
+// navi_thread_join
+//
+void navi_thread_join(navi_thread_t *thread)
+{
+	(void)pthread_join(*thread, NULL);
+}
+
+//
+// navi_thread_yield
+//
+void navi_thread_yield(void)
+{
+	(void)sched_yield();
+}
+
+//
+// navi_cpu_count
+//
+int navi_cpu_count(void)
+{
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n > 0 ? (int)n : 1;
+}
+
+//
+// navi_clock_now
+//
+double navi_clock_now(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+void navi_mutex_init(navi_mutex_t *mutex) { (void)pthread_mutex_init(mutex, NULL); }
+void navi_mutex_destroy(navi_mutex_t *mutex) { (void)pthread_mutex_destroy(mutex); }
+void navi_mutex_lock(navi_mutex_t *mutex) { (void)pthread_mutex_lock(mutex); }
+void navi_mutex_unlock(navi_mutex_t *mutex) { (void)pthread_mutex_unlock(mutex); }
+
+void navi_cond_init(navi_cond_t *cond) { (void)pthread_cond_init(cond, NULL); }
+void navi_cond_destroy(navi_cond_t *cond) { (void)pthread_cond_destroy(cond); }
+void navi_cond_wait(navi_cond_t *cond, navi_mutex_t *mutex) { (void)pthread_cond_wait(cond, mutex); }
+void navi_cond_signal(navi_cond_t *cond) { (void)pthread_cond_signal(cond); }
+void navi_cond_broadcast(navi_cond_t *cond) { (void)pthread_cond_broadcast(cond); }
+
+#endif // _WIN32
@@ -0,0 +1,94 @@
+/*
+ * thread.h - threads and synchronization used internally by libnavigate
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_navi_thread_h
+#define INCLUDE_navi_thread_h
+
+#include <libnavigate/errors.h>
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+typedef HANDLE navi_thread_t;
+typedef CRITICAL_SECTION navi_mutex_t;
+typedef CONDITION_VARIABLE navi_cond_t;
+
+//! Declares a thread procedure taking the argument arg
+#define NAVI_THREAD_PROC(name, arg)		DWORD WINAPI name(LPVOID arg)
+
+typedef LPTHREAD_START_ROUTINE navi_thread_proc_t;
+
+#else
+
+#include <pthread.h>
+
+typedef pthread_t navi_thread_t;
+typedef pthread_mutex_t navi_mutex_t;
+typedef pthread_cond_t navi_cond_t;
+
+//! Declares a thread procedure taking the argument arg
+#define NAVI_THREAD_PROC(name, arg)		void *name(void *arg)
+
+typedef void *(*navi_thread_proc_t)(void *);
+
+#endif // _WIN32
+
+//! Declares a variable with the copy per thread
+#if defined(_MSC_VER)
+	#define NAVI_THREAD_LOCAL	__declspec(thread)
+#elif defined(__GNUC__)
+	#define NAVI_THREAD_LOCAL	__thread
+#else
+	#define NAVI_THREAD_LOCAL
+#endif // _MSC_VER, __GNUC__ or other compiler
+
+//
+// Starts a new thread. On failure sets the last error to navi_SystemError
+navierr_status_t navi_thread_create(navi_thread_t *thread,
+	navi_thread_proc_t proc, void *arg);
+
+//
+// Waits for the thread to finish and frees it
+void navi_thread_join(navi_thread_t *thread);
+
+//
+// Yields the rest of time slice of the calling thread
+void navi_thread_yield(void);
+
+//
+// Returns the number of online processors
+int navi_cpu_count(void);
+
+//
+// Returns the monotonic time in seconds
+double navi_clock_now(void);
+
+void navi_mutex_init(navi_mutex_t *mutex);
+void navi_mutex_destroy(navi_mutex_t *mutex);
+void navi_mutex_lock(navi_mutex_t *mutex);
+void navi_mutex_unlock(navi_mutex_t *mutex);
+
+void navi_cond_init(navi_cond_t *cond);
+void navi_cond_destroy(navi_cond_t *cond);
+void navi_cond_wait(navi_cond_t *cond, navi_mutex_t *mutex);
+void navi_cond_signal(navi_cond_t *cond);
+void navi_cond_broadcast(navi_cond_t *cond);
+
+#endif // INCLUDE_navi_thread_h
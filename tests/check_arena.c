@@ -0,0 +1,237 @@
+/*
+ * check_arena.c - tests of the arena of parsed sentences
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <navigate.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NM_EPOCHS		3
+#define SLABSIZE		4096
+#define NM_REUSES		100000
+
+static const char *g_unsupported =
+	"$PSRF100,1,4800,8,1,0*0E\r\n"
+	"$GPECQ,RMC*30\r\n";
+
+static const char *g_reused = "$GNGLL,5957.01433,N,03023.22067,E,094550,A,A*5C\r\n";
+
+// Checks if the sentences generated from both messages are the same
+static int same_sentences(const struct approved_field_t *a, const struct approved_field_t *b)
+{
+	char abuf[NAVI_SENTENCE_MAXSIZE + 1], bbuf[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t alength, blength;
+
+	if ((navi_create_msg(navi_af_Approved, a, a + 1, abuf, sizeof(abuf), &alength) != navi_Ok) ||
+		(navi_create_msg(navi_af_Approved, b, b + 1, bbuf, sizeof(bbuf), &blength) != navi_Ok))
+	{
+		return 0;
+	}
+
+	return (alength == blength) && (memcmp(abuf, bbuf, alength) == 0);
+}
+
+// Parses the stream into the arena and compares with navi_parse_msg()
+static int parse_stream(struct navi_arena_t *arena, char *stream, size_t size,
+	size_t *nmparsed)
+{
+	union
+	{
+		struct approved_field_t address;
+		double align;
+		char bytes[4096];
+	} expected;
+
+	struct approved_field_t *msg, *prev = NULL;
+	navi_addrfield_t type;
+	size_t offset, nmread, nmexpected;
+	int result = 0;
+
+	*nmparsed = 0;
+
+	for (offset = 0; offset < size; offset += nmread)
+	{
+		nmread = 0;
+		if (navi_parse_msg(stream + offset, size - offset, sizeof(expected), &type,
+				&expected, &nmexpected) != navi_Ok)
+		{
+			nmexpected = 0;
+		}
+
+		msg = navi_arena_parse(arena, stream + offset, size - offset, &nmread);
+		if (msg == NULL)
+		{
+			if ((nmexpected != 0) && (type == navi_af_Approved))
+				result = 1;
+			if (nmread == 0)
+				break;
+			continue;
+		}
+
+		(*nmparsed)++;
+
+		// the sentence is stored right after the previous one
+		if ((nmread != nmexpected) || (msg->afmt != expected.address.afmt) ||
+			(msg->tid != expected.address.tid) || !same_sentences(msg, &expected.address) ||
+			((prev != NULL) && ((char *)msg < (char *)prev) && ((char *)prev - (char *)msg < SLABSIZE)))
+		{
+			result = 1;
+		}
+		prev = msg;
+	}
+
+	return result;
+}
+
+static int read_tracks(const char *tracksdir, char **stream, size_t *size)
+{
+	char filename[1024];
+	FILE *f;
+	size_t i, n;
+
+	*stream = NULL;
+	*size = 0;
+
+	for (i = 0; i < 3; i++)
+	{
+		sprintf(filename, "%s/iec.track.%d", tracksdir, (int)i);
+		if ((f = fopen(filename, "rb")) == NULL)
+		{
+			printf("Cannot read %s\n", filename);
+			return 1;
+		}
+
+		fseek(f, 0, SEEK_END);
+		n = (size_t)ftell(f);
+		fseek(f, 0, SEEK_SET);
+
+		*stream = (char *)realloc(*stream, *size + n);
+		*size += fread(*stream + *size, 1, n, f);
+		fclose(f);
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *tracksdir = argc > 1 ? argv[1] : "tests/tracks";
+	struct navi_arena_t *arena;
+	struct approved_field_t *a, *b, *c;
+	char *stream, unsupported[64];
+	size_t size, nmparsed, nmread, reserved = 0, used = 0;
+	int i, result = 0;
+	void *large;
+
+	if (read_tracks(tracksdir, &stream, &size) != 0)
+		return 1;
+
+	arena = navi_arena_create(SLABSIZE);
+
+	// every epoch reuses the slabs of the first one
+	for (i = 0; i < NM_EPOCHS; i++)
+	{
+		navi_arena_reset(arena);
+
+		result |= parse_stream(arena, stream, size, &nmparsed);
+		if (i == 0)
+			reserved = navi_arena_reserved(arena);
+
+		if ((nmparsed == 0) || (navi_arena_reserved(arena) != reserved) ||
+			(navi_arena_used(arena) > reserved))
+		{
+			result = 1;
+		}
+	}
+
+	printf("%d sentences, %d bytes used, %d bytes reserved\n", (int)nmparsed,
+		(int)navi_arena_used(arena), (int)navi_arena_reserved(arena));
+
+	// the freed slot is reused by the sentence of the same type only
+	a = navi_arena_alloc_msg(arena, navi_RMC);
+	navi_arena_free_msg(arena, a);
+	b = navi_arena_alloc_msg(arena, navi_GGA);
+	c = navi_arena_alloc_msg(arena, navi_RMC);
+	if ((a == NULL) || (c != a) || (b == a) || (c->afmt != navi_RMC) ||
+		(navi_arena_alloc_msg(arena, navi_MWD) != NULL) ||
+		(navierr_get_last()->errclass != navi_MsgNotSupported))
+	{
+		printf("Slot reuse failed\n");
+		result = 1;
+	}
+
+	// the parsed sentence takes the freed slot of its type
+	navi_arena_reset(arena);
+	for (i = 0; i < NM_REUSES; i++)
+	{
+		strcpy(unsupported, g_reused);
+		a = navi_arena_parse(arena, unsupported, strlen(unsupported), &nmread);
+		if ((a == NULL) || (a->afmt != navi_GLL) || ((i > 0) && (a != b)))
+		{
+			result = 1;
+			break;
+		}
+		if (i == 0)
+			used = navi_arena_used(arena);
+		navi_arena_free_msg(arena, a);
+		b = a;
+	}
+	if ((i < NM_REUSES) || (navi_arena_used(arena) != used))
+	{
+		printf("Parsed slot reuse failed: %d bytes used\n", (int)navi_arena_used(arena));
+		result = 1;
+	}
+
+	// the large request gets its own slab, freed by reset
+	large = navi_arena_alloc(arena, 3 * SLABSIZE);
+	memset(large, 0xAA, 3 * SLABSIZE);
+	if (navi_arena_reserved(arena) != reserved + 3 * SLABSIZE)
+		result = 1;
+	navi_arena_reset(arena);
+	if ((navi_arena_reserved(arena) != reserved) || (navi_arena_used(arena) != 0))
+		result = 1;
+
+	// the proprietary and query sentences are not stored
+	strcpy(unsupported, g_unsupported);
+	if ((navi_arena_parse(arena, unsupported, strlen(unsupported), &nmread) != NULL) ||
+		(navierr_get_last()->errclass != navi_MsgNotSupported) ||
+		(navi_arena_parse(arena, unsupported + nmread, strlen(unsupported) - nmread, &nmread) != NULL) ||
+		(navierr_get_last()->errclass != navi_MsgNotSupported) || (navi_arena_used(arena) != 0))
+	{
+		printf("Unsupported sentences failed\n");
+		result = 1;
+	}
+
+	// the proprietary sentence without <cr><lf> is not read at all
+	nmread = 12345;
+	if ((navi_arena_parse(arena, unsupported, 10, &nmread) != NULL) ||
+		(navierr_get_last()->errclass != navi_NoValidMessage) || (nmread != 12345))
+	{
+		printf("Incomplete proprietary sentence failed\n");
+		result = 1;
+	}
+
+	navi_arena_destroy(arena);
+	free(stream);
+
+	printf("%s\n", result ? "FAILED" : "ok");
+
+	return result;
+}
@@ -0,0 +1,209 @@
+/*
+ * check_async.cpp - tests of the coroutine reader of the input sources
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/c++/async.hpp>
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace libnavigate;
+
+#define NM_PIPES		100
+#define NM_COPIES		50
+
+static const char *g_sentences =
+	"$GNZDA,094550,09,06,2012,00,00*55\r\n"
+	"$GNDTM,W84,,,,,,,*0F\r\n"
+	"$GNRMC,094550,A,5957.01433,N,03023.22067,E,0,,090612,,,A*57\r\n"
+	"$GNRMC,094550,A,5957.01433,N,03023.22067,E,0,,090612,,,A*00\r\n";
+
+#define NM_PER_WRITE	3
+
+struct counters_t
+{
+	int messages, rmc, ended;
+};
+
+static Task_t reader(Source_t source, counters_t *counters)
+{
+	while (std::optional<AnyMessage_t> msg = co_await source.next())
+	{
+		counters->messages++;
+		if (std::holds_alternative<Rmc_v>(*msg))
+			counters->rmc++;
+	}
+
+	counters->ended++;
+}
+
+// The reader closing its source after the first message. The messages
+// already queued are still received.
+static Task_t closer(EventLoop_t *loop, Source_t source, counters_t *counters)
+{
+	std::optional<AnyMessage_t> msg = co_await source.next();
+
+	loop->close(source);
+
+	for ( ; msg; msg = co_await source.next())
+		counters->messages++;
+
+	counters->ended++;
+}
+
+static Task_t thrower(Source_t source)
+{
+	co_await source.next();
+	throw NaviError_t(NaviError_t::InvalidParameter);
+}
+
+static int check_pipes(void)
+{
+	int i, fds[NM_PIPES][2], result = 0;
+	counters_t counters = { 0, 0, 0 };
+	EventLoop_t loop(NM_PIPES + 1);
+
+	for (i = 0; i < NM_PIPES; i++)
+	{
+		if (pipe(fds[i]) != 0)
+			return 1;
+		loop.spawn(reader(loop.addFd(fds[i][0]), &counters));
+	}
+
+	// the readers suspend waiting for data
+	loop.runOnce(0);
+
+	for (i = 0; i < NM_PIPES; i++)
+	{
+		write(fds[i][1], g_sentences, strlen(g_sentences));
+		close(fds[i][1]);
+	}
+
+	loop.run();
+
+	for (i = 0; i < NM_PIPES; i++)
+		close(fds[i][0]);
+
+	if ((counters.messages != NM_PIPES * NM_PER_WRITE) || (counters.rmc != NM_PIPES) ||
+		(counters.ended != NM_PIPES))
+	{
+		result = 1;
+	}
+
+	printf("%d pipes: %d messages, %d ended, %s\n", NM_PIPES, counters.messages,
+		counters.ended, result ? "FAILED" : "ok");
+
+	return result;
+}
+
+static int check_file(void)
+{
+	const char *filename = "check_async.track";
+	int i, result = 0;
+	counters_t counters = { 0, 0, 0 };
+	FILE *f;
+	EventLoop_t loop(4);
+	Source_t source;
+
+	f = fopen(filename, "wb");
+	for (i = 0; i < NM_COPIES; i++)
+		fputs(g_sentences, f);
+	fclose(f);
+
+	source = loop.openFile(filename);
+	loop.spawn(reader(source, &counters));
+	loop.run();
+
+	remove(filename);
+
+	if ((counters.messages != NM_COPIES * NM_PER_WRITE) || (counters.ended != 1) ||
+		(source.nmfailed() != NM_COPIES) || (source.id() != -1))
+	{
+		result = 1;
+	}
+
+	printf("file: %d messages, %d failed, %s\n", counters.messages,
+		(int)source.nmfailed(), result ? "FAILED" : "ok");
+
+	return result;
+}
+
+static int check_close(void)
+{
+	int fds[2], result = 0;
+	counters_t counters = { 0, 0, 0 };
+	EventLoop_t loop(2);
+
+	if (pipe(fds) != 0)
+		return 1;
+
+	loop.spawn(closer(&loop, loop.addFd(fds[0]), &counters));
+	write(fds[1], g_sentences, strlen(g_sentences));
+	loop.run();
+
+	close(fds[0]);
+	close(fds[1]);
+
+	if ((counters.messages != NM_PER_WRITE) || (counters.ended != 1) || (loop.runOnce(0) != 0))
+		result = 1;
+
+	printf("close: %s\n", result ? "FAILED" : "ok");
+
+	return result;
+}
+
+static int check_exception(void)
+{
+	int fds[2], result = 1;
+	EventLoop_t loop(2);
+
+	if (pipe(fds) != 0)
+		return 1;
+
+	loop.spawn(thrower(loop.addFd(fds[0])));
+	write(fds[1], g_sentences, strlen(g_sentences));
+
+	try
+	{
+		loop.run();
+	}
+	catch (NaviError_t &e)
+	{
+		result = e == NaviError_t::InvalidParameter ? 0 : 1;
+	}
+
+	close(fds[0]);
+	close(fds[1]);
+
+	printf("exception: %s\n", result ? "FAILED" : "ok");
+
+	return result;
+}
+
+int main(void)
+{
+	int result = 0;
+
+	result |= check_pipes();
+	result |= check_file();
+	result |= check_close();
+	result |= check_exception();
+
+	return result;
+}
@@ -0,0 +1,254 @@
+/*
+ * check_batch.c - tests of the sequential and parallel track parsers
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <navigate.h>
+#include <libnavigate/batch.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NM_COPIES		24
+
+// Digest of everything the handler has seen
+struct digest_t
+{
+	size_t nmsentences, nmfailed, nmcreated;
+	unsigned long hash;
+	size_t lastoffset;
+	int unordered;
+};
+
+static unsigned long hash_bytes(unsigned long hash, const void *data, size_t size)
+{
+	size_t i;
+	const unsigned char *p = (const unsigned char *)data;
+
+	for (i = 0; i < size; i++)
+		hash = (hash ^ p[i]) * 16777619UL;
+
+	return hash;
+}
+
+static int handler(const struct navi_parsed_t *parsed, void *context)
+{
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t nmwritten;
+	struct digest_t *digest = (struct digest_t *)context;
+
+	if (digest->nmsentences > 0 && parsed->offset < digest->lastoffset)
+		digest->unordered = 1;
+	digest->lastoffset = parsed->offset;
+	digest->nmsentences++;
+
+	digest->hash = hash_bytes(digest->hash, &parsed->offset, sizeof(parsed->offset));
+	digest->hash = hash_bytes(digest->hash, &parsed->length, sizeof(parsed->length));
+	digest->hash = hash_bytes(digest->hash, &parsed->status, sizeof(parsed->status));
+	digest->hash = hash_bytes(digest->hash, &parsed->errclass, sizeof(parsed->errclass));
+
+	if (parsed->status != navi_Ok)
+	{
+		digest->nmfailed++;
+		return 0;
+	}
+
+	// The messages are compared through the generated sentences,
+	// since the structures may have padding
+	if (parsed->type == navi_af_Approved && navi_create_msg(parsed->type, parsed->msg,
+		parsed->msg + sizeof(struct approved_field_t), buffer, sizeof(buffer), &nmwritten) == navi_Ok)
+	{
+		digest->hash = hash_bytes(digest->hash, buffer, nmwritten);
+		digest->nmcreated++;
+	}
+
+	return 0;
+}
+
+static int stop_handler(const struct navi_parsed_t *parsed, void *context)
+{
+	(void)parsed;
+	return ++*(size_t *)context == 100;
+}
+
+static char *read_file(const char *filename, size_t *size)
+{
+	FILE *f;
+	long length;
+	char *data;
+
+	if ((f = fopen(filename, "rb")) == NULL)
+		return NULL;
+
+	fseek(f, 0, SEEK_END);
+	length = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	data = (char *)malloc(length > 0 ? length : 1);
+	*size = fread(data, 1, length, f);
+	fclose(f);
+
+	return data;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *tracksdir = argc > 1 ? argv[1] : "tests/tracks";
+	const char *trackfile = "check_batch.track";
+	const char *noise = "garbage $GPGGA,broken\r\n$GPZDA,\r\n\r\n$";
+	char filename[1024];
+	char *track, *data;
+	size_t size, tracksize = 0, i, j, k, nmstopped;
+	int result = 0, nmthreads[] = { 1, 2, 3, 8 };
+	int backends[] = { navi_reader_Pread, navi_reader_Uring };
+	const char *backendnames[] = { "pread", "io_uring" };
+	struct digest_t expected, digest;
+	FILE *f;
+
+	// Build a big track of several copies with noise at chunk borders
+	track = NULL;
+	for (i = 0; i < 3; i++)
+	{
+		sprintf(filename, "%s/iec.track.%d", tracksdir, (int)i);
+		if ((data = read_file(filename, &size)) == NULL)
+		{
+			printf("Cannot read %s\n", filename);
+			return 1;
+		}
+
+		track = (char *)realloc(track, tracksize + size);
+		memcpy(track + tracksize, data, size);
+		tracksize += size;
+		free(data);
+	}
+
+	f = fopen(trackfile, "wb");
+	for (i = 0; i < NM_COPIES; i++)
+	{
+		fwrite(track, 1, tracksize - i * 7, f);
+		fwrite(noise, 1, strlen(noise), f);
+	}
+	fclose(f);
+	free(track);
+
+	data = read_file(trackfile, &size);
+
+	// Sequential results are the reference
+	memset(&expected, 0, sizeof(expected));
+	navi_parse_batch(data, size, handler, &expected, NULL);
+
+	printf("Sequential: %u sentences, %u failed, %u created\n", (unsigned)expected.nmsentences,
+		(unsigned)expected.nmfailed, (unsigned)expected.nmcreated);
+
+	if (expected.nmcreated == 0 || expected.nmfailed == 0)
+	{
+		printf("The reference track is not representative\n");
+		result = 1;
+	}
+
+	for (j = 0; j < sizeof(nmthreads) / sizeof(nmthreads[0]); j++)
+	{
+		memset(&digest, 0, sizeof(digest));
+		if (navi_parse_track(trackfile, nmthreads[j], handler, &digest) != navi_Ok)
+		{
+			printf("navi_parse_track failed (%d)\n", navierr_get_last()->errclass);
+			result = 1;
+			continue;
+		}
+
+		printf("%d thread(s): %u sentences, %u failed, %u created, %s\n", nmthreads[j],
+			(unsigned)digest.nmsentences, (unsigned)digest.nmfailed, (unsigned)digest.nmcreated,
+			(digest.hash == expected.hash) && !digest.unordered ? "identical" : "DIFFERENT");
+
+		if ((digest.nmsentences != expected.nmsentences) ||
+			(digest.hash != expected.hash) || digest.unordered)
+		{
+			result = 1;
+		}
+	}
+
+	// Bulk reader, the track is bigger than all the buffers
+	for (k = 0; k < sizeof(backends) / sizeof(backends[0]); k++)
+	{
+		for (j = 0; j < sizeof(nmthreads) / sizeof(nmthreads[0]); j++)
+		{
+			memset(&digest, 0, sizeof(digest));
+			if (navi_read_track(trackfile, backends[k], nmthreads[j], handler, &digest) != navi_Ok)
+			{
+				if (navierr_get_last()->errclass == navi_NotImplemented)
+				{
+					printf("%s is not available, skipped\n", backendnames[k]);
+					break;
+				}
+
+				printf("navi_read_track failed (%d)\n", navierr_get_last()->errclass);
+				result = 1;
+				continue;
+			}
+
+			printf("%s, %d thread(s): %u sentences, %s\n", backendnames[k], nmthreads[j],
+				(unsigned)digest.nmsentences,
+				(digest.hash == expected.hash) && !digest.unordered ? "identical" : "DIFFERENT");
+
+			if ((digest.nmsentences != expected.nmsentences) ||
+				(digest.hash != expected.hash) || digest.unordered)
+			{
+				result = 1;
+			}
+		}
+	}
+
+	for (j = 0; j < 2; j++)
+	{
+		nmstopped = 0;
+		navi_read_track(trackfile, navi_reader_Auto, nmthreads[j * 3], stop_handler, &nmstopped);
+		if (nmstopped != 100)
+		{
+			printf("Handler did not stop the reader on %d thread(s)\n", nmthreads[j * 3]);
+			result = 1;
+		}
+	}
+
+	// Stopping by the handler
+	nmstopped = 0;
+	navi_parse_parallel(data, size, 4, stop_handler, &nmstopped);
+	if (nmstopped != 100)
+	{
+		printf("Handler did not stop the parsing\n");
+		result = 1;
+	}
+
+	if (navi_parse_track("no/such/file", 2, handler, &digest) == navi_Ok ||
+		navierr_get_last()->errclass != navi_SystemError)
+	{
+		printf("Missing file is not reported\n");
+		result = 1;
+	}
+
+	if (navi_read_track("no/such/file", navi_reader_Auto, 1, handler, &digest) == navi_Ok ||
+		navierr_get_last()->errclass != navi_SystemError)
+	{
+		printf("Missing file is not reported by the reader\n");
+		result = 1;
+	}
+
+	free(data);
+	remove(trackfile);
+
+	return result;
+}
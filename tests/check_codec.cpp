@@ -0,0 +1,453 @@
+/*
+ * check_codec.cpp - tests of the template codec against the C parser and generator
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/c++/codec.hpp>
+#include <libnavigate/c++/navigate.hpp>
+#include <libnavigate/c++/writer.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+using namespace libnavigate;
+
+static const char *g_samples[] =
+{
+	"$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76\r\n",
+	"$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n",
+	"$GNGGA,001043.00,4404.14036,N,12118.85961,W,1,12,0.98,1113.0,M,-21.3,M,,*47\r\n",
+	"$GPGGA,,,,,,0,,,,,,,,*66\r\n",
+	"$GPGGA,002153.000,3342.6618,N,11751.3858,W,1,0A,1.0,27.0,M,-34.2,M,1.5,0031*04\r\n",
+	"$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W,A*07\r\n",
+	"$GPRMC,,V,,,,,,,,,,N*53\r\n",
+	"$GNRMC,094550,A,5957.01433,N,03023.22067,E,0,,090612,,,A*57\r\n",
+	"$GNZDA,094550,09,06,2012,00,00*55\r\n",
+	"$GNDTM,W84,,,,,,,*0F\r\n",
+	"$GPDBT,0.0,f,0.0,M,0.0,F*06\r\n",
+	"$SDDBT,12.5,f,3.8,M,2.1,F*38\r\n",
+	"$SDDBT,,f,3.8,M,,F*0D\r\n",
+	"$SDDPT,3.8,-0.4,100*68\r\n",
+	"$SDDPT,2.5,0.7*57\r\n",
+	"$HCHDG,98.3,0.0,E,12.6,W*57\r\n",
+	"$HCHDG,271.0,,,,*46\r\n",
+	"$HEHDT,274.07,T*19\r\n",
+	"$WIMWV,214.8,R,0.1,K,A*28\r\n",
+	"$WIMWV,,T,,N,V*32\r\n",
+	NULL
+};
+
+// Outcome of parsing and generating one sentence
+struct outcome_t
+{
+	int errclass;
+	size_t nmread;
+	std::string created;
+};
+
+static outcome_t parse_c(char *sentence, size_t length)
+{
+	union
+	{
+		struct approved_field_t address;
+		double align;
+		char bytes[sizeof(struct approved_field_t) + Message_t::MaxSize];
+	} parsed;
+
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+	navi_addrfield_t type;
+	outcome_t result;
+	size_t nmwritten;
+
+	result.nmread = 0;
+	if (navi_parse_msg(sentence, length, sizeof(parsed), &type, &parsed, &result.nmread) != navi_Ok)
+	{
+		result.errclass = navierr_get_last()->errclass;
+		return result;
+	}
+
+	result.errclass = navi_Undefined;
+	if ((type == navi_af_Approved) && (navi_create_msg(type, &parsed.address,
+		parsed.bytes + sizeof(struct approved_field_t), buffer, sizeof(buffer), &nmwritten) == navi_Ok))
+	{
+		result.created.assign(buffer, nmwritten);
+	}
+
+	return result;
+}
+
+static outcome_t parse_codec(char *sentence, size_t length)
+{
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+	outcome_t result;
+	AnyMessage_t msg;
+
+	result.nmread = 0;
+	result.errclass = navi_Undefined;
+
+	try
+	{
+		msg = DecodeAny(sentence, length, &result.nmread);
+	}
+	catch (NaviError_t &e)
+	{
+		result.errclass = e;
+		return result;
+	}
+
+	try
+	{
+		result.created.assign(buffer, EncodeAny(msg, buffer, sizeof(buffer)));
+	}
+	catch (NaviError_t &)
+	{
+	}
+
+	return result;
+}
+
+// The same without exceptions
+static outcome_t parse_codec_nothrow(char *sentence, size_t length)
+{
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+	outcome_t result;
+	AnyMessage_t msg;
+	NaviError_t error;
+	size_t nmwritten;
+
+	result.nmread = 0;
+	result.errclass = navi_Undefined;
+
+	msg = DecodeAny(sentence, length, &result.nmread, error);
+	if (std::holds_alternative<std::monostate>(msg))
+	{
+		result.errclass = error;
+		return result;
+	}
+
+	if ((nmwritten = EncodeAny(msg, buffer, sizeof(buffer), error)) > 0)
+		result.created.assign(buffer, nmwritten);
+
+	return result;
+}
+
+// Navigate_t without exceptions
+static outcome_t parse_bindings_nothrow(char *sentence, size_t length)
+{
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+	outcome_t result;
+	Navigate_t navi;
+	Message_t msg(MessageType_t::Unknown);
+	NaviError_t error;
+	size_t nmwritten;
+
+	result.nmread = 0;
+	result.errclass = navi_Undefined;
+
+	if (!navi.ParseMessage(sentence, length, &result.nmread, msg, error))
+	{
+		result.errclass = error;
+		return result;
+	}
+
+	if ((nmwritten = navi.CreateMessage(msg, buffer, sizeof(buffer), error)) > 0)
+		result.created.assign(buffer, nmwritten);
+
+	return result;
+}
+
+static bool equal(const outcome_t &left, const outcome_t &right)
+{
+	return (left.errclass == right.errclass) && (left.nmread == right.nmread) &&
+		(left.created == right.created);
+}
+
+// Parses the sentence in all the ways and compares the results
+static int check(const std::string &sentence, size_t *nmchecked)
+{
+	std::string copy = sentence;
+	outcome_t expected = parse_c(&copy[0], copy.size()), actual;
+
+	copy = sentence;
+	actual = parse_codec(&copy[0], copy.size());
+
+	(*nmchecked)++;
+
+	if (equal(expected, actual))
+	{
+		copy = sentence;
+		actual = parse_codec_nothrow(&copy[0], copy.size());
+	}
+	if (equal(expected, actual))
+	{
+		copy = sentence;
+		actual = parse_bindings_nothrow(&copy[0], copy.size());
+	}
+
+	if (!equal(expected, actual))
+	{
+		printf("%s  C: %d '%s'\n  codec: %d '%s'\n", sentence.c_str(),
+			expected.errclass, expected.created.c_str(), actual.errclass, actual.created.c_str());
+		return 1;
+	}
+
+	return 0;
+}
+
+// Replaces the checksum to make the sentence look valid
+static std::string fix_checksum(std::string sentence)
+{
+	size_t star = sentence.find('*');
+	unsigned int cs = 0;
+	size_t i;
+	char hex[3];
+
+	if ((star == std::string::npos) || (star + 4 >= sentence.size()))
+		return sentence;
+
+	for (i = 1; i < star; i++)
+		cs ^= (unsigned char)sentence[i];
+	snprintf(hex, sizeof(hex), "%02X", cs);
+	sentence.replace(star + 1, 2, hex);
+
+	return sentence;
+}
+
+// Mutated copies of the sentence, to check the error paths
+static int check_mutations(const std::string &sentence, size_t *nmchecked)
+{
+	static const char replacements[] = ",.*-0A9NZ";
+	size_t i, j, star = sentence.find('*');
+	int result = 0;
+
+	if (star == std::string::npos)
+		return 0;
+
+	for (i = 7; i < star; i++)
+	{
+		for (j = 0; replacements[j] != '\0'; j++)
+		{
+			std::string mutated = sentence;
+			mutated[i] = replacements[j];
+			result |= check(fix_checksum(mutated), nmchecked);
+		}
+
+		result |= check(fix_checksum(std::string(sentence).erase(i, 1)), nmchecked);
+	}
+
+	return result;
+}
+
+static int check_track(const char *filename, size_t *nmchecked)
+{
+	FILE *f;
+	char line[1024];
+	int result = 0;
+	std::string sentence;
+
+	if ((f = fopen(filename, "rb")) == NULL)
+	{
+		printf("Cannot read %s\n", filename);
+		return 1;
+	}
+
+	while (fgets(line, sizeof(line), f) != NULL)
+	{
+		sentence = line;
+		result |= check(sentence, nmchecked);
+
+		if ((sentence.compare(3, 3, "RMC") == 0) || (sentence.compare(3, 3, "GGA") == 0))
+			result |= check_mutations(sentence, nmchecked);
+	}
+
+	fclose(f);
+
+	return result;
+}
+
+template <typename T>
+static int check_encode_error(const Sentence_t<T> &msg, char *buffer, size_t maxsize, int expected)
+{
+	try
+	{
+		Encode(msg, buffer, maxsize);
+	}
+	catch (NaviError_t &e)
+	{
+		if (e == expected)
+			return 0;
+	}
+
+	printf("%s: the error %d is expected\n", navi_sentencefmt_str(msg.formatter), expected);
+	return 1;
+}
+
+// Sentences of various precision made by the C generator
+static int check_generated(size_t *nmchecked)
+{
+	Rmc_v rmc;
+	Gga_v gga;
+	Mwv_v mwv;
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+	int precision, oldprecision, result = 0;
+
+	rmc.tid = navi_GP;
+	navi_init_rmc(&rmc.data);
+	navi_init_utc_from_hhmmss(23, 59, 59.999, &rmc.data.utc);
+	rmc.data.status = navi_status_A;
+	navi_init_position_from_degrees(-33.8688197, 151.2092955, &rmc.data.fix);
+	rmc.data.speedN = 0.0625;
+	rmc.data.courseT = 359.99;
+	navi_init_date(2013, 1, 31, &rmc.data.date);
+	rmc.data.vfields = RMC_VALID_DATE;
+	navi_init_offset_from_degrees(11.25, navi_West, &rmc.data.magnVariation);
+	rmc.data.mi = navi_Differential;
+
+	gga.tid = navi_GN;
+	navi_init_gga(&gga.data);
+	navi_init_utc_from_hhmmss(0, 0, 0.5, &gga.data.utc);
+	navi_init_position_from_degrees(89.999, -179.5, &gga.data.fix);
+	gga.data.gpsindicator = navi_gps_Differential;
+	gga.data.nmsatellites = 12;
+	gga.data.hdop = 0.7;
+	gga.data.antaltitude = -12.125;
+	gga.data.geoidalsep = 18.0;
+	gga.data.diffdata_age = 3;
+	gga.data.station_id = 1023;
+
+	mwv.tid = navi_WI;
+	navi_init_mwv(&mwv.data);
+	mwv.data.angle = 359.875;
+	mwv.data.reference = 'T';
+	mwv.data.speed = 12.5;
+	mwv.data.units = 'N';
+	mwv.data.status = navi_status_A;
+
+	oldprecision = naviconf_get_presicion();
+
+	for (precision = 0; precision <= 4; precision++)
+	{
+		naviconf_set_presicion(precision);
+
+		result |= check(std::string(buffer, CreateSentence(rmc, buffer, sizeof(buffer))), nmchecked);
+		result |= check(std::string(buffer, CreateSentence(gga, buffer, sizeof(buffer))), nmchecked);
+		result |= check(std::string(buffer, CreateSentence(mwv, buffer, sizeof(buffer))), nmchecked);
+	}
+
+	// the sentence too long for the standard and the buffer too short
+	naviconf_set_presicion(12);
+	gga.data.hdop = gga.data.antaltitude = 1.0 / 3.0;
+	result |= check_encode_error(rmc, buffer, sizeof(buffer), NaviError_t::MsgExceedsMaxSize);
+	result |= check_encode_error(gga, buffer, sizeof(buffer), NaviError_t::MsgExceedsMaxSize);
+
+	naviconf_set_presicion(oldprecision);
+	result |= check_encode_error(rmc, buffer, 20, NaviError_t::NotEnoughBuffer);
+	result |= check_encode_error(gga, buffer, 20, NaviError_t::NotEnoughBuffer);
+	result |= check_encode_error(mwv, buffer, 20, NaviError_t::NotEnoughBuffer);
+
+	// the values the schema does not allow
+	mwv.data.units = 'X';
+	result |= check_encode_error(mwv, buffer, sizeof(buffer), NaviError_t::InvalidParameter);
+	mwv.data.units = 'K';
+	mwv.data.status = navi_status_t(7);
+	result |= check_encode_error(mwv, buffer, sizeof(buffer), NaviError_t::InvalidParameter);
+
+	return result;
+}
+
+// The sentences of one epoch appended to the fixed and the growable output
+static int check_writer(void)
+{
+	char buffer[3 * Writer_t::SentenceRoom], expected[NAVI_SENTENCE_MAXSIZE + 1];
+	std::string epoch, joined;
+	Writer_t fixed(buffer, sizeof(buffer)), growable(epoch), small(buffer, 40);
+	NaviError_t error;
+	AnyMessage_t msgs[3];
+	size_t i, j;
+	int result = 0;
+
+	for (i = 0; i < 3; i++)
+	{
+		std::string sample = g_samples[i == 0 ? 5 : i == 1 ? 1 : 8];
+		msgs[i] = DecodeAny(&sample[0], sample.size(), &j);
+	}
+
+	for (j = 0; j < 100; j++)
+	{
+		fixed.clear();
+		for (i = 0; i < 3; i++)
+		{
+			std::string_view sentence = growable.append(msgs[i]);
+
+			if ((fixed.append(msgs[i]) != sentence) ||
+				(sentence != std::string_view(expected, CreateSentence(msgs[i], expected, sizeof(expected)))))
+			{
+				result = 1;
+			}
+			if (j == 0)
+				joined += sentence;
+		}
+	}
+
+	if ((fixed.view() != joined) || (growable.size() != 100 * joined.size()) ||
+		(growable.view().substr(0, joined.size()) != joined))
+	{
+		result = 1;
+	}
+
+	// no room for the second sentence, the first one is kept
+	if (small.append(msgs[2], error).empty() || !small.append(msgs[2], error).empty() ||
+		(error != NaviError_t::NotEnoughBuffer) || (small.size() != 35) ||
+		!small.append(std::monostate(), error).empty() || (error != NaviError_t::InvalidParameter))
+	{
+		result = 1;
+	}
+
+	printf("writer: %s\n", result ? "FAILED" : "ok");
+
+	return result;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *tracksdir = argc > 1 ? argv[1] : "tests/tracks";
+	char filename[1024];
+	size_t i, nmchecked = 0;
+	int result = 0;
+
+	for (i = 0; g_samples[i] != NULL; i++)
+	{
+		result |= check(g_samples[i], &nmchecked);
+		result |= check_mutations(g_samples[i], &nmchecked);
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		sprintf(filename, "%s/iec.track.%d", tracksdir, (int)i);
+		result |= check_track(filename, &nmchecked);
+	}
+
+	result |= check_generated(&nmchecked);
+	result |= check_writer();
+
+	printf("%d sentences checked, %s\n", (int)nmchecked, result ? "FAILED" : "ok");
+
+	return result;
+}
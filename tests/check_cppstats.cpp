@@ -0,0 +1,164 @@
+/*
+ * check_cppstats.cpp - tests of the accounting of the C++ bindings
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <navigate++>
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace libnavigate;
+
+#ifdef WITH_STATS
+
+#define NM_REPEATS		100
+
+// A RMC, a GLL and a sentence with the bad checksum
+static const char *g_stream =
+	"$GNRMC,094550,A,5957.01433,N,03023.22067,E,0,,090612,,,A*57\r\n"
+	"$GPGLL,4807.038,N,01131.000,E,123519,A,A*48\r\n"
+	"$GPGLL,4807.038,N,01131.000,E,123519,A,A*00\r\n";
+
+static int expect(const char *what, size_t actual, size_t expected)
+{
+	if (actual != expected)
+	{
+		printf("%s: %lu, expected %lu\n", what, (unsigned long)actual, (unsigned long)expected);
+		return 1;
+	}
+	return 0;
+}
+
+//
+// Parses the stream with the both kinds of ParseMessage() and generates
+// the sentences back
+static void run(void)
+{
+	char buffer[1024], generated[NAVI_SENTENCE_MAXSIZE + 1], text[4 * NAVI_SENTENCE_MAXSIZE];
+	size_t length = strlen(g_stream), offset, nmread;
+	Navigate_t navi;
+	Message_t msg(MessageType_t::Unknown);
+	NaviError_t error;
+	int i;
+
+	for (i = 0; i < NM_REPEATS; i++)
+	{
+		memcpy(buffer, g_stream, length);
+
+		for (offset = 0; offset < length; offset += nmread)
+		{
+			if (navi.ParseMessage(buffer + offset, length - offset, &nmread, msg, error))
+				(void)navi.CreateMessage(msg, generated, sizeof(generated), error);
+		}
+
+		memcpy(buffer, g_stream, length);
+
+		for (offset = 0; offset < length; offset += nmread)
+		{
+			try
+			{
+				Message_t copy = navi.ParseMessage(buffer + offset, length - offset, &nmread);
+				(void)copy;
+			}
+			catch (NaviError_t &)
+			{
+			}
+		}
+
+		(void)navi.CreateTxtSequence(TalkerId_t::GP, 1, "virtual", text, sizeof(text));
+	}
+}
+
+#endif // WITH_STATS
+
+int main(void)
+{
+	int result = 0;
+
+#ifdef WITH_STATS
+
+	BindingsStats_t before = BindingsStats_t::snapshot(), after;
+	size_t copied;
+
+	run();
+
+	after = BindingsStats_t::snapshot();
+
+	// 3 sentences parsed twice, a call of the throwing one counts once
+	result |= expect("ParseMessage calls",
+		after[BindingsStats_t::ParseMessage].calls -
+		before[BindingsStats_t::ParseMessage].calls, 6 * NM_REPEATS);
+	result |= expect("CreateMessage calls",
+		after[BindingsStats_t::CreateMessage].calls -
+		before[BindingsStats_t::CreateMessage].calls, 2 * NM_REPEATS);
+
+	// the exception of the bad checksum
+	result |= expect("ParseMessage exceptions",
+		after[BindingsStats_t::ParseMessage].exceptions -
+		before[BindingsStats_t::ParseMessage].exceptions, NM_REPEATS);
+	result |= expect("CreateMessage exceptions",
+		after[BindingsStats_t::CreateMessage].exceptions -
+		before[BindingsStats_t::CreateMessage].exceptions, 0);
+
+	// every parsed sentence is copied at least once
+	copied = after[BindingsStats_t::ParseMessage].bytesCopied -
+		before[BindingsStats_t::ParseMessage].bytesCopied;
+	if (copied < 4 * NM_REPEATS * sizeof(struct gll_t))
+	{
+		printf("ParseMessage bytes copied: %lu\n", (unsigned long)copied);
+		result = 1;
+	}
+
+	// the members of Message_t are called statically, the talker
+	// identifier passed by reference is not
+	result |= expect("CreateMessage virtual calls",
+		after[BindingsStats_t::CreateMessage].virtualCalls -
+		before[BindingsStats_t::CreateMessage].virtualCalls, 0);
+	result |= expect("ParseMessage virtual calls",
+		after[BindingsStats_t::ParseMessage].virtualCalls -
+		before[BindingsStats_t::ParseMessage].virtualCalls, 0);
+	result |= expect("CreateTxtSequence virtual calls",
+		after[BindingsStats_t::CreateTxtSequence].virtualCalls -
+		before[BindingsStats_t::CreateTxtSequence].virtualCalls, NM_REPEATS);
+
+	result |= expect("Other calls", after[BindingsStats_t::Other].calls, 0);
+
+#else
+
+	try
+	{
+		(void)BindingsStats_t::snapshot();
+
+		printf("BindingsStats_t::snapshot without WITH_STATS\n");
+		result = 1;
+	}
+	catch (NaviError_t &error)
+	{
+		if (error != NaviError_t::NotImplemented)
+		{
+			printf("BindingsStats_t::snapshot: %d\n", int(error));
+			result = 1;
+		}
+	}
+
+#endif // WITH_STATS
+
+	printf("%s\n", result ? "FAILED" : "ok");
+
+	return result;
+}
@@ -0,0 +1,231 @@
+/*
+ * check_fuzzcases.c - regression tests of the inputs found by fuzzing
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// The inputs that crashed fuzz/fuzz_fields.c and fuzz/fuzz_parse.c.
+// A field is given to its parser as fuzz_fields does, as the last field
+// of a sentence, followed by "*hh<cr><lf>" at the end of a buffer of the
+// exact size. Build with -fsanitize=address to catch the reads behind it.
+//
+
+#include <navigate.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NM_MODES		2		// the capacity of the mode indicator array
+
+enum fieldparser_t
+{
+	field_Character,
+	field_MiArray,
+	field_GsaMode,
+	field_LocalZone,
+	field_DatumSub,
+	field_PositionFix
+};
+
+struct fieldcase_t
+{
+	enum fieldparser_t parser;
+	const char *field;
+	size_t maxsize;		// the output size of navi_parse_character_field()
+	int errclass;		// navi_Undefined, if parsed
+};
+
+static const struct fieldcase_t g_fields[] =
+{
+	// '^' escape cut by the end of the field
+	{ field_Character, "abc^", 16, navi_InvalidMessage },
+	{ field_Character, "ab^4", 16, navi_InvalidMessage },
+	{ field_Character, "ab^2C", 16, navi_Undefined },
+	// control characters, <cr> included
+	{ field_Character, "a\x01" "b", 16, navi_InvalidMessage },
+	{ field_Character, "a\rb", 16, navi_InvalidMessage },
+	// longer than the output
+	{ field_Character, "abcdefgh", 4, navi_NotEnoughBuffer },
+	{ field_Character, "abc^2C", 4, navi_NotEnoughBuffer },
+	// more modes than the array holds
+	{ field_MiArray, "ADEMS", 0, navi_InvalidMessage },
+	{ field_MiArray, "AD", 0, navi_Undefined },
+	// invalid first character
+	{ field_GsaMode, "X", 0, navi_InvalidMessage },
+	{ field_GsaMode, "", 0, navi_InvalidMessage },
+	// null field at the end of the sentence, too many hours
+	{ field_LocalZone, "", 0, navi_NullField },
+	{ field_LocalZone, "1234567,00", 0, navi_InvalidMessage },
+	{ field_LocalZone, "-05,30", 0, navi_Undefined },
+	{ field_DatumSub, "", 0, navi_NullField },
+	// null position fix cut by the end of the sentence
+	{ field_PositionFix, ",,", 0, navi_InvalidMessage },
+	{ field_PositionFix, ",,x,", 0, navi_InvalidMessage },
+	{ field_PositionFix, ",,,", 0, navi_NullField }
+};
+
+#define NM_FIELDS		(sizeof(g_fields) / sizeof(g_fields[0]))
+
+// The same sentences, with valid checksums, and the error of navi_parse_msg()
+struct sentencecase_t
+{
+	const char *sentence;
+	int errclass;
+};
+
+static const struct sentencecase_t g_sentences[] =
+{
+	{ "$GPTXT,01,01,02,abc^*73\r\n", navi_InvalidMessage },
+	{ "$GPTXT,01,01,02,ab^4*24\r\n", navi_InvalidMessage },
+	{ "$GPTXT,01,01,02,a\x01" "b*4F\r\n", navi_InvalidMessage },
+	{ "$GNGNS,122310.2,3722.425671,N,12258.856215,W,ADEMSADEMSAD,14,0.9,1005.543,6.5,,*71\r\n",
+		navi_InvalidMessage },
+	{ "$GPGSA,X,3,,,,,,,,,,,,,,,*05\r\n", navi_InvalidMessage },
+	{ "$GPGSA,*6E\r\n", navi_InvalidMessage },
+	{ "$GPZDA,160012.71,11,03,2004,*4D\r\n", navi_Undefined },
+	{ "$GPZDA,160012.71,11,03,2004,1234567,00*51\r\n", navi_InvalidMessage },
+	{ "$GPDTM,W84,*11\r\n", navi_InvalidMessage },
+	{ "$GPGLL,,,*7C\r\n", navi_InvalidMessage },
+	{ "$GPGLL,,,,*50\r\n", navi_InvalidMessage }
+};
+
+#define NM_SENTENCES	(sizeof(g_sentences) / sizeof(g_sentences[0]))
+
+static int check_field(const struct fieldcase_t *test)
+{
+	char *buffer, *end, text[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t length, nmread = 0, misize = NM_MODES;
+	navi_modeindicator_t mi[NM_MODES + 1];
+	navierr_status_t status = navi_Error;
+	int errclass, result = 0;
+	union
+	{
+		int integer;
+		struct navi_position_t fix;
+		navi_gsaswitchmode_t mode;
+		navi_datum_subdivision_t datumsub;
+	} value;
+
+	length = strlen(test->field);
+	buffer = (char *)malloc(length + 5);
+	if (buffer == NULL)
+		return 1;
+	memcpy(buffer, test->field, length);
+	memcpy(buffer + length, "*00\r\n", 5);
+	end = (char *)memchr(buffer, '*', length + 1);
+
+	mi[NM_MODES] = navi_DataNotValid;
+	memset(text, 'x', sizeof(text));
+
+	switch (test->parser)
+	{
+	case field_Character:
+		status = navi_parse_character_field(buffer, text, test->maxsize, &nmread);
+		if (strlen(text) >= test->maxsize)
+			result = 1;
+		break;
+	case field_MiArray:
+		status = navi_parse_miarray(buffer, mi, &misize, &nmread);
+		if ((misize > NM_MODES) || (mi[NM_MODES] != navi_DataNotValid))
+			result = 1;
+		break;
+	case field_GsaMode:
+		status = navi_parse_gsamode(buffer, &value.mode, &nmread);
+		break;
+	case field_LocalZone:
+		status = navi_parse_localzone(buffer, &value.integer, &nmread);
+		break;
+	case field_DatumSub:
+		status = navi_parse_datumsub(buffer, &value.datumsub, &nmread);
+		break;
+	case field_PositionFix:
+		status = navi_parse_position_fix(buffer, &value.fix, &nmread);
+		break;
+	}
+
+	errclass = status == navi_Ok ? navi_Undefined : navierr_get_last()->errclass;
+
+	// the next field starts behind the '*' the latest
+	if ((errclass != test->errclass) || (buffer + nmread > end + 1))
+		result = 1;
+
+	if (result != 0)
+	{
+		printf("field %d '%s': error %d, %d expected, nmread = %u\n", (int)test->parser,
+			test->field, errclass, test->errclass, (unsigned)nmread);
+	}
+
+	free(buffer);
+
+	return result;
+}
+
+static int check_sentence(const struct sentencecase_t *test)
+{
+	union
+	{
+		struct approved_field_t address;
+		double align;
+		char bytes[4096];
+	} parsed;
+
+	char *buffer;
+	size_t length, nmread = 0;
+	navi_addrfield_t type;
+	int errclass;
+
+	// the sentence at the end of a buffer of the exact size
+	length = strlen(test->sentence);
+	buffer = (char *)malloc(length);
+	if (buffer == NULL)
+		return 1;
+	memcpy(buffer, test->sentence, length);
+
+	if (navi_parse_msg(buffer, length, sizeof(parsed), &type, &parsed, &nmread) == navi_Ok)
+		errclass = navi_Undefined;
+	else
+		errclass = navierr_get_last()->errclass;
+
+	free(buffer);
+
+	if ((errclass != test->errclass) || (nmread != length))
+	{
+		printf("%s: error %d, %d expected, nmread = %u\n", test->sentence, errclass,
+			test->errclass, (unsigned)nmread);
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int result = 0;
+	size_t i;
+
+	for (i = 0; i < NM_FIELDS; i++)
+		result |= check_field(&g_fields[i]);
+
+	for (i = 0; i < NM_SENTENCES; i++)
+		result |= check_sentence(&g_sentences[i]);
+
+	printf("%u fuzzing cases checked, %s\n", (unsigned)(NM_FIELDS + NM_SENTENCES),
+		result ? "FAILED" : "ok");
+
+	return result;
+}
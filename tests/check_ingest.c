@@ -0,0 +1,281 @@
+/*
+ * check_ingest.c - tests of the multi-stream ingest engine
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <navigate.h>
+#include <libnavigate/ingest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif // _WIN32
+
+#define NM_STREAMS		40
+#define NM_BUSY			4		// the first streams are busy
+#define NM_BUSY_SENT	8000	// sentences per busy stream
+#define NM_IDLE_SENT	200		// sentences per idle stream
+#define NM_PRODUCERS	2
+
+static struct navi_ingest_t *g_engine;
+
+// The next expected sequence number per stream, touched only by the
+// worker handling the stream
+static size_t g_expected[NM_STREAMS];
+static volatile int g_errors;
+
+static void yield_thread(void)
+{
+#ifdef _WIN32
+	SwitchToThread();
+#else
+	sched_yield();
+#endif // _WIN32
+}
+
+static void count_error(void)
+{
+#ifdef _WIN32
+	InterlockedIncrement((volatile LONG *)&g_errors);
+#else
+	__sync_fetch_and_add(&g_errors, 1);
+#endif // _WIN32
+}
+
+static size_t sentences_of(size_t stream)
+{
+	return stream < NM_BUSY ? NM_BUSY_SENT : NM_IDLE_SENT;
+}
+
+// The sequence number is encoded in ZDA time
+static size_t create_zda(size_t seq, char *buffer, size_t maxsize)
+{
+	struct approved_field_t address;
+	struct zda_t zda;
+	size_t nmwritten = 0;
+
+	address.afmt = navi_ZDA;
+	address.tid = navi_GP;
+
+	navi_init_zda(&zda);
+	navi_init_utc_from_hhmmss((int)(seq / 3600), (int)(seq / 60 % 60), (double)(seq % 60), &zda.utc);
+
+	navi_create_msg(navi_af_Approved, &address, &zda, buffer, maxsize, &nmwritten);
+	return nmwritten;
+}
+
+static void handler(size_t stream, const struct navi_parsed_t *parsed, void *context)
+{
+	const struct zda_t *zda;
+	size_t seq;
+
+	(void)context;
+
+	if (parsed->status != navi_Ok)
+	{
+		count_error();
+		return;
+	}
+
+	zda = (const struct zda_t *)(parsed->msg + sizeof(struct approved_field_t));
+	seq = (size_t)zda->utc.hour * 3600 + (size_t)zda->utc.min * 60 + (size_t)zda->utc.sec;
+
+	if (seq != g_expected[stream])
+		count_error();
+
+	g_expected[stream] = seq + 1;
+}
+
+static void ignore(size_t stream, const struct navi_parsed_t *parsed, void *context)
+{
+	(void)stream;
+	(void)parsed;
+	(void)context;
+}
+
+// The framing counters of a noisy stream: garbage before a sentence cut
+// by '$', a good sentence and one with the wrong checksum
+static int check_frames(void)
+{
+	static const char noise[] = "garbage$GPZDA,1$GPZDA,,,,,,*48\r\n$GPZDA,,,,,,*00\r\n";
+
+	struct navi_ingest_t *engine;
+	struct navi_streamstats_t stats;
+	size_t nmread;
+	int result = 0;
+
+	engine = navi_ingest_create(2, 8, 1, ignore, NULL);
+	if (engine == NULL)
+	{
+		printf("navi_ingest_create failed (%d)\n", navierr_get_last()->errclass);
+		return 1;
+	}
+
+	if ((navi_ingest_feed(engine, 1, noise, sizeof(noise) - 1, &nmread) != navi_Ok) ||
+		(navi_ingest_drain(engine) != navi_Ok) ||
+		(navi_ingest_stats(engine, 1, &stats) != navi_Ok))
+	{
+		printf("noisy stream: failed (%d)\n", navierr_get_last()->errclass);
+		result = 1;
+	}
+	else if ((stats.frames.bytes != sizeof(noise) - 1) || (stats.frames.garbage != 15) ||
+		(stats.frames.sentences != 2) || (stats.frames.resyncs != 1) ||
+		(stats.frames.crcerrors != 1) || (stats.frames.overlong != 0) ||
+		(stats.frames.unterminated != 0) || (stats.received != 2))
+	{
+		printf("noisy stream: wrong framing statistics\n");
+		result = 1;
+	}
+
+	if ((navi_ingest_stats(engine, 0, &stats) != navi_Ok) || (stats.frames.bytes != 0))
+	{
+		printf("idle stream: wrong framing statistics\n");
+		result = 1;
+	}
+
+	navi_ingest_destroy(engine);
+
+	return result;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI producer(LPVOID arg)
+#else
+static void *producer(void *arg)
+#endif // _WIN32
+{
+	char buffer[4 * NAVI_SENTENCE_MAXSIZE];
+	size_t first = (size_t)arg, stream, sent[NM_STREAMS], length, offset, nmread, n;
+	int active = 1;
+
+	memset(sent, 0, sizeof(sent));
+
+	while (active)
+	{
+		active = 0;
+
+		for (stream = first; stream < NM_STREAMS; stream += NM_PRODUCERS)
+		{
+			// a busy stream gets several sentences per round
+			for (n = 0; n < (stream < NM_BUSY ? 4 : 1) && sent[stream] < sentences_of(stream); n++)
+			{
+				length = create_zda(sent[stream]++, buffer, sizeof(buffer));
+
+				// the sentence framed into the full queue is queued by the
+				// next call, even with no data left
+				for (offset = 0; navi_ingest_feed(g_engine, stream, buffer + offset,
+					length - offset, &nmread) != navi_Ok; offset += nmread)
+				{
+					yield_thread();
+				}
+			}
+
+			if (sent[stream] < sentences_of(stream))
+				active = 1;
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int result = 0, i;
+	size_t stream;
+	struct navi_streamstats_t stats;
+
+#ifdef _WIN32
+	HANDLE threads[NM_PRODUCERS];
+#else
+	pthread_t threads[NM_PRODUCERS];
+#endif // _WIN32
+
+	if (navi_ingest_create(NM_STREAMS, 6, 2, handler, NULL) != NULL ||
+		navierr_get_last()->errclass != navi_InvalidParameter)
+	{
+		printf("Invalid depth is accepted\n");
+		result = 1;
+	}
+
+	g_engine = navi_ingest_create(NM_STREAMS, 32, 4, handler, NULL);
+	if (g_engine == NULL)
+	{
+		printf("navi_ingest_create failed (%d)\n", navierr_get_last()->errclass);
+		return 1;
+	}
+
+	for (i = 0; i < NM_PRODUCERS; i++)
+	{
+#ifdef _WIN32
+		threads[i] = CreateThread(NULL, 0, producer, (LPVOID)(size_t)i, 0, NULL);
+#else
+		pthread_create(&threads[i], NULL, producer, (void *)(size_t)i);
+#endif // _WIN32
+	}
+
+	for (i = 0; i < NM_PRODUCERS; i++)
+	{
+#ifdef _WIN32
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+#else
+		pthread_join(threads[i], NULL);
+#endif // _WIN32
+	}
+
+	navi_ingest_drain(g_engine);
+
+	for (stream = 0; stream < NM_STREAMS; stream++)
+	{
+		navi_ingest_stats(g_engine, stream, &stats);
+
+		if (stream == 0 || stream == NM_STREAMS - 1)
+		{
+			printf("stream %u: received = %u, parsed = %u, failed = %u, overflows = %u, "
+				"backlog = %u, lag: last = %.6f, mean = %.6f, max = %.6f\n", (unsigned)stream,
+				(unsigned)stats.received, (unsigned)stats.parsed, (unsigned)stats.failed,
+				(unsigned)stats.overflows, (unsigned)stats.backlog,
+				stats.lastlag, stats.meanlag, stats.maxlag);
+		}
+
+		if ((stats.received != sentences_of(stream)) || (stats.parsed != stats.received) ||
+			(stats.failed != 0) || (stats.backlog != 0) || (stats.maxlag < stats.meanlag) ||
+			(stats.frames.sentences != stats.received) || (stats.frames.garbage != 0) ||
+			(g_expected[stream] != sentences_of(stream)))
+		{
+			printf("stream %u: wrong statistics\n", (unsigned)stream);
+			result = 1;
+		}
+	}
+
+	if (g_errors != 0)
+	{
+		printf("%d sentence(s) out of order or failed\n", g_errors);
+		result = 1;
+	}
+
+	navi_ingest_destroy(g_engine);
+
+	result |= check_frames();
+
+	return result;
+}
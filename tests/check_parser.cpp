@@ -0,0 +1,336 @@
+/*
+ * check_parser.cpp - tests of the reusable parser with the sentence handlers
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libnavigate/c++/arena.hpp>
+#include <libnavigate/c++/parser.hpp>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace libnavigate;
+
+// The sentences with a bad checksum and a bad field are appended to the track
+static const char *g_broken =
+	"$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W,A*00\r\n"
+	"$GPGGA,123519,4807.038,N,01131.000,E,7,08,0.9,545.4,M,46.9,M,,*40\r\n"
+	"$GNZDA,094550,09,06,2012,00,00*00\r\n";
+
+static bool is_handled(const char *sentence)
+{
+	return (sentence[0] == '$') && ((memcmp(sentence + 3, "RMC", 3) == 0) ||
+		(memcmp(sentence + 3, "GGA", 3) == 0) || (memcmp(sentence + 3, "ZDA", 3) == 0) ||
+		(memcmp(sentence + 3, "GSV", 3) == 0));
+}
+
+// The outcome of one sentence as a string, e.g. "ok $GPRMC,..." or "error 2"
+static std::string outcome(const AnyMessage_t &msg)
+{
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+	NaviError_t error;
+
+	return "ok " + std::string(buffer, EncodeAny(msg, buffer, sizeof(buffer), error));
+}
+
+static std::string outcome(const NaviError_t &error)
+{
+	return "error " + std::to_string((int)error);
+}
+
+// What the handlers should receive, by the codec
+static std::vector<std::string> expected_outcomes(const std::string &input, size_t *nmskipped)
+{
+	std::vector<std::string> result;
+	size_t start = 0, end, nmread;
+	NaviError_t error;
+	AnyMessage_t msg;
+
+	while ((end = input.find('\n', start)) != std::string::npos)
+	{
+		std::string sentence = input.substr(start, end + 1 - start);
+		start = end + 1;
+
+		if (!is_handled(sentence.c_str()))
+		{
+			(*nmskipped)++;
+			continue;
+		}
+
+		msg = DecodeAny(&sentence[0], sentence.size(), &nmread, error);
+		result.push_back(std::holds_alternative<std::monostate>(msg) ? outcome(error) : outcome(msg));
+	}
+
+	return result;
+}
+
+static void register_handlers(Parser_t &parser, std::vector<std::string> &outcomes)
+{
+	parser.on<Rmc_v>([&](const Rmc_v &rmc) { outcomes.push_back(outcome(rmc)); });
+	parser.on<Gga_v>([&](const Gga_v &gga) { outcomes.push_back(outcome(gga)); });
+	parser.on<Zda_v>([&](const Zda_v &zda) { outcomes.push_back(outcome(zda)); });
+	parser.on<Gsv_v>([&](const Gsv_v &gsv) { outcomes.push_back(outcome(gsv)); });
+	parser.onError([&](const NaviError_t &error, std::string_view) { outcomes.push_back(outcome(error)); });
+}
+
+// The stream pushed in the chunks of various sizes
+static int check_push(const std::string &input, const std::vector<std::string> &expected,
+	size_t nmskipped)
+{
+	size_t chunk = 1, offset, nmhandled = 0;
+	std::vector<std::string> outcomes;
+	Parser_t parser;
+	int result = 0;
+
+	register_handlers(parser, outcomes);
+
+	for (offset = 0; offset < input.size(); offset += chunk, chunk = chunk % 97 + 1)
+	{
+		nmhandled += parser.push(input.data() + offset,
+			offset + chunk < input.size() ? chunk : input.size() - offset);
+	}
+
+	if ((outcomes != expected) || (parser.nmparsed() != nmhandled) ||
+		(parser.nmparsed() + parser.nmfailed() != expected.size()) || (parser.nmskipped() != nmskipped))
+	{
+		result = 1;
+	}
+
+	printf("push: %d handled, %d failed, %d skipped, %s\n", (int)parser.nmparsed(),
+		(int)parser.nmfailed(), (int)parser.nmskipped(), result ? "FAILED" : "ok");
+
+	return result;
+}
+
+// The sentences parsed one by one, then with a handler removed
+static int check_parse(const std::string &input, const std::vector<std::string> &expected)
+{
+	std::string copy = input;
+	size_t offset, nmread, nmrmc = 0;
+	std::vector<std::string> outcomes;
+	Parser_t parser;
+	NaviError_t error;
+	int result = 0;
+
+	register_handlers(parser, outcomes);
+
+	for (offset = 0; offset < copy.size(); offset += nmread)
+	{
+		if (!parser.parse(&copy[offset], copy.size() - offset, &nmread, error) &&
+			(outcomes.empty() || (outcomes.back() != outcome(error))))
+		{
+			result = 1;
+		}
+	}
+
+	if (outcomes != expected)
+		result = 1;
+
+	parser.off<Rmc_v>();
+	parser.on<Gga_v>([&](const Gga_v &) { });
+	parser.on<Zda_v>([&](const Zda_v &) { });
+	parser.on<Gsv_v>([&](const Gsv_v &) { });
+	parser.onError([&](const NaviError_t &, std::string_view sentence) {
+		if (sentence.compare(3, 3, "RMC") == 0)
+			nmrmc++;
+	});
+
+	copy = input;
+	for (offset = 0; offset < copy.size(); offset += nmread)
+		parser.parse(&copy[offset], copy.size() - offset, &nmread, error);
+
+	if (nmrmc != 0)
+		result = 1;
+
+	printf("parse: %s\n", result ? "FAILED" : "ok");
+
+	return result;
+}
+
+// The history of the sentences kept in the arena, reset per epoch
+static int check_history(const std::string &input)
+{
+	typedef std::deque<Gll_v, ArenaAllocator_t<Gll_v> > history_t;
+
+	std::vector<std::string> outcomes, stored;
+	size_t epoch, reserved = 0;
+	Arena_t arena(4096);
+	Parser_t parser;
+	int result = 0;
+
+	for (epoch = 0; epoch < 3; epoch++)
+	{
+		history_t history(arena.allocator<Gll_v>());
+
+		outcomes.clear();
+		stored.clear();
+
+		parser.on<Gll_v>([&](const Gll_v &gll) {
+			history.push_back(gll);
+			outcomes.push_back(outcome(gll));
+		});
+		parser.push(input.data(), input.size());
+		parser.off<Gll_v>();
+
+		for (history_t::const_iterator i = history.begin(); i != history.end(); ++i)
+			stored.push_back(outcome(*i));
+
+		if (epoch == 0)
+			reserved = arena.reserved();
+
+		if (outcomes.empty() || (stored != outcomes) || (arena.used() == 0) ||
+			(arena.reserved() != reserved))
+		{
+			result = 1;
+		}
+
+		history.clear();
+		history.shrink_to_fit();
+		arena.reset();
+	}
+
+	printf("history: %d sentences, %d bytes reserved, %s\n", (int)outcomes.size(),
+		(int)reserved, result ? "FAILED" : "ok");
+
+	return result;
+}
+
+// The frame too short to carry an address fails, without reading behind it
+static int check_short()
+{
+	static const char frame[] = "$\r\n";
+
+	std::vector<std::string> outcomes;
+	std::vector<char> buffer(frame, frame + sizeof(frame) - 1);
+	size_t nmread = 0, nmhandled;
+	Parser_t parser;
+	NaviError_t error;
+	int result = 0;
+
+	register_handlers(parser, outcomes);
+
+	// the frame at the end of a buffer of the exact size
+	if (parser.parse(&buffer[0], buffer.size(), &nmread, error) || (nmread != buffer.size()) ||
+		(error != NaviError_t::InvalidMessage))
+	{
+		result = 1;
+	}
+
+	nmhandled = parser.push(&buffer[0], buffer.size());
+	if ((nmhandled != 0) || (parser.nmfailed() != 2) || (parser.nmskipped() != 0) ||
+		(outcomes.size() != 2))
+	{
+		result = 1;
+	}
+
+	printf("short: %d failed, %s\n", (int)parser.nmfailed(), result ? "FAILED" : "ok");
+
+	return result;
+}
+
+#ifdef WITH_STATS
+
+// Sums the histogram of the whole span of the RMC sentences traced
+static size_t nmtraced(const struct navi_stats_t &stats)
+{
+	size_t sum = 0;
+	int i;
+
+	for (i = 0; i < NAVI_STATS_NM_BUCKETS; i++)
+		sum += stats.trace_latency[navi_RMC][NAVI_TRACE_TOTAL][i];
+	return sum;
+}
+
+// Every sentence handled is traced while the tracing is on, and nothing
+// while it is off
+static int check_trace(const std::string &input)
+{
+	static struct navi_stats_t before, after;
+	size_t nmhandled = 0, handled, traced;
+	Parser_t parser;
+	int result = 0;
+
+	parser.on<Rmc_v>([&](const Rmc_v &) { nmhandled++; });
+
+	navi_stats_snapshot(&before);
+	navi_trace_enable(1);
+	parser.push(input.data(), input.size());
+	navi_trace_enable(0);
+	navi_stats_snapshot(&after);
+
+	handled = nmhandled;
+	traced = nmtraced(after) - nmtraced(before);
+	if ((handled == 0) || (traced != handled))
+		result = 1;
+
+	before = after;
+	parser.push(input.data(), input.size());
+	navi_stats_snapshot(&after);
+
+	if (nmtraced(after) != nmtraced(before))
+		result = 1;
+
+	printf("trace: %d of %d sentences, %s\n", (int)traced, (int)handled,
+		result ? "FAILED" : "ok");
+
+	return result;
+}
+
+#endif // WITH_STATS
+
+int main(int argc, char *argv[])
+{
+	const char *tracksdir = argc > 1 ? argv[1] : "tests/tracks";
+	char filename[1024], chunk[4096];
+	std::string input;
+	std::vector<std::string> expected;
+	size_t i, size, nmskipped = 0;
+	int result = 0;
+	FILE *f;
+
+	for (i = 0; i < 3; i++)
+	{
+		sprintf(filename, "%s/iec.track.%d", tracksdir, (int)i);
+		if ((f = fopen(filename, "rb")) == NULL)
+		{
+			printf("Cannot read %s\n", filename);
+			return 1;
+		}
+
+		while ((size = fread(chunk, 1, sizeof(chunk), f)) > 0)
+			input.append(chunk, size);
+		fclose(f);
+	}
+
+	input += g_broken;
+
+	expected = expected_outcomes(input, &nmskipped);
+
+	result |= check_push(input, expected, nmskipped);
+	result |= check_parse(input, expected);
+	result |= check_history(input);
+	result |= check_short();
+#ifdef WITH_STATS
+	result |= check_trace(input);
+#endif // WITH_STATS
+
+	return result;
+}
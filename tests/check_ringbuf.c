@@ -0,0 +1,208 @@
+/*
+ * check_ringbuf.c - tests of the streaming framer and the lock-free ring buffer
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <navigate.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif // _WIN32
+
+#define NM_REPEATS		2000
+#define NM_SLOTS		64
+
+// 5 valid sentences, garbage, an unterminated and a too long sentence
+static const char *g_stream =
+	"$GNZDA,094550,09,06,2012,00,00*55\r\n"
+	"garbage$GNDTM,W84,,,,,,,*0F\r\n"
+	"$GNRMC,094550,A,5957.01433,N,03023.22067,E,0,,090612,,,A*57\r\n"
+	"\r\n$GNGLL,5957.01433,N,03023.22067,E,094550,A,A*5C\r\n"
+	"$GNGLL,5957.01433,N,03023.22\n"
+	"$GNTXT,01,01,25,0123456789012345678901234567890123456789012345678901234567890123456789*00\r\n"
+	"$GNVTG,,,,,0,N,0,K,A*24\r\n";
+
+#define NM_VALID_PER_STREAM		5
+
+static struct navi_record_t g_slots[NM_SLOTS];
+static struct navi_ringbuf_t g_rb;
+static volatile int g_producers;
+
+static void yield_thread(void)
+{
+#ifdef _WIN32
+	SwitchToThread();
+#else
+	sched_yield();
+#endif // _WIN32
+}
+
+static int producers_left(void)
+{
+#ifdef _WIN32
+	return (int)InterlockedCompareExchange((volatile LONG *)&g_producers, 0, 0);
+#else
+	return __sync_fetch_and_add(&g_producers, 0);
+#endif // _WIN32
+}
+
+#ifdef _WIN32
+static DWORD WINAPI producer(LPVOID arg)
+#else
+static void *producer(void *arg)
+#endif // _WIN32
+{
+	struct navi_framer_t fr;
+	size_t length = strlen(g_stream), offset, chunk, nmread;
+	unsigned int seed = (unsigned int)(size_t)arg;
+	int i;
+
+	navi_framer_init(&fr);
+
+	for (i = 0; i < NM_REPEATS; i++)
+	{
+		for (offset = 0; offset < length; )
+		{
+			seed = seed * 1103515245 + 12345;
+			chunk = 1 + (seed >> 16) % 37;
+			if (chunk > length - offset)
+				chunk = length - offset;
+
+			while (navi_ringbuf_feed(&g_rb, &fr, g_stream + offset, chunk, &nmread) != navi_Ok)
+			{
+				offset += nmread;
+				chunk -= nmread;
+				yield_thread();
+			}
+			offset += nmread;
+		}
+	}
+
+#ifdef _WIN32
+	InterlockedDecrement((volatile LONG *)&g_producers);
+#else
+	__sync_fetch_and_sub(&g_producers, 1);
+#endif // _WIN32
+
+	return 0;
+}
+
+static int run(int mode, int nmproducers)
+{
+	int i, nmparsed = 0, nmfailed = 0;
+	navi_addrfield_t type;
+	char msg[1024];
+
+#ifdef _WIN32
+	HANDLE threads[4];
+#else
+	pthread_t threads[4];
+#endif // _WIN32
+
+	if (navi_ringbuf_init(&g_rb, g_slots, NM_SLOTS, mode) != navi_Ok)
+	{
+		printf("navi_ringbuf_init failed (%d)\n", navierr_get_last()->errclass);
+		return 1;
+	}
+
+	g_producers = nmproducers;
+
+	for (i = 0; i < nmproducers; i++)
+	{
+#ifdef _WIN32
+		threads[i] = CreateThread(NULL, 0, producer, (LPVOID)(size_t)(i + 1), 0, NULL);
+#else
+		pthread_create(&threads[i], NULL, producer, (void *)(size_t)(i + 1));
+#endif // _WIN32
+	}
+
+	for ( ; ; )
+	{
+		if (navi_ringbuf_parse(&g_rb, sizeof(msg), &type, msg) == navi_Ok)
+		{
+			nmparsed++;
+		}
+		else if (navierr_get_last()->errclass != navi_NoValidMessage)
+		{
+			nmfailed++;
+		}
+		else if (producers_left() == 0 && navi_ringbuf_size(&g_rb) == 0)
+		{
+			break;
+		}
+		else
+		{
+			yield_thread();
+		}
+	}
+
+	for (i = 0; i < nmproducers; i++)
+	{
+#ifdef _WIN32
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+#else
+		pthread_join(threads[i], NULL);
+#endif // _WIN32
+	}
+
+	printf("%s, %d producer(s): parsed = %d, failed = %d\n",
+		mode == navi_ringbuf_SPSC ? "SPSC" : "MPSC", nmproducers, nmparsed, nmfailed);
+
+	return (nmparsed == nmproducers * NM_REPEATS * NM_VALID_PER_STREAM) && (nmfailed == 0) ? 0 : 1;
+}
+
+int main(void)
+{
+	int result = 0;
+	size_t nmread, length;
+	struct navi_framer_t fr;
+	char sentence[NAVI_FRAME_MAXSIZE + 1];
+
+	// Framing of a sentence split into pieces
+	navi_framer_init(&fr);
+	if ((navi_framer_push(&fr, "xx$GPZDA,", 9, &nmread) == navi_Ok) || (nmread != 9) ||
+		(navi_framer_push(&fr, "094550,09,06,2012,00,00*55\r", 27, &nmread) == navi_Ok) ||
+		(navi_framer_push(&fr, "\n$GP", 4, &nmread) != navi_Ok) || (nmread != 1) ||
+		(strcmp(fr.sentence, "$GPZDA,094550,09,06,2012,00,00*55\r\n") != 0))
+	{
+		printf("Framing of split sentence failed\n");
+		result = 1;
+	}
+
+	// Copying pop
+	navi_ringbuf_init(&g_rb, g_slots, NM_SLOTS, navi_ringbuf_SPSC);
+	navi_ringbuf_push(&g_rb, fr.sentence, fr.length);
+	if ((navi_ringbuf_pop(&g_rb, sentence, sizeof(sentence), &length) != navi_Ok) ||
+		(length != fr.length) || (strcmp(sentence, fr.sentence) != 0) ||
+		(navi_ringbuf_pop(&g_rb, sentence, sizeof(sentence), &length) == navi_Ok))
+	{
+		printf("Push/pop failed\n");
+		result = 1;
+	}
+
+	result |= run(navi_ringbuf_SPSC, 1);
+	result |= run(navi_ringbuf_MPSC, 3);
+
+	return result;
+}
@@ -0,0 +1,161 @@
+/*
+ * check_schema.c - tests of the sentences generated from the schema
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <navigate.h>
+
+#include <stdio.h>
+#include <string.h>
+
+// The sentence and what it is generated back as, NULL if the same
+static const char *g_roundtrip[][2] =
+{
+	{ "$SDDBT,17.5,f,5.33,M,2.92,F*39\r\n", NULL },
+	{ "$SDDPT,5.33,-0.5,100*57\r\n", NULL },
+	{ "$SDDPT,5.33,0.5*67\r\n", "$SDDPT,5.33,0.5,*4B\r\n" },
+	{ "$HCHDG,98.3,0.5,E,12.6,W*52\r\n", NULL },
+	{ "$HCHDG,98.3,,,,*70\r\n", NULL },
+	{ "$HEHDT,274.07,T*19\r\n", NULL },
+	{ "$WIMWV,214.8,R,0.1,N,A*2D\r\n", NULL },
+	{ "$WIMWV,,,,,V*28\r\n", NULL }
+};
+
+// The sentences with invalid fields
+static const char *g_invalid[] =
+{
+	"$WIMWV,214.8,X,0.1,N,A*27\r\n",
+	"$SDDBT,17.5,m,5.33,M,2.92,F*32\r\n"
+};
+
+union parsed_t
+{
+	struct approved_field_t address;
+	double align;
+	char bytes[sizeof(struct approved_field_t) + 256];
+};
+
+// Parses the sentence and generates it back
+static int check_roundtrip(const char *sentence, const char *expected)
+{
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1], generated[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t nmread, nmwritten;
+	navi_addrfield_t type;
+	union parsed_t parsed;
+
+	strcpy(buffer, sentence);
+
+	if ((navi_parse_msg(buffer, strlen(buffer), sizeof(parsed), &type, &parsed, &nmread) != navi_Ok) ||
+		(type != navi_af_Approved) ||
+		(navi_create_msg(navi_af_Approved, &parsed.address, &parsed.address + 1, generated,
+			sizeof(generated), &nmwritten) != navi_Ok) ||
+		(nmwritten != strlen(expected)) || (memcmp(generated, expected, nmwritten) != 0))
+	{
+		printf("Round trip failed: %s", sentence);
+		return 1;
+	}
+
+	return 0;
+}
+
+// Checks the values of the fields
+static int check_fields(void)
+{
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t nmread;
+	navi_addrfield_t type;
+	union parsed_t parsed;
+	const struct mwv_t *mwv = (const struct mwv_t *)(&parsed.address + 1);
+	const struct hdg_t *hdg = (const struct hdg_t *)(&parsed.address + 1);
+	const struct dpt_t *dpt = (const struct dpt_t *)(&parsed.address + 1);
+	int result = 0;
+
+	strcpy(buffer, g_roundtrip[6][0]);
+	if ((navi_parse_msg(buffer, strlen(buffer), sizeof(parsed), &type, &parsed, &nmread) != navi_Ok) ||
+		(parsed.address.afmt != navi_MWV) || (parsed.address.tid != navi_WI) ||
+		(mwv->angle != 214.8) || (mwv->reference != 'R') || (mwv->speed != 0.1) ||
+		(mwv->units != 'N') || (mwv->status != navi_status_A))
+	{
+		result = 1;
+	}
+
+	strcpy(buffer, g_roundtrip[4][0]);
+	if ((navi_parse_msg(buffer, strlen(buffer), sizeof(parsed), &type, &parsed, &nmread) != navi_Ok) ||
+		(parsed.address.afmt != navi_HDG) || (hdg->heading != 98.3) ||
+		navi_schema_valid_offset(&hdg->deviation) || navi_schema_valid_offset(&hdg->variation))
+	{
+		result = 1;
+	}
+
+	// the range scale is missing in the older sentences
+	strcpy(buffer, g_roundtrip[2][0]);
+	if ((navi_parse_msg(buffer, strlen(buffer), sizeof(parsed), &type, &parsed, &nmread) != navi_Ok) ||
+		(parsed.address.afmt != navi_DPT) || (dpt->offset != 0.5) || navi_schema_valid_number(&dpt->range))
+	{
+		result = 1;
+	}
+
+	if (result)
+		printf("Field values failed\n");
+
+	return result;
+}
+
+int main(void)
+{
+	char buffer[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t i, nmread;
+	navi_addrfield_t type;
+	union parsed_t parsed;
+	struct hdt_t hdt;
+	int result = 0;
+
+	for (i = 0; i < sizeof(g_roundtrip) / sizeof(g_roundtrip[0]); i++)
+	{
+		result |= check_roundtrip(g_roundtrip[i][0],
+			g_roundtrip[i][1] ? g_roundtrip[i][1] : g_roundtrip[i][0]);
+	}
+
+	result |= check_fields();
+
+	for (i = 0; i < sizeof(g_invalid) / sizeof(g_invalid[0]); i++)
+	{
+		strcpy(buffer, g_invalid[i]);
+		if ((navi_parse_msg(buffer, strlen(buffer), sizeof(parsed), &type, &parsed, &nmread) == navi_Ok) ||
+			(navierr_get_last()->errclass != navi_InvalidMessage))
+		{
+			printf("Invalid sentence accepted: %s", g_invalid[i]);
+			result = 1;
+		}
+	}
+
+	// the generator checks the room
+	navi_init_hdt(&hdt);
+	hdt.heading = 274.07;
+	if ((navi_create_hdt(&hdt, buffer, 4, &nmread) == navi_Ok) ||
+		(navierr_get_last()->errclass != navi_NotEnoughBuffer) ||
+		(navi_create_hdt(&hdt, buffer, sizeof(buffer), &nmread) != navi_Ok) ||
+		(strcmp(buffer, "274.07,T") != 0) || (nmread != 8))
+	{
+		printf("HDT generator failed\n");
+		result = 1;
+	}
+
+	printf("%s\n", result ? "FAILED" : "ok");
+
+	return result;
+}
@@ -0,0 +1,374 @@
+/*
+ * check_source.c - tests of the epoll source layer with ptys, pipes, files and UDP
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _GNU_SOURCE
+
+#include <navigate.h>
+#include <libnavigate/source.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#define NM_PIPES		200
+#define NM_SOURCES		(NM_PIPES + 8)
+
+static const char *g_sentences =
+	"$GNZDA,094550,09,06,2012,00,00*55\r\n"
+	"$GNDTM,W84,,,,,,,*0F\r\n"
+	"$GNRMC,094550,A,5957.01433,N,03023.22067,E,0,,090612,,,A*57\r\n";
+
+#define NM_PER_WRITE	3
+
+static int g_received[NM_SOURCES];
+static int g_parsed[NM_SOURCES];
+static int g_ended[NM_SOURCES];
+
+// The source the handler closes on its first sentence, and the descriptor
+// it opens instead, or -1
+static struct navi_sources_t *g_sources;
+static int g_closing = -1, g_reopen = -1, g_reopened = -1;
+
+static void handler(int source, char *sentence, size_t length, void *context)
+{
+	char msg[1024];
+	size_t nmread;
+	navi_addrfield_t type;
+
+	(void)context;
+
+	if (sentence == NULL)
+	{
+		g_ended[source] = 1;
+		return;
+	}
+
+	g_received[source]++;
+	if (navi_parse_msg(sentence, length, sizeof(msg), &type, msg, &nmread) == navi_Ok)
+		g_parsed[source]++;
+
+	if (source == g_closing)
+	{
+		g_closing = -1;
+		navi_source_close(g_sources, source);
+		navi_source_add_fd(g_sources, g_reopen, &g_reopened);
+	}
+}
+
+// Source identifiers are reused after closing
+static void reset_counters(int source)
+{
+	g_received[source] = g_parsed[source] = g_ended[source] = 0;
+}
+
+// Polls until the source has received count sentences or time is out
+static int wait_for(struct navi_sources_t *sources, int source, int count)
+{
+	int i;
+
+	for (i = 0; (i < 200) && (g_received[source] < count); i++)
+		navi_sources_poll(sources, 10, NULL);
+
+	return g_received[source] == count;
+}
+
+static int check_pty(struct navi_sources_t *sources)
+{
+	int master, source, result = 0;
+	size_t length = strlen(g_sentences);
+
+	master = posix_openpt(O_RDWR | O_NOCTTY);
+	if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0))
+	{
+		printf("pty is not available, skipped\n");
+		return 0;
+	}
+
+	if (navi_source_open_serial(sources, ptsname(master), 4800, &source) != navi_Ok)
+	{
+		printf("navi_source_open_serial failed (%d)\n", navierr_get_last()->errclass);
+		close(master);
+		return 1;
+	}
+	reset_counters(source);
+
+	// a sentence split between two writes
+	write(master, g_sentences, 10);
+	navi_sources_poll(sources, 10, NULL);
+	write(master, g_sentences + 10, length - 10);
+
+	if (!wait_for(sources, source, NM_PER_WRITE) || (g_parsed[source] != NM_PER_WRITE))
+	{
+		printf("pty: received %d sentences\n", g_received[source]);
+		result = 1;
+	}
+
+	navi_source_close(sources, source);
+	close(master);
+
+	return result;
+}
+
+static int check_udp(struct navi_sources_t *sources)
+{
+	int fd, source = -1, result = 0;
+	unsigned short port;
+	size_t length = strlen(g_sentences);
+	struct sockaddr_in sa;
+
+	for (port = 29450; port < 29500; port++)
+	{
+		if (navi_source_open_udp(sources, "127.0.0.1", port, &source) == navi_Ok)
+			break;
+	}
+
+	if (source < 0)
+	{
+		printf("navi_source_open_udp failed (%d)\n", navierr_get_last()->errclass);
+		return 1;
+	}
+	reset_counters(source);
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sin_family = AF_INET;
+	sa.sin_port = htons(port);
+	sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+	// whole datagrams and a sentence split between datagrams
+	sendto(fd, g_sentences, length, 0, (struct sockaddr *)&sa, sizeof(sa));
+	sendto(fd, g_sentences, 20, 0, (struct sockaddr *)&sa, sizeof(sa));
+	sendto(fd, g_sentences + 20, length - 20, 0, (struct sockaddr *)&sa, sizeof(sa));
+
+	if (!wait_for(sources, source, 2 * NM_PER_WRITE) || (g_parsed[source] != 2 * NM_PER_WRITE))
+	{
+		printf("UDP: received %d sentences\n", g_received[source]);
+		result = 1;
+	}
+
+	close(fd);
+	navi_source_close(sources, source);
+
+	return result;
+}
+
+static int check_file(struct navi_sources_t *sources)
+{
+	const char *filename = "check_source.track";
+	int i, source, result = 0;
+	FILE *f;
+
+	f = fopen(filename, "wb");
+	for (i = 0; i < 1000; i++)
+		fputs(g_sentences, f);
+	fclose(f);
+
+	if (navi_source_open_file(sources, filename, &source) != navi_Ok)
+	{
+		printf("navi_source_open_file failed (%d)\n", navierr_get_last()->errclass);
+		return 1;
+	}
+	reset_counters(source);
+
+	for (i = 0; (i < 1000) && !g_ended[source]; i++)
+		navi_sources_poll(sources, 10, NULL);
+
+	if (!g_ended[source] || (g_parsed[source] != 1000 * NM_PER_WRITE))
+	{
+		printf("file: received %d sentences, ended = %d\n", g_received[source], g_ended[source]);
+		result = 1;
+	}
+
+	remove(filename);
+
+	return result;
+}
+
+static int check_pipes(struct navi_sources_t *sources)
+{
+	int i, fds[NM_PIPES][2], ids[NM_PIPES], total = 0, result = 0;
+	size_t nmsentences;
+
+	for (i = 0; i < NM_PIPES; i++)
+	{
+		if ((pipe(fds[i]) != 0) || (navi_source_add_fd(sources, fds[i][0], &ids[i]) != navi_Ok))
+		{
+			printf("pipe %d cannot be added (%d)\n", i, navierr_get_last()->errclass);
+			return 1;
+		}
+		reset_counters(ids[i]);
+		write(fds[i][1], g_sentences, strlen(g_sentences));
+	}
+
+	for (i = 0; (i < 200) && (total < NM_PIPES * NM_PER_WRITE); i++)
+	{
+		navi_sources_poll(sources, 10, &nmsentences);
+		total += (int)nmsentences;
+	}
+
+	for (i = 0; i < NM_PIPES; i++)
+	{
+		if (g_parsed[ids[i]] != NM_PER_WRITE)
+			result = 1;
+		close(fds[i][1]);
+	}
+
+	// the closed write end is the end of the source
+	for (i = 0; i < 10; i++)
+		navi_sources_poll(sources, 10, NULL);
+
+	for (i = 0; i < NM_PIPES; i++)
+	{
+		if (!g_ended[ids[i]])
+			result = 1;
+		close(fds[i][0]);
+	}
+
+	printf("%d pipes: %d sentences, %s\n", NM_PIPES, total, result ? "FAILED" : "ok");
+
+	return result;
+}
+
+static int check_health(struct navi_sources_t *sources)
+{
+	int fds[2], source, i, result = 0;
+	char stream[512];
+	size_t length;
+	struct navi_framestats_t stats;
+
+	// noise, a sentence, a sentence cut by '$', a line without <cr>,
+	// a sentence with the bad checksum and a too long one
+	strcpy(stream, "\x01\xff~~ $GNZDA,094550,09,06,2012,00,00*55\r\n"
+		"$GPZDA,0945$GNDTM,W84,,,,,,,*0F\r\n"
+		"$GPGLL,4807.038,N\n"
+		"$GNZDA,094550,09,06,2012,00,00*00\r\n$");
+	length = strlen(stream);
+	memset(stream + length, 'A', 100);
+	strcpy(stream + length + 100, "\r\n");
+	length = strlen(stream);
+
+	if ((pipe(fds) != 0) || (navi_source_add_fd(sources, fds[0], &source) != navi_Ok))
+	{
+		printf("health: pipe cannot be added (%d)\n", navierr_get_last()->errclass);
+		return 1;
+	}
+	reset_counters(source);
+	write(fds[1], stream, length);
+
+	for (i = 0; (i < 200) && (g_received[source] < 3); i++)
+		navi_sources_poll(sources, 10, NULL);
+
+	if ((navi_source_stats(sources, source, &stats) != navi_Ok) ||
+		(stats.bytes != length) || (stats.sentences != 3) ||
+		(stats.garbage != length - 35 - 22 - 35) || (stats.resyncs != 1) ||
+		(stats.unterminated != 1) || (stats.overlong != 1) || (stats.crcerrors != 1))
+	{
+		printf("health: %lu bytes, %lu garbage, %lu sentences, %lu resyncs, "
+			"%lu unterminated, %lu overlong, %lu crc errors\n",
+			(unsigned long)stats.bytes, (unsigned long)stats.garbage,
+			(unsigned long)stats.sentences, (unsigned long)stats.resyncs,
+			(unsigned long)stats.unterminated, (unsigned long)stats.overlong,
+			(unsigned long)stats.crcerrors);
+		result = 1;
+	}
+
+	navi_source_close(sources, source);
+	close(fds[0]);
+	close(fds[1]);
+
+	if (navi_source_stats(sources, source, &stats) == navi_Ok)
+	{
+		printf("health: stats of the closed source\n");
+		result = 1;
+	}
+
+	return result;
+}
+
+// The handler closes the source and reopens another one in its slot
+static int check_close(struct navi_sources_t *sources)
+{
+	int fds[2], other[2], source, i, result = 0;
+	struct navi_framestats_t stats;
+
+	if ((pipe(fds) != 0) || (pipe(other) != 0) ||
+		(navi_source_add_fd(sources, fds[0], &source) != navi_Ok))
+	{
+		printf("close: pipe cannot be added (%d)\n", navierr_get_last()->errclass);
+		return 1;
+	}
+	reset_counters(source);
+	write(fds[1], g_sentences, strlen(g_sentences));
+
+	g_sources = sources;
+	g_closing = source;
+	g_reopen = other[0];
+
+	for (i = 0; (i < 200) && (g_reopened < 0); i++)
+		navi_sources_poll(sources, 10, NULL);
+
+	// the rest of the data is not passed, nor fed to the new source
+	if ((g_received[source] != 1) || (g_reopened < 0) ||
+		(navi_source_stats(sources, g_reopened, &stats) != navi_Ok) || (stats.bytes != 0))
+	{
+		printf("close: received %d sentences after the source is closed\n",
+			g_received[source]);
+		result = 1;
+	}
+
+	if (g_reopened >= 0)
+		navi_source_close(sources, g_reopened);
+	close(fds[0]);
+	close(fds[1]);
+	close(other[0]);
+	close(other[1]);
+
+	return result;
+}
+
+int main(void)
+{
+	int result = 0;
+	struct navi_sources_t *sources;
+
+	sources = navi_sources_create(NM_SOURCES, handler, NULL);
+	if (sources == NULL)
+	{
+		printf("navi_sources_create failed (%d)\n", navierr_get_last()->errclass);
+		return 1;
+	}
+
+	result |= check_pty(sources);
+	result |= check_udp(sources);
+	result |= check_file(sources);
+	result |= check_pipes(sources);
+	result |= check_health(sources);
+	result |= check_close(sources);
+
+	navi_sources_destroy(sources);
+
+	return result;
+}
@@ -0,0 +1,302 @@
+/*
+ * check_stats.c - tests of the statistics of the parser and the generator
+ *
+ * Copyright (C) 2013 I. S. Gorbunov <igor.genius at gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <navigate.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif // _WIN32
+
+#ifdef WITH_STATS
+
+#define NM_THREADS		4
+#define NM_REPEATS		1000
+
+// 2 GLL, a RMC, a sentence with the bad checksum and an unsupported one
+static const char *g_stream =
+	"$GPGLL,4807.038,N,01131.000,E,123519,A,A*48\r\n"
+	"$GNRMC,094550,A,5957.01433,N,03023.22067,E,0,,090612,,,A*57\r\n"
+	"$GLGLL,4807.038,N,01131.000,E,123519,A,A*54\r\n"
+	"$GPGLL,4807.038,N,01131.000,E,123519,A,A*00\r\n"
+	"$GPMWD,,,,,,,,*49\r\n";
+
+static struct navi_stats_t g_before, g_after;
+
+//
+// Parses the stream NM_REPEATS times and generates a sentence back
+#ifdef _WIN32
+static DWORD WINAPI worker(LPVOID arg)
+#else
+static void *worker(void *arg)
+#endif // _WIN32
+{
+	char buffer[1024], msg[1024], generated[NAVI_SENTENCE_MAXSIZE + 1];
+	size_t length = strlen(g_stream), offset, nmread, nmwritten;
+	navi_addrfield_t type;
+	int i;
+
+	(void)arg;
+
+	strcpy(buffer, g_stream);
+
+	for (i = 0; i < NM_REPEATS; i++)
+	{
+		for (offset = 0; offset < length; offset += nmread)
+		{
+			if ((navi_parse_msg(buffer + offset, length - offset, sizeof(msg), &type, msg,
+					&nmread) == navi_Ok) && (i == 0))
+			{
+				(void)navi_create_msg(type, msg, (struct approved_field_t *)msg + 1,
+					generated, sizeof(generated), &nmwritten);
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int check_counters(void)
+{
+	const struct navi_stats_t *b = &g_before, *a = &g_after;
+	size_t nmlatency = 0;
+	int i, j, result = 0;
+
+	if ((a->parsed[navi_GLL][navi_GP] - b->parsed[navi_GLL][navi_GP] != NM_THREADS * NM_REPEATS) ||
+		(a->parsed[navi_GLL][navi_GL] - b->parsed[navi_GLL][navi_GL] != NM_THREADS * NM_REPEATS) ||
+		(a->parsed[navi_RMC][navi_GN] - b->parsed[navi_RMC][navi_GN] != NM_THREADS * NM_REPEATS))
+	{
+		printf("Parsed sentences miscounted\n");
+		result = 1;
+	}
+
+	if ((a->parse_errors[navi_CrcEror] - b->parse_errors[navi_CrcEror] != NM_THREADS * NM_REPEATS) ||
+		(a->parse_errors[navi_MsgNotSupported] - b->parse_errors[navi_MsgNotSupported] !=
+			NM_THREADS * NM_REPEATS))
+	{
+		printf("Errors miscounted\n");
+		result = 1;
+	}
+
+	if ((a->generated[navi_GLL][navi_GP] - b->generated[navi_GLL][navi_GP] != NM_THREADS) ||
+		(a->generated[navi_RMC][navi_GN] - b->generated[navi_RMC][navi_GN] != NM_THREADS))
+	{
+		printf("Generated sentences miscounted\n");
+		result = 1;
+	}
+
+	// every call is in a histogram
+	for (i = 0; i < NAVI_STATS_NM_TYPES; i++)
+		for (j = 0; j < NAVI_STATS_NM_BUCKETS; j++)
+			nmlatency += a->parse_latency[i][j] - b->parse_latency[i][j];
+
+	if (nmlatency != 5 * NM_THREADS * NM_REPEATS)
+	{
+		printf("Latency histograms miscounted: %lu\n", (unsigned long)nmlatency);
+		result = 1;
+	}
+
+	if (a->ticks_per_second <= 0.0)
+	{
+		printf("No tick frequency\n");
+		result = 1;
+	}
+
+	return result;
+}
+
+//
+// Sums the histogram of the trace span
+static size_t nmtraced(const struct navi_stats_t *stats, int type, int span)
+{
+	size_t sum = 0;
+	int i;
+
+	for (i = 0; i < NAVI_STATS_NM_BUCKETS; i++)
+		sum += stats->trace_latency[type][span][i];
+
+	return sum;
+}
+
+//
+// Handles the sentences of navi_parse_batch()
+static int delivered(const struct navi_parsed_t *parsed, void *context)
+{
+	(void)parsed;
+	(void)context;
+
+	return 0;
+}
+
+//
+// Traces the stream taken by the framer, then parsed in the batch
+static int check_trace(void)
+{
+	char buffer[1024], msg[1024];
+	size_t length = strlen(g_stream), offset, nmread, nmparsed;
+	struct navi_framer_t fr;
+	navi_addrfield_t type;
+	int i, span, result = 0;
+
+	navi_stats_snapshot(&g_before);
+	navi_trace_enable(1);
+
+	for (i = 0; i < NM_REPEATS; i++)
+	{
+		navi_framer_init(&fr);
+
+		for (offset = 0; navi_framer_push(&fr, g_stream + offset, length - offset,
+			&nmread) == navi_Ok; offset += nmread)
+		{
+			if (navi_parse_msg(fr.sentence, fr.length, sizeof(msg), &type, msg,
+					&nmparsed) == navi_Ok)
+				navi_trace_mark(navi_trace_Delivered, 0);
+		}
+
+		strcpy(buffer, g_stream);
+		navi_parse_batch(buffer, length, delivered, NULL, NULL);
+	}
+
+	navi_trace_enable(0);
+	navi_stats_snapshot(&g_after);
+
+	// the decoded sentences only, and all the stages of them
+	for (span = 0; span < NAVI_TRACE_NM_SPANS; span++)
+	{
+		if ((nmtraced(&g_after, navi_GLL, span) - nmtraced(&g_before, navi_GLL, span) !=
+				4 * NM_REPEATS) ||
+			(nmtraced(&g_after, navi_RMC, span) - nmtraced(&g_before, navi_RMC, span) !=
+				2 * NM_REPEATS) ||
+			(nmtraced(&g_after, NAVI_STATS_OTHER, span) -
+				nmtraced(&g_before, NAVI_STATS_OTHER, span) != 0))
+		{
+			printf("Trace span %d miscounted\n", span);
+			result = 1;
+		}
+	}
+
+	// and nothing while off
+	g_before = g_after;
+	strcpy(buffer, g_stream);
+	navi_parse_batch(buffer, length, delivered, NULL, NULL);
+	navi_stats_snapshot(&g_after);
+
+	if (nmtraced(&g_after, navi_GLL, NAVI_TRACE_TOTAL) !=
+		nmtraced(&g_before, navi_GLL, NAVI_TRACE_TOTAL))
+	{
+		printf("Traced while off\n");
+		result = 1;
+	}
+
+	return result;
+}
+
+#endif // WITH_STATS
+
+int main(void)
+{
+	int result = 0;
+
+#ifdef WITH_STATS
+
+#ifdef _WIN32
+	HANDLE threads[NM_THREADS];
+#else
+	pthread_t threads[NM_THREADS];
+#endif // _WIN32
+	int i;
+
+	if (navi_stats_snapshot(&g_before) != navi_Ok)
+	{
+		printf("navi_stats_snapshot failed (%d)\n", navierr_get_last()->errclass);
+		return 1;
+	}
+
+	for (i = 0; i < NM_THREADS; i++)
+	{
+#ifdef _WIN32
+		threads[i] = CreateThread(NULL, 0, worker, NULL, 0, NULL);
+#else
+		pthread_create(&threads[i], NULL, worker, NULL);
+#endif // _WIN32
+	}
+
+	for (i = 0; i < NM_THREADS; i++)
+	{
+#ifdef _WIN32
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+#else
+		pthread_join(threads[i], NULL);
+#endif // _WIN32
+	}
+
+	// the counters of the finished threads are kept
+	navi_stats_snapshot(&g_after);
+	result |= check_counters();
+
+	// and the blocks are reused by the new threads
+	g_before = g_after;
+#ifdef _WIN32
+	threads[0] = CreateThread(NULL, 0, worker, NULL, 0, NULL);
+	WaitForSingleObject(threads[0], INFINITE);
+	CloseHandle(threads[0]);
+#else
+	pthread_create(&threads[0], NULL, worker, NULL);
+	pthread_join(threads[0], NULL);
+#endif // _WIN32
+	navi_stats_snapshot(&g_after);
+
+	if (g_after.parsed[navi_RMC][navi_GN] - g_before.parsed[navi_RMC][navi_GN] != NM_REPEATS)
+	{
+		printf("Reused block miscounted\n");
+		result = 1;
+	}
+
+	result |= check_trace();
+
+#else
+
+	static struct navi_stats_t stats;
+
+	// compiled out
+	if ((navi_stats_snapshot(&stats) == navi_Ok) ||
+		(navierr_get_last()->errclass != navi_NotImplemented))
+	{
+		printf("navi_stats_snapshot without WITH_STATS\n");
+		result = 1;
+	}
+
+	if ((navi_trace_enable(1) == navi_Ok) ||
+		(navierr_get_last()->errclass != navi_NotImplemented))
+	{
+		printf("navi_trace_enable without WITH_STATS\n");
+		result = 1;
+	}
+
+#endif // WITH_STATS
+
+	printf("%s\n", result ? "FAILED" : "ok");
+
+	return result;
+}